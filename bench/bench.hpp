@@ -0,0 +1,79 @@
+/*
+Minimal benchmarking helpers shared by the bench/ programs of every module.
+On Linux, run() also reads hardware counters (cycles, instructions, cache misses, branch misses) around the timed
+calls with perf_event_open, when the kernel lets the process open them (see /proc/sys/kernel/perf_event_paranoid);
+report() prints them per iteration.
+If the environment variable BENCH_JSON names a file, report() also appends every result to it as a JSON object on one
+line, so that two runs can be diffed with jq or a script.
+*/
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace bench {
+
+    // Keeps the compiler from discarding a value that is computed only to be measured.
+    template <typename T>
+    void do_not_optimize (const T& value);
+
+    // Counts over all the timed iterations; a counter the kernel did not provide is empty. Counts of a multiplexed
+    // counter are scaled up to the whole time.
+    struct counters {
+        std::optional<std::uint64_t> cycles;
+        std::optional<std::uint64_t> instructions;
+        std::optional<std::uint64_t> cache_misses;
+        std::optional<std::uint64_t> branch_misses;
+    };
+
+    // The hardware counters of the calling thread, user space only.
+    class perf_counters {
+        private:
+            static constexpr int count = 4;
+            int fds[count] = {-1, -1, -1, -1};
+
+        public:
+            perf_counters();
+            ~perf_counters();
+            perf_counters (const perf_counters&) = delete;
+            perf_counters& operator= (const perf_counters&) = delete;
+
+            // Whether any counter could be opened.
+            bool available() const;
+
+            void start();
+            counters stop();
+    };
+
+    struct result {
+        std::string name;
+        std::size_t iterations = 0;
+        double seconds = 0;
+        std::size_t bytes = 0;    // processed per iteration, 0 if not meaningful
+        std::size_t items = 0;    // processed per iteration, 0 if not meaningful
+        bench::counters counters;
+
+        double ns_per_iteration() const;
+        double gb_per_second() const;
+        double items_per_second() const;
+    };
+
+    // Calls f() until at least min_seconds have passed (after one warm-up call) and reports the average.
+    template <typename F>
+    result run (std::string name, F&& f, std::size_t bytes = 0, std::size_t items = 0, double min_seconds = 0.25);
+
+    // Prints r, and appends it to the BENCH_JSON file if that is set.
+    void report (const result& r);
+
+    // argv[i] as a number, or fallback when it is missing.
+    std::size_t arg_or (int argc, char** argv, int i, std::size_t fallback);
+
+} // namespace bench
+
+#include "bench.impl.hpp"
+
+#endif // BENCH_HPP
@@ -0,0 +1,231 @@
+#ifndef BENCH_IMPL_HPP
+#define BENCH_IMPL_HPP
+
+#include "bench.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#define BENCH_HAS_PERF 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#define BENCH_HAS_PERF 0
+#endif
+
+namespace bench {
+
+    template <typename T>
+    void do_not_optimize (const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    // perf_counters ----------------------------------------------------------------------------------------------------------------
+
+#if BENCH_HAS_PERF
+    namespace detail {
+        inline constexpr std::uint64_t perf_events[] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+        };
+    }
+
+    inline perf_counters::perf_counters() {
+        for (int i = 0; i < count; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = detail::perf_events[i];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds[i] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+    }
+
+    inline perf_counters::~perf_counters() {
+        for (const int fd : fds) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    inline void perf_counters::start() {
+        for (const int fd : fds) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    inline counters perf_counters::stop() {
+        std::optional<std::uint64_t> values[count];
+        for (int i = 0; i < count; ++i) {
+            if (fds[i] >= 0) {
+                ::ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        for (int i = 0; i < count; ++i) {
+            std::uint64_t data[3];    // value, time enabled, time running
+            if (fds[i] >= 0 && ::read(fds[i], data, sizeof(data)) == static_cast<ssize_t>(sizeof(data)) && data[2] != 0) {
+                values[i] = data[2] == data[1] ? data[0]
+                                               : static_cast<std::uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+            }
+        }
+        return counters{values[0], values[1], values[2], values[3]};
+    }
+#else
+    inline perf_counters::perf_counters() = default;
+    inline perf_counters::~perf_counters() = default;
+    inline void perf_counters::start() {}
+    inline counters perf_counters::stop() { return counters{}; }
+#endif
+
+    inline bool perf_counters::available() const {
+        for (const int fd : fds) {
+            if (fd >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    // result -----------------------------------------------------------------------------------------------------------------------
+
+    inline double result::ns_per_iteration() const {
+        return iterations ? seconds * 1e9 / static_cast<double>(iterations) : 0.0;
+    }
+
+    inline double result::gb_per_second() const {
+        return seconds > 0 ? static_cast<double>(bytes) * static_cast<double>(iterations) / seconds / 1e9 : 0.0;
+    }
+
+    inline double result::items_per_second() const {
+        return seconds > 0 ? static_cast<double>(items) * static_cast<double>(iterations) / seconds : 0.0;
+    }
+
+    template <typename F>
+    result run (std::string name, F&& f, std::size_t bytes, std::size_t items, double min_seconds) {
+        using clock = std::chrono::steady_clock;
+        f();
+        result r;
+        r.name = std::move(name);
+        r.bytes = bytes;
+        r.items = items;
+        perf_counters perf;
+        perf.start();
+        const auto start = clock::now();
+        do {
+            f();
+            ++r.iterations;
+            r.seconds = std::chrono::duration<double>(clock::now() - start).count();
+        } while (r.seconds < min_seconds);
+        r.counters = perf.stop();
+        return r;
+    }
+
+    // report -----------------------------------------------------------------------------------------------------------------------
+
+    namespace detail {
+        inline double per_iteration (std::uint64_t count, const result& r) {
+            return r.iterations ? static_cast<double>(count) / static_cast<double>(r.iterations) : 0.0;
+        }
+
+        inline void write_json_string (std::FILE* f, const char* s) {
+            std::fputc('"', f);
+            for (; *s; ++s) {
+                const unsigned char c = static_cast<unsigned char>(*s);
+                if (c == '"' || c == '\\') {
+                    std::fprintf(f, "\\%c", c);
+                } else if (c < 0x20) {
+                    std::fprintf(f, "\\u%04x", c);
+                } else {
+                    std::fputc(c, f);
+                }
+            }
+            std::fputc('"', f);
+        }
+
+        inline const char* program_name() {
+#ifdef __GLIBC__
+            return program_invocation_short_name;
+#else
+            return "";
+#endif
+        }
+
+        // One line per result; the counters are per iteration and left out when they were not read.
+        inline void append_json (const result& r) {
+            const char* path = std::getenv("BENCH_JSON");
+            if (path == nullptr || *path == '\0') {
+                return;
+            }
+            std::FILE* f = std::fopen(path, "a");
+            if (f == nullptr) {
+                return;
+            }
+            std::fputs("{\"program\": ", f);
+            write_json_string(f, program_name());
+            std::fputs(", \"name\": ", f);
+            write_json_string(f, r.name.c_str());
+            std::fprintf(f, ", \"iterations\": %zu, \"ns_per_iteration\": %.6g, \"bytes\": %zu, \"items\": %zu", r.iterations,
+                         r.ns_per_iteration(), r.bytes, r.items);
+            if (r.bytes) {
+                std::fprintf(f, ", \"gb_per_second\": %.6g", r.gb_per_second());
+            }
+            if (r.items) {
+                std::fprintf(f, ", \"items_per_second\": %.6g", r.items_per_second());
+            }
+            const std::pair<const char*, const std::optional<std::uint64_t>*> fields[] = {
+                {"cycles", &r.counters.cycles}, {"instructions", &r.counters.instructions},
+                {"cache_misses", &r.counters.cache_misses}, {"branch_misses", &r.counters.branch_misses},
+            };
+            for (const auto& [key, value] : fields) {
+                if (*value) {
+                    std::fprintf(f, ", \"%s\": %.6g", key, per_iteration(**value, r));
+                }
+            }
+            std::fputs("}\n", f);
+            std::fclose(f);
+        }
+    }
+
+    inline void report (const result& r) {
+        std::printf("%-44s %14.1f ns/iter", r.name.c_str(), r.ns_per_iteration());
+        if (r.bytes) {
+            std::printf(" %9.3f GB/s", r.gb_per_second());
+        }
+        if (r.items) {
+            std::printf(" %12.4g items/s", r.items_per_second());
+        }
+        if (r.counters.cycles && r.counters.instructions && *r.counters.cycles) {
+            std::printf("  IPC %.2f", static_cast<double>(*r.counters.instructions) / static_cast<double>(*r.counters.cycles));
+        }
+        if (r.counters.cache_misses) {
+            std::printf(" %10.4g cache-misses/iter", detail::per_iteration(*r.counters.cache_misses, r));
+        }
+        if (r.counters.branch_misses) {
+            std::printf(" %10.4g branch-misses/iter", detail::per_iteration(*r.counters.branch_misses, r));
+        }
+        std::printf("\n");
+        detail::append_json(r);
+    }
+
+    inline std::size_t arg_or (int argc, char** argv, int i, std::size_t fallback) {
+        return i < argc ? static_cast<std::size_t>(std::strtoull(argv[i], nullptr, 10)) : fallback;
+    }
+
+} // namespace bench
+
+#endif // BENCH_IMPL_HPP
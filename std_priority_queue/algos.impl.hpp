@@ -31,7 +31,7 @@ template <typename RandomIt, typename Compare>
 constexpr void alg::push__heap (RandomIt first, RandomIt last, Compare comp) {
     const auto elemToPushIter = std::prev(last);
     const auto parentDist = std::distance(first, last);    
-    const auto parentIter = std::next(first, (parentDist - 1) / 2 );
+    const auto parentIter = std::next(first, (parentDist - 2) / 2 );
     if (first != elemToPushIter && !comp(*elemToPushIter, *parentIter)) {
         using std::swap;
         swap(*parentIter, *elemToPushIter);
@@ -0,0 +1,106 @@
+// Memory behaviour of pq::priority__queue under bursts: filling to the peak by growth vs. after reserve(), draining
+// with and without a shrink_policy (the storage kept afterwards, from memory()), and many short-lived per-request
+// queues on std::allocator vs. pmr::local_queue (inline buffer + monotonic resource) vs. a shared
+// unsynchronized_pool_resource.
+// usage: memory_bench [peak entries = 5000000] [requests = 100000] [entries per request = 64]
+
+#include "../pq.hpp"
+#include "../../bench/bench.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+namespace {
+    void print_memory (const char* name, const pq::memory_stats &m) {
+        std::printf("%-40s size %zu, capacity %zu, %.1f MiB reserved, %zu reallocations\n", name, m.size, m.capacity,
+                    m.bytes_reserved / 1048576.0, m.reallocations);
+    }
+}
+
+int main (int argc, char** argv) {
+    const std::size_t peak = bench::arg_or(argc, argv, 1, 5000000);
+    const std::size_t requests = bench::arg_or(argc, argv, 2, 100000);
+    const std::size_t per_request = bench::arg_or(argc, argv, 3, 64);
+
+    std::mt19937_64 rng(50);
+    std::vector<std::uint64_t> keys(peak);
+    for (std::uint64_t& k : keys) {
+        k = rng();
+    }
+
+    pq::memory_stats grown {}, reserved {};
+    bench::report(bench::run("burst fill, growing", [&] {
+        pq::priority__queue<std::uint64_t> q;
+        for (const std::uint64_t k : keys) {
+            q.push(k);
+        }
+        grown = q.memory();
+    }, 0, peak));
+    bench::report(bench::run("burst fill, reserve(peak) first", [&] {
+        pq::priority__queue<std::uint64_t> q;
+        q.reserve(peak);
+        for (const std::uint64_t k : keys) {
+            q.push(k);
+        }
+        reserved = q.memory();
+    }, 0, peak));
+    print_memory("growing:", grown);
+    print_memory("reserved:", reserved);
+
+    // Drain to 1% of the peak.
+    pq::memory_stats kept {}, shrunk {};
+    const auto drain = [&](pq::memory_stats &after, bool shrink) {
+        pq::priority__queue<std::uint64_t> q (keys.begin(), keys.end());
+        q.set_shrink_policy(pq::shrink_policy {shrink});
+        while (q.size() > peak / 100) {
+            q.pop();
+        }
+        after = q.memory();
+    };
+    bench::report(bench::run("drain to 1%, no shrink policy", [&] { drain(kept, false); }, 0, peak));
+    bench::report(bench::run("drain to 1%, shrink policy", [&] { drain(shrunk, true); }, 0, peak));
+    print_memory("drained, no shrink policy:", kept);
+    print_memory("drained, shrink policy:", shrunk);
+
+    // Short-lived queues: fill one per request, pop them all, destroy it.
+    const auto serve = [&](auto &q, std::size_t r) {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < per_request; ++i) {
+            q.push(keys[(r * per_request + i) % peak]);
+        }
+        while (!q.empty()) {
+            sum += q.top();
+            q.pop();
+        }
+        return sum;
+    };
+    bench::report(bench::run("per request, std::allocator", [&] {
+        std::uint64_t sum = 0;
+        for (std::size_t r = 0; r < requests; ++r) {
+            pq::priority__queue<std::uint64_t> q;
+            sum += serve(q, r);
+        }
+        bench::do_not_optimize(sum);
+    }, 0, requests * per_request));
+    bench::report(bench::run("per request, pmr::local_queue<4 KiB>", [&] {
+        std::uint64_t sum = 0;
+        for (std::size_t r = 0; r < requests; ++r) {
+            pq::pmr::local_queue<std::uint64_t, 4096> q;
+            q.reserve(per_request);
+            sum += serve(q, r);
+        }
+        bench::do_not_optimize(sum);
+    }, 0, requests * per_request));
+    std::pmr::unsynchronized_pool_resource pool;
+    bench::report(bench::run("per request, pmr unsynchronized pool", [&] {
+        std::uint64_t sum = 0;
+        for (std::size_t r = 0; r < requests; ++r) {
+            pq::pmr::priority__queue<std::uint64_t> q {std::pmr::polymorphic_allocator<std::uint64_t>(&pool)};
+            sum += serve(q, r);
+        }
+        bench::do_not_optimize(sum);
+    }, 0, requests * per_request));
+}
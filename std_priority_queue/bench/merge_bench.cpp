@@ -0,0 +1,91 @@
+// K-way merge of sorted runs of uint64: a pq::priority__queue of (head, run) popped and pushed once per element vs.
+// the loser tree (plain, batched into a block callback, and parallel over std::threads), with std::sort of the
+// concatenation as a baseline.
+// usage: merge_bench [runs = 1024] [elements per run = 4096] [threads = 0 (one per core)]
+
+#include "../loser_tree.hpp"
+#include "../pq.hpp"
+#include "../../bench/bench.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+int main (int argc, char** argv) {
+    const std::size_t k = bench::arg_or(argc, argv, 1, 1024);
+    const std::size_t per_run = bench::arg_or(argc, argv, 2, 4096);
+    const std::size_t threads = bench::arg_or(argc, argv, 3, 0);
+    const std::size_t total = k * per_run;
+
+    std::mt19937_64 rng(42);
+    std::vector<std::vector<std::uint64_t> > data(k);
+    for (auto& run : data) {
+        run.resize(per_run);
+        for (std::uint64_t& x : run) {
+            x = rng();
+        }
+        std::sort(run.begin(), run.end());
+    }
+    using iterator = std::vector<std::uint64_t>::const_iterator;
+    std::vector<std::pair<iterator, iterator> > runs;
+    for (const auto& run : data) {
+        runs.emplace_back(run.cbegin(), run.cend());
+    }
+    std::vector<std::uint64_t> out(total);
+    const std::size_t bytes = total * sizeof(std::uint64_t);
+
+    bench::report(bench::run("std::sort of the concatenation", [&] {
+        auto it = out.begin();
+        for (const auto& run : data) {
+            it = std::copy(run.begin(), run.end(), it);
+        }
+        std::sort(out.begin(), out.end());
+        bench::do_not_optimize(out.back());
+    }, bytes, total));
+
+    bench::report(bench::run("priority__queue of run heads", [&] {
+        pq::priority__queue<std::pair<std::uint64_t, std::size_t> > heads;
+        std::vector<iterator> cur;
+        for (std::size_t r = 0; r < k; ++r) {
+            cur.push_back(runs[r].first);
+            if (cur[r] != runs[r].second) {
+                heads.push({*cur[r], r});
+            }
+        }
+        auto it = out.begin();
+        while (!heads.empty()) {
+            const std::size_t r = heads.top().second;
+            *it++ = heads.top().first;
+            heads.pop();
+            if (++cur[r] != runs[r].second) {
+                heads.push({*cur[r], r});
+            }
+        }
+        bench::do_not_optimize(out.back());
+    }, bytes, total));
+
+    bench::report(bench::run("loser tree", [&] {
+        pq::multiway_merge(runs, out.begin());
+        bench::do_not_optimize(out.back());
+    }, bytes, total));
+
+    bench::report(bench::run("loser tree, batches of 4096", [&] {
+        std::uint64_t sum = 0;
+        pq::multiway_merge_batched(runs, 4096, [&](const std::uint64_t* p, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += p[i];
+            }
+        });
+        bench::do_not_optimize(sum);
+    }, bytes, total));
+
+    bench::report(bench::run("parallel loser tree", [&] {
+        pq::parallel_multiway_merge(runs, out.begin(), threads);
+        bench::do_not_optimize(out.back());
+    }, bytes, total));
+
+    std::printf("merged output sorted: %s\n", std::is_sorted(out.begin(), out.end()) ? "yes" : "no");
+}
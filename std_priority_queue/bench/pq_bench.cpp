@@ -0,0 +1,80 @@
+// pq::priority__queue vs. std::priority_queue<T, std::vector<T>, std::greater<T>> (the same min-heap) for int, double
+// and short std::string elements at three sizes: n pushes, n pops (the copy of the full queue they start from is
+// included), a mixed run of n pushes with a pop after every other one, and a bulk load from a range.
+// usage: pq_bench [largest size = 1048576]
+
+#include "../pq.hpp"
+#include "../../bench/bench.hpp"
+
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+template <typename Queue, typename T>
+void run_suite (const std::string& label, const std::vector<T>& data) {
+    const std::size_t n = data.size();
+    bench::report(bench::run(label + " push", [&] {
+        Queue q;
+        for (const T& x : data) {
+            q.push(x);
+        }
+        bench::do_not_optimize(q.top());
+    }, 0, n));
+
+    const Queue full (data.begin(), data.end());
+    bench::report(bench::run(label + " pop", [&] {
+        Queue q = full;
+        while (!q.empty()) {
+            q.pop();
+        }
+        bench::do_not_optimize(q.size());
+    }, 0, n));
+
+    bench::report(bench::run(label + " mixed", [&] {
+        Queue q;
+        for (std::size_t i = 0; i < n; ++i) {
+            q.push(data[i]);
+            if (i % 2 == 1) {
+                q.pop();
+            }
+        }
+        bench::do_not_optimize(q.top());
+    }, 0, n));
+
+    bench::report(bench::run(label + " bulk load", [&] {
+        Queue q (data.begin(), data.end());
+        bench::do_not_optimize(q.top());
+    }, 0, n));
+}
+
+template <typename T>
+void compare (const char* type_name, const std::vector<T>& data) {
+    const std::string suffix = std::string(" ") + type_name + " n=" + std::to_string(data.size());
+    run_suite<pq::priority__queue<T> >("pq" + suffix, data);
+    run_suite<std::priority_queue<T, std::vector<T>, std::greater<T> > >("std" + suffix, data);
+}
+
+int main (int argc, char** argv) {
+    const std::size_t largest = bench::arg_or(argc, argv, 1, 1 << 20);
+
+    std::vector<std::size_t> sizes = {std::size_t(1) << 10, std::size_t(1) << 16};
+    if (largest > sizes.back()) {
+        sizes.push_back(largest);
+    }
+    std::mt19937_64 rng(42);
+    for (const std::size_t n : sizes) {
+        std::vector<int> ints(n);
+        std::vector<double> doubles(n);
+        std::vector<std::string> strings(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            ints[i] = static_cast<int>(rng());
+            doubles[i] = static_cast<double>(rng()) / 3.0;
+            strings[i] = "key:" + std::to_string(rng() % 100000000);
+        }
+        compare("int", ints);
+        compare("double", doubles);
+        compare("string", strings);
+    }
+}
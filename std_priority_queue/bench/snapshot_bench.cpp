@@ -0,0 +1,61 @@
+// Restart time of a large scheduler queue of (deadline, job id) entries: rebuilding it through the range constructor
+// (copy into the container, then make__heap) vs. writing a snapshot and mapping it back with load_snapshot, with and
+// without the checksum pass, until top() is available; then the cost of the first pop, which promotes the mapping into
+// a vector. The file stays in the page cache between iterations, so the loads measure the mapping, not the disk.
+// usage: snapshot_bench [entries = 10000000] [snapshot file = /tmp/pq_snapshot_bench.bin]
+
+#include "../snapshot.hpp"
+#include "../../bench/bench.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    struct entry {
+        std::uint64_t deadline;
+        std::uint64_t job;
+
+        bool operator> (const entry &other) const { return deadline > other.deadline; }
+    };
+}
+
+int main (int argc, char** argv) {
+    const std::size_t n = bench::arg_or(argc, argv, 1, 10000000);
+    const std::string path = argc > 2 ? argv[2] : "/tmp/pq_snapshot_bench.bin";
+    const std::size_t bytes = n * sizeof(entry);
+
+    std::mt19937_64 rng(49);
+    std::vector<entry> entries(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        entries[i] = entry {rng() % 1000000000, i};
+    }
+
+    bench::report(bench::run("rebuild: range constructor (copy + make__heap)", [&] {
+        pq::priority__queue<entry> q (entries.begin(), entries.end());
+        bench::do_not_optimize(q.top());
+    }, bytes, n));
+
+    const pq::priority__queue<entry> queue (entries.begin(), entries.end());
+    bench::report(bench::run("save_snapshot (write + fsync + rename)", [&] {
+        pq::save_snapshot(queue, path);
+    }, bytes, n));
+
+    bench::report(bench::run("load_snapshot, checksum verified, to top()", [&] {
+        const auto q = pq::load_snapshot<entry>(path);
+        bench::do_not_optimize(q.top());
+    }, bytes, n));
+    bench::report(bench::run("load_snapshot, header only, to top()", [&] {
+        const auto q = pq::load_snapshot<entry>(path, std::greater<entry>(), false);
+        bench::do_not_optimize(q.top());
+    }, bytes, n));
+    bench::report(bench::run("load_snapshot, header only, then first pop", [&] {
+        auto q = pq::load_snapshot<entry>(path, std::greater<entry>(), false);
+        q.pop();
+        bench::do_not_optimize(q.top());
+    }, bytes, n));
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,106 @@
+/*
+K-way merge of sorted runs on a loser tree (tournament tree).
+Every inner node keeps the loser of the match played there and node 0 the overall winner, so after the winner's run
+advances, one replay from its leaf to the root (log k comparisons with the losers on the way) finds the next winner. A
+heap of run heads needs a pop and a push for the same step, about 2 log k comparisons.
+Equal elements come out in run order, so the merge is stable. The tie-break costs no second comparison: the leaves are
+padded to a power of two, so at every node the leaves on the left come first, and which side the winner climbs from
+settles equal keys.
+Runs can be iterator pairs or pull sources (callables bool(T&) that fill in the next element and return false once
+exhausted). parallel_multiway_merge cuts the output at splitters sampled from the runs, finds each splitter in
+every run by binary search and merges the pieces independently on std::threads.
+*/
+
+#ifndef LOSER_TREE_HPP
+#define LOSER_TREE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace pq {
+    // The tournament over k leaves, each holding the current head of a run or nothing once the run is exhausted (an
+    // exhausted leaf goes after everything). Every node keeps the key of its loser next to the leaf index, so a replay
+    // only reads the nodes on one path and carries the winner's key up with it.
+    template <typename T, typename Compare = std::less<> >
+    class loser_tree {
+        public:
+            using size_type = std::size_t;
+            using value_type = T;
+
+        private:
+            // rank: the leaf index, plus exhausted once the leaf has run out; ranks break ties between equal keys.
+            struct node {
+                T key;
+                size_type rank;
+            };
+
+            static constexpr size_type exhausted = size_type(1) << (sizeof(size_type) * 8 - 1);
+
+            std::vector<node> nodes;    // nodes[0]: winner; nodes[1, base): loser of the match at that node
+            size_type k;
+            size_type base;             // k rounded up to a power of two; leaf i is node base + i
+            Compare comp;
+
+            // Whether a goes first; a_left: a's leaf is left of b's (the lower rank), as the caller knows from the path.
+            bool before (const node &a, const node &b, bool a_left) const;
+            bool before (const node* pair, bool left) const;     // pair[0] before pair[1], pair[0] left if left
+            void replay (node w);
+
+        public:
+            explicit loser_tree (size_type leaves, const Compare &compare = Compare());
+
+            // Plays all the matches. head(i, key) stores the first key of leaf i into key and returns true, or returns
+            // false if the leaf is empty.
+            template <typename Head>
+            void build (Head head);
+
+            // Whether every leaf is exhausted.
+            bool empty() const;
+
+            // The leaf holding the smallest key, and that key; ties go to the lower leaf.
+            size_type winner() const;
+            const T& top() const;
+
+            // The winner's leaf moves on to key, or is exhausted; either replays the matches on its path.
+            void replace_top (T key);
+            void exhaust_top();
+
+            size_type size() const;
+    };
+
+    // Merges runs (a range of pairs of iterators, e.g. std::vector<std::pair<It, It>>) into out.
+    template <typename Runs, typename OutputIt, typename Compare = std::less<> >
+    OutputIt multiway_merge (const Runs& runs, OutputIt out, Compare comp = Compare());
+
+    // The same merge handed out in blocks: f(const T* data, size_t n) is called with up to batch elements at a time,
+    // copied into a buffer that is reused between calls.
+    template <typename Runs, typename F, typename Compare = std::less<> >
+    void multiway_merge_batched (const Runs& runs, std::size_t batch, F f, Compare comp = Compare());
+
+    // Merges pull sources: sources[i](value) stores the next element of run i into value and returns true, or returns
+    // false once the run is exhausted.
+    template <typename T, typename Source, typename OutputIt, typename Compare = std::less<> >
+    OutputIt multiway_merge_pull (std::vector<Source>& sources, OutputIt out, Compare comp = Compare());
+
+    // Merges into [out, out + total size) using up to `threads` threads (0: one per core).
+    template <typename Runs, typename RandomIt, typename Compare = std::less<> >
+    RandomIt parallel_multiway_merge (const Runs& runs, RandomIt out, std::size_t threads = 0, Compare comp = Compare());
+
+} // namespace pq
+
+#include "loser_tree.impl.hpp"
+
+#endif // LOSER_TREE_HPP
+
+/*
+Methods                       Time Complexity      Auxiliary Space
+loser_tree::build()           O(k)                 O(k)
+loser_tree::replace_top()     O(log k)             O(1)
+loser_tree::exhaust_top()     O(log k)             O(1)
+multiway_merge()              O(N log k)           O(k)
+multiway_merge_batched()      O(N log k)           O(k + batch)
+multiway_merge_pull()         O(N log k)           O(k)
+parallel_multiway_merge()     O(N log k / threads + threads * k log N)      O(threads * k)
+*/
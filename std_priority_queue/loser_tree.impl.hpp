@@ -0,0 +1,277 @@
+#ifndef LOSER_TREE_IMPL_HPP
+#define LOSER_TREE_IMPL_HPP
+
+#include <algorithm>
+#include <bit>
+#include <exception>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace pq {
+    // loser_tree--------------------------------------------------------------------------------------
+    /// NOTE: the leaves are nodes base .. 2 base - 1, base being k rounded up to a power of two (the leaves past k are
+    ///       exhausted), and node i has children 2i and 2i + 1, as in a heap. In that full tree every leaf under the
+    ///       left child of a node comes before every leaf under its right child, so the side a match is played from
+    ///       tells which of the two ranks is lower without looking at them.
+    template <typename T, typename Compare>
+    loser_tree<T, Compare>::loser_tree (size_type leaves, const Compare &compare)
+        : nodes (std::bit_ceil(std::max<size_type>(leaves, 1)), node{T(), exhausted}), k (leaves), base (nodes.size()),
+          comp (compare)
+    {}
+
+    // One call to comp: a.rank < b.rank ? !comp(b.key, a.key) : comp(a.key, b.key), with a_left standing for the rank
+    // comparison, which the caller knows from the path before the match.
+    template <typename T, typename Compare>
+    inline bool loser_tree<T, Compare>::before (const node &a, const node &b, bool a_left) const {
+        if ((a.rank | b.rank) & exhausted) {
+            return a.rank < b.rank;
+        }
+        return a_left ? !comp(b.key, a.key) : comp(a.key, b.key);
+    }
+
+    // The same match on two adjacent nodes, with the operands picked by indexing: left is known early, so nothing
+    // waits on it, where the ?: above becomes a branch on random path bits.
+    template <typename T, typename Compare>
+    inline bool loser_tree<T, Compare>::before (const node* pair, bool left) const {
+        if ((pair[0].rank | pair[1].rank) & exhausted) {
+            return pair[0].rank < pair[1].rank;
+        }
+        return comp(pair[left].key, pair[!left].key) != left;
+    }
+
+    template <typename T, typename Compare>
+    template <typename Head>
+    void loser_tree<T, Compare>::build (Head head) {
+        std::vector<node> winners (2 * base, node{T(), exhausted});
+        for (size_type i = 0; i < base; ++i) {
+            node& leaf = winners[base + i];
+            leaf.rank = i < k && head(i, leaf.key) ? i : i | exhausted;
+        }
+        for (size_type n = base; n-- > 1;) {
+            const bool a_wins = before(&winners[2 * n], true);
+            nodes[n] = std::move(winners[2 * n + a_wins]);
+            winners[n] = std::move(winners[2 * n + !a_wins]);
+        }
+        nodes[0] = std::move(winners[1]);
+    }
+
+    // Only the winner's path can change: at each node the stored loser plays the climbing candidate. The outcome of a
+    // match on random keys is a coin toss, so small trivially copyable nodes are exchanged by indexing, not a branch.
+    // The inline keywords on this path matter: out of line, the node passed by value goes through memory at each call.
+    template <typename T, typename Compare>
+    inline void loser_tree<T, Compare>::replay (node w) {
+        // The loser kept at a node comes from the other side than the winner's path: left of it when m is a right child.
+        for (size_type m = (w.rank & ~exhausted) + base; m > 1; m /= 2) {
+            node& x = nodes[m / 2];
+            const bool x_left = m & 1;
+            if constexpr (std::is_trivially_copyable_v<node> && sizeof(node) <= 32) {
+                const node pair[2] = {x, w};
+                const bool lost = before(pair, x_left);
+                x = pair[lost];
+                w = pair[!lost];
+            } else if (before(x, w, x_left)) {
+                std::swap(x, w);
+            }
+        }
+        nodes[0] = std::move(w);
+    }
+
+    template <typename T, typename Compare>
+    inline bool loser_tree<T, Compare>::empty () const {
+        return (nodes[0].rank & exhausted) != 0;
+    }
+
+    template <typename T, typename Compare>
+    inline auto loser_tree<T, Compare>::winner () const -> size_type {
+        return nodes[0].rank & ~exhausted;
+    }
+
+    template <typename T, typename Compare>
+    inline const T& loser_tree<T, Compare>::top () const {
+        return nodes[0].key;
+    }
+
+    template <typename T, typename Compare>
+    inline void loser_tree<T, Compare>::replace_top (T key) {
+        replay(node{std::move(key), nodes[0].rank});
+    }
+
+    template <typename T, typename Compare>
+    inline void loser_tree<T, Compare>::exhaust_top () {
+        node w = std::move(nodes[0]);
+        w.rank |= exhausted;
+        replay(std::move(w));
+    }
+
+    template <typename T, typename Compare>
+    auto loser_tree<T, Compare>::size () const -> size_type {
+        return k;
+    }
+
+    // merges------------------------------------------------------------------------------------------
+    namespace detail {
+        template <typename Runs>
+        using run_iterator = std::remove_cvref_t<decltype(std::begin(std::declval<const Runs&>())->first)>;
+
+        // Loser tree over iterator runs, built from their first elements.
+        template <typename Runs, typename Compare>
+        auto run_tree (const Runs& runs, std::vector<run_iterator<Runs> >& cur, std::vector<run_iterator<Runs> >& end,
+                       const Compare& comp) {
+            using value_type = typename std::iterator_traits<run_iterator<Runs> >::value_type;
+            for (const auto& r : runs) {
+                cur.push_back(r.first);
+                end.push_back(r.second);
+            }
+            loser_tree<value_type, Compare> tree (cur.size(), comp);
+            tree.build([&](std::size_t i, value_type& key) {
+                if (cur[i] == end[i]) {
+                    return false;
+                }
+                key = *cur[i];
+                return true;
+            });
+            return tree;
+        }
+
+        // Steps the winner's run and hands its next element, if any, to the tree.
+        template <typename Tree, typename It>
+        void advance_top (Tree& tree, std::vector<It>& cur, const std::vector<It>& end) {
+            const std::size_t w = tree.winner();
+            if (++cur[w] == end[w]) {
+                tree.exhaust_top();
+            } else {
+                tree.replace_top(*cur[w]);
+            }
+        }
+    }
+
+    template <typename Runs, typename OutputIt, typename Compare>
+    OutputIt multiway_merge (const Runs& runs, OutputIt out, Compare comp) {
+        std::vector<detail::run_iterator<Runs> > cur, end;
+        auto tree = detail::run_tree(runs, cur, end, comp);
+        while (!tree.empty()) {
+            *out = tree.top();
+            ++out;
+            detail::advance_top(tree, cur, end);
+        }
+        return out;
+    }
+
+    template <typename Runs, typename F, typename Compare>
+    void multiway_merge_batched (const Runs& runs, std::size_t batch, F f, Compare comp) {
+        using value_type = typename std::iterator_traits<detail::run_iterator<Runs> >::value_type;
+        std::vector<detail::run_iterator<Runs> > cur, end;
+        auto tree = detail::run_tree(runs, cur, end, comp);
+        batch = std::max<std::size_t>(batch, 1);
+        std::vector<value_type> buffer;
+        buffer.reserve(batch);
+        while (!tree.empty()) {
+            buffer.push_back(tree.top());
+            detail::advance_top(tree, cur, end);
+            if (buffer.size() == batch || tree.empty()) {
+                f(static_cast<const value_type*>(buffer.data()), buffer.size());
+                buffer.clear();
+            }
+        }
+    }
+
+    template <typename T, typename Source, typename OutputIt, typename Compare>
+    OutputIt multiway_merge_pull (std::vector<Source>& sources, OutputIt out, Compare comp) {
+        loser_tree<T, Compare> tree (sources.size(), comp);
+        tree.build([&](std::size_t i, T& key) { return bool(sources[i](key)); });
+        T next {};
+        while (!tree.empty()) {
+            *out = tree.top();
+            ++out;
+            if (sources[tree.winner()](next)) {
+                tree.replace_top(std::move(next));
+            } else {
+                tree.exhaust_top();
+            }
+        }
+        return out;
+    }
+
+    // parallel_multiway_merge-------------------------------------------------------------------------
+    /// NOTE: the splitters are taken from a sample of every run, 32 per part in proportion to the run lengths, and
+    ///       each run is cut at the first element not below a splitter (lower_bound). Equal elements therefore never
+    ///       straddle a cut, so the parts can be merged independently and the result stays stable; the part sizes are
+    ///       only as even as the sample.
+    template <typename Runs, typename RandomIt, typename Compare>
+    RandomIt parallel_multiway_merge (const Runs& runs, RandomIt out, std::size_t threads, Compare comp) {
+        using It = detail::run_iterator<Runs>;
+        using value_type = typename std::iterator_traits<It>::value_type;
+        std::vector<std::pair<It, It>> all;
+        std::size_t total = 0;
+        for (const auto& r : runs) {
+            all.emplace_back(r.first, r.second);
+            total += static_cast<std::size_t>(std::distance(r.first, r.second));
+        }
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        constexpr std::size_t min_part = 1 << 14;
+        const std::size_t parts = std::min(threads, total / min_part + 1);
+        if (parts <= 1) {
+            return multiway_merge(all, out, comp);
+        }
+
+        constexpr std::size_t oversample = 32;
+        const std::size_t stride = std::max<std::size_t>(total / (parts * oversample), 1);
+        std::vector<value_type> sample;
+        for (const auto& [first, last] : all) {
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            for (std::size_t i = stride / 2; i < n; i += stride) {
+                sample.push_back(first[i]);
+            }
+        }
+        std::sort(sample.begin(), sample.end(), comp);
+
+        // cuts[p][r]: where part p starts in run r.
+        std::vector<std::vector<It>> cuts (parts + 1);
+        std::vector<std::size_t> offsets (parts + 1, 0);
+        for (std::size_t p = 0; p <= parts; ++p) {
+            for (const auto& [first, last] : all) {
+                if (p == 0) {
+                    cuts[p].push_back(first);
+                } else if (p == parts || sample.empty()) {
+                    cuts[p].push_back(last);
+                } else {
+                    cuts[p].push_back(std::lower_bound(first, last, sample[p * sample.size() / parts], comp));
+                }
+                offsets[p] += static_cast<std::size_t>(cuts[p].back() - first);
+            }
+        }
+
+        std::vector<std::exception_ptr> errors (parts);
+        const auto merge_part = [&](std::size_t p) {
+            try {
+                std::vector<std::pair<It, It>> piece;
+                for (std::size_t r = 0; r < all.size(); ++r) {
+                    piece.emplace_back(cuts[p][r], cuts[p + 1][r]);
+                }
+                multiway_merge(piece, out + static_cast<std::ptrdiff_t>(offsets[p]), comp);
+            } catch (...) {
+                errors[p] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> workers;
+        for (std::size_t p = 1; p < parts; ++p) {
+            workers.emplace_back(merge_part, p);
+        }
+        merge_part(0);
+        for (std::thread& t : workers) {
+            t.join();
+        }
+        for (const std::exception_ptr& e : errors) {
+            if (e) {
+                std::rethrow_exception(e);
+            }
+        }
+        return out + static_cast<std::ptrdiff_t>(total);
+    }
+
+} // namespace pq
+
+#endif // LOSER_TREE_IMPL_HPP
@@ -1,4 +1,8 @@
 #include "pq.hpp"
+#include "loser_tree.hpp"
+#include "snapshot.hpp"
+#include <cstdio>
+#include <filesystem>
 #include <functional>
 #include <iostream>
 #include <queue>
@@ -53,4 +57,30 @@ int main() {
     for (int n : data)
         q5.push(n); 
     print_queue("q5", q5);
-}
\ No newline at end of file
+
+    // k-way merge of sorted runs on a loser tree
+    const std::vector<std::vector<int>> runs {{0, 3, 6, 9}, {1, 4, 7}, {2, 5, 8}};
+    std::vector<std::pair<std::vector<int>::const_iterator, std::vector<int>::const_iterator>> ranges;
+    for (const auto& run : runs)
+        ranges.emplace_back(run.begin(), run.end());
+    std::vector<int> merged;
+    pq::multiway_merge(ranges, std::back_inserter(merged));
+    print("merged", merged);
+
+    // Snapshot of q1, mapped back in heap order
+    const std::string snapshot = (std::filesystem::temp_directory_path() / "pq_demo.snapshot").string();
+    pq::save_snapshot(q1, snapshot);
+    const pq::restored_queue<int> restored = pq::load_snapshot<int>(snapshot);
+    print_queue("restored", restored);
+    std::remove(snapshot.c_str());
+
+    // A per-request queue on an inline buffer, reserved up front
+    pq::pmr::local_queue<int, 1024> scratch;
+    scratch.reserve(data.size());
+    for (int n : data)
+        scratch.push(n);
+    const pq::memory_stats stats = scratch.memory();
+    std::cout << "scratch: \t" << stats.size << " of " << stats.capacity << ", "
+              << stats.reallocations << " reallocation(s)\n";
+    print_queue("scratch", pq::pmr::priority__queue<int>(scratch));
+}
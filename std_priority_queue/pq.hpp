@@ -1,6 +1,10 @@
 /* 
 Implement priority queue based on min-heap data structure, satisifying 
 the synatactic and semantic requirements of std::priority_queue adapter.
+Memory: the allocator-extended constructors of std::priority_queue (and pq::pmr::priority__queue over a
+std::pmr::vector), reserve() up front instead of growing by reallocation, an optional shrink_policy that gives memory
+back as the queue drains, and memory() to see capacity, bytes and reallocations so far. pq::pmr::local_queue takes its
+storage from an inline buffer and a monotonic resource, for short-lived queues that die all at once.
 */
  
 /// NOTE: I'm trying to mimic the style of the STL...
@@ -9,15 +13,59 @@ the synatactic and semantic requirements of std::priority_queue adapter.
 #define PQ_HPP
 
 #include "algos.hpp"
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 
 namespace pq {
+    // Marks a container that is already a heap under the queue's Compare, adopted as is (no make__heap).
+    struct heap_order_t {
+        explicit heap_order_t() = default;
+    };
+    inline constexpr heap_order_t heap_order {};
+
+    // Containers whose storage can be reserved, measured and reallocated with their allocator (std::vector).
+    template <typename Container>
+    concept reservable_container = requires (Container &c, const Container &cc, typename Container::size_type n) {
+        c.reserve(n);
+        { cc.capacity() } -> std::convertible_to<typename Container::size_type>;
+        Container(cc.get_allocator());
+    };
+
+    // Shrink-on-drain: once pop() leaves size() below `below` * capacity(), the storage is reallocated to
+    // `headroom` * size() elements (never fewer than min_capacity). With below * headroom < 1 a queue hovering around one
+    // size does not shrink and grow back in turns: after a shrink it has to halve again (with the defaults) before the
+    // next one, and double before it grows.
+    struct shrink_policy {
+        bool enabled = false;
+        double below = 0.25;
+        double headroom = 2.0;
+        std::size_t min_capacity = 4096;
+    };
+
+    struct memory_stats {
+        std::size_t size;               // elements
+        std::size_t capacity;           // elements the storage holds (size for containers without capacity())
+        std::size_t bytes_used;         // size * sizeof(value_type)
+        std::size_t bytes_reserved;     // capacity * sizeof(value_type)
+        std::size_t reallocations;      // times the storage moved: growth, reserve() and shrinks
+    };
+
     template <typename T, typename Container = std::vector<T>,
               typename Compare = std::greater<typename Container::value_type>>
     class priority__queue {
         private:
             Container c;
             Compare comp;
+            shrink_policy shrink;
+            std::size_t reallocations = 0;
+
+            std::size_t storage() const noexcept;
+            void count_reallocation (std::size_t before) noexcept;
+            void reallocate (std::size_t n);
+            void shrink_if_drained();
 
         public:
             using container_type = Container;
@@ -30,6 +78,7 @@ namespace pq {
         public:
             explicit priority__queue(const Compare &compare = Compare(), const Container &cont = Container());
             priority__queue(const Compare &compare, Container &&cont);
+            priority__queue(heap_order_t, const Compare &compare, Container &&cont);
 
             template <typename InputIt>
             priority__queue(InputIt first, InputIt last, const Compare &compare = Compare(), const Container &cont = Container());
@@ -37,6 +86,26 @@ namespace pq {
             template <typename InputIt>
             priority__queue(InputIt first, InputIt last, const Compare &compare, Container &&cont);
 
+            // Allocator-extended: the container is constructed with alloc.
+            template <typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+            explicit priority__queue(const Alloc &alloc);
+            template <typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+            priority__queue(const Compare &compare, const Alloc &alloc);
+            template <typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+            priority__queue(const Compare &compare, const Container &cont, const Alloc &alloc);
+            template <typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+            priority__queue(const Compare &compare, Container &&cont, const Alloc &alloc);
+            template <typename InputIt, typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+            priority__queue(InputIt first, InputIt last, const Alloc &alloc);
+            template <typename InputIt, typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+            priority__queue(InputIt first, InputIt last, const Compare &compare, const Alloc &alloc);
+            template <typename InputIt, typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+            priority__queue(InputIt first, InputIt last, const Compare &compare, const Container &cont, const Alloc &alloc);
+            template <typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+            priority__queue(const priority__queue &other, const Alloc &alloc);
+            template <typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+            priority__queue(priority__queue &&other, const Alloc &alloc);
+
             ~priority__queue() =default;
 
             priority__queue(const priority__queue &other);
@@ -50,6 +119,22 @@ namespace pq {
             size_type size() const;
             const_reference top() const;           
 
+            // The heap array, in heap order (top() first).
+            const container_type& container() const noexcept;
+
+        public: // Memory
+            // Makes room for n elements, so that pushing up to n does not reallocate.
+            void reserve (size_type n) requires reservable_container<Container>;
+            size_type capacity() const requires reservable_container<Container>;
+
+            // Reallocates the storage to size(), whatever the shrink policy.
+            void shrink_to_fit() requires reservable_container<Container>;
+
+            void set_shrink_policy (const shrink_policy &policy);
+            const shrink_policy& get_shrink_policy() const noexcept;
+
+            memory_stats memory() const noexcept;
+
         public:
             template <typename... Args>           
             void emplace (Args&&... args);
@@ -69,12 +154,45 @@ namespace pq {
     priority__queue (Comp, Container) 
     -> priority__queue<typename Container::value_type, Container, Comp>;
 
+    template <typename Comp, typename Container, typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+    priority__queue (Comp, Container, Alloc)
+    -> priority__queue<typename Container::value_type, Container, Comp>;
+
     template <typename InputIt, 
               typename Comp = std::greater<typename std::iterator_traits<InputIt>::value_type>,
               typename Container = std::vector<typename std::iterator_traits<InputIt>::value_type>>
     priority__queue(InputIt, InputIt, Comp = Comp(), Container = Container())
     -> priority__queue<typename std::iterator_traits<InputIt>::value_type, Container, Comp>;
 
+    namespace pmr {
+        template <typename T, typename Compare = std::greater<T>>
+        using priority__queue = pq::priority__queue<T, std::pmr::vector<T>, Compare>;
+
+        namespace detail {
+            // Constructed before the queue that allocates from it (a base class ahead of the queue base).
+            template <std::size_t Bytes>
+            struct local_arena {
+                alignas(std::max_align_t) std::byte buffer[Bytes];
+                std::pmr::monotonic_buffer_resource resource;
+
+                explicit local_arena(std::pmr::memory_resource *upstream) : resource(buffer, Bytes, upstream) {}
+            };
+        }
+
+        // A queue for one request: its storage comes from an inline buffer of Bytes bytes, then from upstream, and is
+        // never given back before the queue is destroyed (the old storage of every reallocation stays in the arena,
+        // so reserve() what it will need first). Neither copyable nor movable, as its storage is itself.
+        template <typename T, std::size_t Bytes, typename Compare = std::greater<T>>
+        class local_queue : private detail::local_arena<Bytes>, public priority__queue<T, Compare> {
+            public:
+                explicit local_queue(const Compare &compare = Compare(),
+                                     std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+
+                local_queue(const local_queue &) = delete;
+                local_queue &operator=(const local_queue &) = delete;
+        };
+    } // namespace pmr
+
 } // namespace pq
 
 #include "pq.impl.hpp"
@@ -86,9 +204,13 @@ Methods                       Time Complexity      Auxiliary Space
 priority_queue::empty()       O(1)                 O(1)
 priority_queue::size()        O(1)                 O(1)
 priority_queue::top()         O(1)                 O(1)
+priority_queue::container()   O(1)                 O(1)
+priority_queue::reserve()     O(N)                 O(n)
+priority_queue::shrink_to_fit() O(N)               O(N)
+priority_queue::memory()      O(1)                 O(1)
 priority_queue::push()        O(logN)              O(1)
 priority_queue::push_range()  ? O(nlogN)           ? O(1)
-priority_queue::pop()         O(logN)              O(1)
+priority_queue::pop()         O(logN), O(N) when it shrinks      O(1)
 priority_queue::swap()        O(1)                 O(N)
 priority_queue::emplace()     O(logN)              O(1)
 priority_queue value_type     O(1)                 O(1)
@@ -1,6 +1,9 @@
 #ifndef PQ_IMPL_HPP
 #define PQ_IMPL_HPP
 
+#include <algorithm>
+#include <iterator>
+
 namespace pq {
     // ctors-------------------------------------------------------------------------------------------
     /// NOTES: 1. redeclaration may not have default arguments 
@@ -23,10 +26,16 @@ namespace pq {
         alg::make__heap(c.begin(), c.end(), comp);
     }
 
+    template <typename T, typename Container, typename Compare>
+    priority__queue<T, Container, Compare>::priority__queue (heap_order_t, const Compare &compare, Container &&cont)
+        : c(std::move(cont)), comp (compare)
+    {}
+
     template <typename T, typename Container, typename Compare>
     template <typename InputIt>
     priority__queue<T, Container, Compare>::priority__queue (InputIt first, InputIt last, 
                     const Compare &compare, const Container &cont) 
+        : c (cont), comp (compare)
     {
         c.insert(c.end(), first, last);
         alg::make__heap (c.begin(), c.end(), comp);
@@ -41,15 +50,83 @@ namespace pq {
         alg::make__heap(c.begin(), c.end(), comp);
     }
     
+    // allocator-extended ctors-----------------------------------------------------------------------
+    template <typename T, typename Container, typename Compare>
+    template <typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+    priority__queue<T, Container, Compare>::priority__queue (const Alloc &alloc)
+        : c (alloc), comp ()
+    {}
+
+    template <typename T, typename Container, typename Compare>
+    template <typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+    priority__queue<T, Container, Compare>::priority__queue (const Compare &compare, const Alloc &alloc)
+        : c (alloc), comp (compare)
+    {}
+
+    template <typename T, typename Container, typename Compare>
+    template <typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+    priority__queue<T, Container, Compare>::priority__queue (const Compare &compare, const Container &cont, const Alloc &alloc)
+        : c (cont, alloc), comp (compare)
+    {
+        alg::make__heap(c.begin(), c.end(), comp);
+    }
+
+    template <typename T, typename Container, typename Compare>
+    template <typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+    priority__queue<T, Container, Compare>::priority__queue (const Compare &compare, Container &&cont, const Alloc &alloc)
+        : c (std::move(cont), alloc), comp (compare)
+    {
+        alg::make__heap(c.begin(), c.end(), comp);
+    }
+
+    template <typename T, typename Container, typename Compare>
+    template <typename InputIt, typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+    priority__queue<T, Container, Compare>::priority__queue (InputIt first, InputIt last, const Alloc &alloc)
+        : c (first, last, alloc), comp ()
+    {
+        alg::make__heap(c.begin(), c.end(), comp);
+    }
+
+    template <typename T, typename Container, typename Compare>
+    template <typename InputIt, typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+    priority__queue<T, Container, Compare>::priority__queue (InputIt first, InputIt last, const Compare &compare, const Alloc &alloc)
+        : c (first, last, alloc), comp (compare)
+    {
+        alg::make__heap(c.begin(), c.end(), comp);
+    }
+
+    template <typename T, typename Container, typename Compare>
+    template <typename InputIt, typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+    priority__queue<T, Container, Compare>::priority__queue (InputIt first, InputIt last, const Compare &compare, 
+                                                             const Container &cont, const Alloc &alloc)
+        : c (cont, alloc), comp (compare)
+    {
+        c.insert(c.end(), first, last);
+        alg::make__heap(c.begin(), c.end(), comp);
+    }
+
+    template <typename T, typename Container, typename Compare>
+    template <typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+    priority__queue<T, Container, Compare>::priority__queue (const priority__queue &other, const Alloc &alloc)
+        : c (other.c, alloc), comp (other.comp), shrink (other.shrink)
+    {}
+
+    template <typename T, typename Container, typename Compare>
+    template <typename Alloc> requires std::uses_allocator_v<Container, Alloc>
+    priority__queue<T, Container, Compare>::priority__queue (priority__queue &&other, const Alloc &alloc)
+        : c (std::move(other.c), alloc), comp (std::move(other.comp)), shrink (other.shrink), reallocations (other.reallocations)
+    {}
+
     // copy ctors--------------------------------------------------------------------------------------
+    /// NOTE: a copy has storage of its own, so its reallocation count starts from 0; a move takes the count along.
     template <typename T, typename Container, typename Compare>
     priority__queue<T, Container, Compare>::priority__queue(const priority__queue &other) 
-        : c(other.c), comp(other.comp)  
+        : c(other.c), comp(other.comp), shrink(other.shrink)
     {}
 
     template <typename T, typename Container, typename Compare>
     priority__queue<T, Container, Compare>::priority__queue(priority__queue &&other) 
-        : c (std::move(other.c)), comp (std::move(other.comp))
+        : c (std::move(other.c)), comp (std::move(other.comp)), shrink (other.shrink), reallocations (other.reallocations)
     {}
 
     // = ----------------------------------------------------------------------------------------------
@@ -58,6 +135,7 @@ namespace pq {
         if (this != &other) {
             c = other.c;
             comp = other.comp;
+            shrink = other.shrink;
         }
         return *this;
     }
@@ -67,6 +145,8 @@ namespace pq {
         if (this != &other) {
             c = std::move(other.c);
             comp = std::move(other.comp);
+            shrink = other.shrink;
+            reallocations = other.reallocations;
         }
         return *this;
     }
@@ -75,7 +155,9 @@ namespace pq {
     template <typename T, typename Container, typename Compare>           
     template <typename... Args>
     void priority__queue<T, Container, Compare>::emplace (Args&&... args) {
+        const std::size_t before = storage();
         c.emplace_back(std::forward<Args>(args)...); 
+        count_reallocation(before);
         alg::push__heap(c.begin(), c.end(), comp);
     }
 
@@ -85,23 +167,30 @@ namespace pq {
         using std::swap; 
         swap(c, other.c); 
         swap(comp, other.comp);
+        swap(shrink, other.shrink);
+        swap(reallocations, other.reallocations);
     }
 
     template <typename T, typename Container, typename Compare>
     void priority__queue<T, Container, Compare>::pop () {
         alg::pop__heap (c.begin(), c.end(), comp); 
         c.pop_back();
+        shrink_if_drained();
     }
 
     template <typename T, typename Container, typename Compare>
     void priority__queue<T, Container, Compare>::push (const value_type& value) {  
+        const std::size_t before = storage();
         c.push_back(value);
+        count_reallocation(before);
         alg::push__heap(c.begin(), c.end(), comp);               
     }
 
     template <typename T, typename Container, typename Compare>
     void priority__queue<T, Container, Compare>::push (value_type&& value) {  
+        const std::size_t before = storage();
         c.push_back(std::move(value)); 
+        count_reallocation(before);
         alg::push__heap(c.begin(), c.end(), comp);               
     }
 
@@ -109,7 +198,9 @@ namespace pq {
     template <typename InputIt>    
     void priority__queue<T, Container, Compare>::push_range (InputIt first, InputIt last) {
         for (auto it = first; it != last; ++it) {
+            const std::size_t before = storage();
             c.push_back(*it);
+            count_reallocation(before);
             alg::push__heap(c.begin(), c.end(), comp);
         }
     }
@@ -128,6 +219,96 @@ namespace pq {
     typename Container::size_type priority__queue<T, Container, Compare>::size() const {
         return c.size();
     }
+
+    template <typename T, typename Container, typename Compare>
+    const Container& priority__queue<T, Container, Compare>::container() const noexcept {
+        return c;
+    }
+
+    // memory------------------------------------------------------------------------------------------
+    template <typename T, typename Container, typename Compare>
+    std::size_t priority__queue<T, Container, Compare>::storage () const noexcept {
+        if constexpr (reservable_container<Container>) {
+            return c.capacity();
+        } else {
+            return c.size();
+        }
+    }
+
+    template <typename T, typename Container, typename Compare>
+    void priority__queue<T, Container, Compare>::count_reallocation (std::size_t before) noexcept {
+        if constexpr (reservable_container<Container>) {
+            reallocations += c.capacity() != before;
+        }
+    }
+
+    // Moves the elements into storage for n of them, allocated with the same allocator.
+    template <typename T, typename Container, typename Compare>
+    void priority__queue<T, Container, Compare>::reallocate (std::size_t n) {
+        if constexpr (reservable_container<Container>) {
+            Container fresh (c.get_allocator());
+            fresh.reserve(n);
+            fresh.insert(fresh.end(), std::make_move_iterator(c.begin()), std::make_move_iterator(c.end()));
+            c = std::move(fresh);
+            ++reallocations;
+        }
+    }
+
+    template <typename T, typename Container, typename Compare>
+    void priority__queue<T, Container, Compare>::shrink_if_drained () {
+        if constexpr (reservable_container<Container>) {
+            const std::size_t capacity = c.capacity();
+            if (shrink.enabled && capacity > shrink.min_capacity && c.size() < shrink.below * capacity) {
+                const auto target = std::max(shrink.min_capacity, static_cast<std::size_t>(shrink.headroom * c.size()));
+                if (target < capacity) {
+                    reallocate(target);
+                }
+            }
+        }
+    }
+
+    template <typename T, typename Container, typename Compare>
+    void priority__queue<T, Container, Compare>::reserve (size_type n) requires reservable_container<Container> {
+        const std::size_t before = c.capacity();
+        c.reserve(n);
+        count_reallocation(before);
+    }
+
+    template <typename T, typename Container, typename Compare>
+    auto priority__queue<T, Container, Compare>::capacity () const -> size_type requires reservable_container<Container> {
+        return c.capacity();
+    }
+
+    template <typename T, typename Container, typename Compare>
+    void priority__queue<T, Container, Compare>::shrink_to_fit () requires reservable_container<Container> {
+        if (c.capacity() != c.size()) {
+            reallocate(c.size());
+        }
+    }
+
+    template <typename T, typename Container, typename Compare>
+    void priority__queue<T, Container, Compare>::set_shrink_policy (const shrink_policy &policy) {
+        shrink = policy;
+        shrink_if_drained();
+    }
+
+    template <typename T, typename Container, typename Compare>
+    const shrink_policy& priority__queue<T, Container, Compare>::get_shrink_policy () const noexcept {
+        return shrink;
+    }
+
+    template <typename T, typename Container, typename Compare>
+    memory_stats priority__queue<T, Container, Compare>::memory () const noexcept {
+        const std::size_t capacity = storage();
+        return memory_stats {c.size(), capacity, c.size() * sizeof(value_type), capacity * sizeof(value_type), reallocations};
+    }
+
+    // pmr::local_queue--------------------------------------------------------------------------------
+    template <typename T, std::size_t Bytes, typename Compare>
+    pmr::local_queue<T, Bytes, Compare>::local_queue (const Compare &compare, std::pmr::memory_resource *upstream)
+        : detail::local_arena<Bytes>(upstream),
+          pmr::priority__queue<T, Compare>(compare, std::pmr::polymorphic_allocator<T>(&this->resource))
+    {}
 } // namespace pq
 
 #endif // PQ_IMPL_HPP
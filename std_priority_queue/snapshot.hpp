@@ -0,0 +1,132 @@
+/*
+Snapshots of priority queues of trivially copyable elements, reloaded without re-heapifying.
+save_snapshot writes the heap array as it is, already in heap order, after a 64-byte header (magic, format version,
+element size and alignment, count and a checksum of the elements) to a temporary file that is synced and renamed over
+the target, and the directory is synced after the rename, so a crash leaves either the old snapshot or the new one.
+load_snapshot maps the file (POSIX mmap) and adopts the mapped array as the queue's container, a mapped_heap: top(),
+size() and empty() read the mapping, so the queue is usable as soon as the header (and, if asked, the checksum) is
+checked, and pages are read in on demand. The first call that can modify the heap (push, pop, emplace, anything taking a
+non-const iterator) copies the elements into a std::vector and unmaps the file; from then on it is an ordinary queue.
+The file is a raw memory image: it can only be read back on a machine with the same element layout, and with the
+Compare the heap was built with.
+*/
+
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include "pq.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace pq {
+    inline constexpr std::uint32_t snapshot_version = 1;
+
+    // The file starts with this header; the elements follow at offset sizeof(snapshot_header).
+    struct snapshot_header {
+        char magic[8];                  // "PQSNAP\0\0"
+        std::uint32_t version;
+        std::uint32_t header_size;
+        std::uint64_t element_size;
+        std::uint64_t element_align;
+        std::uint64_t count;
+        std::uint64_t checksum;         // snapshot_checksum of the count * element_size bytes of elements
+        std::uint64_t reserved[2];
+    };
+    static_assert(sizeof(snapshot_header) == 64);
+
+    // A checksum of raw memory: four independent multiply-rotate lanes over 8-byte words, combined at the end, so it
+    // runs at several bytes per cycle. It detects truncation and corruption, not tampering.
+    std::uint64_t snapshot_checksum (const void* data, std::size_t bytes) noexcept;
+
+    // A sequence container over a read-only mapping of a snapshot, promoted into a std::vector<T> on the first call
+    // that can modify it. Non-const begin() and end() both promote, so a pair of them is never split across the two.
+    template <typename T>
+    class mapped_heap {
+        static_assert(std::is_trivially_copyable_v<T>, "mapped_heap holds trivially copyable elements");
+
+        public:
+            using value_type = T;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference = T&;
+            using const_reference = const T&;
+            using iterator = T*;
+            using const_iterator = const T*;
+
+        private:
+            std::vector<T> v;
+            const T* mapped = nullptr;          // the elements in the mapping, while there is one
+            size_type mapped_size = 0;
+            void* map = nullptr;
+            size_type map_length = 0;
+
+            void promote();
+            void unmap() noexcept;
+
+        public:
+            mapped_heap() = default;
+            ~mapped_heap();
+
+            // Adopts a mapping of mapping_length bytes whose count elements start at data.
+            mapped_heap (void* mapping, size_type mapping_length, const T* data, size_type count) noexcept;
+
+            mapped_heap (const mapped_heap &other);
+            mapped_heap (mapped_heap &&other) noexcept;
+            mapped_heap &operator= (const mapped_heap &other);
+            mapped_heap &operator= (mapped_heap &&other) noexcept;
+
+        public:
+            // Whether the elements are still read from the snapshot file.
+            bool is_mapped() const noexcept;
+
+            bool empty() const noexcept;
+            size_type size() const noexcept;
+            const_reference front() const;
+            const T* data() const noexcept;
+
+            const_iterator begin() const noexcept;
+            const_iterator end() const noexcept;
+            iterator begin();
+            iterator end();
+
+            void push_back (const T& value);
+            template <typename... Args>
+            reference emplace_back (Args&&... args);
+            void pop_back();
+
+            template <typename InputIt>
+            iterator insert (const_iterator pos, InputIt first, InputIt last);
+
+            void swap (mapped_heap &other) noexcept;
+    };
+
+    template <typename T, typename Compare = std::greater<T> >
+    using restored_queue = priority__queue<T, mapped_heap<T>, Compare>;
+
+    // Writes q's heap array to path. Throws std::system_error on I/O errors.
+    template <typename T, typename Container, typename Compare>
+    void save_snapshot (const priority__queue<T, Container, Compare> &q, const std::string &path);
+
+    // Maps the snapshot at path as a queue. verify checks the checksum (one pass over the file); without it only the
+    // header and the file size are checked. Throws std::system_error on I/O errors and std::runtime_error on a file
+    // that is not a snapshot of T (bad magic, version, element size or alignment, size or checksum).
+    template <typename T, typename Compare = std::greater<T> >
+    restored_queue<T, Compare> load_snapshot (const std::string &path, const Compare &compare = Compare(), bool verify = true);
+
+} // namespace pq
+
+#include "snapshot.impl.hpp"
+
+#endif // SNAPSHOT_HPP
+
+/*
+Methods                       Time Complexity      Auxiliary Space
+save_snapshot()               O(N) writes          O(1)
+load_snapshot()               O(1), O(N) verified  O(1) (the mapping)
+mapped_heap promotion         O(N), once           O(N)
+*/
@@ -0,0 +1,316 @@
+#ifndef SNAPSHOT_IMPL_HPP
+#define SNAPSHOT_IMPL_HPP
+
+#include "snapshot.hpp"
+
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pq {
+    namespace detail {
+        inline constexpr char snapshot_magic[8] = {'P', 'Q', 'S', 'N', 'A', 'P', '\0', '\0'};
+
+        // Closes the descriptor on every way out of the scope it guards.
+        struct fd_guard {
+            int fd;
+            ~fd_guard() {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+        };
+
+        struct map_guard {
+            void* map;
+            std::size_t length;
+            ~map_guard() {
+                if (map != nullptr) {
+                    ::munmap(map, length);
+                }
+            }
+        };
+
+        inline void write_all (int fd, const void* data, std::size_t bytes, const std::string &path) {
+            const char* p = static_cast<const char*>(data);
+            while (bytes > 0) {
+                const ::ssize_t n = ::write(fd, p, bytes);
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw std::system_error(errno, std::generic_category(), "pq::save_snapshot: write " + path);
+                }
+                p += n;
+                bytes -= static_cast<std::size_t>(n);
+            }
+        }
+    } // namespace detail
+
+    inline std::uint64_t snapshot_checksum (const void* data, std::size_t bytes) noexcept {
+        constexpr std::uint64_t k = 0x9E3779B97F4A7C15ull;
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        std::uint64_t lanes[4] = {k, k ^ 1, k ^ 2, k ^ 3};
+        const auto mix = [](std::uint64_t h, std::uint64_t w) { return std::rotl((h ^ w) * k, 29); };
+        std::size_t i = 0;
+        for (; i + 32 <= bytes; i += 32) {
+            for (int l = 0; l < 4; ++l) {
+                std::uint64_t w;
+                std::memcpy(&w, p + i + 8 * l, 8);
+                lanes[l] = mix(lanes[l], w);
+            }
+        }
+        std::uint64_t h = mix(mix(mix(lanes[0], lanes[1]), lanes[2]), lanes[3]);
+        for (; i < bytes; ++i) {
+            h = mix(h, p[i]);
+        }
+        return mix(h, bytes);
+    }
+
+
+    // mapped_heap -------------------------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    mapped_heap<T>::mapped_heap (void* mapping, size_type mapping_length, const T* data, size_type count) noexcept
+        : mapped(data), mapped_size(count), map(mapping), map_length(mapping_length)
+    {}
+
+    template <typename T>
+    mapped_heap<T>::~mapped_heap() {
+        unmap();
+    }
+
+    template <typename T>
+    mapped_heap<T>::mapped_heap (const mapped_heap &other) : v(other.begin(), other.end()) {}
+
+    template <typename T>
+    mapped_heap<T>::mapped_heap (mapped_heap &&other) noexcept
+        : v(std::move(other.v)), mapped(std::exchange(other.mapped, nullptr)), mapped_size(std::exchange(other.mapped_size, 0)),
+          map(std::exchange(other.map, nullptr)), map_length(std::exchange(other.map_length, 0))
+    {}
+
+    template <typename T>
+    auto mapped_heap<T>::operator= (const mapped_heap &other) -> mapped_heap & {
+        if (this != &other) {
+            mapped_heap(other).swap(*this);
+        }
+        return *this;
+    }
+
+    template <typename T>
+    auto mapped_heap<T>::operator= (mapped_heap &&other) noexcept -> mapped_heap & {
+        if (this != &other) {
+            mapped_heap(std::move(other)).swap(*this);
+        }
+        return *this;
+    }
+
+    template <typename T>
+    void mapped_heap<T>::swap (mapped_heap &other) noexcept {
+        using std::swap;
+        swap(v, other.v);
+        swap(mapped, other.mapped);
+        swap(mapped_size, other.mapped_size);
+        swap(map, other.map);
+        swap(map_length, other.map_length);
+    }
+
+    template <typename T>
+    void mapped_heap<T>::unmap() noexcept {
+        if (map != nullptr) {
+            ::munmap(map, map_length);
+        }
+        mapped = nullptr;
+        mapped_size = 0;
+        map = nullptr;
+        map_length = 0;
+    }
+
+    template <typename T>
+    void mapped_heap<T>::promote() {
+        if (map != nullptr) {
+            v.assign(mapped, mapped + mapped_size);
+            unmap();
+        }
+    }
+
+    template <typename T>
+    bool mapped_heap<T>::is_mapped() const noexcept {
+        return map != nullptr;
+    }
+
+    template <typename T>
+    bool mapped_heap<T>::empty() const noexcept {
+        return size() == 0;
+    }
+
+    template <typename T>
+    std::size_t mapped_heap<T>::size() const noexcept {
+        return map != nullptr ? mapped_size : v.size();
+    }
+
+    template <typename T>
+    const T& mapped_heap<T>::front() const {
+        return *data();
+    }
+
+    template <typename T>
+    const T* mapped_heap<T>::data() const noexcept {
+        return map != nullptr ? mapped : v.data();
+    }
+
+    template <typename T>
+    const T* mapped_heap<T>::begin() const noexcept {
+        return data();
+    }
+
+    template <typename T>
+    const T* mapped_heap<T>::end() const noexcept {
+        return data() + size();
+    }
+
+    template <typename T>
+    T* mapped_heap<T>::begin() {
+        promote();
+        return v.data();
+    }
+
+    template <typename T>
+    T* mapped_heap<T>::end() {
+        promote();
+        return v.data() + v.size();
+    }
+
+    template <typename T>
+    void mapped_heap<T>::push_back (const T& value) {
+        const T copy = value;           // value may be an element of the mapping
+        promote();
+        v.push_back(copy);
+    }
+
+    template <typename T>
+    template <typename... Args>
+    T& mapped_heap<T>::emplace_back (Args&&... args) {
+        T value(std::forward<Args>(args)...);
+        promote();
+        return v.emplace_back(value);
+    }
+
+    template <typename T>
+    void mapped_heap<T>::pop_back() {
+        promote();
+        v.pop_back();
+    }
+
+    template <typename T>
+    template <typename InputIt>
+    T* mapped_heap<T>::insert (const_iterator pos, InputIt first, InputIt last) {
+        const difference_type at = pos - data();
+        promote();
+        const auto it = v.insert(v.begin() + at, first, last);
+        return v.data() + (it - v.begin());
+    }
+
+
+    // save / load -------------------------------------------------------------------------------------------------------------------
+
+    template <typename T, typename Container, typename Compare>
+    void save_snapshot (const priority__queue<T, Container, Compare> &q, const std::string &path) {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshots hold trivially copyable elements");
+        static_assert(std::contiguous_iterator<typename Container::const_iterator>, "snapshots are written from contiguous containers");
+        const Container& c = q.container();
+        const T* elements = c.size() == 0 ? nullptr : &*c.begin();
+        const std::size_t bytes = c.size() * sizeof(T);
+
+        snapshot_header header {};
+        std::memcpy(header.magic, detail::snapshot_magic, sizeof(header.magic));
+        header.version = snapshot_version;
+        header.header_size = sizeof(snapshot_header);
+        header.element_size = sizeof(T);
+        header.element_align = alignof(T);
+        header.count = c.size();
+        header.checksum = snapshot_checksum(elements, bytes);
+
+        const std::string temporary = path + ".tmp";
+        detail::fd_guard file {::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+        if (file.fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "pq::save_snapshot: open " + temporary);
+        }
+        detail::write_all(file.fd, &header, sizeof(header), temporary);
+        detail::write_all(file.fd, elements, bytes, temporary);
+        if (::fsync(file.fd) != 0) {
+            throw std::system_error(errno, std::generic_category(), "pq::save_snapshot: fsync " + temporary);
+        }
+        if (::rename(temporary.c_str(), path.c_str()) != 0) {
+            throw std::system_error(errno, std::generic_category(), "pq::save_snapshot: rename " + temporary);
+        }
+        // The rename is only durable once the directory entry is: sync the parent directory too.
+        const std::string::size_type slash = path.find_last_of('/');
+        const std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+        detail::fd_guard parent {::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+        if (parent.fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "pq::save_snapshot: open " + directory);
+        }
+        if (::fsync(parent.fd) != 0) {
+            throw std::system_error(errno, std::generic_category(), "pq::save_snapshot: fsync " + directory);
+        }
+    }
+
+    template <typename T, typename Compare>
+    restored_queue<T, Compare> load_snapshot (const std::string &path, const Compare &compare, bool verify) {
+        static_assert(alignof(T) <= sizeof(snapshot_header), "the elements start 64 bytes into a page-aligned mapping");
+        detail::fd_guard file {::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (file.fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "pq::load_snapshot: open " + path);
+        }
+        struct stat st {};
+        if (::fstat(file.fd, &st) != 0) {
+            throw std::system_error(errno, std::generic_category(), "pq::load_snapshot: fstat " + path);
+        }
+        const std::size_t file_size = static_cast<std::size_t>(st.st_size);
+        const auto invalid = [&path](const char* what) {
+            return std::runtime_error(std::string("pq::load_snapshot: ") + what + ": " + path);
+        };
+        if (file_size < sizeof(snapshot_header)) {
+            throw invalid("not a snapshot");
+        }
+        void* map = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+        if (map == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "pq::load_snapshot: mmap " + path);
+        }
+        // The mapping keeps the file alive once the descriptor is closed. It is unmapped here if the file is rejected.
+        detail::map_guard mapping {map, file_size};
+        snapshot_header header;
+        std::memcpy(&header, map, sizeof(header));
+        if (std::memcmp(header.magic, detail::snapshot_magic, sizeof(header.magic)) != 0) {
+            throw invalid("not a snapshot");
+        }
+        if (header.version != snapshot_version || header.header_size != sizeof(snapshot_header)) {
+            throw invalid("unsupported snapshot version");
+        }
+        if (header.element_size != sizeof(T) || header.element_align != alignof(T)) {
+            throw invalid("element type mismatch");
+        }
+        if (header.count > (file_size - sizeof(header)) / sizeof(T) || file_size - sizeof(header) != header.count * sizeof(T)) {
+            throw invalid("truncated snapshot");
+        }
+        const T* elements = reinterpret_cast<const T*>(static_cast<const char*>(map) + sizeof(header));
+        if (verify && snapshot_checksum(elements, header.count * sizeof(T)) != header.checksum) {
+            throw invalid("checksum mismatch");
+        }
+        mapping.map = nullptr;
+        return restored_queue<T, Compare>(heap_order, compare, mapped_heap<T>(map, file_size, elements, header.count));
+    }
+
+} // namespace pq
+
+#endif // SNAPSHOT_IMPL_HPP
@@ -0,0 +1,168 @@
+// loser_tree and the merges built on it: sorted and stable output (equal keys in run order) for any number of runs,
+// empty ones included, at most ceil(log2 k) comparisons per element, and the iterator, batched, pull and parallel merges
+// against std::stable_sort.
+
+#include "../loser_tree.hpp"
+#include "../../tests/check.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    // A key and the run it came from; only the key is compared.
+    struct item {
+        int key;
+        int run;
+        bool operator== (const item&) const = default;
+    };
+
+    struct by_key {
+        std::size_t* calls = nullptr;
+        bool operator() (const item& a, const item& b) const {
+            if (calls != nullptr) {
+                ++*calls;
+            }
+            return a.key < b.key;
+        }
+    };
+
+    using run_range = std::pair<std::vector<item>::const_iterator, std::vector<item>::const_iterator>;
+
+    std::vector<std::vector<item> > make_runs (std::mt19937& rng, std::size_t k, int keys) {
+        std::vector<std::vector<item> > runs(k);
+        for (std::size_t r = 0; r < k; ++r) {
+            runs[r].resize(rng() % 4 == 0 ? 0 : rng() % 200);
+            for (item& it : runs[r]) {
+                it = item{static_cast<int>(rng() % keys), static_cast<int>(r)};
+            }
+            std::sort(runs[r].begin(), runs[r].end(), by_key{});
+        }
+        return runs;
+    }
+
+    // Concatenated in run order then stably sorted: what a stable merge gives.
+    std::vector<item> reference (const std::vector<std::vector<item> >& runs) {
+        std::vector<item> all;
+        for (const auto& run : runs) {
+            all.insert(all.end(), run.begin(), run.end());
+        }
+        std::stable_sort(all.begin(), all.end(), by_key{});
+        return all;
+    }
+
+    std::vector<run_range> ranges_of (const std::vector<std::vector<item> >& runs) {
+        std::vector<run_range> ranges;
+        for (const auto& run : runs) {
+            ranges.emplace_back(run.begin(), run.end());
+        }
+        return ranges;
+    }
+
+    void test_tree() {
+        pq::loser_tree<int> tree(3);
+        const int heads[] = {7, 0, 3};
+        tree.build([&](std::size_t i, int& key) {
+            key = heads[i];
+            return i != 1;
+        });
+        CHECK(tree.size() == 3 && !tree.empty());
+        CHECK(tree.winner() == 2 && tree.top() == 3);
+        tree.replace_top(9);
+        CHECK(tree.winner() == 0 && tree.top() == 7);
+        tree.replace_top(9);
+        CHECK(tree.winner() == 0 && tree.top() == 9);       // a tie goes to the lower leaf
+        tree.exhaust_top();
+        CHECK(tree.winner() == 2 && tree.top() == 9);
+        tree.exhaust_top();
+        CHECK(tree.empty());
+
+        pq::loser_tree<int> none(0);
+        none.build([](std::size_t, int&) { return true; });
+        CHECK(none.empty());
+    }
+
+    void test_merges() {
+        std::mt19937 rng(43);
+        for (const std::size_t k : {1, 2, 3, 5, 8, 13, 64, 100}) {
+            for (const int keys : {3, 1000}) {
+                const auto runs = make_runs(rng, k, keys);
+                const std::vector<item> expected = reference(runs);
+                const auto ranges = ranges_of(runs);
+
+                std::size_t calls = 0;
+                std::vector<item> merged;
+                pq::multiway_merge(ranges, std::back_inserter(merged), by_key{&calls});
+                CHECK(merged == expected);
+                const std::size_t depth = std::bit_width(std::bit_ceil(k)) - 1;
+                CHECK(calls <= expected.size() * depth + std::bit_ceil(k));
+
+                std::vector<item> batched;
+                pq::multiway_merge_batched(ranges, 7, [&](const item* data, std::size_t n) {
+                    CHECK(n >= 1 && n <= 7);
+                    batched.insert(batched.end(), data, data + n);
+                }, by_key{});
+                CHECK(batched == expected);
+
+                std::vector<std::size_t> next(k, 0);
+                std::vector<std::function<bool(item&)> > sources;
+                for (std::size_t r = 0; r < k; ++r) {
+                    sources.emplace_back([&, r](item& out) {
+                        if (next[r] == runs[r].size()) {
+                            return false;
+                        }
+                        out = runs[r][next[r]++];
+                        return true;
+                    });
+                }
+                std::vector<item> pulled;
+                pq::multiway_merge_pull<item>(sources, std::back_inserter(pulled), by_key{});
+                CHECK(pulled == expected);
+            }
+        }
+    }
+
+    void test_parallel() {
+        std::mt19937 rng(44);
+        std::vector<std::vector<item> > runs(16);
+        for (std::size_t r = 0; r < runs.size(); ++r) {
+            runs[r].resize(20000 + rng() % 20000);
+            for (item& it : runs[r]) {
+                it = item{static_cast<int>(rng() % 5000), static_cast<int>(r)};
+            }
+            std::sort(runs[r].begin(), runs[r].end(), by_key{});
+        }
+        const std::vector<item> expected = reference(runs);
+        for (const std::size_t threads : {1, 3, 8}) {
+            std::vector<item> out(expected.size());
+            const auto end = pq::parallel_multiway_merge(ranges_of(runs), out.begin(), threads, by_key{});
+            CHECK(end == out.end());
+            CHECK(out == expected);
+        }
+    }
+
+    void test_strings() {
+        const std::vector<std::vector<std::string> > runs {{"apple", "kiwi", "pear"}, {}, {"banana", "kiwi"}, {"fig"}};
+        std::vector<std::pair<std::vector<std::string>::const_iterator, std::vector<std::string>::const_iterator> > ranges;
+        for (const auto& run : runs) {
+            ranges.emplace_back(run.begin(), run.end());
+        }
+        std::vector<std::string> merged;
+        pq::multiway_merge(ranges, std::back_inserter(merged));
+        CHECK(merged == (std::vector<std::string>{"apple", "banana", "fig", "kiwi", "kiwi", "pear"}));
+    }
+}
+
+int main() {
+    test_tree();
+    test_merges();
+    test_parallel();
+    test_strings();
+    return check::report();
+}
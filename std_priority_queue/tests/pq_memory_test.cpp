@@ -0,0 +1,176 @@
+// The memory side of priority__queue: allocator-extended constructors (a stateful allocator, std::pmr), reserve(),
+// shrink_to_fit(), shrink_policy, memory() and pmr::local_queue's inline buffer. The queue order is checked after
+// every reallocation.
+
+#include "../pq.hpp"
+#include "../../tests/check.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+namespace {
+    // Counts the allocations made through every copy of it.
+    template <typename T>
+    struct counting_allocator {
+        using value_type = T;
+
+        std::size_t* allocations;
+
+        explicit counting_allocator (std::size_t* counter) noexcept : allocations(counter) {}
+        template <typename U>
+        counting_allocator (const counting_allocator<U>& other) noexcept : allocations(other.allocations) {}
+
+        T* allocate (std::size_t n) {
+            ++*allocations;
+            return std::allocator<T>().allocate(n);
+        }
+        void deallocate (T* p, std::size_t n) noexcept {
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template <typename U>
+        bool operator== (const counting_allocator<U>& other) const noexcept { return allocations == other.allocations; }
+    };
+
+    struct counting_resource : std::pmr::memory_resource {
+        std::size_t allocations = 0;
+
+        void* do_allocate (std::size_t bytes, std::size_t align) override {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, align);
+        }
+        void do_deallocate (void* p, std::size_t bytes, std::size_t align) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+        }
+        bool do_is_equal (const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    // Pops everything and checks that it comes out in order.
+    template <typename Q>
+    bool drains_in_order (Q& q) {
+        bool sorted = true;
+        while (!q.empty()) {
+            const int top = q.top();
+            q.pop();
+            sorted &= q.empty() || !(q.top() < top);
+        }
+        return sorted;
+    }
+
+    void test_allocators() {
+        std::size_t allocations = 0;
+        using container = std::vector<int, counting_allocator<int> >;
+        const counting_allocator<int> alloc(&allocations);
+
+        pq::priority__queue<int, container> q(alloc);
+        for (int i = 0; i < 100; ++i) {
+            q.push((i * 37) % 101);
+        }
+        CHECK(allocations > 0);
+        CHECK(q.container().get_allocator() == alloc);
+
+        std::size_t other_allocations = 0;
+        const counting_allocator<int> other(&other_allocations);
+        pq::priority__queue<int, container> copy(q, other);
+        CHECK(copy.container().get_allocator() == other && other_allocations > 0 && copy.size() == 100);
+        CHECK(drains_in_order(copy));
+
+        const std::vector<int> data {5, 1, 4, 2, 3};
+        pq::priority__queue<int, container> ranged(data.begin(), data.end(), std::greater<int>(), other);
+        CHECK(ranged.top() == 1 && ranged.container().get_allocator() == other);
+
+        counting_resource resource;
+        pq::pmr::priority__queue<int> pmr_q(&resource);
+        for (int i = 0; i < 100; ++i) {
+            pmr_q.push(i);
+        }
+        CHECK(resource.allocations > 0);
+        CHECK(pmr_q.container().get_allocator().resource() == &resource);
+        CHECK(drains_in_order(pmr_q));
+    }
+
+    void test_reserve_and_stats() {
+        pq::priority__queue<int> q;
+        q.reserve(1000);
+        CHECK(q.capacity() >= 1000);
+        CHECK(q.memory().reallocations == 1);
+        std::mt19937 rng(44);
+        for (int i = 0; i < 1000; ++i) {
+            q.push(static_cast<int>(rng() % 5000));
+        }
+        const pq::memory_stats stats = q.memory();
+        CHECK(stats.reallocations == 1);
+        CHECK(stats.size == 1000 && stats.bytes_used == 1000 * sizeof(int));
+        CHECK(stats.capacity == q.capacity() && stats.bytes_reserved == stats.capacity * sizeof(int));
+
+        for (int i = 0; i < 900; ++i) {
+            q.pop();
+        }
+        q.shrink_to_fit();
+        CHECK(q.capacity() == 100 && q.memory().reallocations == 2);
+        CHECK(drains_in_order(q));
+    }
+
+    void test_shrink_policy() {
+        pq::priority__queue<int> q;
+        CHECK(!q.get_shrink_policy().enabled);
+        q.set_shrink_policy(pq::shrink_policy{true, 0.25, 2.0, 64});
+        for (int i = 0; i < 4096; ++i) {
+            q.push((i * 7919) % 4096);
+        }
+        const std::size_t full = q.capacity();
+        const std::size_t grown = q.memory().reallocations;
+
+        // Down to a quarter nothing moves; one element below, the storage is cut to twice the size.
+        while (q.size() >= full / 4) {
+            q.pop();
+        }
+        CHECK(q.memory().reallocations == grown + 1);
+        CHECK(q.capacity() == 2 * q.size());
+        while (q.size() > 10) {
+            q.pop();
+        }
+        CHECK(q.capacity() >= 64);
+        CHECK(drains_in_order(q));
+
+        // Disabled, draining keeps the storage.
+        pq::priority__queue<int> keep;
+        for (int i = 0; i < 4096; ++i) {
+            keep.push(i);
+        }
+        const std::size_t capacity = keep.capacity();
+        while (keep.size() > 1) {
+            keep.pop();
+        }
+        CHECK(keep.capacity() == capacity);
+    }
+
+    void test_local_queue() {
+        counting_resource upstream;
+        {
+            pq::pmr::local_queue<int, 1024> q(std::greater<int>(), &upstream);
+            q.reserve(100);
+            for (int i = 100; i-- > 0;) {
+                q.push(i);
+            }
+            CHECK(upstream.allocations == 0);
+            CHECK(q.top() == 0 && q.memory().reallocations == 1);
+            for (int i = 0; i < 1000; ++i) {
+                q.push(i);
+            }
+            CHECK(upstream.allocations > 0);
+            CHECK(drains_in_order(q));
+        }
+    }
+}
+
+int main() {
+    test_allocators();
+    test_reserve_and_stats();
+    test_shrink_policy();
+    test_local_queue();
+    return check::report();
+}
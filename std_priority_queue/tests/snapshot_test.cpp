@@ -0,0 +1,147 @@
+// save_snapshot and load_snapshot: a queue saved, mapped back and drained in the same order, promotion of the mapping on
+// the first modification, and every rejected file (missing, truncated, corrupted, wrong magic or element type).
+
+#include "../snapshot.hpp"
+#include "../../tests/check.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+    struct order {
+        std::uint64_t id;
+        double price;
+    };
+
+    struct by_price {
+        bool operator() (const order& a, const order& b) const { return a.price > b.price; }
+    };
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "pq_snapshot_test";
+
+    std::string file (const char* name) {
+        return (directory / name).string();
+    }
+
+    template <typename Q>
+    std::vector<int> drain (Q q) {
+        std::vector<int> out;
+        for (; !q.empty(); q.pop()) {
+            out.push_back(q.top());
+        }
+        return out;
+    }
+
+    // Overwrites the byte at offset of the file at path.
+    void poke (const std::string& path, std::size_t offset, char value) {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(static_cast<std::streamoff>(offset));
+        f.put(value);
+    }
+
+    void test_round_trip() {
+        std::mt19937 rng(49);
+        pq::priority__queue<int> q;
+        for (int i = 0; i < 10000; ++i) {
+            q.push(static_cast<int>(rng() % 100000));
+        }
+        const std::string path = file("ints.snapshot");
+        pq::save_snapshot(q, path);
+        CHECK(std::filesystem::file_size(path) == sizeof(pq::snapshot_header) + q.size() * sizeof(int));
+
+        pq::restored_queue<int> restored = pq::load_snapshot<int>(path);
+        CHECK(restored.container().is_mapped());
+        CHECK(restored.size() == q.size() && restored.top() == q.top());
+        CHECK(drain(restored) == drain(q));
+        CHECK(restored.container().is_mapped());        // drain took a copy
+
+        restored.push(-1);
+        CHECK(!restored.container().is_mapped());
+        CHECK(restored.top() == -1 && restored.size() == q.size() + 1);
+        restored.pop();
+        CHECK(drain(restored) == drain(q));
+
+        // Saving over an existing snapshot replaces it.
+        pq::priority__queue<int> small;
+        small.push(3);
+        small.push(1);
+        pq::save_snapshot(small, path);
+        CHECK(drain(pq::load_snapshot<int>(path)) == (std::vector<int>{1, 3}));
+
+        pq::save_snapshot(pq::priority__queue<int>(), path);
+        CHECK(pq::load_snapshot<int>(path).empty());
+    }
+
+    void test_structs() {
+        pq::priority__queue<order, std::vector<order>, by_price> q;
+        for (std::uint64_t i = 0; i < 100; ++i) {
+            q.push(order{i, static_cast<double>((i * 37) % 101)});
+        }
+        const std::string path = file("orders.snapshot");
+        pq::save_snapshot(q, path);
+        auto restored = pq::load_snapshot<order, by_price>(path);
+        CHECK(restored.size() == 100);
+        double last = -1;
+        bool ordered = true;
+        for (; !restored.empty(); restored.pop()) {
+            ordered &= restored.top().price >= last;
+            last = restored.top().price;
+        }
+        CHECK(ordered);
+    }
+
+    void test_rejected() {
+        pq::priority__queue<int> q;
+        for (int i = 0; i < 1000; ++i) {
+            q.push(i);
+        }
+        const std::string path = file("rejected.snapshot");
+
+        CHECK_THROWS(pq::load_snapshot<int>(file("missing.snapshot")), std::system_error);
+        CHECK_THROWS(pq::save_snapshot(q, file("no/such/directory/x.snapshot")), std::system_error);
+
+        pq::save_snapshot(q, path);
+        CHECK_THROWS(pq::load_snapshot<long long>(path), std::runtime_error);
+
+        poke(path, sizeof(pq::snapshot_header) + 100, '\x7f');
+        CHECK_THROWS(pq::load_snapshot<int>(path), std::runtime_error);
+        CHECK(pq::load_snapshot<int>(path, std::greater<int>(), false).size() == 1000);
+
+        pq::save_snapshot(q, path);
+        poke(path, 0, 'X');
+        CHECK_THROWS(pq::load_snapshot<int>(path), std::runtime_error);
+
+        pq::save_snapshot(q, path);
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+        CHECK_THROWS(pq::load_snapshot<int>(path), std::runtime_error);
+        std::filesystem::resize_file(path, 10);
+        CHECK_THROWS(pq::load_snapshot<int>(path), std::runtime_error);
+    }
+
+    void test_checksum() {
+        std::vector<unsigned char> bytes(1000);
+        for (std::size_t i = 0; i < bytes.size(); ++i) {
+            bytes[i] = static_cast<unsigned char>(i * 7);
+        }
+        const std::uint64_t sum = pq::snapshot_checksum(bytes.data(), bytes.size());
+        CHECK(sum == pq::snapshot_checksum(bytes.data(), bytes.size()));
+        CHECK(sum != pq::snapshot_checksum(bytes.data(), bytes.size() - 1));
+        bytes[513] ^= 1;
+        CHECK(sum != pq::snapshot_checksum(bytes.data(), bytes.size()));
+    }
+}
+
+int main() {
+    std::filesystem::create_directories(directory);
+    test_round_trip();
+    test_structs();
+    test_rejected();
+    test_checksum();
+    std::filesystem::remove_all(directory);
+    return check::report();
+}
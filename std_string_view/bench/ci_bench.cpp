@@ -0,0 +1,102 @@
+// Case-insensitive search and comparison: ci_string_view (folding kernels) vs. lower-casing into a std::string
+// before a case-sensitive find / compare, vs. a per-character ci_char_traits::eq loop, with the case-sensitive
+// string_view::find as the reference.
+// usage: ci_bench [megabytes = 64]
+
+#include "../string_view.hpp"
+#include "../../bench/bench.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    std::string lower (bsv::string_view s) {
+        std::string out(s.data(), s.size());
+        std::transform(out.begin(), out.end(), out.begin(), [] (char c) { return static_cast<char>(bsv::simd::fold(c)); });
+        return out;
+    }
+
+    // What a traits type without a dedicated kernel gets: eq at every position.
+    std::size_t eq_loop_find (bsv::string_view hay, bsv::string_view needle) {
+        for (std::size_t i = 0; i + needle.size() <= hay.size(); ++i) {
+            std::size_t k = 0;
+            while (k < needle.size() && bsv::ci_char_traits::eq(hay[i + k], needle[k])) {
+                ++k;
+            }
+            if (k == needle.size()) {
+                return i;
+            }
+        }
+        return bsv::string_view::npos;
+    }
+}
+
+int main (int argc, char** argv) {
+    const std::size_t bytes = bench::arg_or(argc, argv, 1, 64) << 20;
+
+    // Mixed-case words; the needle only occurs, in another case, at the very end.
+    std::mt19937 rng(35);
+    std::string text;
+    text.reserve(bytes + 64);
+    while (text.size() < bytes) {
+        const std::size_t len = 2 + rng() % 10;
+        for (std::size_t k = 0; k < len; ++k) {
+            text += static_cast<char>((rng() % 4 == 0 ? 'A' : 'a') + rng() % 26);
+        }
+        text += ' ';
+    }
+    text += "Transfer-ENCODING";
+    const bsv::string_view hay(text.data(), text.size());
+    const bsv::string_view needle("transfer-encoding");
+    const bsv::string_view exact("Transfer-ENCODING");
+
+    bench::report(bench::run("string_view::find (case-sensitive)", [&] {
+        bench::do_not_optimize(hay.find(exact));
+    }, text.size(), 1));
+
+    bench::report(bench::run("lower-case copy + find", [&] {
+        const std::string h = lower(hay);
+        bench::do_not_optimize(bsv::string_view(h.data(), h.size()).find(needle));
+    }, text.size(), 1));
+
+    bench::report(bench::run("ci_char_traits::eq loop", [&] {
+        bench::do_not_optimize(eq_loop_find(hay, needle));
+    }, text.size(), 1));
+
+    bench::report(bench::run("ci_string_view::find", [&] {
+        bench::do_not_optimize(bsv::ci_string_view(hay).find(bsv::ci_string_view(needle)));
+    }, text.size(), 1));
+
+    // Header-name style comparisons: short keys, equal apart from case.
+    const char* names[] = {"Content-Type", "content-length", "ACCEPT-ENCODING", "X-Request-Id", "Cache-Control",
+                           "If-None-Match", "user-agent", "Authorization"};
+    std::vector<std::string> headers, probes;
+    for (std::size_t i = 0; i < 1 << 16; ++i) {
+        headers.push_back(names[rng() % 8]);
+        std::string p = names[rng() % 8];
+        for (char& c : p) {
+            c = rng() % 2 ? static_cast<char>(bsv::simd::fold(c)) : static_cast<char>(c & ~((c >= 'a' && c <= 'z') << 5));
+        }
+        probes.push_back(std::move(p));
+    }
+
+    bench::report(bench::run("lower-case copies + ==", [&] {
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < headers.size(); ++i) {
+            const std::string a = lower(bsv::string_view(headers[i].data(), headers[i].size()));
+            const std::string b = lower(bsv::string_view(probes[i].data(), probes[i].size()));
+            hits += bsv::string_view(a.data(), a.size()) == bsv::string_view(b.data(), b.size());
+        }
+        bench::do_not_optimize(hits);
+    }, 0, headers.size()));
+
+    bench::report(bench::run("ci_string_view ==", [&] {
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < headers.size(); ++i) {
+            hits += bsv::ci_string_view(headers[i]) == bsv::ci_string_view(probes[i]);
+        }
+        bench::do_not_optimize(hits);
+    }, 0, headers.size()));
+}
@@ -0,0 +1,75 @@
+// Sorting and binary-searching many keys held in separately allocated strings: std::sort / std::lower_bound over
+// bsv::string_view (every comparison reads the string heap) vs. over bsv::compact_view (most comparisons end on the
+// length and prefix inside the 16-byte handle).
+// usage: compact_view_bench [millions of keys = 4] [percent of keys of at most 12 bytes = 30]
+
+#include "../compact_view.hpp"
+#include "../../bench/bench.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+int main (int argc, char** argv) {
+    const std::size_t count = bench::arg_or(argc, argv, 1, 4) * 1000000;
+    const std::size_t short_percent = bench::arg_or(argc, argv, 2, 30);
+
+    // One heap allocation per key, in random order, as for keys parsed out of many documents.
+    std::mt19937_64 rng(40);
+    std::vector<std::unique_ptr<std::string> > storage;
+    storage.reserve(count);
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t length = (rng() % 100 < short_percent) ? 4 + rng() % 9 : 13 + rng() % 40;
+        auto key = std::make_unique<std::string>(length, ' ');
+        for (char& ch : *key) {
+            ch = static_cast<char>('a' + rng() % 26);
+        }
+        bytes += length;
+        storage.push_back(std::move(key));
+    }
+    std::shuffle(storage.begin(), storage.end(), rng);
+
+    std::vector<bsv::string_view> views;
+    std::vector<bsv::compact_view> compact;
+    for (const auto& key : storage) {
+        views.emplace_back(key->data(), key->size());
+        compact.emplace_back(bsv::string_view(key->data(), key->size()));
+    }
+    std::vector<bsv::string_view> probes;
+    for (std::size_t i = 0; i < count / 4; ++i) {
+        probes.push_back(views[rng() % views.size()]);
+    }
+
+    std::vector<bsv::string_view> sorted_views;
+    bench::report(bench::run("sort string_view", [&] {
+        sorted_views = views;
+        std::sort(sorted_views.begin(), sorted_views.end());
+    }, bytes, count));
+
+    std::vector<bsv::compact_view> sorted_compact;
+    bench::report(bench::run("sort compact_view", [&] {
+        sorted_compact = compact;
+        std::sort(sorted_compact.begin(), sorted_compact.end());
+    }, bytes, count));
+
+    bench::report(bench::run("lower_bound string_view", [&] {
+        std::size_t found = 0;
+        for (const bsv::string_view p : probes) {
+            found += *std::lower_bound(sorted_views.begin(), sorted_views.end(), p) == p;
+        }
+        bench::do_not_optimize(found);
+    }, 0, probes.size()));
+
+    bench::report(bench::run("lower_bound compact_view", [&] {
+        std::size_t found = 0;
+        for (const bsv::string_view p : probes) {
+            const auto it = std::lower_bound(sorted_compact.begin(), sorted_compact.end(), p,
+                                             [](const bsv::compact_view& a, bsv::string_view b) { return a.compare(b) < 0; });
+            found += *it == p;
+        }
+        bench::do_not_optimize(found);
+    }, 0, probes.size()));
+}
@@ -0,0 +1,76 @@
+// Sorting URL-like keys with long shared prefixes: bsv::string_view (operator<, vector mismatch kernel) vs. 
+// std::string_view, plus equality checks on keys that differ only near the end.
+// usage: compare_bench [keys = 10000000]
+
+#include "../string_view.hpp"
+#include "../../bench/bench.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int main (int argc, char** argv) {
+    const std::size_t key_count = bench::arg_or(argc, argv, 1, 10000000);
+
+    const char* hosts[] = {"https://api.example.com/v2/customers/", "https://api.example.com/v2/orders/", 
+                           "https://static.example-cdn.net/assets/images/products/thumbnails/"};
+    std::mt19937_64 rng(11);
+    std::string arena;
+    std::vector<std::pair<std::size_t, std::size_t> > spans;
+    for (std::size_t i = 0; i < key_count; ++i) {
+        std::string key = hosts[rng() % 3];
+        key += std::to_string(rng() % 1000);
+        key += "/items/";
+        key += std::to_string(rng() % 100000000);
+        spans.emplace_back(arena.size(), key.size());
+        arena += key;
+    }
+    std::vector<bsv::string_view> keys;
+    std::vector<std::string_view> std_keys;
+    for (auto [off, len] : spans) {
+        keys.emplace_back(arena.data() + off, len);
+        std_keys.emplace_back(arena.data() + off, len);
+    }
+
+    bench::report(bench::run("copy only (baseline)", [&] {
+        auto copy = keys;
+        bench::do_not_optimize(copy.data());
+    }, 0, key_count, 0));
+
+    bench::report(bench::run("std::sort bsv::string_view", [&] {
+        auto copy = keys;
+        std::sort(copy.begin(), copy.end());
+        bench::do_not_optimize(copy.data());
+    }, 0, key_count, 0));
+
+    bench::report(bench::run("std::sort std::string_view", [&] {
+        auto copy = std_keys;
+        std::sort(copy.begin(), copy.end());
+        bench::do_not_optimize(copy.data());
+    }, 0, key_count, 0));
+
+    // Equal length, equal up to the last few bytes: the worst case for equality.
+    std::vector<std::string> probes;
+    for (std::size_t i = 0; i < 1024; ++i) {
+        std::string p(keys[i].data(), keys[i].size());
+        p.back() = p.back() == '0' ? '1' : '0';
+        probes.push_back(std::move(p));
+    }
+    bench::report(bench::run("bsv::string_view == (late mismatch)", [&] {
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < probes.size(); ++i) {
+            hits += keys[i] == bsv::string_view(probes[i].data(), probes[i].size());
+        }
+        bench::do_not_optimize(hits);
+    }, 0, probes.size()));
+
+    bench::report(bench::run("std::string_view == (late mismatch)", [&] {
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < probes.size(); ++i) {
+            hits += std_keys[i] == std::string_view(probes[i]);
+        }
+        bench::do_not_optimize(hits);
+    }, 0, probes.size()));
+}
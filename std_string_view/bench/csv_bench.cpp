@@ -0,0 +1,81 @@
+// CSV parsing throughput: csv_parser on an in-memory buffer and csv_reader over a stream (1 MiB chunks), vs. a
+// byte-at-a-time quote-state machine producing the same fields.
+// usage: csv_bench [megabytes = 256] [percent of quoted fields = 10]
+
+#include "../csv.hpp"
+#include "../../bench/bench.hpp"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    // Reference: one branch per byte, the usual hand-written loop.
+    template <typename F>
+    void scalar_csv (bsv::string_view text, F f) {
+        std::vector<bsv::string_view> fields;
+        std::size_t field = 0;
+        bool quoted = false;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            const char ch = text[i];
+            if (ch == '"') {
+                quoted = !quoted;
+            } else if (!quoted && (ch == ',' || ch == '\n')) {
+                fields.emplace_back(text.data() + field, i - field);
+                field = i + 1;
+                if (ch == '\n') {
+                    f(fields);
+                    fields.clear();
+                }
+            }
+        }
+    }
+}
+
+int main (int argc, char** argv) {
+    const std::size_t bytes = bench::arg_or(argc, argv, 1, 256) << 20;
+    const std::size_t quoted_percent = bench::arg_or(argc, argv, 2, 10);
+
+    std::mt19937 rng(21);
+    std::string text;
+    text.reserve(bytes + 4096);
+    while (text.size() < bytes) {
+        for (int f = 0; f < 8; ++f) {
+            if (rng() % 100 < quoted_percent) {
+                text += "\"quoted, with \"\"escapes\"\"\nand a newline\"";
+            } else {
+                text += std::to_string(rng() % 1000000);
+                text.append(rng() % 12, 'v');
+            }
+            text += (f == 7) ? '\n' : ',';
+        }
+    }
+    const bsv::string_view view(text.data(), text.size());
+
+    std::size_t records = 0;
+    bsv::csv_parser parser;
+    parser.parse(view, true, [&](const bsv::csv_record&) { ++records; });
+
+    bench::report(bench::run("scalar state machine", [&] {
+        std::size_t fields = 0;
+        scalar_csv(view, [&](const std::vector<bsv::string_view>& r) { fields += r.size(); });
+        bench::do_not_optimize(fields);
+    }, text.size(), records));
+
+    bench::report(bench::run("csv_parser, whole buffer", [&] {
+        std::size_t fields = 0;
+        parser.parse(view, true, [&](const bsv::csv_record& r) { fields += r.size(); });
+        bench::do_not_optimize(fields);
+    }, text.size(), records));
+
+    std::istringstream in(text);
+    bench::report(bench::run("csv_reader, 1 MiB chunks", [&] {
+        in.clear();
+        in.seekg(0);
+        bsv::csv_reader reader(in);
+        std::size_t fields = 0;
+        reader.for_each_record([&](const bsv::csv_record& r) { fields += r.size(); });
+        bench::do_not_optimize(fields);
+    }, text.size(), records));
+}
@@ -0,0 +1,99 @@
+// Needles known at compile time vs the same needles as run-time data, over synthetic HTTP request heads: bsv::find<"...">
+// / starts_with<"..."> against basic_string_view::find / starts_with and std::string_view. One pass over a large buffer
+// of heads (many partial matches of "\r\n", one "\r\n\r\n" per head), then per-head and per-line calls, where the
+// fixed cost of a search dominates.
+// usage: fixed_string_bench [number of request heads = 20000]
+
+#include "../fixed_string.hpp"
+#include "../split.hpp"
+#include "../../bench/bench.hpp"
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int main (int argc, char** argv) {
+    const std::size_t heads = bench::arg_or(argc, argv, 1, 20000);
+
+    std::mt19937 rng(42);
+    const char* names[] = {"Host", "User-Agent", "Accept", "Accept-Encoding", "Connection", "Cache-Control", "Cookie"};
+    std::string all;
+    std::vector<bsv::string_view> blocks;
+    std::vector<std::size_t> starts;
+    for (std::size_t h = 0; h < heads; ++h) {
+        starts.push_back(all.size());
+        all += "POST /api/v1/items/" + std::to_string(rng() % 100000) + " HTTP/1.1\r\n";
+        const std::size_t fields = 4 + rng() % 6;
+        for (std::size_t f = 0; f < fields; ++f) {
+            all += std::string(names[rng() % 7]) + ": " + std::string(8 + rng() % 40, static_cast<char>('a' + rng() % 26)) + "\r\n";
+        }
+        all += "Content-Length: " + std::to_string(rng() % 5000) + "\r\n\r\n";
+    }
+    starts.push_back(all.size());
+    for (std::size_t h = 0; h < heads; ++h) {
+        blocks.emplace_back(all.data() + starts[h], starts[h + 1] - starts[h]);
+    }
+    std::vector<bsv::string_view> lines;
+    for (const bsv::string_view b : blocks) {
+        for (const bsv::string_view line : bsv::split(b, bsv::string_view("\r\n"))) {
+            lines.push_back(line);
+        }
+    }
+    const bsv::string_view text (all.data(), all.size());
+    const std::string_view std_text (all.data(), all.size());
+    const bsv::string_view end_runtime ("\r\n\r\n");
+    const bsv::string_view length_runtime ("Content-Length:");
+
+    // Every "\r\n\r\n" of the buffer, one search after another.
+    const auto every = [&](auto find_next) {
+        std::size_t found = 0;
+        for (std::size_t i = find_next(0); i != bsv::string_view::npos; i = find_next(i + 4)) {
+            ++found;
+        }
+        return found;
+    };
+    bench::report(bench::run("whole buffer: find<\"\\r\\n\\r\\n\"> (compile time)", [&] {
+        bench::do_not_optimize(every([&](std::size_t pos) { return bsv::find<"\r\n\r\n">(text, pos); }));
+    }, all.size()));
+    bench::report(bench::run("whole buffer: bsv find(\"\\r\\n\\r\\n\") (run time)", [&] {
+        bench::do_not_optimize(every([&](std::size_t pos) { return text.find(end_runtime, pos); }));
+    }, all.size()));
+    bench::report(bench::run("whole buffer: std find(\"\\r\\n\\r\\n\")", [&] {
+        bench::do_not_optimize(every([&](std::size_t pos) { return std_text.find("\r\n\r\n", pos); }));
+    }, all.size()));
+
+    const auto per_block = [&](auto op) {
+        std::size_t sum = 0;
+        for (const bsv::string_view b : blocks) {
+            sum += op(b);
+        }
+        return sum;
+    };
+    bench::report(bench::run("per head: find<\"Content-Length:\"> (compile time)", [&] {
+        bench::do_not_optimize(per_block([](bsv::string_view b) { return bsv::find<"Content-Length:">(b); }));
+    }, all.size(), heads));
+    bench::report(bench::run("per head: bsv find(\"Content-Length:\") (run time)", [&] {
+        bench::do_not_optimize(per_block([&](bsv::string_view b) { return b.find(length_runtime); }));
+    }, all.size(), heads));
+    bench::report(bench::run("per head: std find(\"Content-Length:\")", [&] {
+        bench::do_not_optimize(per_block([](bsv::string_view b) { return std::string_view(b.data(), b.size()).find("Content-Length:"); }));
+    }, all.size(), heads));
+
+    const auto per_line = [&](auto op) {
+        std::size_t hits = 0;
+        for (const bsv::string_view line : lines) {
+            hits += op(line);
+        }
+        return hits;
+    };
+    bench::report(bench::run("per line: starts_with<\"Content-Length:\"> (compile time)", [&] {
+        bench::do_not_optimize(per_line([](bsv::string_view l) { return bsv::starts_with<"Content-Length:">(l); }));
+    }, all.size(), lines.size()));
+    bench::report(bench::run("per line: bsv starts_with(\"Content-Length:\") (run time)", [&] {
+        bench::do_not_optimize(per_line([&](bsv::string_view l) { return l.starts_with(length_runtime); }));
+    }, all.size(), lines.size()));
+    bench::report(bench::run("per line: std starts_with(\"Content-Length:\")", [&] {
+        bench::do_not_optimize(per_line([](bsv::string_view l) { return std::string_view(l.data(), l.size()).starts_with("Content-Length:"); }));
+    }, all.size(), lines.size()));
+}
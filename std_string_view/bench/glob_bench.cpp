@@ -0,0 +1,165 @@
+// Routing / ACL rules against request paths: a glob_set of a few hundred rules (fixed routes, `*` and `?` placeholders,
+// `**` subtrees, extension rules), matched with glob_set::match and match_all, vs. trying the compiled globs one by one,
+// vs. a naive recursive matcher over the uncompiled patterns. Then one pattern with many `*` against a text that almost
+// matches, where the recursive matcher backtracks exponentially.
+// usage: glob_bench [number of paths = 100000] [number of stars in the last test = 12]
+
+#include "../glob.hpp"
+#include "../../bench/bench.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    // What the compiled globs replace: `*` tries every split, `**` (as a component) every number of components.
+    bool naive_match (const char* p, const char* t, bool path) {
+        if (*p == '\0') {
+            return *t == '\0';
+        }
+        if (*p == '*') {
+            const bool any = path && p[1] == '*';
+            while (*p == '*') {
+                ++p;
+            }
+            for (;; ++t) {
+                if (naive_match(p, t, path)) {
+                    return true;
+                }
+                if (*t == '\0' || (*t == '/' && path && !any)) {
+                    return false;
+                }
+            }
+        }
+        if (*t == '\0' || (*t == '/' && path && *p != '/')) {
+            return false;
+        }
+        if (*p == '[') {
+            const char* q = p + 1;
+            const bool negated = *q == '!';
+            q += negated;
+            bool in = false;
+            for (bool first = true; first || *q != ']'; first = false, ++q) {
+                if (q[1] == '-' && q[2] != ']') {
+                    in |= *t >= q[0] && *t <= q[2];
+                    q += 2;
+                } else {
+                    in |= *t == *q;
+                }
+            }
+            return in != negated && naive_match(q + 1, t + 1, path);
+        }
+        return (*p == '?' || *p == *t) && naive_match(p + 1, t + 1, path);
+    }
+}
+
+int main (int argc, char** argv) {
+    const std::size_t count = bench::arg_or(argc, argv, 1, 100000);
+    const std::size_t stars = bench::arg_or(argc, argv, 2, 12);
+
+    const char* resources[] = {"users", "orders", "items", "carts", "payments", "invoices", "sessions", "reports",
+                               "teams", "projects", "tickets", "comments", "files", "events", "webhooks", "tokens"};
+    const char* subs[] = {"history", "settings", "members", "attachments", "status", "audit"};
+    std::vector<std::string> rules;
+    for (const char* r : resources) {
+        for (const char* v : {"v1", "v2"}) {
+            rules.push_back(std::string("/api/") + v + "/" + r);
+            rules.push_back(std::string("/api/") + v + "/" + r + "/*");
+            for (const char* s : subs) {
+                rules.push_back(std::string("/api/") + v + "/" + r + "/*/" + s);
+                rules.push_back(std::string("/api/") + v + "/" + r + "/*/" + s + "/[0-9]*");
+            }
+        }
+        rules.push_back(std::string("/api/*/") + r + "/?\?/profile*");
+        rules.push_back(std::string("/admin/**/") + r + "/export.*");
+    }
+    for (const char* ext : {"js", "css", "png", "svg", "woff2", "map"}) {
+        rules.push_back(std::string("/static/**/*.") + ext);
+    }
+    rules.push_back("**/.git/**");
+    rules.push_back("/health");
+    rules.push_back("/metrics");
+
+    bsv::glob_set set;
+    std::vector<bsv::glob> globs;
+    for (const std::string& r : rules) {
+        set.add(bsv::string_view(r.data(), r.size()));
+        globs.emplace_back(bsv::string_view(r.data(), r.size()));
+    }
+
+    std::mt19937 rng(48);
+    std::vector<std::string> paths;
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::string r = resources[rng() % 16];
+        const std::string id = std::to_string(rng() % 100000);
+        std::string p;
+        switch (rng() % 6) {
+            case 0: p = "/api/v" + std::to_string(1 + rng() % 3) + "/" + r + "/" + id; break;
+            case 1: p = "/api/v1/" + r + "/" + id + "/" + subs[rng() % 6] + "/" + std::to_string(rng() % 100); break;
+            case 2: p = "/api/v2/" + r + "/" + std::to_string(10 + rng() % 90) + "/profile.json"; break;
+            case 3: p = "/static/app/" + id + "/bundle." + (rng() % 2 ? "js" : "txt"); break;
+            case 4: p = "/admin/tenants/" + id + "/" + r + "/export.csv"; break;
+            default: p = "/unknown/" + r + "/" + id + "/x/y/z"; break;
+        }
+        bytes += p.size();
+        paths.push_back(std::move(p));
+    }
+
+    std::size_t matched = 0;
+    bench::report(bench::run("glob_set::match (first rule)", [&] {
+        matched = 0;
+        for (const std::string& p : paths) {
+            matched += set.match(bsv::string_view(p.data(), p.size())) != bsv::glob_set::npos;
+        }
+        bench::do_not_optimize(matched);
+    }, bytes, paths.size()));
+    std::printf("%zu rules, %zu of %zu paths matched\n", rules.size(), matched, paths.size());
+    bench::report(bench::run("glob_set::match_all", [&] {
+        std::vector<std::size_t> ids;
+        for (const std::string& p : paths) {
+            ids.clear();
+            set.match_all(bsv::string_view(p.data(), p.size()), std::back_inserter(ids));
+            bench::do_not_optimize(ids.data());
+        }
+    }, bytes, paths.size()));
+    bench::report(bench::run("glob::matches, rule after rule", [&] {
+        std::size_t n = 0;
+        for (const std::string& p : paths) {
+            for (const bsv::glob& g : globs) {
+                if (g.matches(bsv::string_view(p.data(), p.size()))) {
+                    ++n;
+                    break;
+                }
+            }
+        }
+        bench::do_not_optimize(n);
+    }, bytes, paths.size()));
+    bench::report(bench::run("naive recursive, rule after rule", [&] {
+        std::size_t n = 0;
+        for (const std::string& p : paths) {
+            for (const std::string& r : rules) {
+                if (naive_match(r.c_str(), p.c_str(), true)) {
+                    ++n;
+                    break;
+                }
+            }
+        }
+        bench::do_not_optimize(n);
+    }, bytes, paths.size()));
+
+    // "*a*a*...*a*b" against "aaa...a": every way to place the stars fails at the end.
+    std::string pattern;
+    for (std::size_t i = 0; i < stars; ++i) {
+        pattern += "*a";
+    }
+    pattern += "*b";
+    const std::string text(2 * stars + 8, 'a');
+    const bsv::glob many(bsv::string_view(pattern.data(), pattern.size()), bsv::glob_mode::text);
+    bench::report(bench::run("many stars: glob::matches", [&] {
+        bench::do_not_optimize(many.matches(bsv::string_view(text.data(), text.size())));
+    }, text.size(), 1));
+    bench::report(bench::run("many stars: naive recursive", [&] {
+        bench::do_not_optimize(naive_match(pattern.c_str(), text.c_str(), false));
+    }, text.size(), 1));
+}
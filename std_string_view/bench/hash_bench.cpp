@@ -0,0 +1,109 @@
+// Hash throughput by key length, and string-keyed lookups: bsv::string_map looked up by view vs. 
+// std::unordered_map<std::string, ...> (one key string per lookup, and C++20 transparent lookup by std::string_view).
+// usage: hash_bench [keys = 1000000]
+
+#include "../string_map.hpp"
+#include "../../bench/bench.hpp"
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    struct transparent_hash {
+        using is_transparent = void;
+        std::size_t operator() (std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+    };
+}
+
+int main (int argc, char** argv) {
+    const std::size_t key_count = bench::arg_or(argc, argv, 1, 1000000);
+    std::mt19937_64 rng(7);
+
+    for (std::size_t len : {4, 8, 16, 32, 64, 256, 1024, 4096, 65536}) {
+        std::string data(len, ' ');
+        for (auto& ch : data) {
+            ch = static_cast<char>(rng());
+        }
+        const std::size_t reps = 1 + (1 << 20) / len;
+        bench::report(bench::run("bsv::hash_value " + std::to_string(len) + "B", [&] {
+            std::uint64_t acc = 0;
+            for (std::size_t i = 0; i < reps; ++i) {
+                acc += bsv::hash_value(bsv::string_view(data.data(), len), acc);
+            }
+            bench::do_not_optimize(acc);
+        }, len * reps, reps));
+        bench::report(bench::run("std::hash<std::string_view> " + std::to_string(len) + "B", [&] {
+            std::size_t acc = 0;
+            for (std::size_t i = 0; i < reps; ++i) {
+                data[0] = static_cast<char>(acc);
+                acc += std::hash<std::string_view>{}(std::string_view(data.data(), len));
+            }
+            bench::do_not_optimize(acc);
+        }, len * reps, reps));
+    }
+
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < key_count; ++i) {
+        keys.push_back("/metrics/host-" + std::to_string(rng() % 100000) + "/series/" + std::to_string(i));
+    }
+    // Lookups come in as views into a larger buffer, as they do when parsing requests.
+    std::string buffer;
+    std::vector<std::pair<std::size_t, std::size_t> > spans;
+    for (std::size_t i = 0; i < key_count; ++i) {
+        const auto& k = keys[rng() % key_count];
+        spans.emplace_back(buffer.size(), k.size());
+        buffer += k;
+    }
+
+    bsv::string_map<std::size_t> flat;
+    std::unordered_map<std::string, std::size_t> by_string;
+    std::unordered_map<std::string, std::size_t, transparent_hash, std::equal_to<> > by_view;
+    for (std::size_t i = 0; i < key_count; ++i) {
+        flat[bsv::string_view(keys[i].data(), keys[i].size())] = i;
+        by_string[keys[i]] = i;
+        by_view[keys[i]] = i;
+    }
+
+    bench::report(bench::run("bsv::string_map find(view)", [&] {
+        std::size_t sum = 0;
+        for (auto [off, len] : spans) {
+            sum += flat.find(bsv::string_view(buffer.data() + off, len))->second;
+        }
+        bench::do_not_optimize(sum);
+    }, 0, key_count));
+
+    bench::report(bench::run("unordered_map<string> find(string(view))", [&] {
+        std::size_t sum = 0;
+        for (auto [off, len] : spans) {
+            sum += by_string.find(std::string(buffer.data() + off, len))->second;
+        }
+        bench::do_not_optimize(sum);
+    }, 0, key_count));
+
+    bench::report(bench::run("unordered_map<string> transparent find", [&] {
+        std::size_t sum = 0;
+        for (auto [off, len] : spans) {
+            sum += by_view.find(std::string_view(buffer.data() + off, len))->second;
+        }
+        bench::do_not_optimize(sum);
+    }, 0, key_count));
+
+    bench::report(bench::run("bsv::string_map build", [&] {
+        bsv::string_map<std::size_t> m;
+        for (std::size_t i = 0; i < key_count; ++i) {
+            m[bsv::string_view(keys[i].data(), keys[i].size())] = i;
+        }
+        bench::do_not_optimize(m.size());
+    }, 0, key_count));
+
+    bench::report(bench::run("unordered_map<string> build", [&] {
+        std::unordered_map<std::string, std::size_t> m;
+        for (std::size_t i = 0; i < key_count; ++i) {
+            m[keys[i]] = i;
+        }
+        bench::do_not_optimize(m.size());
+    }, 0, key_count));
+}
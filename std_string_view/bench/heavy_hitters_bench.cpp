@@ -0,0 +1,97 @@
+// Top-100 keys of a Zipf-distributed token stream: heavy_hitters (one sketch, and four merged per-thread sketches)
+// vs. counting every key exactly in a std::unordered_map<std::string, uint64_t> and partially sorting it. Reports
+// throughput, then the recall of the true top-100 and the mean relative error of the reported counts.
+// usage: heavy_hitters_bench [millions of tokens = 20] [thousands of distinct keys = 1000] [zipf exponent x100 = 110]
+
+#include "../heavy_hitters.hpp"
+#include "../../bench/bench.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+int main (int argc, char** argv) {
+    const std::size_t tokens = bench::arg_or(argc, argv, 1, 20) * 1000000;
+    const std::size_t distinct = bench::arg_or(argc, argv, 2, 1000) * 1000;
+    const double exponent = static_cast<double>(bench::arg_or(argc, argv, 3, 110)) / 100;
+    constexpr std::size_t k = 100;
+
+    std::vector<std::string> keys(distinct);
+    for (std::size_t i = 0; i < distinct; ++i) {
+        keys[i] = "/api/v1/items/" + std::to_string(i * 2654435761u % 1000000007u);
+    }
+    std::vector<double> cdf(distinct);
+    double sum = 0;
+    for (std::size_t i = 0; i < distinct; ++i) {
+        sum += 1 / std::pow(static_cast<double>(i + 1), exponent);
+        cdf[i] = sum;
+    }
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> uniform(0, sum);
+    std::vector<bsv::string_view> stream;
+    std::size_t bytes = 0;
+    stream.reserve(tokens);
+    for (std::size_t i = 0; i < tokens; ++i) {
+        const std::string& key = keys[std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin()];
+        stream.emplace_back(key.data(), key.size());
+        bytes += key.size();
+    }
+
+    std::unordered_map<std::string, std::uint64_t> exact;
+    bench::report(bench::run("exact unordered_map", [&] {
+        exact.clear();
+        for (const bsv::string_view t : stream) {
+            ++exact[std::string(t.data(), t.size())];
+        }
+    }, bytes, tokens));
+
+    bsv::heavy_hitters_options options;
+    options.k = k;
+    bsv::heavy_hitters single(options);
+    bench::report(bench::run("heavy_hitters", [&] {
+        single.clear();
+        for (const bsv::string_view t : stream) {
+            single.add(t);
+        }
+    }, bytes, tokens));
+
+    // Four sketches over interleaved quarters of the stream, as four threads would build them, then merged.
+    bsv::heavy_hitters merged(options);
+    bench::report(bench::run("heavy_hitters, 4 parts + merge", [&] {
+        std::vector<bsv::heavy_hitters> parts(4, bsv::heavy_hitters(options));
+        for (std::size_t i = 0; i < stream.size(); ++i) {
+            parts[i % 4].add(stream[i]);
+        }
+        merged = parts[0];
+        for (std::size_t p = 1; p < 4; ++p) {
+            merged.merge(parts[p]);
+        }
+    }, bytes, tokens));
+
+    std::vector<std::pair<std::uint64_t, std::string> > truth;
+    for (const auto& [key, count] : exact) {
+        truth.emplace_back(count, key);
+    }
+    std::partial_sort(truth.begin(), truth.begin() + k, truth.end(), std::greater<>());
+    std::unordered_set<std::string> true_top;
+    for (std::size_t i = 0; i < k; ++i) {
+        true_top.insert(truth[i].second);
+    }
+    for (const auto& [name, hh] : {std::pair<const char*, const bsv::heavy_hitters*>{"single", &single}, {"merged", &merged}}) {
+        std::size_t hits = 0;
+        double error = 0;
+        const auto top = hh->top();
+        for (const auto& e : top) {
+            hits += true_top.count(e.key);
+            const double real = static_cast<double>(exact[e.key]);
+            error += (static_cast<double>(e.count) - real) / real;
+        }
+        std::printf("%-8s recall %zu/%zu, mean relative count error %.4f%%, %zu exact keys vs %zu tracked\n", name, hits, k,
+                    100 * error / static_cast<double>(top.size()), exact.size(), hh->tracked());
+    }
+}
@@ -0,0 +1,91 @@
+// Interning a skewed stream of metric labels: intern rate of bsv::intern_pool (one thread and several) vs. a
+// mutex-guarded std::unordered_set<std::string>, and the memory kept per series vs. one std::string copy each.
+// usage: intern_pool_bench [distinct labels = 300000] [threads = 4]
+
+#include "../intern_pool.hpp"
+#include "../../bench/bench.hpp"
+
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+int main (int argc, char** argv) {
+    const std::size_t distinct = bench::arg_or(argc, argv, 1, 300000);
+    const std::size_t threads = bench::arg_or(argc, argv, 2, 4);
+    const std::size_t stream_length = 4000000;
+
+    std::mt19937_64 rng(11);
+    std::vector<std::string> labels;
+    labels.reserve(distinct);
+    for (std::size_t i = 0; labels.size() < distinct; ++i) {
+        labels.push_back("service=api-" + std::to_string(rng() % 97) + ",region=eu-" + std::to_string(rng() % 7)
+                         + ",endpoint=/v1/items/" + std::to_string(i));
+    }
+    // Roughly Zipfian: a few labels dominate the stream, most show up rarely.
+    std::vector<bsv::string_view> stream;
+    stream.reserve(stream_length);
+    std::uniform_real_distribution<double> unit(0, 1);
+    for (std::size_t i = 0; i < stream_length; ++i) {
+        const auto k = static_cast<std::size_t>(static_cast<double>(distinct) * unit(rng) * unit(rng) * unit(rng));
+        stream.emplace_back(labels[k].data(), labels[k].size());
+    }
+
+    bench::report(bench::run("unordered_set<string> + mutex", [&] {
+        std::unordered_set<std::string> set;
+        std::mutex mutex;
+        for (auto s : stream) {
+            std::lock_guard<std::mutex> lock(mutex);
+            bench::do_not_optimize(*set.emplace(s.data(), s.size()).first);
+        }
+    }, 0, stream_length));
+
+    bench::report(bench::run("intern_pool, 1 thread", [&] {
+        bsv::intern_pool pool;
+        for (auto s : stream) {
+            bench::do_not_optimize(pool.intern(s));
+        }
+    }, 0, stream_length));
+
+    bsv::intern_pool warm;
+    for (auto s : stream) {
+        warm.intern(s);
+    }
+    bench::report(bench::run("intern_pool, 1 thread, all present", [&] {
+        for (auto s : stream) {
+            bench::do_not_optimize(warm.intern(s));
+        }
+    }, 0, stream_length));
+
+    const std::string name = "intern_pool, " + std::to_string(threads) + " threads";
+    bench::report(bench::run(name, [&] {
+        bsv::intern_pool pool;
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (std::size_t i = t; i < stream.size(); i += threads) {
+                    bench::do_not_optimize(pool.intern(stream[i]));
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }, 0, stream_length));
+
+    // Memory: a std::string per series (heap block only past the SSO buffer) vs. one stored copy per label plus a
+    // 16-byte view per series.
+    std::size_t string_bytes = 0;
+    for (auto s : stream) {
+        string_bytes += sizeof(std::string) + (s.size() > 15 ? s.size() + 1 : 0);
+    }
+    const auto m = warm.memory();
+    const std::size_t pool_bytes = m.arena_bytes + m.index_bytes + stream.size() * sizeof(bsv::string_view);
+    std::printf("%zu series, %zu distinct: std::string copies %.1f MiB, intern_pool %.1f MiB "
+                "(arena %.1f, index %.1f), saved %.1f MiB\n",
+                stream.size(), m.strings, string_bytes / 1048576.0, pool_bytes / 1048576.0,
+                m.arena_bytes / 1048576.0, m.index_bytes / 1048576.0, (double(string_bytes) - double(pool_bytes)) / 1048576.0);
+}
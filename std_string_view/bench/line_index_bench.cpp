@@ -0,0 +1,86 @@
+// Building a line_index over a log-like buffer, sequentially and with 1, 2, 4... threads, vs. collecting the line starts
+// into a std::vector<std::size_t> with memchr; then the memory per line of both, and random line(n) / line_of(offset)
+// lookups.
+// usage: line_index_bench [megabytes = 256] [max threads = cores]
+
+#include "../line_index.hpp"
+#include "../../bench/bench.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main (int argc, char** argv) {
+    const std::size_t bytes = bench::arg_or(argc, argv, 1, 256) << 20;
+    const std::size_t max_threads = bench::arg_or(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+
+    std::mt19937 rng(47);
+    std::string text;
+    text.reserve(bytes + 128);
+    while (text.size() < bytes) {
+        text += "2024-05-01T12:00:00Z INFO request id=";
+        text += std::to_string(rng() % 1000000);
+        text += (rng() % 64 == 0) ? " status=503 upstream timeout\n" : " status=200\n";
+    }
+    const bsv::string_view view(text.data(), text.size());
+
+    const auto memchr_starts = [&] {
+        std::vector<std::size_t> starts {0};
+        for (const char* p = text.data(), *end = p + text.size(); (p = static_cast<const char*>(std::memchr(p, '\n', end - p))) != nullptr; ) {
+            starts.push_back(++p - text.data());
+        }
+        return starts;
+    };
+    bench::report(bench::run("memchr into vector<size_t>", [&] {
+        bench::do_not_optimize(memchr_starts().data());
+    }, text.size(), 1));
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        bsv::thread_pool pool(threads);
+        const bsv::parallel_policy policy(pool);
+        char name[64];
+        std::snprintf(name, sizeof(name), "line_index, %zu thread(s)", threads);
+        bench::report(bench::run(name, [&] {
+            bench::do_not_optimize(bsv::line_index(view, policy).lines());
+        }, text.size(), 1));
+        if (threads < max_threads && threads * 2 > max_threads) {
+            threads = max_threads / 2;
+        }
+    }
+
+    const std::vector<std::size_t> starts = memchr_starts();
+    const bsv::line_index index(view);
+    std::printf("%zu lines: line_index %.2f bytes per line, vector<size_t> %.2f bytes per line\n", index.lines(),
+                double(index.memory_bytes()) / index.lines(), double(starts.capacity() * sizeof(std::size_t)) / index.lines());
+
+    constexpr std::size_t lookups = 1 << 20;
+    std::vector<std::size_t> lines(lookups), offsets(lookups);
+    for (std::size_t i = 0; i < lookups; ++i) {
+        lines[i] = rng() % index.lines();
+        offsets[i] = rng() % text.size();
+    }
+    bench::report(bench::run("random line(n)", [&] {
+        std::size_t sum = 0;
+        for (const std::size_t n : lines) {
+            sum += index.line(n).size();
+        }
+        bench::do_not_optimize(sum);
+    }, 0, lookups));
+    bench::report(bench::run("random line_of(offset)", [&] {
+        std::size_t sum = 0;
+        for (const std::size_t off : offsets) {
+            sum += index.line_of(off);
+        }
+        bench::do_not_optimize(sum);
+    }, 0, lookups));
+    bench::report(bench::run("random upper_bound over vector<size_t>", [&] {
+        std::size_t sum = 0;
+        for (const std::size_t off : offsets) {
+            sum += std::upper_bound(starts.begin(), starts.end(), off) - starts.begin() - 1;
+        }
+        bench::do_not_optimize(sum);
+    }, 0, lookups));
+}
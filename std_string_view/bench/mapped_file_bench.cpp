@@ -0,0 +1,77 @@
+// Reading a large log file line by line: ifstream + getline vs. mapped_file + lines() (whole file, windowed,
+// with MAP_POPULATE). The file is written to path once and read from the page cache afterwards.
+// usage: mapped_file_bench [megabytes = 1024] [path = /tmp/mapped_file_bench.log]
+
+#include "../mapped_file.hpp"
+#include "../split.hpp"
+#include "../../bench/bench.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+int main (int argc, char** argv) {
+    const std::size_t bytes = bench::arg_or(argc, argv, 1, 1024) << 20;
+    const std::string path = argc > 2 ? argv[2] : "/tmp/mapped_file_bench.log";
+
+    {
+        std::mt19937 rng(7);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        std::string line;
+        for (std::size_t written = 0; written < bytes; written += line.size()) {
+            line = "2024-05-01T12:00:" + std::to_string(rng() % 60) + " host" + std::to_string(rng() % 64) + " GET /api/v1/item/";
+            line.append(rng() % 120, 'x');
+            line += " 200\n";
+            out << line;
+        }
+    }
+
+    std::size_t line_count = 0;
+    {
+        bsv::mapped_file file(path);
+        for (auto line : bsv::lines(file.view())) {
+            bench::do_not_optimize(line);
+            ++line_count;
+        }
+    }
+
+    const auto scan = [](bsv::mapped_file& file) {
+        std::size_t total = 0;
+        do {
+            for (auto line : bsv::lines(file.view())) {
+                total += line.size();
+            }
+        } while (file.next_window());
+        bench::do_not_optimize(total);
+    };
+    const double min_seconds = 1.0;
+    const std::size_t file_bytes = bsv::mapped_file(path).file_size();
+
+    bench::report(bench::run("ifstream + getline", [&] {
+        std::ifstream in(path, std::ios::binary);
+        std::string line;
+        std::size_t total = 0;
+        while (std::getline(in, line)) {
+            total += line.size();
+        }
+        bench::do_not_optimize(total);
+    }, file_bytes, line_count, min_seconds));
+
+    bench::report(bench::run("mapped_file + lines", [&] {
+        bsv::mapped_file file(path, {bsv::map_advice::sequential});
+        scan(file);
+    }, file_bytes, line_count, min_seconds));
+
+    bench::report(bench::run("mapped_file + lines, populate", [&] {
+        bsv::mapped_file file(path, {bsv::map_advice::sequential | bsv::map_advice::hugepage, true});
+        scan(file);
+    }, file_bytes, line_count, min_seconds));
+
+    bench::report(bench::run("mapped_file + lines, 64 MiB windows", [&] {
+        bsv::mapped_file file(path, {bsv::map_advice::sequential | bsv::map_advice::willneed, false, 64 << 20});
+        scan(file);
+    }, file_bytes, line_count, min_seconds));
+
+    std::remove(path.c_str());
+}
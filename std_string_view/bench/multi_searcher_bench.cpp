@@ -0,0 +1,96 @@
+// Matches request-like lines against a keyword set: one multi_searcher pass vs. one basic_string_view::find per pattern.
+// usage: multi_searcher_bench [patterns = 5000] [lines = 200]
+
+#include "../multi_searcher.hpp"
+#include "../../bench/bench.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+int main (int argc, char** argv) {
+    const std::size_t pattern_count = bench::arg_or(argc, argv, 1, 5000);
+    const std::size_t line_count = bench::arg_or(argc, argv, 2, 200);
+
+    std::mt19937 rng(42);
+    auto random_word = [&rng] (std::size_t min_len, std::size_t max_len) {
+        std::string w(min_len + rng() % (max_len - min_len + 1), ' ');
+        for (auto& ch : w) {
+            ch = static_cast<char>('a' + rng() % 26);
+        }
+        return w;
+    };
+
+    std::vector<std::string> keywords;
+    for (std::size_t i = 0; i < pattern_count; ++i) {
+        keywords.push_back(random_word(5, 12));
+    }
+    std::vector<bsv::string_view> patterns(keywords.begin(), keywords.end());
+
+    std::vector<std::string> lines;
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < line_count; ++i) {
+        std::string line = "GET /api/v1/";
+        while (line.size() < 200) {
+            line += (rng() % 8 == 0) ? keywords[rng() % keywords.size()] : random_word(2, 9);
+            line += (rng() % 2) ? '/' : '?';
+        }
+        bytes += line.size();
+        lines.push_back(std::move(line));
+    }
+
+    const bsv::multi_searcher searcher(patterns.begin(), patterns.end());
+    std::printf("%zu patterns, %zu states, %zu KiB automaton, prefilter %s\n", searcher.pattern_count(), 
+                searcher.state_count(), searcher.memory_usage() / 1024, searcher.uses_prefilter() ? "on" : "off");
+
+    bench::report(bench::run("find loop: any match", [&] {
+        std::size_t hits = 0;
+        for (const auto& line : lines) {
+            const bsv::string_view text(line.data(), line.size());
+            for (const auto& p : patterns) {
+                if (text.find(p) != bsv::string_view::npos) {
+                    ++hits;
+                    break;
+                }
+            }
+        }
+        bench::do_not_optimize(hits);
+    }, bytes, line_count));
+
+    bench::report(bench::run("multi_searcher: any match", [&] {
+        std::size_t hits = 0;
+        for (const auto& line : lines) {
+            hits += searcher.contains_any(bsv::string_view(line.data(), line.size()));
+        }
+        bench::do_not_optimize(hits);
+    }, bytes, line_count));
+
+    bench::report(bench::run("find loop: all matches", [&] {
+        std::size_t hits = 0;
+        for (const auto& line : lines) {
+            const bsv::string_view text(line.data(), line.size());
+            for (const auto& p : patterns) {
+                for (auto pos = text.find(p); pos != bsv::string_view::npos; pos = text.find(p, pos + 1)) {
+                    ++hits;
+                }
+            }
+        }
+        bench::do_not_optimize(hits);
+    }, bytes, line_count));
+
+    bench::report(bench::run("multi_searcher: all matches", [&] {
+        std::size_t hits = 0;
+        for (const auto& line : lines) {
+            searcher.for_each_match(bsv::string_view(line.data(), line.size()), [&hits] (const auto&) { ++hits; });
+        }
+        bench::do_not_optimize(hits);
+    }, bytes, line_count));
+
+    bench::report(bench::run("multi_searcher: leftmost-longest", [&] {
+        std::size_t total = 0;
+        for (const auto& line : lines) {
+            total += searcher.find_leftmost_longest(bsv::string_view(line.data(), line.size())).length;
+        }
+        bench::do_not_optimize(total);
+    }, bytes, line_count));
+}
@@ -0,0 +1,70 @@
+// Emitting many small views (a response serializer: header names, separators, short values, the occasional body):
+// output_builder with writev vs. bsv::operator<< on a std::ofstream and fwrite on a FILE*, all to the same file.
+// usage: output_builder_bench [thousands of views = 1000] [path = /dev/null]
+
+#include "../output_builder.hpp"
+#include "../../bench/bench.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+int main (int argc, char** argv) {
+    const std::size_t count = bench::arg_or(argc, argv, 1, 1000) * 1000;
+    const char* path = argc > 2 ? argv[2] : "/dev/null";
+
+    const std::vector<std::string> names = {"Content-Type", "Content-Length", "Cache-Control", "X-Request-Id", "Vary"};
+    const std::vector<std::string> values = {"text/html; charset=utf-8", "1024", "no-store", "a1b2c3d4e5f6", "Accept"};
+    const std::string body(4096, 'b');
+    std::mt19937 rng(39);
+    std::vector<bsv::string_view> views;
+    std::size_t bytes = 0;
+    views.reserve(count);
+    while (views.size() < count) {
+        const std::size_t k = rng() % names.size();
+        for (const std::string* s : {&names[k], &values[k]}) {
+            views.emplace_back(s->data(), s->size());
+            views.emplace_back(s == &names[k] ? ": " : "\r\n");
+        }
+        if (rng() % 64 == 0) {
+            views.emplace_back(body.data(), body.size());
+        }
+    }
+    for (const bsv::string_view v : views) {
+        bytes += v.size();
+    }
+
+    std::ofstream os(path, std::ios::binary);
+    bench::report(bench::run("std::ofstream <<", [&] {
+        for (const bsv::string_view v : views) {
+            os << v;
+        }
+        os.flush();
+    }, bytes, views.size()));
+
+    std::FILE* file = std::fopen(path, "wb");
+    bench::report(bench::run("fwrite", [&] {
+        for (const bsv::string_view v : views) {
+            std::fwrite(v.data(), 1, v.size(), file);
+        }
+        std::fflush(file);
+    }, bytes, views.size()));
+    std::fclose(file);
+
+    const int fd = ::open(path, O_WRONLY);
+    bsv::output_builder out(fd);
+    bench::report(bench::run("output_builder (writev)", [&] {
+        for (const bsv::string_view v : views) {
+            out << v;
+        }
+        out.flush();
+    }, bytes, views.size()));
+    const bsv::flush_stats totals = out.totals();
+    std::printf("output_builder: %.1f bytes per writev\n", static_cast<double>(totals.bytes) / static_cast<double>(totals.syscalls));
+    ::close(fd);
+}
@@ -0,0 +1,63 @@
+// Scaling of the parallel algorithms with the number of threads, on a log-like buffer with the needle near the end:
+// parallel_find, parallel_rfind, parallel_count('\n'), parallel_count(needle) and parallel_find_all, vs. the
+// sequential find / count loop.
+// usage: parallel_bench [megabytes = 512] [max threads = cores]
+
+#include "../parallel.hpp"
+#include "../../bench/bench.hpp"
+
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main (int argc, char** argv) {
+    const std::size_t bytes = bench::arg_or(argc, argv, 1, 512) << 20;
+    const std::size_t max_threads = bench::arg_or(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+
+    std::mt19937 rng(37);
+    std::string text;
+    text.reserve(bytes + 128);
+    while (text.size() < bytes) {
+        text += "2024-05-01T12:00:00Z INFO request id=";
+        text += std::to_string(rng() % 1000000);
+        text += (rng() % 64 == 0) ? " status=503 upstream timeout\n" : " status=200\n";
+    }
+    text += "FATAL out of memory\n";
+    const bsv::string_view view(text.data(), text.size());
+    const bsv::string_view needle("FATAL");
+    const bsv::string_view frequent("status=503");
+
+    bench::report(bench::run("sequential find", [&] {
+        bench::do_not_optimize(view.find(needle));
+    }, text.size(), 1));
+    bench::report(bench::run("sequential count('\\n')", [&] {
+        bench::do_not_optimize(bsv::simd::count(reinterpret_cast<const unsigned char*>(text.data()), text.size(), '\n'));
+    }, text.size(), 1));
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        bsv::thread_pool pool(threads);
+        const bsv::parallel_policy policy(pool);
+        std::printf("%zu thread(s):\n", threads);
+        bench::report(bench::run("  parallel_find", [&] {
+            bench::do_not_optimize(bsv::parallel_find(policy, view, needle));
+        }, text.size(), 1));
+        bench::report(bench::run("  parallel_rfind (match at the end)", [&] {
+            bench::do_not_optimize(bsv::parallel_rfind(policy, view, needle));
+        }, 0, 1));
+        bench::report(bench::run("  parallel_count('\\n')", [&] {
+            bench::do_not_optimize(bsv::parallel_count(policy, view, '\n'));
+        }, text.size(), 1));
+        bench::report(bench::run("  parallel_count(needle)", [&] {
+            bench::do_not_optimize(bsv::parallel_count(policy, view, frequent));
+        }, text.size(), 1));
+        bench::report(bench::run("  parallel_find_all", [&] {
+            std::vector<std::size_t> positions;
+            bsv::parallel_find_all(policy, view, frequent, std::back_inserter(positions));
+            bench::do_not_optimize(positions.data());
+        }, text.size(), 1));
+        if (threads < max_threads && threads * 2 > max_threads) {
+            threads = max_threads / 2;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+// Number parsing from views, in values per second: bsv::parse / bsv::parse_column vs. std::from_chars, strtoll /
+// strtod, and the std::string + std::stoll / std::stod round trip that CSV ingestion used to do.
+// usage: parse_bench [values = 1000000]
+
+#include "../parse.hpp"
+#include "../../bench/bench.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    struct column {
+        std::string buffer;                     // fields separated by ',', so strtoll / strtod stop on their own
+        std::vector<bsv::string_view> fields;
+    };
+
+    template <typename Gen>
+    column make_column (std::size_t count, Gen gen) {
+        column c;
+        std::vector<std::size_t> offsets;
+        for (std::size_t i = 0; i < count; ++i) {
+            offsets.push_back(c.buffer.size());
+            c.buffer += gen();
+            c.buffer += ',';
+        }
+        offsets.push_back(c.buffer.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            c.fields.emplace_back(c.buffer.data() + offsets[i], offsets[i + 1] - offsets[i] - 1);
+        }
+        return c;
+    }
+
+    template <typename T>
+    void run_all (const std::string& label, const column& c) {
+        const std::size_t n = c.fields.size();
+        std::vector<T> out(n);
+        const auto report = [&](const std::string& name, auto&& f) {
+            bench::report(bench::run(label + ": " + name, f, c.buffer.size(), n));
+        };
+
+        report("bsv::parse", [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = bsv::parse<T>(c.fields[i]).value;
+            }
+            bench::do_not_optimize(out.data());
+        });
+        report("bsv::parse_column", [&] {
+            bench::do_not_optimize(bsv::parse_column<T>(c.fields, out.data()));
+        });
+        report("std::from_chars", [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                std::from_chars(c.fields[i].data(), c.fields[i].data() + c.fields[i].size(), out[i]);
+            }
+            bench::do_not_optimize(out.data());
+        });
+        report(std::is_integral_v<T> ? "strtoll" : "strtod", [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                if constexpr (std::is_integral_v<T>) {
+                    out[i] = static_cast<T>(std::strtoll(c.fields[i].data(), nullptr, 10));
+                } else {
+                    out[i] = static_cast<T>(std::strtod(c.fields[i].data(), nullptr));
+                }
+            }
+            bench::do_not_optimize(out.data());
+        });
+        report(std::is_integral_v<T> ? "std::string + stoll" : "std::string + stod", [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                const std::string s(c.fields[i].data(), c.fields[i].size());
+                if constexpr (std::is_integral_v<T>) {
+                    out[i] = static_cast<T>(std::stoll(s));
+                } else {
+                    out[i] = static_cast<T>(std::stod(s));
+                }
+            }
+            bench::do_not_optimize(out.data());
+        });
+    }
+}
+
+int main (int argc, char** argv) {
+    const std::size_t count = bench::arg_or(argc, argv, 1, 1000000);
+    std::mt19937_64 rng(5);
+
+    run_all<long long>("ints 1-4 digits", make_column(count, [&] { return std::to_string(rng() % 10000); }));
+    run_all<long long>("ints 8-16 digits", make_column(count, [&] {
+        return std::to_string(10000000 + rng() % 9999999990000000ull / (1ull << (rng() % 27)));
+    }));
+    run_all<long long>("ints 19 digits, signed", make_column(count, [&] {
+        return std::to_string(static_cast<long long>((rng() >> 1) | (1ull << 62)) * ((rng() & 1) ? 1 : -1));
+    }));
+    run_all<double>("prices", make_column(count, [&] {
+        char buf[32];
+        std::snprintf(buf, sizeof buf, "%.2f", static_cast<double>(rng() % 10000000) / 100);
+        return std::string(buf);
+    }));
+    run_all<double>("doubles %.17g", make_column(count, [&] {
+        char buf[32];
+        std::snprintf(buf, sizeof buf, "%.17g", std::uniform_real_distribution<double>(-1e6, 1e6)(rng));
+        return std::string(buf);
+    }));
+    run_all<double>("scientific", make_column(count, [&] {
+        char buf[32];
+        std::snprintf(buf, sizeof buf, "%.9e", std::uniform_real_distribution<double>(0, 1)(rng) * std::pow(10.0, int(rng() % 200) - 100));
+        return std::string(buf);
+    }));
+}
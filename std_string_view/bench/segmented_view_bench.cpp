@@ -0,0 +1,56 @@
+// Searching a body held as a chain of 16 KiB receive buffers: segmented_view::find / count of '\n' over the chain vs.
+// linearizing the chain into one std::string first and searching that.
+// usage: segmented_view_bench [megabytes = 64] [segment bytes = 16384]
+
+#include "../segmented_view.hpp"
+#include "../../bench/bench.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+int main (int argc, char** argv) {
+    const std::size_t bytes = bench::arg_or(argc, argv, 1, 64) << 20;
+    const std::size_t segment_size = bench::arg_or(argc, argv, 2, 16384);
+
+    std::mt19937 rng(38);
+    std::vector<std::string> buffers;
+    for (std::size_t total = 0; total < bytes; total += segment_size) {
+        std::string b(segment_size, ' ');
+        for (char& ch : b) {
+            ch = (rng() % 64 == 0) ? '\n' : static_cast<char>('a' + rng() % 26);
+        }
+        buffers.push_back(std::move(b));
+    }
+    // The needle straddles the last seam.
+    const std::string needle = "--boundary-7f3a";
+    buffers[buffers.size() - 2].replace(segment_size - 5, 5, needle.substr(0, 5));
+    buffers.back().replace(0, needle.size() - 5, needle.substr(5));
+    const bsv::string_view pattern(needle.data(), needle.size());
+
+    bsv::segmented_view chain;
+    for (const std::string& b : buffers) {
+        chain.append(bsv::string_view(b.data(), b.size()));
+    }
+
+    bench::report(bench::run("linearize + find", [&] {
+        std::string flat;
+        flat.reserve(chain.size());
+        for (const std::string& b : buffers) {
+            flat += b;
+        }
+        bench::do_not_optimize(bsv::string_view(flat.data(), flat.size()).find(pattern));
+    }, chain.size(), 1));
+
+    bench::report(bench::run("segmented_view::find", [&] {
+        bench::do_not_optimize(chain.find(pattern));
+    }, chain.size(), 1));
+
+    bench::report(bench::run("segmented_view, find('\\n') loop", [&] {
+        std::size_t lines = 0;
+        for (std::size_t pos = chain.find('\n'); pos != bsv::segmented_view::npos; pos = chain.find('\n', pos + 1)) {
+            ++lines;
+        }
+        bench::do_not_optimize(lines);
+    }, chain.size(), 1));
+}
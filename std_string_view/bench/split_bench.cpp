@@ -0,0 +1,99 @@
+// Tokenizing a large buffer: bsv::split views vs. the hand-written find + substr loop.
+// usage: split_bench [megabytes = 64]
+
+#include "../split.hpp"
+#include "../../bench/bench.hpp"
+
+#include <random>
+#include <string>
+
+int main (int argc, char** argv) {
+    const std::size_t bytes = bench::arg_or(argc, argv, 1, 64) << 20;
+
+    std::mt19937 rng(3);
+    std::string csv, words;
+    while (csv.size() < bytes) {
+        csv += std::to_string(rng() % 100000);
+        csv += (rng() % 8 == 0) ? '\n' : ',';
+    }
+    while (words.size() < bytes) {
+        words.append(1 + rng() % 10, 'w');
+        words.append(1 + rng() % 3 / 2, (rng() % 4 == 0) ? '\t' : ' ');
+    }
+    const bsv::string_view text(csv.data(), csv.size());
+    const bsv::string_view prose(words.data(), words.size());
+
+    std::size_t tokens = 0;
+    for (auto field : bsv::split(text, ',')) {
+        bench::do_not_optimize(field);
+        ++tokens;
+    }
+
+    bench::report(bench::run("find/substr loop, ','", [&] {
+        std::size_t total = 0;
+        for (std::size_t pos = 0; ; ) {
+            const std::size_t next = text.find(',', pos);
+            total += text.substr(pos, next == bsv::string_view::npos ? bsv::string_view::npos : next - pos).size();
+            if (next == bsv::string_view::npos) {
+                break;
+            }
+            pos = next + 1;
+        }
+        bench::do_not_optimize(total);
+    }, text.size(), tokens));
+
+    bench::report(bench::run("bsv::split, ','", [&] {
+        std::size_t total = 0;
+        for (auto field : bsv::split(text, ',')) {
+            total += field.size();
+        }
+        bench::do_not_optimize(total);
+    }, text.size(), tokens));
+
+    bench::report(bench::run("find_first_of/substr loop, \",\\n\"", [&] {
+        std::size_t total = 0;
+        for (std::size_t pos = 0; ; ) {
+            const std::size_t next = text.find_first_of(",\n", pos);
+            total += text.substr(pos, next == bsv::string_view::npos ? bsv::string_view::npos : next - pos).size();
+            if (next == bsv::string_view::npos) {
+                break;
+            }
+            pos = next + 1;
+        }
+        bench::do_not_optimize(total);
+    }, text.size()));
+
+    bench::report(bench::run("bsv::split_any, \",\\n\"", [&] {
+        std::size_t total = 0;
+        for (auto field : bsv::split_any(text, ",\n")) {
+            total += field.size();
+        }
+        bench::do_not_optimize(total);
+    }, text.size()));
+
+    bench::report(bench::run("bsv::split, \"\\n\" substring", [&] {
+        std::size_t total = 0;
+        for (auto line : bsv::split(text, bsv::string_view("\n"))) {
+            total += line.size();
+        }
+        bench::do_not_optimize(total);
+    }, text.size()));
+
+    bench::report(bench::run("find_first_(not_)of loop, whitespace", [&] {
+        std::size_t total = 0;
+        for (std::size_t pos = prose.find_first_not_of(" \t"); pos != bsv::string_view::npos; ) {
+            const std::size_t next = prose.find_first_of(" \t", pos);
+            total += prose.substr(pos, next == bsv::string_view::npos ? bsv::string_view::npos : next - pos).size();
+            pos = next == bsv::string_view::npos ? next : prose.find_first_not_of(" \t", next);
+        }
+        bench::do_not_optimize(total);
+    }, prose.size()));
+
+    bench::report(bench::run("bsv::split_whitespace", [&] {
+        std::size_t total = 0;
+        for (auto word : bsv::split_whitespace(prose)) {
+            total += word.size();
+        }
+        bench::do_not_optimize(total);
+    }, prose.size()));
+}
@@ -0,0 +1,109 @@
+// Searching a stream delivered in 16 KiB chunks: stream_searcher / stream_multi_searcher vs. copying each chunk behind
+// the tail of the previous one into a staging buffer and rescanning that, with one find over the whole buffer as the
+// reference for the single-pattern case.
+// usage: stream_searcher_bench [megabytes = 64] [chunk bytes = 16384]
+
+#include "../stream_searcher.hpp"
+#include "../../bench/bench.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+int main (int argc, char** argv) {
+    const std::size_t bytes = bench::arg_or(argc, argv, 1, 64) << 20;
+    const std::size_t chunk_size = bench::arg_or(argc, argv, 2, 16384);
+
+    const std::vector<std::string> keywords = {"Transfer-Encoding: chunked", "Connection: close", "X-Forwarded-For", 
+                                               "Content-Length: 0", "Upgrade: websocket", "Expect: 100-continue"};
+    std::mt19937 rng(36);
+    std::string text;
+    text.reserve(bytes + 64);
+    while (text.size() < bytes) {
+        if (rng() % 16 == 0) {
+            text += keywords[rng() % keywords.size()];
+        } else {
+            for (std::size_t k = 2 + rng() % 10; k > 0; --k) {
+                text += static_cast<char>('a' + rng() % 26);
+            }
+        }
+        text += (rng() % 8 == 0) ? "\r\n" : " ";
+    }
+    std::vector<bsv::string_view> chunks;
+    for (std::size_t at = 0; at < text.size(); at += chunk_size) {
+        chunks.emplace_back(text.data() + at, std::min(chunk_size, text.size() - at));
+    }
+
+    const bsv::string_view pattern(keywords[0].data(), keywords[0].size());
+    const bsv::string_view whole(text.data(), text.size());
+    std::size_t matches = 0;
+    for (std::size_t pos = whole.find(pattern); pos != bsv::string_view::npos; pos = whole.find(pattern, pos + 1)) {
+        ++matches;
+    }
+
+    bench::report(bench::run("find on the whole buffer", [&] {
+        std::size_t hits = 0;
+        for (std::size_t pos = whole.find(pattern); pos != bsv::string_view::npos; pos = whole.find(pattern, pos + 1)) {
+            ++hits;
+        }
+        bench::do_not_optimize(hits);
+    }, text.size(), matches));
+
+    // The staging buffer keeps the last m - 1 bytes, followed by a copy of the new chunk.
+    bench::report(bench::run("copy-and-rescan, one pattern", [&] {
+        std::string staging;
+        std::size_t hits = 0;
+        for (const bsv::string_view chunk : chunks) {
+            staging.append(chunk.data(), chunk.size());
+            const bsv::string_view view(staging.data(), staging.size());
+            for (std::size_t pos = view.find(pattern); pos != bsv::string_view::npos; pos = view.find(pattern, pos + 1)) {
+                ++hits;
+            }
+            staging.erase(0, staging.size() - std::min(staging.size(), pattern.size() - 1));
+        }
+        bench::do_not_optimize(hits);
+    }, text.size(), matches));
+
+    bench::report(bench::run("stream_searcher", [&] {
+        bsv::stream_searcher searcher(pattern);
+        std::size_t hits = 0;
+        for (const bsv::string_view chunk : chunks) {
+            searcher.feed(chunk, [&hits](std::size_t) { ++hits; });
+        }
+        bench::do_not_optimize(hits);
+    }, text.size(), matches));
+
+    std::vector<bsv::string_view> patterns(keywords.begin(), keywords.end());
+    const bsv::multi_searcher multi(patterns.begin(), patterns.end());
+    std::size_t longest = 0;
+    for (const auto& k : keywords) {
+        longest = std::max(longest, k.size());
+    }
+    std::size_t multi_matches = 0;
+    multi.for_each_match(whole, [&](const auto&) { ++multi_matches; });
+
+    // Matches that end inside the carried tail were already reported with the previous chunk.
+    bench::report(bench::run("copy-and-rescan, multi_searcher", [&] {
+        std::string staging;
+        std::size_t hits = 0;
+        for (const bsv::string_view chunk : chunks) {
+            const std::size_t carried = staging.size();
+            staging.append(chunk.data(), chunk.size());
+            multi.for_each_match(bsv::string_view(staging.data(), staging.size()), [&](const auto& m) {
+                hits += m.pos + m.length > carried;
+            });
+            staging.erase(0, staging.size() - std::min(staging.size(), longest - 1));
+        }
+        bench::do_not_optimize(hits);
+    }, text.size(), multi_matches));
+
+    bench::report(bench::run("stream_multi_searcher", [&] {
+        bsv::stream_multi_searcher searcher(patterns.begin(), patterns.end());
+        std::size_t hits = 0;
+        for (const bsv::string_view chunk : chunks) {
+            searcher.feed(chunk, [&hits](const auto&) { ++hits; });
+        }
+        bench::do_not_optimize(hits);
+    }, text.size(), multi_matches));
+}
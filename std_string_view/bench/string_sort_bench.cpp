@@ -0,0 +1,72 @@
+// Sorting string_view keys shaped like real data: URLs (long shared prefixes), object-store paths (hierarchical,
+// many duplicate directory prefixes) and short random words. string_sort and parallel_string_sort (1, 2, 4, ...
+// threads) vs. std::sort with compare().
+// usage: string_sort_bench [millions of keys = 2] [max threads = cores]
+
+#include "../string_sort.hpp"
+#include "../../bench/bench.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::vector<std::string> make_keys (const std::string& shape, std::size_t count, std::mt19937& rng) {
+        static const char* const hosts[] = {"www.example.com", "cdn.example.com", "api.example.org", "shop.example.net"};
+        static const char* const dirs[] = {"images", "static/js", "products", "user/profile", "search"};
+        std::vector<std::string> keys;
+        keys.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string k;
+            if (shape == "urls") {
+                k = std::string("https://") + hosts[rng() % 4] + "/" + dirs[rng() % 5] + "/" + std::to_string(rng() % 5000000) + ".html";
+            } else if (shape == "paths") {
+                k = "logs/2024/" + std::to_string(1 + rng() % 12) + "/" + std::to_string(1 + rng() % 28) + "/host-"
+                    + std::to_string(rng() % 64) + "/part-" + std::to_string(rng() % 100000) + ".parquet";
+            } else {
+                for (std::size_t l = 3 + rng() % 10; l > 0; --l) {
+                    k += static_cast<char>('a' + rng() % 26);
+                }
+            }
+            keys.push_back(std::move(k));
+        }
+        return keys;
+    }
+}
+
+int main (int argc, char** argv) {
+    const std::size_t count = bench::arg_or(argc, argv, 1, 2) * 1000000;
+    const std::size_t max_threads = bench::arg_or(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+
+    std::mt19937 rng(41);
+    for (const std::string shape : {"urls", "paths", "words"}) {
+        const std::vector<std::string> keys = make_keys(shape, count, rng);
+        std::vector<bsv::string_view> input;
+        std::size_t bytes = 0;
+        for (const std::string& k : keys) {
+            input.emplace_back(k.data(), k.size());
+            bytes += k.size();
+        }
+        std::vector<bsv::string_view> work;
+
+        bench::report(bench::run(shape + ": std::sort", [&] {
+            work = input;
+            std::sort(work.begin(), work.end());
+        }, bytes, count));
+
+        bench::report(bench::run(shape + ": string_sort", [&] {
+            work = input;
+            bsv::string_sort(work.begin(), work.end());
+        }, bytes, count));
+
+        for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+            bsv::thread_pool pool(threads);
+            bench::report(bench::run(shape + ": parallel_string_sort, " + std::to_string(threads) + " threads", [&] {
+                work = input;
+                bsv::parallel_string_sort(bsv::parallel_policy(pool), work.begin(), work.end());
+            }, bytes, count));
+        }
+    }
+}
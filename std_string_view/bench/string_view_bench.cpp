@@ -0,0 +1,62 @@
+// Every search and comparison of bsv::string_view next to the same call on std::string_view, over a text of random
+// lowercase words. The searches are set up to scan (nearly) the whole text: the match, if any, is at the far end.
+// usage: string_view_bench [text bytes = 1048576]
+
+#include "../string_view.hpp"
+#include "../../bench/bench.hpp"
+
+#include <random>
+#include <string>
+#include <string_view>
+
+// Calls op(v) with both view types over the same bytes, as two benchmarks.
+template <typename Op>
+void both (const char* name, const std::string& text, Op op) {
+    const bsv::string_view b (text.data(), text.size());
+    const std::string_view s (text.data(), text.size());
+    bench::report(bench::run(std::string("bsv::string_view ") + name, [&] { bench::do_not_optimize(op(b)); }, text.size()));
+    bench::report(bench::run(std::string("std::string_view ") + name, [&] { bench::do_not_optimize(op(s)); }, text.size()));
+}
+
+int main (int argc, char** argv) {
+    const std::size_t bytes = bench::arg_or(argc, argv, 1, 1 << 20);
+
+    std::mt19937 rng(42);
+    std::string text;
+    while (text.size() < bytes) {
+        const std::size_t length = 2 + rng() % 8;
+        for (std::size_t i = 0; i < length; ++i) {
+            text += static_cast<char>('a' + rng() % 26);
+        }
+        text += ' ';
+    }
+    text.resize(bytes);
+    // A marker at each end for the searches to find after a full scan.
+    const std::string marker = "#MARKER#";
+    text.replace(0, marker.size(), marker);
+    text.replace(text.size() - marker.size(), marker.size(), marker);
+    const std::string copy = text;
+    std::string late = text;
+    late[late.size() - 2] = '!';
+
+    // Forward searches start past the first marker, backward ones end before the last.
+    const std::size_t first = marker.size();
+    const std::size_t last = text.size() - marker.size() - 1;
+    both("find(char)", text, [&](auto v) { return v.find('#', first); });
+    both("find(view)", text, [&](auto v) { return v.find(decltype(v)(marker.data(), marker.size()), first); });
+    both("rfind(char)", text, [&](auto v) { return v.rfind('#', last); });
+    both("rfind(view)", text, [&](auto v) { return v.rfind(decltype(v)(marker.data(), marker.size()), last); });
+    both("find_first_of(3 chars)", text, [&](auto v) { return v.find_first_of(decltype(v)("#!?"), first); });
+    both("find_last_of(3 chars)", text, [&](auto v) { return v.find_last_of(decltype(v)("#!?"), last); });
+    both("find_first_not_of(a-z, space)", text, [&](auto v) {
+        return v.find_first_not_of(decltype(v)("abcdefghijklmnopqrstuvwxyz "), first);
+    });
+    both("find_last_not_of(a-z, space)", text, [&](auto v) {
+        return v.find_last_not_of(decltype(v)("abcdefghijklmnopqrstuvwxyz "), last);
+    });
+    both("compare (equal)", text, [&](auto v) { return v.compare(decltype(v)(copy.data(), copy.size())); });
+    both("compare (late mismatch)", text, [&](auto v) { return v.compare(decltype(v)(late.data(), late.size())); });
+    both("operator== (equal)", text, [&](auto v) { return v == decltype(v)(copy.data(), copy.size()); });
+    both("starts_with (whole text)", text, [&](auto v) { return v.starts_with(decltype(v)(copy.data(), copy.size())); });
+    both("ends_with (whole text)", text, [&](auto v) { return v.ends_with(decltype(v)(copy.data(), copy.size())); });
+}
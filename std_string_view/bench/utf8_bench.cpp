@@ -0,0 +1,97 @@
+// UTF-8 throughput on an ASCII-heavy corpus (English text with a few accents) and a CJK-heavy one: validation,
+// counting and UTF-8 <-> UTF-16 transcoding, vs. the byte-at-a-time scalar paths.
+// usage: utf8_bench [megabytes = 64]
+
+#include "../utf8.hpp"
+#include "../../bench/bench.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    void append (std::string& s, char32_t c) {
+        if (c < 0x80) {
+            s += static_cast<char>(c);
+        } else if (c < 0x800) {
+            s += static_cast<char>(0xC0 | (c >> 6));
+            s += static_cast<char>(0x80 | (c & 0x3F));
+        } else {
+            s += static_cast<char>(0xE0 | (c >> 12));
+            s += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            s += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+
+    // cjk_percent of the code points are CJK ideographs, 1% Latin-1 letters, the rest ASCII words.
+    std::string corpus (std::size_t bytes, unsigned cjk_percent) {
+        std::mt19937 rng(34);
+        std::string s;
+        s.reserve(bytes + 16);
+        while (s.size() < bytes) {
+            const unsigned r = rng() % 100;
+            if (r < cjk_percent) {
+                append(s, 0x4E00 + rng() % 0x5000);
+            } else if (r == 99) {
+                append(s, 0xE0 + rng() % 0x20);
+            } else {
+                append(s, (rng() % 6 == 0) ? ' ' : 'a' + rng() % 26);
+            }
+        }
+        return s;
+    }
+
+    // Reference: the usual one-branch-per-sequence decode loop.
+    std::size_t scalar_utf8_to_utf16 (const std::string& s, char16_t* out) {
+        const auto* p = reinterpret_cast<const unsigned char*>(s.data());
+        std::size_t i = 0;
+        char16_t* o = out;
+        while (i < s.size()) {
+            char32_t cp;
+            if (bsv::detail::decode_utf8(p, s.size(), i, cp) != bsv::utf_error::none) {
+                return 0;
+            }
+            *o++ = static_cast<char16_t>(cp);
+        }
+        return static_cast<std::size_t>(o - out);
+    }
+
+    void run_corpus (const char* name, const std::string& text) {
+        std::cout << name << ":\n";
+        const bsv::string_view view(text.data(), text.size());
+        const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+        const std::size_t code_points = bsv::count_utf8(view);
+        std::vector<char16_t> utf16(bsv::utf16_length_from_utf8(view));
+        std::vector<char8_t> utf8(text.size());
+
+        bench::report(bench::run("scalar validate", [&] {
+            bench::do_not_optimize(bsv::detail::validate_utf8_scalar(bytes, text.size(), 0));
+        }, text.size(), code_points));
+        bench::report(bench::run("validate_utf8", [&] {
+            bench::do_not_optimize(bsv::validate_utf8(view));
+        }, text.size(), code_points));
+
+        bench::report(bench::run("scalar count", [&] {
+            bench::do_not_optimize(bsv::detail::utf8_count_scalar(bytes, text.size()));
+        }, text.size(), code_points));
+        bench::report(bench::run("count_utf8", [&] {
+            bench::do_not_optimize(bsv::count_utf8(view));
+        }, text.size(), code_points));
+
+        bench::report(bench::run("scalar utf8 -> utf16", [&] {
+            bench::do_not_optimize(scalar_utf8_to_utf16(text, utf16.data()));
+        }, text.size(), code_points));
+        bench::report(bench::run("utf8_to_utf16", [&] {
+            bench::do_not_optimize(bsv::utf8_to_utf16(view, utf16.data()));
+        }, text.size(), code_points));
+        bench::report(bench::run("utf16_to_utf8", [&] {
+            bench::do_not_optimize(bsv::utf16_to_utf8(bsv::u16string_view(utf16.data(), utf16.size()), utf8.data()));
+        }, text.size(), code_points));
+    }
+}
+
+int main (int argc, char** argv) {
+    const std::size_t bytes = bench::arg_or(argc, argv, 1, 64) << 20;
+    run_corpus("ASCII-heavy", corpus(bytes, 0));
+    run_corpus("CJK-heavy", corpus(bytes, 90));
+}
@@ -0,0 +1,74 @@
+// The searches and comparisons of bsv::basic_string_view over char16_t and char32_t next to the same calls on
+// std::u16string_view / std::u32string_view, over a text of random lowercase words widened to the unit type, with a
+// marker at each end as in string_view_bench. The vector kernels picked at run time are the same for every width.
+// usage: wide_string_view_bench [text units = 262144]
+
+#include "../string_view.hpp"
+#include "../../bench/bench.hpp"
+
+#include <random>
+#include <string>
+#include <string_view>
+
+// Calls op(v) with both view types over the same units, as two benchmarks.
+template <typename CharT, typename Op>
+void both (const std::string& name, const std::basic_string<CharT>& text, Op op) {
+    const bsv::basic_string_view<CharT> b (text.data(), text.size());
+    const std::basic_string_view<CharT> s (text.data(), text.size());
+    const std::size_t bytes = text.size() * sizeof(CharT);
+    bench::report(bench::run("bsv " + name, [&] { bench::do_not_optimize(op(b)); }, bytes));
+    bench::report(bench::run("std " + name, [&] { bench::do_not_optimize(op(s)); }, bytes));
+}
+
+template <typename CharT>
+void run_width (const char* unit, std::size_t units) {
+    std::mt19937 rng(42);
+    std::basic_string<CharT> text;
+    while (text.size() < units) {
+        const std::size_t length = 2 + rng() % 8;
+        for (std::size_t i = 0; i < length; ++i) {
+            text += static_cast<CharT>('a' + rng() % 26);
+        }
+        text += CharT(' ');
+    }
+    text.resize(units);
+    const std::basic_string<CharT> marker = {CharT('#'), CharT('M'), CharT('A'), CharT('R'), CharT('K'), CharT('#')};
+    text.replace(0, marker.size(), marker);
+    text.replace(text.size() - marker.size(), marker.size(), marker);
+    const std::basic_string<CharT> copy = text;
+    const std::basic_string<CharT> set3 = {CharT('#'), CharT('!'), CharT('?')};
+    const std::basic_string<CharT> words = {CharT('a'), CharT('e'), CharT('i'), CharT('o'), CharT('u'), CharT(' ')};
+    std::basic_string<CharT> letters (1, CharT(' '));
+    for (char c = 'a'; c <= 'z'; ++c) {
+        letters += static_cast<CharT>(c);
+    }
+    std::basic_string<CharT> vowels;
+    while (vowels.size() < units) {
+        vowels += words[rng() % words.size()];
+    }
+
+    const std::size_t first = marker.size();
+    const std::size_t last = text.size() - marker.size() - 1;
+    const std::string w = std::string(unit) + " ";
+    both(w + "find(unit)", text, [&](auto v) { return v.find(CharT('#'), first); });
+    both(w + "find(view)", text, [&](auto v) { return v.find(decltype(v)(marker.data(), marker.size()), first); });
+    both(w + "rfind(unit)", text, [&](auto v) { return v.rfind(CharT('#'), last); });
+    both(w + "rfind(view)", text, [&](auto v) { return v.rfind(decltype(v)(marker.data(), marker.size()), last); });
+    both(w + "find_first_of(3 units)", text, [&](auto v) { return v.find_first_of(decltype(v)(set3.data(), set3.size()), first); });
+    both(w + "find_last_of(3 units)", text, [&](auto v) { return v.find_last_of(decltype(v)(set3.data(), set3.size()), last); });
+    both(w + "find_first_not_of(a-z, space)", text, [&](auto v) {
+        return v.find_first_not_of(decltype(v)(letters.data(), letters.size()), first);
+    });
+    // A run of vowels and spaces, scanned to its end for anything else.
+    both(w + "find_first_not_of(6 units)", vowels, [&](auto v) {
+        return v.find_first_not_of(decltype(v)(words.data(), words.size()));
+    });
+    both(w + "compare (equal)", text, [&](auto v) { return v.compare(decltype(v)(copy.data(), copy.size())); });
+    both(w + "operator== (equal)", text, [&](auto v) { return v == decltype(v)(copy.data(), copy.size()); });
+}
+
+int main (int argc, char** argv) {
+    const std::size_t units = bench::arg_or(argc, argv, 1, 1 << 18);
+    run_width<char16_t>("u16", units);
+    run_width<char32_t>("u32", units);
+}
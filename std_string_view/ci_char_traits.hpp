@@ -0,0 +1,41 @@
+/*
+Character traits for ASCII case-insensitive views: basic_string_view<char, ci_char_traits> (ci_string_view) compares,
+searches and hashes with 'A'..'Z' and 'a'..'z' treated as equal, for HTTP header names, keywords and the like.
+basic_string_view recognizes these traits and runs compare, starts_with / ends_with and find through the folding
+kernels of simd.hpp (fold_mismatch, fold_find), which fold 16 or 32 bytes per step instead of calling eq per character.
+Bytes >= 0x80 are compared as they are, so UTF-8 text folds its ASCII letters only.
+*/
+
+#ifndef CI_CHAR_TRAITS_HPP
+#define CI_CHAR_TRAITS_HPP
+
+#include "simd.hpp"
+
+#include <compare>
+#include <cstddef>
+#include <string>
+
+namespace bsv {
+    struct ci_char_traits : std::char_traits<char> {
+        // "ABC" and "abc" compare equal but are not substitutable, so <=> is weak, not char_traits<char>'s strong.
+        using comparison_category = std::weak_ordering;
+
+        static constexpr bool eq (char_type a, char_type b) noexcept;
+        // Orders by the lower-case byte values, so "Apple" < "banana" < "Cherry".
+        static constexpr bool lt (char_type a, char_type b) noexcept;
+        static constexpr int compare (const char_type* a, const char_type* b, std::size_t n) noexcept;
+        static constexpr const char_type* find (const char_type* p, std::size_t n, const char_type& ch) noexcept;
+    };
+
+} // namespace bsv
+
+#include "ci_char_traits.impl.hpp"
+
+#endif // CI_CHAR_TRAITS_HPP
+
+/*
+Methods                           Time Complexity      Auxiliary Space
+eq(a, b) / lt(a, b)               O(1)                 O(1)
+compare(a, b, n)                  O(n)                 O(1)
+find(p, n, ch)                    O(n)                 O(1)
+*/
@@ -0,0 +1,50 @@
+#ifndef CI_CHAR_TRAITS_IMPL_HPP
+#define CI_CHAR_TRAITS_IMPL_HPP
+
+#include "ci_char_traits.hpp"
+
+#include <type_traits>
+
+namespace bsv {
+    // ci_char_traits ------------------------------------------------------------------------------------------------------------
+
+    constexpr bool ci_char_traits::eq (char_type a, char_type b) noexcept {
+        return simd::fold(static_cast<unsigned char>(a)) == simd::fold(static_cast<unsigned char>(b));
+    }
+
+    constexpr bool ci_char_traits::lt (char_type a, char_type b) noexcept {
+        return simd::fold(static_cast<unsigned char>(a)) < simd::fold(static_cast<unsigned char>(b));
+    }
+
+    constexpr int ci_char_traits::compare (const char_type* a, const char_type* b, std::size_t n) noexcept {
+        if (!std::is_constant_evaluated()) {
+            const std::size_t i = simd::fold_mismatch(reinterpret_cast<const unsigned char*>(a),
+                                                      reinterpret_cast<const unsigned char*>(b), n);
+            if (i == n) { return 0; }
+            return lt(a[i], b[i]) ? -1 : 1;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!eq(a[i], b[i])) {
+                return lt(a[i], b[i]) ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    constexpr auto ci_char_traits::find (const char_type* p, std::size_t n, const char_type& ch) noexcept -> const char_type* {
+        if (!std::is_constant_evaluated()) {
+            const std::size_t i = simd::fold_find(reinterpret_cast<const unsigned char*>(p), n,
+                                                  reinterpret_cast<const unsigned char*>(&ch), 1);
+            return i == n ? nullptr : p + i;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if (eq(p[i], ch)) {
+                return p + i;
+            }
+        }
+        return nullptr;
+    }
+
+} // namespace bsv
+
+#endif // CI_CHAR_TRAITS_IMPL_HPP
@@ -0,0 +1,117 @@
+/*
+A 16-byte string view in the "German string" layout of Umbra / DuckDB / Arrow StringView, for keys that are sorted,
+binary-searched and compared far more often than they are read in full:
+    bytes  0..3     length (32 bits)
+    bytes  4..7     the first 4 code units (zero padded)
+    bytes  8..15    a pointer to the whole string, or for strings of at most 12 units, units 4..11 inline
+Most comparisons are decided by the length and the prefix, which sit in the handle itself: the pointer (a likely cache
+miss into the string heap) is only followed when the prefixes are equal. Short strings are copied into the handle and
+never touch the heap; long ones are referenced and must outlive it.
+Only byte-sized code units. The ordering shortcut is used with std::char_traits; with other traits (ci_char_traits)
+equal prefixes still short-cut equality of the bytes, the rest goes through Traits.
+*/
+
+#ifndef COMPACT_VIEW_HPP
+#define COMPACT_VIEW_HPP
+
+#include "string_view.hpp"
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bsv {
+    template <typename CharT, typename Traits = std::char_traits<CharT> > requires (sizeof(CharT) == 1)
+    class basic_compact_view {
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using traits_type = Traits;
+            using value_type = CharT;
+            using size_type = std::size_t;
+            using const_pointer = const CharT*;
+            using const_reference = const CharT&;
+            using const_iterator = const CharT*;
+            using iterator = const_iterator;
+
+            static constexpr size_type npos = view_type::npos;
+            static constexpr size_type prefix_size = 4;
+            static constexpr size_type inline_capacity = 12;
+            static constexpr size_type max_length = UINT32_MAX;
+
+        private:
+            std::uint32_t size_ = 0;
+            CharT units_[inline_capacity] = {};     // prefix, then either the inline units or the pointer's bytes
+
+            const_pointer pointer() const noexcept;
+            std::uint32_t prefix_word() const noexcept;     // the prefix as a big-endian number: ordered like the units
+
+        public:
+            basic_compact_view() noexcept = default;
+            // Throws std::length_error if v is longer than max_length.
+            basic_compact_view (view_type v);
+            basic_compact_view (const CharT* s);
+
+            operator view_type() const noexcept;
+            view_type view() const noexcept;
+
+        public: // Element access, iterators, capacity
+            const_pointer data() const noexcept;
+            const_reference operator[] (size_type pos) const noexcept;
+            const_reference front() const noexcept;
+            const_reference back() const noexcept;
+            const_iterator begin() const noexcept;
+            const_iterator end() const noexcept;
+            size_type size() const noexcept;
+            size_type length() const noexcept;
+            [[nodiscard]] bool empty() const noexcept;
+            // Whether the units live in the handle (size() <= 12), so that data() is only valid as long as it is.
+            bool is_inline() const noexcept;
+
+        public: // Operations
+            view_type substr (size_type pos = 0, size_type count = npos) const;
+            std::basic_string<CharT, Traits> str() const;
+
+            int compare (const basic_compact_view& other) const noexcept;
+            int compare (view_type v) const noexcept;
+            bool equals (const basic_compact_view& other) const noexcept;
+
+            bool starts_with (view_type v) const noexcept;
+            bool ends_with (view_type v) const noexcept;
+            bool contains (view_type v) const noexcept;
+
+            size_type find (view_type v, size_type pos = 0) const noexcept;
+            size_type find (CharT ch, size_type pos = 0) const noexcept;
+            size_type rfind (view_type v, size_type pos = npos) const noexcept;
+            size_type rfind (CharT ch, size_type pos = npos) const noexcept;
+            size_type find_first_of (view_type v, size_type pos = 0) const noexcept;
+            size_type find_last_of (view_type v, size_type pos = npos) const noexcept;
+            size_type find_first_not_of (view_type v, size_type pos = 0) const noexcept;
+            size_type find_last_not_of (view_type v, size_type pos = npos) const noexcept;
+    };
+
+    template <typename CharT, typename Traits>
+    bool operator== (const basic_compact_view<CharT, Traits>& a, const basic_compact_view<CharT, Traits>& b) noexcept;
+    template <typename CharT, typename Traits>
+    auto operator<=> (const basic_compact_view<CharT, Traits>& a, const basic_compact_view<CharT, Traits>& b) noexcept;
+
+    template <typename CharT, typename Traits>
+    bool operator== (const basic_compact_view<CharT, Traits>& a, std::type_identity_t<basic_string_view<CharT, Traits> > b) noexcept;
+    template <typename CharT, typename Traits>
+    auto operator<=> (const basic_compact_view<CharT, Traits>& a, std::type_identity_t<basic_string_view<CharT, Traits> > b) noexcept;
+
+    using compact_view = basic_compact_view<char>;
+
+} // namespace bsv
+
+#include "compact_view.impl.hpp"
+
+#endif // COMPACT_VIEW_HPP
+
+/*
+Methods                           Time Complexity                     Auxiliary Space
+compact_view(v)                   O(1), O(|v|) for |v| <= 12           O(1)
+compare / == / <=>                O(1) when length or prefix differ,  O(1)
+                                  else as basic_string_view::compare
+find / rfind / ...                as on basic_string_view             O(1)
+*/
@@ -0,0 +1,283 @@
+#ifndef COMPACT_VIEW_IMPL_HPP
+#define COMPACT_VIEW_IMPL_HPP
+
+#include "compact_view.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace bsv {
+    namespace detail {
+        // The first 4 bytes of [p, p + n), zero padded, as a big-endian number: comparing two of these as integers
+        // orders them like the bytes as unsigned char.
+        inline std::uint32_t prefix_word (const void* p, std::size_t n) noexcept {
+            std::uint32_t word = 0;
+            if (n != 0) {
+                std::memcpy(&word, p, n < 4 ? n : 4);
+            }
+            if constexpr (std::endian::native == std::endian::little) {
+                word = __builtin_bswap32(word);
+            }
+            return word;
+        }
+    }
+
+
+    static_assert(sizeof(basic_compact_view<char>) == 16);
+
+
+    // ctors and conversions ---------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    basic_compact_view<CharT, Traits>::basic_compact_view (view_type v) {
+        if (v.size() > max_length) {
+            throw std::length_error("basic_compact_view: string too long");
+        }
+        size_ = static_cast<std::uint32_t>(v.size());
+        if (v.size() <= inline_capacity) {
+            if (!v.empty()) {
+                std::memcpy(units_, v.data(), v.size());
+            }
+        } else {
+            const CharT* p = v.data();
+            std::memcpy(units_, p, prefix_size);
+            std::memcpy(units_ + prefix_size, &p, sizeof(p));
+        }
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    basic_compact_view<CharT, Traits>::basic_compact_view (const CharT* s) : basic_compact_view(view_type(s)) {}
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    basic_compact_view<CharT, Traits>::operator view_type() const noexcept {
+        return view();
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::view() const noexcept -> view_type {
+        return view_type(data(), size_);
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::pointer() const noexcept -> const_pointer {
+        const_pointer p;
+        std::memcpy(&p, units_ + prefix_size, sizeof(p));
+        return p;
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    std::uint32_t basic_compact_view<CharT, Traits>::prefix_word() const noexcept {
+        return detail::prefix_word(units_, prefix_size);
+    }
+
+
+    // Element access, iterators, capacity -------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::data() const noexcept -> const_pointer {
+        return is_inline() ? units_ : pointer();
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::operator[] (size_type pos) const noexcept -> const_reference {
+        return pos < prefix_size ? units_[pos] : data()[pos];
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::front() const noexcept -> const_reference {
+        return units_[0];
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::back() const noexcept -> const_reference {
+        return data()[size_ - 1];
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::begin() const noexcept -> const_iterator {
+        return data();
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::end() const noexcept -> const_iterator {
+        return data() + size_;
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::size() const noexcept -> size_type {
+        return size_;
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::length() const noexcept -> size_type {
+        return size_;
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    bool basic_compact_view<CharT, Traits>::empty() const noexcept {
+        return size_ == 0;
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    bool basic_compact_view<CharT, Traits>::is_inline() const noexcept {
+        return size_ <= inline_capacity;
+    }
+
+
+    // compare -----------------------------------------------------------------------------------------------------------------------
+
+    // With std::char_traits, different prefixes decide the order. Equal prefixes of which one is at most 4 units long
+    // mean that one is a prefix of the other (the padding is zeros), so the lengths decide; otherwise the units after
+    // the prefix do.
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    int basic_compact_view<CharT, Traits>::compare (const basic_compact_view& other) const noexcept {
+        if constexpr (std::is_same_v<Traits, std::char_traits<CharT> >) {
+            const std::uint32_t a = prefix_word();
+            const std::uint32_t b = other.prefix_word();
+            if (a != b) {
+                return a < b ? -1 : 1;
+            }
+            if (size_ > prefix_size && other.size_ > prefix_size) {
+                return view_type(data() + prefix_size, size_ - prefix_size)
+                    .compare(view_type(other.data() + prefix_size, other.size_ - prefix_size));
+            }
+            return (size_ < other.size_) ? -1 : (size_ > other.size_);
+        } else {
+            return view().compare(other.view());
+        }
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    int basic_compact_view<CharT, Traits>::compare (view_type v) const noexcept {
+        if constexpr (std::is_same_v<Traits, std::char_traits<CharT> >) {
+            const std::uint32_t a = prefix_word();
+            const std::uint32_t b = detail::prefix_word(v.data(), v.size());
+            if (a != b) {
+                return a < b ? -1 : 1;
+            }
+            if (size_ > prefix_size && v.size() > prefix_size) {
+                return view_type(data() + prefix_size, size_ - prefix_size).compare(v.substr(prefix_size));
+            }
+            return (size_ < v.size()) ? -1 : (size_ > v.size());
+        } else {
+            return view().compare(v);
+        }
+    }
+
+    // Length and prefix first, then the inline units (zero padded, so compared as bytes) or the referenced ones.
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    bool basic_compact_view<CharT, Traits>::equals (const basic_compact_view& other) const noexcept {
+        if constexpr (std::is_same_v<Traits, std::char_traits<CharT> >) {
+            if (size_ != other.size_ || std::memcmp(units_, other.units_, prefix_size) != 0) {
+                return false;
+            }
+            if (is_inline()) {
+                return std::memcmp(units_ + prefix_size, other.units_ + prefix_size, inline_capacity - prefix_size) == 0;
+            }
+            const const_pointer a = pointer();
+            const const_pointer b = other.pointer();
+            return a == b || view_type(a + prefix_size, size_ - prefix_size) == view_type(b + prefix_size, size_ - prefix_size);
+        } else {
+            return size_ == other.size_ && view() == other.view();
+        }
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    bool basic_compact_view<CharT, Traits>::starts_with (view_type v) const noexcept {
+        if (v.size() > size_) {
+            return false;
+        }
+        if (v.size() <= prefix_size) {
+            return view_type(units_, v.size()) == v;
+        }
+        return view().starts_with(v);
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    bool basic_compact_view<CharT, Traits>::ends_with (view_type v) const noexcept {
+        return view().ends_with(v);
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    bool basic_compact_view<CharT, Traits>::contains (view_type v) const noexcept {
+        return view().find(v) != npos;
+    }
+
+    template <typename CharT, typename Traits>
+    bool operator== (const basic_compact_view<CharT, Traits>& a, const basic_compact_view<CharT, Traits>& b) noexcept {
+        return a.equals(b);
+    }
+
+    template <typename CharT, typename Traits>
+    auto operator<=> (const basic_compact_view<CharT, Traits>& a, const basic_compact_view<CharT, Traits>& b) noexcept {
+        return static_cast<typename detail::comparison_category<Traits>::type>(a.compare(b) <=> 0);
+    }
+
+    template <typename CharT, typename Traits>
+    bool operator== (const basic_compact_view<CharT, Traits>& a, std::type_identity_t<basic_string_view<CharT, Traits> > b) noexcept {
+        return a.size() == b.size() && a.compare(b) == 0;
+    }
+
+    template <typename CharT, typename Traits>
+    auto operator<=> (const basic_compact_view<CharT, Traits>& a, std::type_identity_t<basic_string_view<CharT, Traits> > b) noexcept {
+        return static_cast<typename detail::comparison_category<Traits>::type>(a.compare(b) <=> 0);
+    }
+
+
+    // Searching (on the whole view) -------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::substr (size_type pos, size_type count) const -> view_type {
+        return view().substr(pos, count);
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    std::basic_string<CharT, Traits> basic_compact_view<CharT, Traits>::str() const {
+        return std::basic_string<CharT, Traits>(data(), size_);
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::find (view_type v, size_type pos) const noexcept -> size_type {
+        return view().find(v, pos);
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::find (CharT ch, size_type pos) const noexcept -> size_type {
+        return view().find(ch, pos);
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::rfind (view_type v, size_type pos) const noexcept -> size_type {
+        return view().rfind(v, pos);
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::rfind (CharT ch, size_type pos) const noexcept -> size_type {
+        return view().rfind(ch, pos);
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::find_first_of (view_type v, size_type pos) const noexcept -> size_type {
+        return view().find_first_of(v, pos);
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::find_last_of (view_type v, size_type pos) const noexcept -> size_type {
+        return view().find_last_of(v, pos);
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::find_first_not_of (view_type v, size_type pos) const noexcept -> size_type {
+        return view().find_first_not_of(v, pos);
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    auto basic_compact_view<CharT, Traits>::find_last_not_of (view_type v, size_type pos) const noexcept -> size_type {
+        return view().find_last_not_of(v, pos);
+    }
+
+} // namespace bsv
+
+#endif // COMPACT_VIEW_IMPL_HPP
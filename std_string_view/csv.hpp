@@ -0,0 +1,101 @@
+/*
+Streaming, zero-copy parser for RFC 4180 style delimited text: quoted fields may contain delimiters, newlines and
+doubled quotes (""), records end with "\n" or "\r\n".
+The input is indexed 64 bytes at a time: one vector compare each for quotes, delimiters and newlines, then the
+quoted regions are found with a prefix xor over the quote bits, carried from block to block, and masked out. The
+remaining bits are exactly the field and record boundaries, visited with a bit scan.
+Fields are string_views into the input; only fields with doubled quotes are unescaped, into a buffer owned by the
+parser, and stay valid until the next record.
+*/
+
+#ifndef CSV_HPP
+#define CSV_HPP
+
+#include "string_view.hpp"
+#include "simd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace bsv {
+    struct csv_dialect {
+        char delimiter = ',';
+        char quote = '"';
+    };
+
+    // One record: its fields, with the enclosing quotes removed and doubled quotes unescaped. A blank line is a
+    // record with one empty field. Valid until the callback that received it returns.
+    class csv_record {
+        private:
+            std::span<const string_view> fields_;
+            string_view raw_;
+
+        public:
+            csv_record (std::span<const string_view> fields, string_view raw) noexcept;
+
+            std::size_t size() const noexcept;
+            string_view operator[] (std::size_t i) const noexcept;
+            const string_view* begin() const noexcept;
+            const string_view* end() const noexcept;
+
+            // The record as it appears in the input, without its line terminator.
+            string_view raw() const noexcept;
+    };
+
+    class csv_parser {
+        public:
+            using size_type = std::size_t;
+
+        private:
+            csv_dialect dialect_;
+            std::vector<string_view> fields_;
+            std::vector<std::uint32_t> escaped_;    // indices of the fields of the current record that need unescaping
+            std::string unescaped_;
+
+            string_view finish_field (string_view raw, bool record_end);
+            template <typename F>
+            bool emit (string_view record, F& f);
+
+        public:
+            explicit csv_parser (csv_dialect dialect = {});
+
+            // Calls f(const csv_record&) for every complete record of chunk, which must start at a record boundary.
+            // Returns the number of bytes consumed: everything up to the end of the last complete record. The rest
+            // is an incomplete record; pass it again at the front of the next chunk. With last == true the rest
+            // is emitted as a final record (an unterminated quote then runs to the end of the input).
+            // f may return false to stop; the return value then ends right after that record.
+            template <typename F>
+            size_type parse (string_view chunk, bool last, F f);
+    };
+
+    // Reads records from a stream through a buffer of buffer_size bytes, carrying the incomplete record at the end
+    // of each read over to the next one. The buffer doubles when a single record does not fit.
+    class csv_reader {
+        private:
+            std::istream* in_;
+            csv_parser parser_;
+            std::vector<char> buffer_;
+
+        public:
+            explicit csv_reader (std::istream& in, csv_dialect dialect = {}, std::size_t buffer_size = 1 << 20);
+
+            // f(const csv_record&) for every record of the stream; f may return false to stop.
+            template <typename F>
+            void for_each_record (F f);
+    };
+
+} // namespace bsv
+
+#include "csv.impl.hpp"
+
+#endif // CSV_HPP
+
+/*
+Methods                           Time Complexity      Auxiliary Space
+csv_parser::parse(chunk, ...)     O(chunk)             O(fields of the largest record) + unescaped bytes
+csv_reader::for_each_record(f)    O(stream)            O(buffer_size or largest record)
+*/
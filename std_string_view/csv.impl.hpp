@@ -0,0 +1,174 @@
+#ifndef CSV_IMPL_HPP
+#define CSV_IMPL_HPP
+
+#include "csv.hpp"
+
+#include <bit>
+#include <cstring>
+#include <type_traits>
+
+namespace bsv {
+    // csv_record --------------------------------------------------------------------------------------------------------------------
+
+    inline csv_record::csv_record (std::span<const string_view> fields, string_view raw) noexcept
+        : fields_(fields), raw_(raw)
+    {}
+
+    inline std::size_t csv_record::size() const noexcept {
+        return fields_.size();
+    }
+
+    inline string_view csv_record::operator[] (std::size_t i) const noexcept {
+        return fields_[i];
+    }
+
+    inline const string_view* csv_record::begin() const noexcept {
+        return fields_.data();
+    }
+
+    inline const string_view* csv_record::end() const noexcept {
+        return fields_.data() + fields_.size();
+    }
+
+    inline string_view csv_record::raw() const noexcept {
+        return raw_;
+    }
+
+
+    // csv_parser --------------------------------------------------------------------------------------------------------------------
+
+    inline csv_parser::csv_parser (csv_dialect dialect) : dialect_(dialect) {}
+
+    // Strips the '\r' of a "\r\n" terminator and the enclosing quotes. A quote anywhere else is kept as it is.
+    inline string_view csv_parser::finish_field (string_view raw, bool record_end) {
+        if (record_end && !raw.empty() && raw.back() == '\r') {
+            raw.remove_suffix(1);
+        }
+        if (raw.size() >= 2 && raw.front() == dialect_.quote && raw.back() == dialect_.quote) {
+            raw = string_view(raw.data() + 1, raw.size() - 2);
+            if (std::memchr(raw.data(), dialect_.quote, raw.size()) != nullptr) {
+                escaped_.push_back(static_cast<std::uint32_t>(fields_.size()));
+            }
+        }
+        return raw;
+    }
+
+    // Unescapes the fields that need it into unescaped_, reserved up front so the views into it stay put.
+    template <typename F>
+    bool csv_parser::emit (string_view record, F& f) {
+        if (!escaped_.empty()) {
+            unescaped_.clear();
+            unescaped_.reserve(record.size());
+            for (const std::uint32_t i : escaped_) {
+                const string_view field = fields_[i];
+                const size_type start = unescaped_.size();
+                for (size_type k = 0; k < field.size(); ++k) {
+                    unescaped_.push_back(field[k]);
+                    k += (field[k] == dialect_.quote && k + 1 < field.size() && field[k + 1] == dialect_.quote);
+                }
+                fields_[i] = string_view(unescaped_.data() + start, unescaped_.size() - start);
+            }
+        }
+        if (!record.empty() && record.back() == '\r') {
+            record.remove_suffix(1);
+        }
+        const csv_record r(fields_, record);
+        bool go_on = true;
+        if constexpr (std::is_same_v<std::invoke_result_t<F&, const csv_record&>, bool>) {
+            go_on = f(r);
+        } else {
+            f(r);
+        }
+        fields_.clear();
+        escaped_.clear();
+        return go_on;
+    }
+
+    template <typename F>
+    auto csv_parser::parse (string_view chunk, bool last, F f) -> size_type {
+        constexpr size_type block = 64;
+        const auto* p = reinterpret_cast<const unsigned char*>(chunk.data());
+        const size_type n = chunk.size();
+        const auto quote = static_cast<unsigned char>(dialect_.quote);
+        const auto delimiter = static_cast<unsigned char>(dialect_.delimiter);
+        fields_.clear();
+        escaped_.clear();
+
+        size_type record = 0;
+        size_type field = 0;
+        std::uint64_t inside = 0;       // all ones while the previous block ended inside a quoted field
+        for (size_type base = 0; base < n; base += block) {
+            const unsigned char* bytes = p + base;
+            std::uint64_t valid = ~std::uint64_t(0);
+            unsigned char padded[block];
+            if (n - base < block) {
+                std::memset(padded, 0, block);
+                std::memcpy(padded, bytes, n - base);
+                bytes = padded;
+                valid = (std::uint64_t(1) << (n - base)) - 1;
+            }
+            const std::uint64_t quotes = simd::eq_mask64(bytes, quote);
+            const std::uint64_t newlines = simd::eq_mask64(bytes, '\n');
+            const std::uint64_t delimiters = simd::eq_mask64(bytes, delimiter);
+            const std::uint64_t quoted = simd::prefix_xor(quotes) ^ inside;
+            inside = static_cast<std::uint64_t>(static_cast<std::int64_t>(quoted) >> 63);
+
+            for (std::uint64_t bits = (delimiters | newlines) & ~quoted & valid; bits != 0; bits &= bits - 1) {
+                const size_type pos = base + std::countr_zero(bits);
+                const bool record_end = p[pos] == '\n';
+                fields_.push_back(finish_field(string_view(chunk.data() + field, pos - field), record_end));
+                field = pos + 1;
+                if (record_end) {
+                    if (!emit(string_view(chunk.data() + record, pos - record), f)) {
+                        return field;
+                    }
+                    record = field;
+                }
+            }
+        }
+        if (last && record < n) {
+            fields_.push_back(finish_field(string_view(chunk.data() + field, n - field), true));
+            emit(string_view(chunk.data() + record, n - record), f);
+            return n;
+        }
+        return record;
+    }
+
+
+    // csv_reader --------------------------------------------------------------------------------------------------------------------
+
+    inline csv_reader::csv_reader (std::istream& in, csv_dialect dialect, std::size_t buffer_size)
+        : in_(&in), parser_(dialect), buffer_(buffer_size == 0 ? 1 : buffer_size)
+    {}
+
+    template <typename F>
+    void csv_reader::for_each_record (F f) {
+        bool stop = false;
+        const auto forward = [&f, &stop](const csv_record& r) {
+            if constexpr (std::is_same_v<std::invoke_result_t<F&, const csv_record&>, bool>) {
+                stop = !f(r);
+            } else {
+                f(r);
+            }
+            return !stop;
+        };
+        std::size_t filled = 0;
+        for (;;) {
+            in_->read(buffer_.data() + filled, static_cast<std::streamsize>(buffer_.size() - filled));
+            filled += static_cast<std::size_t>(in_->gcount());
+            const bool eof = !*in_;
+            const std::size_t consumed = parser_.parse(string_view(buffer_.data(), filled), eof, forward);
+            if (stop || eof) {
+                return;
+            }
+            std::memmove(buffer_.data(), buffer_.data() + consumed, filled - consumed);
+            filled -= consumed;
+            if (filled == buffer_.size()) {
+                buffer_.resize(2 * buffer_.size());
+            }
+        }
+    }
+
+} // namespace bsv
+
+#endif // CSV_IMPL_HPP
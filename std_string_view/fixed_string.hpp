@@ -0,0 +1,66 @@
+/*
+Searches for needles known at compile time: bsv::find<"Content-Length:">(v), starts_with, ends_with and contains.
+The needle is a basic_fixed_string template argument (a structural type, deduced from the string literal), so every
+instantiation is specialised for its length and units: the candidate positions are those where the needle's first and
+last units, broadcast into vector constants, match (the vector kernels of simd_units.hpp, picked by CPU at run time),
+and a candidate is verified by comparing the whole needle with overlapping fixed-width word loads against constants,
+with no loop or length check left once the compiler has unrolled it.
+Only std::char_traits (bitwise equality); other traits fall back to basic_string_view::find.
+*/
+
+#ifndef FIXED_STRING_HPP
+#define FIXED_STRING_HPP
+
+#include "string_view.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <string>
+
+namespace bsv {
+    // A string literal as a template argument. Its members are public, as structural types require.
+    template <typename CharT, std::size_t N>
+    struct basic_fixed_string {
+        using value_type = CharT;
+
+        CharT chars[N + 1] = {};
+
+        constexpr basic_fixed_string (const CharT (&s)[N + 1]) noexcept;
+
+        static constexpr std::size_t size() noexcept;
+        constexpr const CharT* data() const noexcept;
+        constexpr basic_string_view<CharT> view() const noexcept;
+    };
+
+    template <typename CharT, std::size_t M>
+    basic_fixed_string (const CharT (&)[M]) -> basic_fixed_string<CharT, M - 1>;
+
+    // The unit type of a needle must be that of the view.
+    template <auto Needle, typename CharT>
+    concept fixed_needle_for = std::same_as<typename decltype(Needle)::value_type, CharT>;
+
+    // v.find(Needle, pos).
+    template <basic_fixed_string Needle, typename CharT, typename Traits> requires fixed_needle_for<Needle, CharT>
+    constexpr std::size_t find (basic_string_view<CharT, Traits> v, std::size_t pos = 0) noexcept;
+
+    template <basic_fixed_string Needle, typename CharT, typename Traits> requires fixed_needle_for<Needle, CharT>
+    constexpr bool contains (basic_string_view<CharT, Traits> v) noexcept;
+
+    template <basic_fixed_string Needle, typename CharT, typename Traits> requires fixed_needle_for<Needle, CharT>
+    constexpr bool starts_with (basic_string_view<CharT, Traits> v) noexcept;
+
+    template <basic_fixed_string Needle, typename CharT, typename Traits> requires fixed_needle_for<Needle, CharT>
+    constexpr bool ends_with (basic_string_view<CharT, Traits> v) noexcept;
+
+} // namespace bsv
+
+#include "fixed_string.impl.hpp"
+
+#endif // FIXED_STRING_HPP
+
+/*
+Methods                       Time Complexity                  Auxiliary Space
+find<Needle>(v, pos)          O(n * m) worst, O(n) typical      O(1)
+contains<Needle>(v)           O(n * m) worst, O(n) typical      O(1)
+starts_with / ends_with       O(m), unrolled                   O(1)
+*/
@@ -0,0 +1,140 @@
+#ifndef FIXED_STRING_IMPL_HPP
+#define FIXED_STRING_IMPL_HPP
+
+#include "fixed_string.hpp"
+#include "simd_units.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace bsv {
+    // basic_fixed_string ------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, std::size_t N>
+    constexpr basic_fixed_string<CharT, N>::basic_fixed_string (const CharT (&s)[N + 1]) noexcept {
+        for (std::size_t i = 0; i < N; ++i) {
+            chars[i] = s[i];
+        }
+    }
+
+    template <typename CharT, std::size_t N>
+    constexpr std::size_t basic_fixed_string<CharT, N>::size() noexcept {
+        return N;
+    }
+
+    template <typename CharT, std::size_t N>
+    constexpr const CharT* basic_fixed_string<CharT, N>::data() const noexcept {
+        return chars;
+    }
+
+    template <typename CharT, std::size_t N>
+    constexpr basic_string_view<CharT> basic_fixed_string<CharT, N>::view() const noexcept {
+        return basic_string_view<CharT>(chars, N);
+    }
+
+
+    // Kernels -----------------------------------------------------------------------------------------------------------------------
+
+    namespace detail {
+        // Whether the units at p are Needle's. Its bytes are covered by words of the widest size that fits (the last one
+        // overlapping the previous where the size is not a multiple), each compared with a constant; the differences are
+        // or'ed together, so the whole comparison is straight-line code.
+        template <auto Needle, typename CharT>
+        inline bool fixed_equal (const CharT* p) noexcept {
+            constexpr std::size_t bytes = Needle.size() * sizeof(CharT);
+            const auto* a = reinterpret_cast<const unsigned char*>(p);
+            const auto* b = reinterpret_cast<const unsigned char*>(Needle.chars);
+            const auto differs = [a, b] (std::size_t at, auto word) -> decltype(word) {
+                decltype(word) x, y;
+                std::memcpy(&x, a + at, sizeof(x));
+                std::memcpy(&y, b + at, sizeof(y));
+                return x ^ y;
+            };
+            const auto covered = [&] (auto word) {
+                constexpr std::size_t w = sizeof(word);
+                return [&]<std::size_t... I> (std::index_sequence<I...>) {
+                    return (differs(I * w, word) | ... | differs(bytes - w, word)) == 0;
+                }(std::make_index_sequence<(bytes - 1) / w>());
+            };
+            if constexpr (bytes >= 8) {
+                return covered(std::uint64_t());
+            } else if constexpr (bytes >= 4) {
+                return covered(std::uint32_t());
+            } else if constexpr (bytes >= 2) {
+                return covered(std::uint16_t());
+            } else {
+                return bytes == 0 || a[0] == b[0];
+            }
+        }
+
+        template <auto Needle>
+        struct fixed_search_body {
+            template <typename Ops, typename T>
+            static std::size_t run (const T* hay, std::size_t n) noexcept {
+                constexpr std::size_t m = Needle.size();
+                return simd::units::detail::search_candidates<Ops>(hay, n, m, Needle.chars[0], Needle.chars[m - 1],
+                                                                    [hay] (std::size_t at) { return fixed_equal<Needle>(hay + at); });
+            }
+        };
+
+        template <typename Traits, typename CharT>
+        constexpr bool bitwise_traits = std::is_same_v<Traits, std::char_traits<CharT> > && simd::units::code_unit<CharT>;
+    }
+
+
+    // Searches ----------------------------------------------------------------------------------------------------------------------
+
+    template <basic_fixed_string Needle, typename CharT, typename Traits> requires fixed_needle_for<Needle, CharT>
+    constexpr std::size_t find (basic_string_view<CharT, Traits> v, std::size_t pos) noexcept {
+        constexpr std::size_t m = Needle.size();
+        if constexpr (detail::bitwise_traits<Traits, CharT>) {
+            if (!std::is_constant_evaluated()) {
+                if (pos > v.size() || v.size() - pos < m) {
+                    return v.npos;
+                }
+                const CharT* hay = v.data() + pos;
+                const std::size_t n = v.size() - pos;
+                std::size_t i;
+                if constexpr (m == 0) {
+                    return pos;
+                } else if constexpr (m == 1) {
+                    i = simd::units::find(hay, n, Needle.chars[0]);
+                } else {
+                    i = simd::units::detail::dispatch<detail::fixed_search_body<Needle>, sizeof(CharT)>(hay, n);
+                }
+                return i == n ? v.npos : pos + i;
+            }
+        }
+        return v.find(basic_string_view<CharT, Traits>(Needle.chars, m), pos);
+    }
+
+    template <basic_fixed_string Needle, typename CharT, typename Traits> requires fixed_needle_for<Needle, CharT>
+    constexpr bool contains (basic_string_view<CharT, Traits> v) noexcept {
+        return find<Needle>(v) != v.npos;
+    }
+
+    template <basic_fixed_string Needle, typename CharT, typename Traits> requires fixed_needle_for<Needle, CharT>
+    constexpr bool starts_with (basic_string_view<CharT, Traits> v) noexcept {
+        if constexpr (detail::bitwise_traits<Traits, CharT>) {
+            if (!std::is_constant_evaluated()) {
+                return v.size() >= Needle.size() && detail::fixed_equal<Needle>(v.data());
+            }
+        }
+        return v.starts_with(basic_string_view<CharT, Traits>(Needle.chars, Needle.size()));
+    }
+
+    template <basic_fixed_string Needle, typename CharT, typename Traits> requires fixed_needle_for<Needle, CharT>
+    constexpr bool ends_with (basic_string_view<CharT, Traits> v) noexcept {
+        if constexpr (detail::bitwise_traits<Traits, CharT>) {
+            if (!std::is_constant_evaluated()) {
+                return v.size() >= Needle.size() && detail::fixed_equal<Needle>(v.data() + v.size() - Needle.size());
+            }
+        }
+        return v.ends_with(basic_string_view<CharT, Traits>(Needle.chars, Needle.size()));
+    }
+
+} // namespace bsv
+
+#endif // FIXED_STRING_IMPL_HPP
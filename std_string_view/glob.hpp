@@ -0,0 +1,196 @@
+/*
+Glob patterns over basic_string_view, compiled once and matched without backtracking: `*`, `?`, `[a-z]` / `[!a-z]`
+classes, `\` escapes and, on paths, `**` for any number of directories.
+In glob_mode::path the pattern and the text are cut at '/' into components: `*`, `?` and classes stay within a component,
+and a component made of two or more stars and nothing else (`**`, `***`) matches zero or more whole components of the
+text. In glob_mode::text '/' is an ordinary unit and `**` is `*`.
+Each component is compiled into pieces of fixed length (literal runs, `?` and classes) separated by stars. A star can take
+any run, so the first piece is matched at the start, the last one at the end and every piece between at its leftmost
+position after the previous one: no choice is ever revisited. A piece is located through basic_string_view::find on its
+longest literal run, then checked at the position found. The components between two `**` are placed the same way, at
+the leftmost run of components they match.
+glob::matches first compares the text with the pattern's literal prefix (its leading literal components and the literal
+start of the next one), then cuts the text one component at a time as they are matched: forwards up to the first `**`,
+backwards from the end down to the last one, forwards again in between. A text that fails early is never cut further.
+basic_glob_set matches a path against many globs at once. The globs sit in a trie of their leading literal components;
+the path is cut into components once, walks down the trie, and only the globs met on the way whose component count fits
+are tried, in id order.
+*/
+
+// For example, in glob_mode::path "/api/**" matches "/api", "/api/" and "/api/v1/users", and a glob_set files
+// "/api/v1/users/*" under "", "api", "v1", "users".
+
+#ifndef GLOB_HPP
+#define GLOB_HPP
+
+#include "string_view.hpp"
+#include "string_map.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace bsv {
+    enum class glob_mode { path, text };
+
+    template <typename CharT, typename Traits>
+    class basic_glob_set;
+
+    namespace detail {
+        // The components of a text, cut at '/' in glob_mode::path (the whole text otherwise). Paths of up to inline_count
+        // components need no allocation; the inline slots are left uninitialized until a component is stored in them.
+        template <typename View>
+        class glob_components {
+            private:
+                static constexpr std::size_t inline_count = 32;
+
+                alignas(View) std::byte inline_[inline_count * sizeof(View)];
+                std::vector<View> heap_;
+                std::size_t size_ = 0;
+
+            public:
+                glob_components (View text, glob_mode mode);
+                glob_components (const glob_components&) = delete;
+                glob_components& operator= (const glob_components&) = delete;
+
+                const View* data() const noexcept;
+                std::size_t size() const noexcept;
+        };
+    }
+
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class basic_glob {
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using size_type = std::size_t;
+
+        private:
+            enum class atom_kind : std::uint8_t { literal, any, set };
+
+            // literal: units_[first, first + count); set: ranges_[first, first + count).
+            struct atom {
+                atom_kind kind;
+                bool negated;
+                std::uint32_t first;
+                std::uint32_t count;
+            };
+
+            // atoms_[first, last), `length` units of text; `anchor` is the index of its longest literal atom (or last if it
+            // has none), at `anchor_offset` units from its start.
+            struct piece {
+                std::uint32_t first;
+                std::uint32_t last;
+                std::uint32_t length;
+                std::uint32_t anchor;
+                std::uint32_t anchor_offset;
+            };
+
+            // pieces_[first, last), with a star before the first piece (lead), after the last one (trail) and between any
+            // two. A globstar component is a `**` of its own in glob_mode::path.
+            struct component {
+                std::uint32_t first;
+                std::uint32_t last;
+                bool lead;
+                bool trail;
+                bool globstar;
+            };
+
+            glob_mode mode_;
+            std::vector<CharT> units_;
+            std::vector<std::pair<CharT, CharT> > ranges_;
+            std::vector<atom> atoms_;
+            std::vector<piece> pieces_;
+            std::vector<component> components_;
+            std::vector<CharT> prefix_;             // units every matching text starts with
+            size_type fixed_components_ = 0;        // components other than `**`
+            bool has_globstar_ = false;
+
+            friend class basic_glob_set<CharT, Traits>;
+
+        public:
+            // Throws std::invalid_argument on an unterminated class or a trailing '\'.
+            explicit basic_glob (view_type pattern, glob_mode mode = glob_mode::path);
+
+        public:
+            bool matches (view_type text) const;
+
+            glob_mode mode() const noexcept;
+
+        private:
+            void compile (view_type pattern);
+            size_type parse_set (view_type pattern, size_type i);
+            void add_literal (CharT ch);
+            void close_piece (std::uint32_t first_atom);
+            void compute_prefix();
+
+            bool literal_component (size_type i, view_type& literal) const noexcept;
+            bool matches_components (const view_type* texts, size_type n) const noexcept;
+            bool matches_component (const component& c, view_type text) const noexcept;
+            bool piece_at (const piece& p, view_type text, size_type pos) const noexcept;
+            size_type find_piece (const piece& p, view_type text, size_type from) const noexcept;
+            bool in_set (const atom& a, CharT ch) const noexcept;
+    };
+
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class basic_glob_set {
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using glob_type = basic_glob<CharT, Traits>;
+            using size_type = std::size_t;
+
+            static constexpr size_type npos = view_type::npos;
+
+        private:
+            static constexpr size_type max_depth = 32;
+
+            // The globs whose literal prefix ends here, by increasing id, and the next literal components.
+            struct node {
+                std::vector<std::uint32_t> globs;
+                basic_string_map<std::uint32_t, CharT, Traits> children;
+            };
+
+            glob_mode mode_;
+            std::vector<glob_type> globs_;
+            std::vector<node> nodes_;
+
+        public:
+            explicit basic_glob_set (glob_mode mode = glob_mode::path);
+
+        public:
+            // Compiles pattern and returns its id, the number of globs added before it.
+            size_type add (view_type pattern);
+
+            size_type size() const noexcept;
+            const glob_type& operator[] (size_type id) const noexcept;
+
+            // The smallest id of a glob matching text, or npos.
+            size_type match (view_type text) const;
+
+            // The ids of all the globs matching text, in increasing order.
+            template <typename OutputIt>
+            OutputIt match_all (view_type text, OutputIt out) const;
+
+        private:
+            // Calls f(id) for the candidates for a text cut into parts, in increasing id order, until f returns true.
+            template <typename F>
+            void for_each_candidate (const detail::glob_components<view_type>& parts, F f) const;
+    };
+
+    using glob = basic_glob<char>;
+    using glob_set = basic_glob_set<char>;
+
+} // namespace bsv
+
+#include "glob.impl.hpp"
+
+#endif // GLOB_HPP
+
+/*
+Methods                       Time Complexity                  Auxiliary Space
+basic_glob(pattern)           O(m)                             O(m)
+glob::matches(text)           O(n) typical, O(n * m) worst     O(1)
+glob_set::add(pattern)        O(m)                             O(m)
+glob_set::match(text)         O(n + candidates * n) typical    O(components) beyond 32, candidates: globs on the trie path
+*/
@@ -0,0 +1,567 @@
+#ifndef GLOB_IMPL_HPP
+#define GLOB_IMPL_HPP
+
+#include "glob.hpp"
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+namespace bsv {
+    // glob_components ---------------------------------------------------------------------------------------------------------------
+
+    namespace detail {
+        template <typename View>
+        glob_components<View>::glob_components (View text, glob_mode mode) {
+            const auto push = [this](View part) {
+                if (size_ < inline_count) {
+                    ::new (static_cast<void*>(inline_ + size_ * sizeof(View))) View(part);
+                } else {
+                    if (size_ == inline_count) {
+                        heap_.assign(data(), data() + inline_count);
+                    }
+                    heap_.push_back(part);
+                }
+                ++size_;
+            };
+            if (mode == glob_mode::text) {
+                push(text);
+                return;
+            }
+            using char_type = typename View::value_type;
+            std::size_t from = 0;
+            for (std::size_t slash = text.find(char_type('/')); slash != View::npos; slash = text.find(char_type('/'), from)) {
+                push(View(text.data() + from, slash - from));
+                from = slash + 1;
+            }
+            push(View(text.data() + from, text.size() - from));
+        }
+
+        template <typename View>
+        const View* glob_components<View>::data() const noexcept {
+            return size_ <= inline_count ? std::launder(reinterpret_cast<const View*>(inline_)) : heap_.data();
+        }
+
+        template <typename View>
+        std::size_t glob_components<View>::size() const noexcept {
+            return size_;
+        }
+    } // namespace detail
+
+
+    // Compilation -------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    basic_glob<CharT, Traits>::basic_glob (view_type pattern, glob_mode mode) : mode_(mode) {
+        compile(pattern);
+    }
+
+    template <typename CharT, typename Traits>
+    void basic_glob<CharT, Traits>::compile (view_type pattern) {
+        const bool path = mode_ == glob_mode::path;
+        const auto is = [](CharT ch, char c) { return Traits::eq(ch, CharT(c)); };
+        component cur {0, 0, false, false, false};
+        std::uint32_t piece_atoms = 0;                  // first atom of the open piece
+        const auto finish = [&] {
+            close_piece(piece_atoms);
+            cur.last = static_cast<std::uint32_t>(pieces_.size());
+            // A `**` right after another matches nothing more.
+            if (!(cur.globstar && !components_.empty() && components_.back().globstar)) {
+                components_.push_back(cur);
+                fixed_components_ += !cur.globstar;
+                has_globstar_ |= cur.globstar;
+            }
+            cur = component {cur.last, cur.last, false, false, false};
+            piece_atoms = static_cast<std::uint32_t>(atoms_.size());
+        };
+
+        for (size_type i = 0; i < pattern.size(); ++i) {
+            const CharT ch = pattern[i];
+            if (path && is(ch, '/')) {
+                finish();
+            } else if (is(ch, '*')) {
+                const size_type run = i;
+                while (i + 1 < pattern.size() && is(pattern[i + 1], '*')) {
+                    ++i;
+                }
+                const bool alone = cur.first == pieces_.size() && piece_atoms == atoms_.size() && !cur.lead;
+                const bool ends = i + 1 == pattern.size() || is(pattern[i + 1], '/');
+                if (path && i > run && alone && ends) {
+                    cur.globstar = true;
+                    continue;
+                }
+                close_piece(piece_atoms);
+                piece_atoms = static_cast<std::uint32_t>(atoms_.size());
+                if (pieces_.size() == cur.first) {
+                    cur.lead = true;
+                } else {
+                    cur.trail = true;
+                }
+            } else {
+                cur.trail = false;
+                if (is(ch, '?')) {
+                    atoms_.push_back(atom {atom_kind::any, false, 0, 1});
+                } else if (is(ch, '[')) {
+                    i = parse_set(pattern, i);
+                } else if (is(ch, '\\')) {
+                    if (++i == pattern.size()) {
+                        throw std::invalid_argument("basic_glob: trailing backslash");
+                    }
+                    add_literal(pattern[i]);
+                } else {
+                    add_literal(ch);
+                }
+            }
+        }
+        finish();
+        compute_prefix();
+    }
+
+    // The leading literal components joined by '/', then the literal start of the first component that is not literal. It
+    // stops short of the '/' before a `**`, which can match no component at all ("/api/**" matches "/api").
+    template <typename CharT, typename Traits>
+    void basic_glob<CharT, Traits>::compute_prefix() {
+        view_type literal;
+        for (size_type c = 0; c < components_.size(); ++c) {
+            if (!literal_component(c, literal)) {
+                const component& k = components_[c];
+                if (!k.globstar && !k.lead && k.first != k.last) {
+                    const piece& p = pieces_[k.first];
+                    for (std::uint32_t a = p.first; a < p.last && atoms_[a].kind == atom_kind::literal; ++a) {
+                        prefix_.insert(prefix_.end(), units_.begin() + atoms_[a].first, units_.begin() + atoms_[a].first + atoms_[a].count);
+                    }
+                }
+                return;
+            }
+            prefix_.insert(prefix_.end(), literal.begin(), literal.end());
+            if (c + 1 == components_.size() || components_[c + 1].globstar) {
+                return;
+            }
+            prefix_.push_back(CharT('/'));
+        }
+    }
+
+    // Parses the class opened at pattern[i] and returns the index of its ']'. A ']' first in the class is a member, and so
+    // is a '-' first or last.
+    template <typename CharT, typename Traits>
+    std::size_t basic_glob<CharT, Traits>::parse_set (view_type pattern, size_type i) {
+        const auto is = [](CharT ch, char c) { return Traits::eq(ch, CharT(c)); };
+        const auto unterminated = [] { return std::invalid_argument("basic_glob: unterminated character class"); };
+        atom a {atom_kind::set, false, static_cast<std::uint32_t>(ranges_.size()), 0};
+        ++i;
+        if (i < pattern.size() && (is(pattern[i], '!') || is(pattern[i], '^'))) {
+            a.negated = true;
+            ++i;
+        }
+        const auto unit = [&] {
+            if (is(pattern[i], '\\') && ++i == pattern.size()) {
+                throw unterminated();
+            }
+            return pattern[i++];
+        };
+        for (bool first = true; ; first = false) {
+            if (i == pattern.size()) {
+                throw unterminated();
+            }
+            if (!first && is(pattern[i], ']')) {
+                break;
+            }
+            const CharT lo = unit();
+            CharT hi = lo;
+            if (i + 1 < pattern.size() && is(pattern[i], '-') && !is(pattern[i + 1], ']')) {
+                ++i;
+                hi = unit();
+            }
+            ranges_.emplace_back(lo, hi);
+        }
+        a.count = static_cast<std::uint32_t>(ranges_.size()) - a.first;
+        atoms_.push_back(a);
+        return i;
+    }
+
+    template <typename CharT, typename Traits>
+    void basic_glob<CharT, Traits>::add_literal (CharT ch) {
+        // Extends the literal atom before it, whose units are the last ones.
+        if (!atoms_.empty() && atoms_.back().kind == atom_kind::literal && atoms_.back().first + atoms_.back().count == units_.size()
+            && !(pieces_.size() > 0 && pieces_.back().last == atoms_.size())) {
+            ++atoms_.back().count;
+        } else {
+            atoms_.push_back(atom {atom_kind::literal, false, static_cast<std::uint32_t>(units_.size()), 1});
+        }
+        units_.push_back(ch);
+    }
+
+    template <typename CharT, typename Traits>
+    void basic_glob<CharT, Traits>::close_piece (std::uint32_t first_atom) {
+        const std::uint32_t last_atom = static_cast<std::uint32_t>(atoms_.size());
+        if (first_atom == last_atom) {
+            return;
+        }
+        piece p {first_atom, last_atom, 0, last_atom, 0};
+        std::uint32_t longest = 0;
+        for (std::uint32_t a = first_atom; a < last_atom; ++a) {
+            if (atoms_[a].kind == atom_kind::literal && atoms_[a].count > longest) {
+                longest = atoms_[a].count;
+                p.anchor = a;
+                p.anchor_offset = p.length;
+            }
+            p.length += atoms_[a].kind == atom_kind::literal ? atoms_[a].count : 1;
+        }
+        pieces_.push_back(p);
+    }
+
+
+    // Matching ----------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    bool basic_glob<CharT, Traits>::in_set (const atom& a, CharT ch) const noexcept {
+        bool in = false;
+        for (std::uint32_t r = a.first; r < a.first + a.count && !in; ++r) {
+            in = !Traits::lt(ch, ranges_[r].first) && !Traits::lt(ranges_[r].second, ch);
+        }
+        return in != a.negated;
+    }
+
+    template <typename CharT, typename Traits>
+    bool basic_glob<CharT, Traits>::piece_at (const piece& p, view_type text, size_type pos) const noexcept {
+        const CharT* s = text.data() + pos;
+        for (std::uint32_t i = p.first; i < p.last; ++i) {
+            const atom& a = atoms_[i];
+            if (a.kind == atom_kind::literal) {
+                if (Traits::compare(s, units_.data() + a.first, a.count) != 0) {
+                    return false;
+                }
+                s += a.count;
+            } else {
+                if (a.kind == atom_kind::set && !in_set(a, *s)) {
+                    return false;
+                }
+                ++s;
+            }
+        }
+        return true;
+    }
+
+    // The leftmost position at or after from where p matches within text, or npos.
+    template <typename CharT, typename Traits>
+    std::size_t basic_glob<CharT, Traits>::find_piece (const piece& p, view_type text, size_type from) const noexcept {
+        if (text.size() < p.length) {
+            return view_type::npos;
+        }
+        const size_type last = text.size() - p.length;
+        if (p.anchor == p.last) {
+            for (size_type pos = from; pos <= last; ++pos) {
+                if (piece_at(p, text, pos)) {
+                    return pos;
+                }
+            }
+            return view_type::npos;
+        }
+        const atom& a = atoms_[p.anchor];
+        const view_type literal(units_.data() + a.first, a.count);
+        const view_type window(text.data(), last + p.anchor_offset + a.count);
+        for (size_type pos = from; pos <= last; ++pos) {
+            const size_type hit = window.find(literal, pos + p.anchor_offset);
+            if (hit == view_type::npos) {
+                return view_type::npos;
+            }
+            pos = hit - p.anchor_offset;
+            if (piece_at(p, text, pos)) {
+                return pos;
+            }
+        }
+        return view_type::npos;
+    }
+
+    template <typename CharT, typename Traits>
+    bool basic_glob<CharT, Traits>::matches_component (const component& c, view_type text) const noexcept {
+        const piece* first = pieces_.data() + c.first;
+        const piece* last = pieces_.data() + c.last;
+        if (first == last) {
+            return c.lead || text.empty();
+        }
+        size_type pos = 0;
+        if (!c.lead) {
+            if (text.size() < first->length || !piece_at(*first, text, 0)) {
+                return false;
+            }
+            pos = first->length;
+            ++first;
+            if (first == last && !c.trail) {
+                return pos == text.size();
+            }
+        }
+        if (!c.trail) {
+            --last;
+            if (text.size() - pos < last->length || !piece_at(*last, text, text.size() - last->length)) {
+                return false;
+            }
+            text = view_type(text.data(), text.size() - last->length);
+        }
+        for (; first != last; ++first) {
+            pos = find_piece(*first, text, pos);
+            if (pos == view_type::npos) {
+                return false;
+            }
+            pos += first->length;
+        }
+        return true;
+    }
+
+    // The same placement one level up: the components before the first `**` at the start, those after the last one at the
+    // end, and every run between two `**` at its leftmost place.
+    template <typename CharT, typename Traits>
+    bool basic_glob<CharT, Traits>::matches_components (const view_type* texts, size_type n) const noexcept {
+        const auto run_at = [&](size_type c, size_type c_end, size_type at) {
+            for (; c < c_end; ++c, ++at) {
+                if (!matches_component(components_[c], texts[at])) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        if (!has_globstar_) {
+            return n == components_.size() && run_at(0, n, 0);
+        }
+        if (n < fixed_components_) {
+            return false;
+        }
+        size_type c = 0;
+        while (!components_[c].globstar) {
+            ++c;
+        }
+        size_type c_last = components_.size() - 1;
+        while (!components_[c_last].globstar) {
+            --c_last;
+        }
+        const size_type tail = components_.size() - 1 - c_last;
+        if (!run_at(0, c, 0) || !run_at(c_last + 1, components_.size(), n - tail)) {
+            return false;
+        }
+        size_type at = c;
+        const size_type limit = n - tail;
+        while (c < c_last) {
+            size_type c_end = c + 1;
+            while (!components_[c_end].globstar) {
+                ++c_end;
+            }
+            const size_type k = c_end - c - 1;
+            for (;; ++at) {
+                if (at + k > limit) {
+                    return false;
+                }
+                if (run_at(c + 1, c_end, at)) {
+                    break;
+                }
+            }
+            at += k;
+            c = c_end;
+        }
+        return true;
+    }
+
+    // Whether component i comes before any `**` and matches exactly one text, stored into literal.
+    template <typename CharT, typename Traits>
+    bool basic_glob<CharT, Traits>::literal_component (size_type i, view_type& literal) const noexcept {
+        for (size_type c = 0; c <= i; ++c) {
+            if (c == components_.size() || components_[c].globstar) {
+                return false;
+            }
+        }
+        const component& c = components_[i];
+        if (c.lead || c.trail || c.last - c.first > 1) {
+            return false;
+        }
+        if (c.first == c.last) {
+            literal = view_type();
+            return true;
+        }
+        const piece& p = pieces_[c.first];
+        const atom& a = atoms_[p.first];
+        if (p.last - p.first != 1 || a.kind != atom_kind::literal) {
+            return false;
+        }
+        literal = view_type(units_.data() + a.first, a.count);
+        return true;
+    }
+
+    // matches_components on a text that is cut as it goes. from is where the next component starts (npos once the text is
+    // used up), and the components after the last `**` are cut from the end of the text, which then shrinks to what is
+    // left for the runs between the `**`.
+    template <typename CharT, typename Traits>
+    bool basic_glob<CharT, Traits>::matches (view_type text) const {
+        if (!text.starts_with(view_type(prefix_.data(), prefix_.size()))) {
+            return false;
+        }
+        if (mode_ == glob_mode::text) {
+            return matches_component(components_[0], text);
+        }
+        const CharT slash('/');
+        size_type from = 0;
+        const auto next = [&] {
+            const size_type end = text.find(slash, from);
+            const view_type part(text.data() + from, (end == view_type::npos ? text.size() : end) - from);
+            from = end == view_type::npos ? view_type::npos : end + 1;
+            return part;
+        };
+
+        size_type c = 0;
+        for (; c < components_.size() && !components_[c].globstar; ++c) {
+            if (from == view_type::npos || !matches_component(components_[c], next())) {
+                return false;
+            }
+        }
+        if (!has_globstar_) {
+            return from == view_type::npos;
+        }
+
+        size_type c_last = components_.size() - 1;
+        for (; !components_[c_last].globstar; --c_last) {
+            // The last component not cut yet must not reach back into those matched above.
+            const size_type end = text.size() == 0 ? view_type::npos : text.rfind(slash, text.size() - 1);
+            const size_type start = end == view_type::npos ? 0 : end + 1;
+            if (from == view_type::npos || start < from 
+                || !matches_component(components_[c_last], view_type(text.data() + start, text.size() - start))) {
+                return false;
+            }
+            if (start == from) {
+                from = view_type::npos;
+            } else {
+                text = view_type(text.data(), end);
+            }
+        }
+
+        while (c < c_last) {
+            size_type c_end = c + 1;
+            while (!components_[c_end].globstar) {
+                ++c_end;
+            }
+            // The leftmost run of components that c + 1 .. c_end - 1 match, tried one start after the other.
+            for (size_type at = from;;) {
+                size_type j = c + 1;
+                while (j < c_end && from != view_type::npos && matches_component(components_[j], next())) {
+                    ++j;
+                }
+                if (j == c_end) {
+                    break;
+                }
+                if (from == view_type::npos) {
+                    return false;
+                }
+                from = at;
+                next();
+                at = from;
+            }
+            c = c_end;
+        }
+        return true;
+    }
+
+    template <typename CharT, typename Traits>
+    glob_mode basic_glob<CharT, Traits>::mode() const noexcept {
+        return mode_;
+    }
+
+
+    // basic_glob_set ----------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    basic_glob_set<CharT, Traits>::basic_glob_set (glob_mode mode) : mode_(mode), nodes_(1) {}
+
+    template <typename CharT, typename Traits>
+    std::size_t basic_glob_set<CharT, Traits>::add (view_type pattern) {
+        const auto id = static_cast<std::uint32_t>(globs_.size());
+        const glob_type& g = globs_.emplace_back(pattern, mode_);
+        std::uint32_t at = 0;
+        view_type literal;
+        for (size_type i = 0; i < max_depth && g.literal_component(i, literal); ++i) {
+            const auto [it, added] = nodes_[at].children.try_emplace(literal, static_cast<std::uint32_t>(nodes_.size()));
+            at = it->second;
+            if (added) {
+                nodes_.emplace_back();
+            }
+        }
+        nodes_[at].globs.push_back(id);
+        return id;
+    }
+
+    template <typename CharT, typename Traits>
+    std::size_t basic_glob_set<CharT, Traits>::size() const noexcept {
+        return globs_.size();
+    }
+
+    template <typename CharT, typename Traits>
+    const basic_glob<CharT, Traits>& basic_glob_set<CharT, Traits>::operator[] (size_type id) const noexcept {
+        return globs_[id];
+    }
+
+    template <typename CharT, typename Traits>
+    template <typename F>
+    void basic_glob_set<CharT, Traits>::for_each_candidate (const detail::glob_components<view_type>& parts, F f) const {
+        // The glob lists met on the trie path, merged by id.
+        using cursor = std::pair<const std::uint32_t*, const std::uint32_t*>;
+        std::array<cursor, max_depth + 1> lists;
+        size_type k = 0;
+        std::uint32_t at = 0;
+        for (size_type i = 0; ; ++i) {
+            const std::vector<std::uint32_t>& globs = nodes_[at].globs;
+            if (!globs.empty()) {
+                lists[k++] = cursor(globs.data(), globs.data() + globs.size());
+            }
+            if (i == parts.size() || i == max_depth) {
+                break;
+            }
+            const auto it = nodes_[at].children.find(parts.data()[i]);
+            if (it == nodes_[at].children.end()) {
+                break;
+            }
+            at = it->second;
+        }
+        const size_type n = parts.size();
+        while (k > 0) {
+            size_type min = 0;
+            for (size_type j = 1; j < k; ++j) {
+                min = *lists[j].first < *lists[min].first ? j : min;
+            }
+            const std::uint32_t id = *lists[min].first++;
+            if (lists[min].first == lists[min].second) {
+                lists[min] = lists[--k];
+            }
+            const glob_type& g = globs_[id];
+            const bool fits = g.has_globstar_ ? n >= g.fixed_components_ : n == g.components_.size();
+            if (fits && f(id)) {
+                return;
+            }
+        }
+    }
+
+    template <typename CharT, typename Traits>
+    std::size_t basic_glob_set<CharT, Traits>::match (view_type text) const {
+        const detail::glob_components<view_type> parts(text, mode_);
+        size_type found = npos;
+        for_each_candidate(parts, [&](std::uint32_t id) {
+            if (globs_[id].matches_components(parts.data(), parts.size())) {
+                found = id;
+                return true;
+            }
+            return false;
+        });
+        return found;
+    }
+
+    template <typename CharT, typename Traits>
+    template <typename OutputIt>
+    OutputIt basic_glob_set<CharT, Traits>::match_all (view_type text, OutputIt out) const {
+        const detail::glob_components<view_type> parts(text, mode_);
+        for_each_candidate(parts, [&](std::uint32_t id) {
+            if (globs_[id].matches_components(parts.data(), parts.size())) {
+                *out++ = size_type(id);
+            }
+            return false;
+        });
+        return out;
+    }
+
+} // namespace bsv
+
+#endif // GLOB_IMPL_HPP
@@ -0,0 +1,45 @@
+/*
+Fast non-cryptographic hashing of basic_string_view. 
+Short keys (the common case for map lookups) take a wyhash style path of one or two 128-bit multiplies, long inputs 
+are folded 64 bytes per step into 8 independent accumulators (the XXH3 "stripe" layout), which maps directly onto 
+SSE2/AVX2 lanes. The function is constexpr, so hashes of literals can be computed at compile time.
+*/
+
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include "string_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace bsv {
+
+    // Hashes size() * sizeof(CharT) bytes of v. The result depends on the byte order of the target. With ci_char_traits
+    // the bytes are hashed case-folded, consistently with ==.
+    template <typename CharT, typename Traits>
+    constexpr std::uint64_t hash_value (basic_string_view<CharT, Traits> v, std::uint64_t seed = 0) noexcept;
+
+    // Same function on raw memory.
+    std::uint64_t hash_bytes (const void* data, std::size_t len, std::uint64_t seed = 0) noexcept;
+
+    inline namespace literals {
+        inline namespace hash_literals {
+            // "Content-Length"_hash == hash_value(string_view("Content-Length")), evaluated at compile time.
+            consteval std::uint64_t operator""_hash (const char* s, std::size_t len) noexcept;
+        }
+    }
+
+} // namespace bsv
+
+template <typename CharT, typename Traits>
+struct std::hash<bsv::basic_string_view<CharT, Traits> > {
+    constexpr std::size_t operator() (bsv::basic_string_view<CharT, Traits> v) const noexcept {
+        return static_cast<std::size_t>(bsv::hash_value(v));
+    }
+};
+
+#include "hash.impl.hpp"
+
+#endif // HASH_HPP
@@ -0,0 +1,319 @@
+#ifndef HASH_IMPL_HPP
+#define HASH_IMPL_HPP
+
+#include "hash.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace bsv::detail {
+
+    inline constexpr std::uint64_t hash_p0 = 0xa0761d6478bd642full;
+    inline constexpr std::uint64_t hash_p1 = 0xe7037ed1a0b428dbull;
+    inline constexpr std::uint64_t hash_p2 = 0x8ebc6af09c88c6e3ull;
+    inline constexpr std::uint64_t hash_p3 = 0x589965cc75374cc3ull;
+
+    // Keys XORed into the input by the long path. Stripe n of a block uses words [n, n + 8), the scramble uses [16, 24).
+    alignas(64) inline constexpr std::uint64_t hash_secret[24] = {
+        0xdaeb8ebd244a330c, 0x685bd8519d0023db, 0x959ef8713231c2ca, 0xd1ea2fa4dd9af44c,
+        0xa402cba46b82bddd, 0x4f7580cd7b17a39e, 0xc8b045b99d6fb286, 0xceca0ca0c351e0a7,
+        0x38987f53584df3c8, 0xbb74476ee0b6e30f, 0x9474c83868219521, 0xa309f5fba2117b34,
+        0xf901131499f29aad, 0x6568525f65be34ae, 0xe61c980e7426b628, 0xf330a10b9efe9904,
+        0x39381640553d574d, 0x0e6c783bd0d3aac1, 0x992877185800058a, 0xe2b445a3cb88bb30,
+        0x42381838bf9d61af, 0x475b2af9c112b40f, 0x9d73761a2479742f, 0xa5869770cc27fdba
+    };
+
+    inline constexpr std::size_t hash_long_threshold = 1024;
+    inline constexpr std::size_t hash_stripe = 64;
+    inline constexpr std::size_t hash_block = 16 * hash_stripe;
+
+#if defined(__SIZEOF_INT128__)
+    __extension__ using u128 = unsigned __int128;
+#endif
+
+    // 64x64 -> 128 bit multiply, folded to 64 bits by XOR of the halves.
+    constexpr std::uint64_t hash_mix (std::uint64_t a, std::uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+        const u128 r = static_cast<u128>(a) * b;
+        return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64);
+#else
+        const std::uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<std::uint32_t>(a), lb = static_cast<std::uint32_t>(b);
+        const std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        const std::uint64_t t = rl + (rm0 << 32);
+        std::uint64_t c = t < rl;
+        const std::uint64_t lo = t + (rm1 << 32);
+        c += lo < t;
+        const std::uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+        return lo ^ hi;
+#endif
+    }
+
+    // Reads little-endian-assembled words from the code units of a view. Used when evaluated at compile time, where 
+    // memcpy from a CharT array into an integer is not allowed. Matches byte_reader on little-endian targets.
+    template <typename CharT>
+    struct unit_reader {
+        const CharT* p;
+
+        constexpr std::uint64_t r8 (std::size_t off) const noexcept {
+            using U = std::make_unsigned_t<CharT>;
+            const auto unit = static_cast<std::uint64_t>(static_cast<U>(p[off / sizeof(CharT)]));
+            return (unit >> (8 * (off % sizeof(CharT)))) & 0xFF;
+        }
+        constexpr std::uint64_t r32 (std::size_t off) const noexcept {
+            return r8(off) | r8(off + 1) << 8 | r8(off + 2) << 16 | r8(off + 3) << 24;
+        }
+        constexpr std::uint64_t r64 (std::size_t off) const noexcept {
+            return r32(off) | r32(off + 4) << 32;
+        }
+    };
+
+    struct byte_reader {
+        const unsigned char* p;
+
+        std::uint64_t r8 (std::size_t off) const noexcept { 
+            return p[off]; 
+        }
+        std::uint64_t r32 (std::size_t off) const noexcept { 
+            std::uint32_t v; 
+            std::memcpy(&v, p + off, 4); 
+            return v; 
+        }
+        std::uint64_t r64 (std::size_t off) const noexcept { 
+            std::uint64_t v; 
+            std::memcpy(&v, p + off, 8); 
+            return v; 
+        }
+    };
+
+    // Reads through another reader with ASCII case folded, so that views equal under ci_char_traits hash equally.
+    template <typename Reader>
+    struct folding_reader {
+        Reader rd;
+
+        constexpr std::uint64_t r8 (std::size_t off) const noexcept {
+            return simd::fold(static_cast<unsigned char>(rd.r8(off)));
+        }
+        constexpr std::uint64_t r32 (std::size_t off) const noexcept {
+            return simd::fold8(rd.r32(off));
+        }
+        constexpr std::uint64_t r64 (std::size_t off) const noexcept {
+            return simd::fold8(rd.r64(off));
+        }
+    };
+
+    // acc[i ^ 1] += data[i]; acc[i] += lo32(data[i] ^ key[i]) * hi32(data[i] ^ key[i])
+    template <typename Reader>
+    constexpr void hash_accumulate (std::uint64_t* acc, const Reader& rd, std::size_t off, const std::uint64_t* key) noexcept {
+        for (int i = 0; i < 8; ++i) {
+            const std::uint64_t data = rd.r64(off + 8 * i);
+            const std::uint64_t dk = data ^ key[i];
+            acc[i ^ 1] += data;
+            acc[i] += (dk & 0xFFFFFFFF) * (dk >> 32);
+        }
+    }
+
+    constexpr void hash_scramble (std::uint64_t* acc, const std::uint64_t* key) noexcept {
+        for (int i = 0; i < 8; ++i) {
+            acc[i] = (acc[i] ^ (acc[i] >> 47) ^ key[i]) * 0x9E3779B1ull;
+        }
+    }
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    // hash_accumulate/hash_scramble over all full stripes with the accumulators kept in vector registers. 
+    // Produces exactly the same acc[] as the scalar loop in hash_long.
+    inline void hash_stripes_vec (std::uint64_t* acc, const unsigned char* p, std::size_t len, const std::uint64_t* key) noexcept {
+#if defined(__AVX2__)
+        using vec = __m256i;
+        constexpr int lanes = 2;
+        auto load = [] (const void* q) { return _mm256_loadu_si256(static_cast<const __m256i*>(q)); };
+        auto step = [] (vec a, vec data, vec k) {
+            const vec dk = _mm256_xor_si256(data, k);
+            const vec product = _mm256_mul_epu32(dk, _mm256_srli_epi64(dk, 32));
+            return _mm256_add_epi64(_mm256_add_epi64(a, _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2))), product);
+        };
+        auto scramble = [] (vec a, vec k) {
+            a = _mm256_xor_si256(_mm256_xor_si256(a, _mm256_srli_epi64(a, 47)), k);
+            // 64-bit multiply by a 32-bit constant: lo * c + (hi * c << 32)
+            const vec c = _mm256_set1_epi32(static_cast<int>(0x9E3779B1u));
+            const vec lo = _mm256_mul_epu32(a, c);
+            const vec hi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), c);
+            return _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+        };
+#else
+        using vec = __m128i;
+        constexpr int lanes = 4;
+        auto load = [] (const void* q) { return _mm_loadu_si128(static_cast<const __m128i*>(q)); };
+        auto step = [] (vec a, vec data, vec k) {
+            const vec dk = _mm_xor_si128(data, k);
+            const vec product = _mm_mul_epu32(dk, _mm_srli_epi64(dk, 32));
+            return _mm_add_epi64(_mm_add_epi64(a, _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2))), product);
+        };
+        auto scramble = [] (vec a, vec k) {
+            a = _mm_xor_si128(_mm_xor_si128(a, _mm_srli_epi64(a, 47)), k);
+            const vec c = _mm_set1_epi32(static_cast<int>(0x9E3779B1u));
+            const vec lo = _mm_mul_epu32(a, c);
+            const vec hi = _mm_mul_epu32(_mm_srli_epi64(a, 32), c);
+            return _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+        };
+#endif
+        constexpr int words = 8 / lanes;    // 64-bit words per vector
+        vec a[lanes];
+        for (int j = 0; j < lanes; ++j) {
+            a[j] = load(acc + j * words);
+        }
+        auto stripe = [&] (const unsigned char* q, const std::uint64_t* k) {
+            for (int j = 0; j < lanes; ++j) {
+                a[j] = step(a[j], load(q + 8 * words * j), load(k + words * j));
+            }
+        };
+        const std::size_t blocks = (len - 1) / hash_block;
+        for (std::size_t b = 0; b < blocks; ++b) {
+            for (std::size_t s = 0; s < 16; ++s) {
+                stripe(p + b * hash_block + s * hash_stripe, key + s);
+            }
+            for (int j = 0; j < lanes; ++j) {
+                a[j] = scramble(a[j], load(key + 16 + words * j));
+            }
+        }
+        const std::size_t stripes = ((len - 1) - blocks * hash_block) / hash_stripe;
+        for (std::size_t s = 0; s < stripes; ++s) {
+            stripe(p + blocks * hash_block + s * hash_stripe, key + s);
+        }
+        stripe(p + len - hash_stripe, key + 9);
+        for (int j = 0; j < lanes; ++j) {
+            std::memcpy(acc + j * words, &a[j], sizeof(vec));
+        }
+    }
+#endif
+
+    template <typename Reader>
+    constexpr std::uint64_t hash_long (const Reader& rd, std::size_t len, std::uint64_t seed) noexcept {
+        std::uint64_t key[24] {};
+        for (int i = 0; i < 24; ++i) {
+            key[i] = (i & 1) ? hash_secret[i] - seed : hash_secret[i] + seed;
+        }
+        std::uint64_t acc[8] = {
+            0xC2B2AE3Dull, 0x9E3779B185EBCA87ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull,
+            0x85EBCA77C2B2AE63ull, 0x85EBCA77ull, 0x27D4EB2F165667C5ull, 0x9E3779B1ull
+        };
+
+        bool done = false;
+#if defined(__AVX2__) || defined(__SSE2__)
+        if constexpr (std::is_same_v<Reader, byte_reader>) {
+            if (!std::is_constant_evaluated()) {
+                hash_stripes_vec(acc, rd.p, len, key);
+                done = true;
+            }
+        }
+#endif
+        if (!done) {
+            const std::size_t blocks = (len - 1) / hash_block;
+            for (std::size_t b = 0; b < blocks; ++b) {
+                for (std::size_t s = 0; s < 16; ++s) {
+                    hash_accumulate(acc, rd, b * hash_block + s * hash_stripe, key + s);
+                }
+                hash_scramble(acc, key + 16);
+            }
+            const std::size_t stripes = ((len - 1) - blocks * hash_block) / hash_stripe;
+            for (std::size_t s = 0; s < stripes; ++s) {
+                hash_accumulate(acc, rd, blocks * hash_block + s * hash_stripe, key + s);
+            }
+            hash_accumulate(acc, rd, len - hash_stripe, key + 9);
+        }
+
+        std::uint64_t h = len * hash_p0;
+        for (int i = 0; i < 4; ++i) {
+            h += hash_mix(acc[2 * i] ^ key[2 * i + 3], acc[2 * i + 1] ^ key[2 * i + 4]);
+        }
+        h ^= h >> 37;
+        h *= 0x165667919E3779F9ull;
+        return h ^ (h >> 32);
+    }
+
+    // wyhash (final version 4) for up to hash_long_threshold bytes, the stripe accumulator above it.
+    template <typename Reader>
+    constexpr std::uint64_t hash_core (const Reader& rd, std::size_t len, std::uint64_t seed) noexcept {
+        if (len > hash_long_threshold) {
+            return hash_long(rd, len, seed);
+        }
+        seed ^= hash_mix(seed ^ hash_p0, hash_p1);
+        std::uint64_t a = 0, b = 0;
+        if (len <= 16) {
+            if (len >= 4) {
+                const std::size_t shift = (len >> 3) << 2;
+                a = (rd.r32(0) << 32) | rd.r32(shift);
+                b = (rd.r32(len - 4) << 32) | rd.r32(len - 4 - shift);
+            } else if (len > 0) {
+                a = (rd.r8(0) << 16) | (rd.r8(len >> 1) << 8) | rd.r8(len - 1);
+            }
+        } else {
+            std::size_t i = len, off = 0;
+            if (i > 48) {
+                std::uint64_t s1 = seed, s2 = seed;
+                do {
+                    seed = hash_mix(rd.r64(off) ^ hash_p1, rd.r64(off + 8) ^ seed);
+                    s1 = hash_mix(rd.r64(off + 16) ^ hash_p2, rd.r64(off + 24) ^ s1);
+                    s2 = hash_mix(rd.r64(off + 32) ^ hash_p3, rd.r64(off + 40) ^ s2);
+                    off += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= s1 ^ s2;
+            }
+            while (i > 16) {
+                seed = hash_mix(rd.r64(off) ^ hash_p1, rd.r64(off + 8) ^ seed);
+                off += 16;
+                i -= 16;
+            }
+            a = rd.r64(off + i - 16);
+            b = rd.r64(off + i - 8);
+        }
+        a ^= hash_p1;
+        b ^= seed;
+#if defined(__SIZEOF_INT128__)
+        const u128 r = static_cast<u128>(a) * b;
+        a = static_cast<std::uint64_t>(r);
+        b = static_cast<std::uint64_t>(r >> 64);
+#else
+        const std::uint64_t folded = hash_mix(a, b);
+        a ^= folded;
+        b ^= folded >> 1;
+#endif
+        return hash_mix(a ^ hash_p0 ^ len, b ^ hash_p1);
+    }
+
+} // namespace bsv::detail
+
+namespace bsv {
+
+    template <typename CharT, typename Traits>
+    constexpr std::uint64_t hash_value (basic_string_view<CharT, Traits> v, std::uint64_t seed) noexcept {
+        if constexpr (std::is_same_v<Traits, ci_char_traits>) {
+            if (std::is_constant_evaluated()) {
+                return detail::hash_core(detail::folding_reader<detail::unit_reader<CharT> > {{v.data()}}, v.size(), seed);
+            }
+            return detail::hash_core(detail::folding_reader<detail::byte_reader> {{reinterpret_cast<const unsigned char*>(v.data())}},
+                                     v.size(), seed);
+        }
+        if (std::is_constant_evaluated()) {
+            return detail::hash_core(detail::unit_reader<CharT> {v.data()}, v.size() * sizeof(CharT), seed);
+        }
+        return hash_bytes(v.data(), v.size() * sizeof(CharT), seed);
+    }
+
+    inline std::uint64_t hash_bytes (const void* data, std::size_t len, std::uint64_t seed) noexcept {
+        return detail::hash_core(detail::byte_reader {static_cast<const unsigned char*>(data)}, len, seed);
+    }
+
+    consteval std::uint64_t literals::hash_literals::operator""_hash (const char* s, std::size_t len) noexcept {
+        return hash_value(basic_string_view<char>(s, len));
+    }
+
+} // namespace bsv
+
+#endif // HASH_IMPL_HPP
@@ -0,0 +1,122 @@
+/*
+Approximate top-K most frequent keys of a stream of string views, in memory bounded by the options rather than by the
+number of distinct keys.
+Every key goes into a Count-Min sketch (depth rows of width counters, conservative update) indexed by its 64-bit
+hash_value. Besides the sketch, up to `capacity` candidate keys are tracked with their own counters, their bytes
+copied; a key not tracked replaces the candidate with the smallest count when its sketch estimate exceeds that count,
+starting from the estimate (the Space-Saving replacement rule, with the sketch instead of min + 1).
+The candidate with the smallest count is found with a pq::priority__queue min-heap of (count, id). Counting a tracked
+key only increments its counter in place; a heap entry left stale is brought up to date when it reaches the top,
+after which a frequent key sinks out of the way: the heap is only touched by the keys near the eviction threshold.
+Sketches built with the same options (one per thread, say) can be merged: the counters are added and the candidates
+of both are re-estimated from the sum.
+Counts are over-estimates: a reported key occurred at least count - error times.
+*/
+
+#ifndef HEAVY_HITTERS_HPP
+#define HEAVY_HITTERS_HPP
+
+#include "string_view.hpp"
+#include "hash.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../std_priority_queue/pq.hpp"
+
+namespace bsv {
+    struct heavy_hitters_options {
+        std::size_t k = 100;                // keys reported by top()
+        std::size_t capacity = 0;           // candidates tracked; 0 means 8 * k
+        std::size_t sketch_width = 1 << 16; // counters per row, rounded up to a power of two
+        std::size_t sketch_depth = 4;
+        std::uint64_t seed = 0;
+    };
+
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class basic_heavy_hitters {
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using size_type = std::size_t;
+
+            struct entry {
+                std::basic_string<CharT, Traits> key;
+                std::uint64_t count = 0;
+                std::uint64_t error = 0;    // the key occurred at least count - error times
+            };
+
+        private:
+            struct candidate {
+                std::basic_string<CharT, Traits> key;
+                std::uint64_t hash = 0;
+                std::uint64_t count = 0;
+                std::uint64_t error = 0;
+            };
+
+            struct heap_entry {
+                std::uint64_t count;
+                std::uint32_t id;
+
+                friend auto operator<=> (const heap_entry&, const heap_entry&) = default;
+            };
+
+            static constexpr std::uint32_t no_id = UINT32_MAX;
+
+            heavy_hitters_options options_;
+            std::vector<std::uint64_t> sketch_;         // sketch_depth rows of sketch_width counters
+            std::uint64_t total_ = 0;
+            std::vector<candidate> candidates_;
+            std::vector<std::uint32_t> index_;          // linear probing on the hash: candidate id or no_id
+            pq::priority__queue<heap_entry> heap_;      // one entry per candidate, possibly with a stale count
+
+            size_type cell (size_type row, std::uint64_t h) const noexcept;   // index in sketch_
+            std::uint64_t sketch_estimate (std::uint64_t h) const noexcept;
+            std::uint64_t sketch_add (std::uint64_t h, std::uint64_t weight) noexcept;
+
+            size_type home (std::uint64_t h) const noexcept;
+            std::uint32_t find_candidate (view_type key, std::uint64_t h) const noexcept;
+            void index_insert (std::uint32_t id) noexcept;
+            void index_erase (std::uint32_t id) noexcept;
+            std::uint32_t min_candidate();
+            void rebuild();
+
+        public:
+            explicit basic_heavy_hitters (heavy_hitters_options options = {});
+
+        public:
+            void add (view_type key, std::uint64_t weight = 1);
+
+            // Adds other's counts. Throws std::invalid_argument unless both were built with the same sketch options.
+            void merge (const basic_heavy_hitters& other);
+
+            // The (up to) k candidates with the highest counts, highest first.
+            std::vector<entry> top() const;
+
+            // The tracked count of key, or its sketch estimate if it is not tracked.
+            std::uint64_t estimate (view_type key) const noexcept;
+
+            // Sum of the weights added.
+            std::uint64_t total() const noexcept;
+            size_type tracked() const noexcept;
+            const heavy_hitters_options& options() const noexcept;
+            void clear() noexcept;
+    };
+
+    using heavy_hitters = basic_heavy_hitters<char>;
+
+} // namespace bsv
+
+#include "heavy_hitters.impl.hpp"
+
+#endif // HEAVY_HITTERS_HPP
+
+/*
+Methods                           Time Complexity                      Auxiliary Space
+add(key)                          O(|key| + depth), plus O(log capacity) per heap refresh     O(|key|) on eviction
+merge(other)                      O(width * depth + capacity log capacity)                     O(capacity)
+top()                             O(capacity log capacity)              O(capacity)
+memory                            width * depth * 8 bytes + capacity keys
+*/
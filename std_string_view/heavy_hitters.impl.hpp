@@ -0,0 +1,267 @@
+#ifndef HEAVY_HITTERS_IMPL_HPP
+#define HEAVY_HITTERS_IMPL_HPP
+
+#include "heavy_hitters.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <stdexcept>
+
+namespace bsv {
+    // ctor --------------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    basic_heavy_hitters<CharT, Traits>::basic_heavy_hitters (heavy_hitters_options options) : options_(options) {
+        options_.k = std::max<size_type>(options_.k, 1);
+        if (options_.capacity == 0) {
+            options_.capacity = 8 * options_.k;
+        }
+        options_.capacity = std::clamp<size_type>(options_.capacity, options_.k, no_id - 1);
+        options_.sketch_width = std::bit_ceil(std::max<size_type>(options_.sketch_width, 1));
+        options_.sketch_depth = std::max<size_type>(options_.sketch_depth, 1);
+        sketch_.assign(options_.sketch_width * options_.sketch_depth, 0);
+        candidates_.reserve(options_.capacity);
+        index_.assign(std::bit_ceil(2 * options_.capacity), no_id);
+    }
+
+
+    // Count-Min sketch --------------------------------------------------------------------------------------------------------------
+
+    // Row i uses h1 + i * h2 (Kirsch and Mitzenmacher), both halves of the one 64-bit hash.
+    template <typename CharT, typename Traits>
+    auto basic_heavy_hitters<CharT, Traits>::cell (size_type row, std::uint64_t h) const noexcept -> size_type {
+        const std::uint64_t h1 = h & 0xFFFFFFFF;
+        const std::uint64_t h2 = (h >> 32) | 1;
+        return row * options_.sketch_width + static_cast<size_type>((h1 + row * h2) & (options_.sketch_width - 1));
+    }
+
+    template <typename CharT, typename Traits>
+    std::uint64_t basic_heavy_hitters<CharT, Traits>::sketch_estimate (std::uint64_t h) const noexcept {
+        std::uint64_t est = UINT64_MAX;
+        for (size_type row = 0; row < options_.sketch_depth; ++row) {
+            est = std::min(est, sketch_[cell(row, h)]);
+        }
+        return est;
+    }
+
+    // Conservative update: no counter is raised above the new estimate, which keeps the over-counting from keys
+    // sharing a counter down without ever under-counting.
+    template <typename CharT, typename Traits>
+    std::uint64_t basic_heavy_hitters<CharT, Traits>::sketch_add (std::uint64_t h, std::uint64_t weight) noexcept {
+        const std::uint64_t est = sketch_estimate(h) + weight;
+        for (size_type row = 0; row < options_.sketch_depth; ++row) {
+            std::uint64_t& c = sketch_[cell(row, h)];
+            c = std::max(c, est);
+        }
+        return est;
+    }
+
+
+    // Candidate index ---------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    auto basic_heavy_hitters<CharT, Traits>::home (std::uint64_t h) const noexcept -> size_type {
+        return static_cast<size_type>(h >> 7) & (index_.size() - 1);
+    }
+
+    template <typename CharT, typename Traits>
+    std::uint32_t basic_heavy_hitters<CharT, Traits>::find_candidate (view_type key, std::uint64_t h) const noexcept {
+        const size_type mask = index_.size() - 1;
+        for (size_type i = home(h); index_[i] != no_id; i = (i + 1) & mask) {
+            const candidate& c = candidates_[index_[i]];
+            if (c.hash == h && view_type(c.key.data(), c.key.size()) == key) {
+                return index_[i];
+            }
+        }
+        return no_id;
+    }
+
+    template <typename CharT, typename Traits>
+    void basic_heavy_hitters<CharT, Traits>::index_insert (std::uint32_t id) noexcept {
+        const size_type mask = index_.size() - 1;
+        size_type i = home(candidates_[id].hash);
+        while (index_[i] != no_id) {
+            i = (i + 1) & mask;
+        }
+        index_[i] = id;
+    }
+
+    // Backward-shift deletion: the entries after the hole that may move into it do, so that no tombstones are needed.
+    template <typename CharT, typename Traits>
+    void basic_heavy_hitters<CharT, Traits>::index_erase (std::uint32_t id) noexcept {
+        const size_type mask = index_.size() - 1;
+        size_type hole = home(candidates_[id].hash);
+        while (index_[hole] != id) {
+            hole = (hole + 1) & mask;
+        }
+        for (size_type i = (hole + 1) & mask; index_[i] != no_id; i = (i + 1) & mask) {
+            const size_type h = home(candidates_[index_[i]].hash);
+            if (((i - h) & mask) >= ((i - hole) & mask)) {
+                index_[hole] = index_[i];
+                hole = i;
+            }
+        }
+        index_[hole] = no_id;
+    }
+
+
+    // add ---------------------------------------------------------------------------------------------------------------------------
+
+    // Pops stale entries (counts only grow, so a stale entry is never above its candidate's count) and pushes them
+    // back with the current count until the top is current: it is then the smallest count.
+    template <typename CharT, typename Traits>
+    std::uint32_t basic_heavy_hitters<CharT, Traits>::min_candidate() {
+        for (;;) {
+            const heap_entry e = heap_.top();
+            const std::uint64_t count = candidates_[e.id].count;
+            if (e.count == count) {
+                return e.id;
+            }
+            heap_.pop();
+            heap_.push(heap_entry{count, e.id});
+        }
+    }
+
+    template <typename CharT, typename Traits>
+    void basic_heavy_hitters<CharT, Traits>::add (view_type key, std::uint64_t weight) {
+        const std::uint64_t h = hash_value(key, options_.seed);
+        const std::uint64_t est = sketch_add(h, weight);
+        total_ += weight;
+        if (const std::uint32_t id = find_candidate(key, h); id != no_id) {
+            candidates_[id].count += weight;
+            return;
+        }
+        if (candidates_.size() < options_.capacity) {
+            const auto id = static_cast<std::uint32_t>(candidates_.size());
+            candidates_.push_back(candidate{std::basic_string<CharT, Traits>(key.data(), key.size()), h, est, est - weight});
+            index_insert(id);
+            heap_.push(heap_entry{est, id});
+            return;
+        }
+        const std::uint32_t id = min_candidate();
+        candidate& c = candidates_[id];
+        if (est > c.count) {
+            index_erase(id);
+            c.key.assign(key.data(), key.size());
+            c.hash = h;
+            c.count = est;
+            c.error = est - weight;
+            index_insert(id);
+            heap_.pop();
+            heap_.push(heap_entry{est, id});
+        }
+    }
+
+
+    // merge -------------------------------------------------------------------------------------------------------------------------
+
+    // Both candidate sets are re-estimated from the summed sketch, which bounds each count from above; the lower
+    // bounds (count - error) of both add up. The capacity highest survive.
+    template <typename CharT, typename Traits>
+    void basic_heavy_hitters<CharT, Traits>::merge (const basic_heavy_hitters& other) {
+        if (options_.sketch_width != other.options_.sketch_width || options_.sketch_depth != other.options_.sketch_depth ||
+            options_.seed != other.options_.seed) {
+            throw std::invalid_argument("basic_heavy_hitters::merge: different sketch options");
+        }
+        if (this == &other) {
+            const basic_heavy_hitters copy(other);
+            merge(copy);
+            return;
+        }
+        for (size_type i = 0; i < sketch_.size(); ++i) {
+            sketch_[i] += other.sketch_[i];
+        }
+        total_ += other.total_;
+
+        std::vector<candidate> added;
+        for (const candidate& o : other.candidates_) {
+            if (find_candidate(view_type(o.key.data(), o.key.size()), o.hash) == no_id) {
+                const std::uint64_t count = sketch_estimate(o.hash);
+                added.push_back(candidate{o.key, o.hash, count, count - (o.count - o.error)});
+            }
+        }
+        std::vector<candidate> merged = std::move(candidates_);
+        for (candidate& c : merged) {
+            const std::uint32_t j = other.find_candidate(view_type(c.key.data(), c.key.size()), c.hash);
+            const std::uint64_t lower = c.count - c.error + (j != no_id ? other.candidates_[j].count - other.candidates_[j].error : 0);
+            c.count = sketch_estimate(c.hash);
+            c.error = c.count - lower;
+        }
+        merged.insert(merged.end(), std::make_move_iterator(added.begin()), std::make_move_iterator(added.end()));
+        if (merged.size() > options_.capacity) {
+            std::nth_element(merged.begin(), merged.begin() + options_.capacity, merged.end(),
+                             [](const candidate& a, const candidate& b) { return a.count > b.count; });
+            merged.resize(options_.capacity);
+        }
+        candidates_ = std::move(merged);
+        rebuild();
+    }
+
+    template <typename CharT, typename Traits>
+    void basic_heavy_hitters<CharT, Traits>::rebuild() {
+        std::fill(index_.begin(), index_.end(), no_id);
+        std::vector<heap_entry> entries;
+        entries.reserve(candidates_.size());
+        for (std::uint32_t id = 0; id < candidates_.size(); ++id) {
+            index_insert(id);
+            entries.push_back(heap_entry{candidates_[id].count, id});
+        }
+        heap_ = pq::priority__queue<heap_entry>(entries.begin(), entries.end());
+    }
+
+
+    // Results -----------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    auto basic_heavy_hitters<CharT, Traits>::top() const -> std::vector<entry> {
+        std::vector<const candidate*> order;
+        order.reserve(candidates_.size());
+        for (const candidate& c : candidates_) {
+            order.push_back(&c);
+        }
+        const size_type k = std::min(options_.k, order.size());
+        std::partial_sort(order.begin(), order.begin() + k, order.end(),
+                          [](const candidate* a, const candidate* b) { return a->count > b->count; });
+        std::vector<entry> result;
+        result.reserve(k);
+        for (size_type i = 0; i < k; ++i) {
+            result.push_back(entry{order[i]->key, order[i]->count, order[i]->error});
+        }
+        return result;
+    }
+
+    template <typename CharT, typename Traits>
+    std::uint64_t basic_heavy_hitters<CharT, Traits>::estimate (view_type key) const noexcept {
+        const std::uint64_t h = hash_value(key, options_.seed);
+        const std::uint32_t id = find_candidate(key, h);
+        return id != no_id ? candidates_[id].count : sketch_estimate(h);
+    }
+
+    template <typename CharT, typename Traits>
+    std::uint64_t basic_heavy_hitters<CharT, Traits>::total() const noexcept {
+        return total_;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_heavy_hitters<CharT, Traits>::tracked() const noexcept -> size_type {
+        return candidates_.size();
+    }
+
+    template <typename CharT, typename Traits>
+    const heavy_hitters_options& basic_heavy_hitters<CharT, Traits>::options() const noexcept {
+        return options_;
+    }
+
+    template <typename CharT, typename Traits>
+    void basic_heavy_hitters<CharT, Traits>::clear() noexcept {
+        std::fill(sketch_.begin(), sketch_.end(), 0);
+        std::fill(index_.begin(), index_.end(), no_id);
+        total_ = 0;
+        candidates_.clear();
+        heap_ = pq::priority__queue<heap_entry>();
+    }
+
+} // namespace bsv
+
+#endif // HEAVY_HITTERS_IMPL_HPP
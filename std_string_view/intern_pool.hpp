@@ -0,0 +1,117 @@
+/*
+A thread-safe string interning pool. intern(view) stores each distinct string once, in bump-allocated arena blocks,
+and returns a view of the stored copy plus a dense 32-bit id (0, 1, 2, ... in insertion order). The stored strings
+never move, so the views stay valid for the lifetime of the pool.
+Lookups of strings already in the pool take no lock: the index is a set of open-addressing tables of atomic slots.
+Only the first intern of a string takes the lock of its shard (one of 16, chosen by hash).
+*/
+
+#ifndef INTERN_POOL_HPP
+#define INTERN_POOL_HPP
+
+#include "string_view.hpp"
+#include "hash.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace bsv {
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class basic_intern_pool {
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using size_type = std::size_t;
+            using id_type = std::uint32_t;
+
+            // Two handles from the same pool are equal iff their strings are: the comparison is on the id alone.
+            struct interned {
+                view_type view;
+                id_type id = 0;
+
+                friend bool operator== (const interned& a, const interned& b) noexcept { return a.id == b.id; }
+            };
+
+            struct memory_stats {
+                size_type strings = 0;          // distinct strings stored
+                size_type string_bytes = 0;     // bytes of their contents
+                size_type arena_bytes = 0;      // bytes reserved by the arena blocks
+                size_type index_bytes = 0;      // hash tables (including retired ones) and the id -> view table
+            };
+
+        private:
+            static constexpr size_type shard_count = 16;
+            static constexpr size_type block_size = 64 * 1024;          // in bytes
+            static constexpr size_type first_segment = 1024;            // entries of segment 0, doubling after that
+            static constexpr size_type segment_count = 23;              // enough for 2^32 ids
+
+            // Slot: upper 32 bits of the hash | id + 1. Zero means empty. Slots only go from empty to full.
+            struct table {
+                size_type mask = 0;
+                std::unique_ptr<std::atomic<std::uint64_t>[]> slots;
+
+                explicit table (size_type capacity);
+            };
+
+            struct alignas(64) shard {
+                mutable std::mutex mutex;
+                std::atomic<table*> current {nullptr};
+                std::vector<std::unique_ptr<table> > tables;     // every generation: readers may still be in an old one
+                size_type count = 0;
+                std::vector<std::unique_ptr<CharT[]> > blocks;
+                CharT* cursor = nullptr;
+                size_type left = 0;                               // units left in the current block
+                size_type arena_bytes = 0;
+                size_type string_bytes = 0;
+            };
+
+            std::array<shard, shard_count> shards_;
+            std::array<std::atomic<view_type*>, segment_count> segments_ {};
+            std::atomic<id_type> next_id_ {0};
+
+            std::optional<id_type> probe (const table& t, std::uint64_t h, view_type s) const noexcept;
+            static void place (table& t, std::uint64_t h, id_type id) noexcept;
+
+            view_type& entry (id_type id);
+            const CharT* store (shard& sh, view_type s);
+            void grow (shard& sh);
+
+        public:
+            basic_intern_pool();
+            ~basic_intern_pool();
+
+            basic_intern_pool (const basic_intern_pool&) = delete;
+            basic_intern_pool& operator= (const basic_intern_pool&) = delete;
+
+            // Thread-safe.
+            interned intern (view_type s);
+            std::optional<interned> find (view_type s) const noexcept;
+
+            // The string with this id; id must have been returned by intern (on any thread, with the usual happens-before).
+            view_type view (id_type id) const noexcept;
+            size_type size() const noexcept;
+
+            // Takes every shard lock in turn; the numbers are exact only while no thread is interning.
+            memory_stats memory() const;
+    };
+
+    using intern_pool = basic_intern_pool<char>;
+
+} // namespace bsv
+
+#include "intern_pool.impl.hpp"
+
+#endif // INTERN_POOL_HPP
+
+/*
+Methods                           Time Complexity      Auxiliary Space
+intern(s), string already there   O(|s|) expected, no lock
+intern(s), new string              O(|s|) expected amortized, one shard lock
+find(s)                           O(|s|) expected      O(1)
+view(id)                          O(1)                 O(1)
+*/
@@ -0,0 +1,200 @@
+#ifndef INTERN_POOL_IMPL_HPP
+#define INTERN_POOL_IMPL_HPP
+
+#include "intern_pool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+
+namespace bsv {
+    // ctors -------------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    basic_intern_pool<CharT, Traits>::table::table (size_type capacity)
+        : mask(capacity - 1), slots(new std::atomic<std::uint64_t>[capacity]) {
+        for (size_type i = 0; i < capacity; ++i) {
+            slots[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename CharT, typename Traits>
+    basic_intern_pool<CharT, Traits>::basic_intern_pool() {
+        for (auto& sh : shards_) {
+            sh.tables.push_back(std::make_unique<table>(64));
+            sh.current.store(sh.tables.back().get(), std::memory_order_release);
+        }
+    }
+
+    template <typename CharT, typename Traits>
+    basic_intern_pool<CharT, Traits>::~basic_intern_pool() {
+        for (auto& segment : segments_) {
+            delete[] segment.load(std::memory_order_relaxed);
+        }
+    }
+
+
+    // Index -------------------------------------------------------------------------------------------------------------------------
+
+    // Linear probing. A reader racing with an insert either sees the slot still empty (and falls back to the locked
+    // path) or sees the full slot, whose release store was made after the entry it points to was written.
+    template <typename CharT, typename Traits>
+    auto basic_intern_pool<CharT, Traits>::probe (const table& t, std::uint64_t h, view_type s) const noexcept
+        -> std::optional<id_type> {
+        const std::uint64_t tag = h >> 32;
+        for (size_type i = h & t.mask; ; i = (i + 1) & t.mask) {
+            const std::uint64_t slot = t.slots[i].load(std::memory_order_acquire);
+            if (slot == 0) {
+                return std::nullopt;
+            }
+            if ((slot >> 32) == tag) {
+                const auto id = static_cast<id_type>(slot - 1);
+                if (view(id) == s) {
+                    return id;
+                }
+            }
+        }
+    }
+
+    template <typename CharT, typename Traits>
+    void basic_intern_pool<CharT, Traits>::place (table& t, std::uint64_t h, id_type id) noexcept {
+        size_type i = h & t.mask;
+        while (t.slots[i].load(std::memory_order_relaxed) != 0) {
+            i = (i + 1) & t.mask;
+        }
+        t.slots[i].store((h >> 32 << 32) | (std::uint64_t(id) + 1), std::memory_order_release);
+    }
+
+    // Builds a table twice as large and publishes it; the old one stays allocated for readers still probing it.
+    template <typename CharT, typename Traits>
+    void basic_intern_pool<CharT, Traits>::grow (shard& sh) {
+        const table& old = *sh.current.load(std::memory_order_relaxed);
+        auto bigger = std::make_unique<table>(2 * (old.mask + 1));
+        for (size_type i = 0; i <= old.mask; ++i) {
+            if (const std::uint64_t slot = old.slots[i].load(std::memory_order_relaxed); slot != 0) {
+                const auto id = static_cast<id_type>(slot - 1);
+                place(*bigger, hash_value(view(id)), id);
+            }
+        }
+        sh.current.store(bigger.get(), std::memory_order_release);
+        sh.tables.push_back(std::move(bigger));
+    }
+
+
+    // Storage -----------------------------------------------------------------------------------------------------------------------
+
+    // Ids map to views through segments of doubling size, so the table grows without ever moving an entry.
+    template <typename CharT, typename Traits>
+    auto basic_intern_pool<CharT, Traits>::entry (id_type id) -> view_type& {
+        const size_type k = std::bit_width(id / first_segment + 1) - 1;
+        view_type* segment = segments_[k].load(std::memory_order_acquire);
+        if (segment == nullptr) {
+            // Shards allocate independently, so two of them may race for a new segment.
+            auto fresh = std::make_unique<view_type[]>(first_segment << k);
+            if (segments_[k].compare_exchange_strong(segment, fresh.get(), std::memory_order_acq_rel)) {
+                segment = fresh.release();
+            }
+        }
+        return segment[id - first_segment * ((size_type(1) << k) - 1)];
+    }
+
+    // Bump allocation; strings larger than a quarter block get a block of their own.
+    template <typename CharT, typename Traits>
+    const CharT* basic_intern_pool<CharT, Traits>::store (shard& sh, view_type s) {
+        constexpr size_type block_units = block_size / sizeof(CharT);
+        CharT* out;
+        if (s.size() > block_units / 4) {
+            sh.blocks.push_back(std::make_unique_for_overwrite<CharT[]>(s.size()));
+            sh.arena_bytes += s.size() * sizeof(CharT);
+            out = sh.blocks.back().get();
+        } else {
+            if (sh.left < s.size() || sh.cursor == nullptr) {
+                sh.blocks.push_back(std::make_unique_for_overwrite<CharT[]>(block_units));
+                sh.arena_bytes += block_size;
+                sh.cursor = sh.blocks.back().get();
+                sh.left = block_units;
+            }
+            out = sh.cursor;
+            sh.cursor += s.size();
+            sh.left -= s.size();
+        }
+        Traits::copy(out, s.data(), s.size());
+        sh.string_bytes += s.size() * sizeof(CharT);
+        return out;
+    }
+
+
+    // Operations --------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    auto basic_intern_pool<CharT, Traits>::intern (view_type s) -> interned {
+        const std::uint64_t h = hash_value(s);
+        shard& sh = shards_[h >> 60];
+        if (const auto id = probe(*sh.current.load(std::memory_order_acquire), h, s)) {
+            return {view(*id), *id};
+        }
+
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        if (const auto id = probe(*sh.current.load(std::memory_order_relaxed), h, s)) {
+            return {view(*id), *id};
+        }
+        if (next_id_.load(std::memory_order_relaxed) == std::numeric_limits<id_type>::max()) {
+            throw std::length_error("basic_intern_pool: too many strings");
+        }
+        const table* t = sh.current.load(std::memory_order_relaxed);
+        if (2 * (sh.count + 1) > t->mask + 1) {
+            grow(sh);
+        }
+        const view_type stored(store(sh, s), s.size());
+        const id_type id = next_id_.fetch_add(1, std::memory_order_relaxed);
+        entry(id) = stored;
+        place(*sh.current.load(std::memory_order_relaxed), h, id);
+        ++sh.count;
+        return {stored, id};
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_intern_pool<CharT, Traits>::find (view_type s) const noexcept -> std::optional<interned> {
+        const std::uint64_t h = hash_value(s);
+        const shard& sh = shards_[h >> 60];
+        if (const auto id = probe(*sh.current.load(std::memory_order_acquire), h, s)) {
+            return interned{view(*id), *id};
+        }
+        return std::nullopt;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_intern_pool<CharT, Traits>::view (id_type id) const noexcept -> view_type {
+        const size_type k = std::bit_width(id / first_segment + 1) - 1;
+        return segments_[k].load(std::memory_order_acquire)[id - first_segment * ((size_type(1) << k) - 1)];
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_intern_pool<CharT, Traits>::size() const noexcept -> size_type {
+        return next_id_.load(std::memory_order_acquire);
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_intern_pool<CharT, Traits>::memory() const -> memory_stats {
+        memory_stats stats;
+        for (const auto& sh : shards_) {
+            std::lock_guard<std::mutex> lock(sh.mutex);
+            stats.strings += sh.count;
+            stats.string_bytes += sh.string_bytes;
+            stats.arena_bytes += sh.arena_bytes;
+            for (const auto& t : sh.tables) {
+                stats.index_bytes += (t->mask + 1) * sizeof(std::uint64_t);
+            }
+        }
+        for (size_type k = 0; k < segment_count; ++k) {
+            if (segments_[k].load(std::memory_order_acquire) != nullptr) {
+                stats.index_bytes += (first_segment << k) * sizeof(view_type);
+            }
+        }
+        return stats;
+    }
+
+} // namespace bsv
+
+#endif // INTERN_POOL_IMPL_HPP
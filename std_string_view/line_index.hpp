@@ -0,0 +1,82 @@
+/*
+Random access to the lines of a large view (a memory-mapped log as one string_view): line(n) in O(1) and the line
+holding a given offset in O(log lines), after one parallel pass over the text.
+The line starts are kept in blocks of 64: each block has a 64-bit anchor (the start of its first line) and every line
+a 16-bit distance from its block's anchor, about 2.1 bytes per line instead of 8. A block whose lines span more than
+64 KiB keeps its 64 starts in full instead, its anchor pointing to them.
+Building counts the '\n's of each chunk (policy.min_chunk units or more, on the policy's thread_pool), which gives
+every chunk the number of its first line; each chunk then writes the blocks that start in it, reading newline
+positions off 64-unit comparison bitmasks (simd::eq_mask64) and carrying on past its end to finish its last block.
+A line is the text up to, not including, its '\n' (a '\r' before it is kept); a last line without a '\n' counts.
+The index refers to the text: it must outlive the index and stay unchanged.
+*/
+
+#ifndef LINE_INDEX_HPP
+#define LINE_INDEX_HPP
+
+#include "string_view.hpp"
+#include "parallel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bsv {
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class basic_line_index {
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using size_type = std::size_t;
+
+            static constexpr size_type npos = view_type::npos;
+            static constexpr size_type block_lines = 64;
+
+        private:
+            static constexpr std::uint64_t wide = std::uint64_t(1) << 63;
+
+            view_type text_;
+            size_type lines_ = 0;
+            std::vector<std::uint64_t> anchors_;    // per block: its first start, or wide | the index of its block in wide_
+            std::vector<std::uint16_t> deltas_;     // per start: the distance from its block's anchor
+            std::vector<std::uint64_t> wide_;       // block_lines starts per wide block
+
+            // starts (lines_ + 1 of them): 0, then one past every '\n' and past the end if the last line has none.
+            size_type start (size_type i) const noexcept;
+
+        public:
+            basic_line_index() = default;
+            explicit basic_line_index (view_type text, const parallel_policy& policy = parallel_policy());
+
+        public:
+            size_type lines() const noexcept;
+
+            // Line n, without its '\n'. n must be below lines().
+            view_type line (size_type n) const noexcept;
+
+            // Offset of the first unit of line n. n must be below lines().
+            size_type offset (size_type n) const noexcept;
+
+            // The line holding the unit at offset, or npos if offset is not below text().size(). The '\n' belongs to the
+            // line it ends.
+            size_type line_of (size_type offset) const noexcept;
+
+            view_type text() const noexcept;
+
+            // Bytes held by the index.
+            size_type memory_bytes() const noexcept;
+    };
+
+    using line_index = basic_line_index<char>;
+
+} // namespace bsv
+
+#include "line_index.impl.hpp"
+
+#endif // LINE_INDEX_HPP
+
+/*
+Methods                       Time Complexity                  Auxiliary Space
+basic_line_index(text)        O(N / threads + lines)            O(lines) (2 bytes and 1 bit per line, mostly)
+line(n) / offset(n)           O(1)                             O(1)
+line_of(offset)               O(log lines)                     O(1)
+*/
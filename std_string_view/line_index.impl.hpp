@@ -0,0 +1,203 @@
+#ifndef LINE_INDEX_IMPL_HPP
+#define LINE_INDEX_IMPL_HPP
+
+#include "line_index.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <type_traits>
+
+namespace bsv {
+    namespace detail {
+        // The '\n's of text from a given offset on, in order, 64 units at a time: a window's bitmask of '\n's is read
+        // lowest bit first, so a line costs a count of trailing zeros and a clear.
+        template <typename CharT, typename Traits>
+        class newline_scanner {
+            private:
+                const CharT* text_;
+                std::size_t size_;
+                std::size_t window_;            // offset of the current window
+                std::uint64_t mask_;            // the '\n's of the window not returned yet
+
+                std::uint64_t mask_at (std::size_t at) const noexcept {
+                    if constexpr (sizeof(CharT) == 1 && std::is_same_v<Traits, std::char_traits<CharT> >) {
+                        if (size_ - at >= 64) {
+                            return simd::eq_mask64(reinterpret_cast<const unsigned char*>(text_ + at), '\n');
+                        }
+                    }
+                    const std::size_t n = std::min<std::size_t>(size_ - at, 64);
+                    std::uint64_t mask = 0;
+                    for (std::size_t i = 0; i < n; ++i) {
+                        mask |= std::uint64_t(Traits::eq(text_[at + i], CharT('\n'))) << i;
+                    }
+                    return mask;
+                }
+
+            public:
+                newline_scanner (const CharT* text, std::size_t size, std::size_t from) noexcept
+                    : text_(text), size_(size), window_(from), mask_(from < size ? mask_at(from) : 0) {}
+
+                // The offset of the next '\n', or the size of the text after the last one.
+                std::size_t next() noexcept {
+                    while (mask_ == 0) {
+                        window_ += 64;
+                        if (window_ >= size_) {
+                            window_ = size_;
+                            return size_;
+                        }
+                        mask_ = mask_at(window_);
+                    }
+                    const std::size_t at = window_ + std::countr_zero(mask_);
+                    mask_ &= mask_ - 1;
+                    return at;
+                }
+        };
+    } // namespace detail
+
+
+    // Construction ------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    basic_line_index<CharT, Traits>::basic_line_index (view_type text, const parallel_policy& policy) : text_(text) {
+        const std::size_t n = text.size();
+        if (n == 0) {
+            return;
+        }
+        thread_pool& pool = detail::pool_of(policy);
+        const detail::chunking chunks(policy, pool, 0, n);
+
+        // Pass 1: the '\n's of every chunk, then the line each chunk's first '\n' ends.
+        std::vector<std::size_t> first_newline(chunks.chunks + 1, 0);
+        pool.for_each_index(chunks.chunks, [&](std::size_t i) {
+            first_newline[i + 1] = detail::count_units(view_type(text.data() + chunks.begin(i), chunks.end(i) - chunks.begin(i)), CharT('\n'));
+        });
+        for (std::size_t i = 0; i < chunks.chunks; ++i) {
+            first_newline[i + 1] += first_newline[i];
+        }
+        const bool unterminated = !Traits::eq(text[n - 1], CharT('\n'));
+        lines_ = first_newline[chunks.chunks] + unterminated;
+
+        // Start e > 0 is one past '\n' number e - 1, so chunk i holds starts [first_start(i), first_start(i + 1)): start
+        // 0 goes with chunk 0 and the one past an unterminated last line with the last chunk.
+        const auto first_start = [&](std::size_t i) {
+            return i == 0 ? 0 : i == chunks.chunks ? lines_ + 1 : first_newline[i] + 1;
+        };
+        const auto first_block = [&](std::size_t i) { return (first_start(i) + block_lines - 1) / block_lines; };
+        const std::size_t blocks = first_block(chunks.chunks);
+        anchors_.assign(blocks, 0);
+        deltas_.assign(blocks * block_lines, 0);
+
+        // Pass 2: every chunk fills the blocks whose first start is its own, reading on past its end for the rest.
+        std::vector<std::vector<std::uint64_t> > wide_parts(chunks.chunks);
+        pool.for_each_index(chunks.chunks, [&](std::size_t i) {
+            const std::size_t b_first = first_block(i);
+            const std::size_t b_end = first_block(i + 1);
+            if (b_first == b_end) {
+                return;
+            }
+            std::size_t e = b_first * block_lines;
+            const std::size_t e_end = std::min(b_end * block_lines, lines_ + 1);
+            detail::newline_scanner<CharT, Traits> scan(text.data(), n, chunks.begin(i));
+            if (e > 0) {
+                for (std::size_t skip = e - 1 - first_newline[i]; skip > 0; --skip) {
+                    scan.next();
+                }
+            }
+            std::uint64_t starts[block_lines];
+            while (e < e_end) {
+                const std::size_t k = std::min(block_lines, e_end - e);
+                for (std::size_t j = 0; j < k; ++j) {
+                    starts[j] = e + j == 0 ? 0 : scan.next() + 1;
+                }
+                const std::size_t b = e / block_lines;
+                if (starts[k - 1] - starts[0] <= 0xFFFF) {
+                    anchors_[b] = starts[0];
+                    for (std::size_t j = 0; j < k; ++j) {
+                        deltas_[e + j] = static_cast<std::uint16_t>(starts[j] - starts[0]);
+                    }
+                } else {
+                    std::vector<std::uint64_t>& part = wide_parts[i];
+                    anchors_[b] = wide | (part.size() / block_lines);
+                    part.insert(part.end(), starts, starts + k);
+                    part.resize(part.size() + block_lines - k, 0);
+                }
+                e += k;
+            }
+        });
+
+        // The wide blocks of every chunk after those of the chunks before it.
+        for (std::size_t i = 0; i < chunks.chunks; ++i) {
+            const std::uint64_t base = wide_.size() / block_lines;
+            for (std::size_t b = first_block(i); b < first_block(i + 1); ++b) {
+                if (anchors_[b] & wide) {
+                    anchors_[b] += base;
+                }
+            }
+            wide_.insert(wide_.end(), wide_parts[i].begin(), wide_parts[i].end());
+        }
+    }
+
+
+    // Lookup ------------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    std::size_t basic_line_index<CharT, Traits>::start (size_type i) const noexcept {
+        const std::uint64_t anchor = anchors_[i / block_lines];
+        if (anchor & wide) {
+            return wide_[(anchor & ~wide) * block_lines + i % block_lines];
+        }
+        return anchor + deltas_[i];
+    }
+
+    template <typename CharT, typename Traits>
+    std::size_t basic_line_index<CharT, Traits>::lines() const noexcept {
+        return lines_;
+    }
+
+    template <typename CharT, typename Traits>
+    typename basic_line_index<CharT, Traits>::view_type basic_line_index<CharT, Traits>::line (size_type n) const noexcept {
+        const size_type first = start(n);
+        return view_type(text_.data() + first, start(n + 1) - 1 - first);
+    }
+
+    template <typename CharT, typename Traits>
+    std::size_t basic_line_index<CharT, Traits>::offset (size_type n) const noexcept {
+        return start(n);
+    }
+
+    template <typename CharT, typename Traits>
+    std::size_t basic_line_index<CharT, Traits>::line_of (size_type offset) const noexcept {
+        if (offset >= text_.size()) {
+            return npos;
+        }
+        // The last block starting at or before offset, then the last start in it at or before offset.
+        size_type lo = 0;
+        size_type hi = anchors_.size();
+        while (hi - lo > 1) {
+            const size_type mid = lo + (hi - lo) / 2;
+            (start(mid * block_lines) <= offset ? lo : hi) = mid;
+        }
+        lo *= block_lines;
+        hi = std::min(lo + block_lines, lines_ + 1);
+        while (hi - lo > 1) {
+            const size_type mid = lo + (hi - lo) / 2;
+            (start(mid) <= offset ? lo : hi) = mid;
+        }
+        return lo;
+    }
+
+    template <typename CharT, typename Traits>
+    typename basic_line_index<CharT, Traits>::view_type basic_line_index<CharT, Traits>::text() const noexcept {
+        return text_;
+    }
+
+    template <typename CharT, typename Traits>
+    std::size_t basic_line_index<CharT, Traits>::memory_bytes() const noexcept {
+        return anchors_.capacity() * sizeof(std::uint64_t) + deltas_.capacity() * sizeof(std::uint16_t)
+             + wide_.capacity() * sizeof(std::uint64_t);
+    }
+
+} // namespace bsv
+
+#endif // LINE_INDEX_IMPL_HPP
@@ -1,7 +1,25 @@
+#include <algorithm>
 #include <iostream>
 #include <vector> 
 
 #include "string_view.hpp"
+#include "multi_searcher.hpp"
+#include "string_map.hpp"
+#include "split.hpp"
+#include "intern_pool.hpp"
+#include "parse.hpp"
+#include "csv.hpp"
+#include "utf8.hpp"
+#include "stream_searcher.hpp"
+#include "parallel.hpp"
+#include "segmented_view.hpp"
+#include "output_builder.hpp"
+#include "compact_view.hpp"
+#include "string_sort.hpp"
+#include "heavy_hitters.hpp"
+#include "fixed_string.hpp"
+#include "line_index.hpp"
+#include "glob.hpp"
 
 void test_string_view() {
     // Creating string views
@@ -65,10 +83,13 @@ void test_string_view() {
     std::cout << sv7.compare(7, 5, sv5) << "\n";        // 0
 
     std::cout << sv7.compare(7, 5, sv6, 9, 5) << "\n";  // 0
+
+    std::cout << std::boolalpha << (sv6 < sv7) << "\n";             // true
+    std::cout << std::boolalpha << (sv7 == "Hello, World!") << "\n"; // true
     
     // Starts/Ends/Contains
     std::cout << "Starts/Ends/Contains:\n";
-    std::cout << std::boolalpha << sv7.starts_with("Hello") << "\n";  // false
+    std::cout << std::boolalpha << sv7.starts_with("Hello") << "\n";  // true
     std::cout << std::boolalpha << sv7.ends_with("World!") << "\n";   // true
     std::cout << std::boolalpha << sv7.contains("World") << "\n";     // true
     
@@ -82,7 +103,213 @@ void test_string_view() {
     std::cout << sv7.find_last_not_of("World!") << "\n"; // 6
 }
 
+void test_multi_searcher() {
+    std::cout << "Multi searcher:\n";
+    const bsv::multi_searcher searcher {"he", "she", "his", "hers"};
+    std::vector<bsv::multi_searcher::match_type> matches;
+    searcher.find_all("ushers", std::back_inserter(matches));
+    for (const auto& m : matches) {
+        std::cout << m.pattern << "@" << m.pos << " ";  // 1@1 0@2 3@2
+    }
+    std::cout << "\n";
+
+    const auto first = searcher.find_leftmost_longest("ushers");
+    std::cout << first.pattern << "@" << first.pos << "\n";  // 1@1
+}
+
+void test_string_map() {
+    using namespace bsv::literals;
+    std::cout << "String map:\n";
+    bsv::string_map<int> counts;
+    for (bsv::string_view word : {"GET", "POST", "GET", "PUT", "GET"}) {
+        ++counts[word];
+    }
+    std::cout << counts.at("GET") << " " << counts.size() << "\n";                       // 3 3
+    std::cout << std::boolalpha << counts.contains("DELETE") << "\n";                   // false
+
+    counts.erase("POST");
+    const bsv::string_map<int> copy = counts;
+    std::cout << copy.at("GET") << " " << copy.at("PUT") << " " << copy.contains("POST") << "\n";   // 3 1 false
+
+    constexpr auto h = "GET"_hash;
+    std::cout << (h == std::hash<bsv::string_view>{}("GET")) << "\n";                   // true
+}
+
+void test_split() {
+    std::cout << "Split:\n";
+    for (bsv::string_view field : bsv::split(bsv::string_view("a,,b,"), ',')) {
+        std::cout << "[" << field << "]";                                               // [a][][b][]
+    }
+    std::cout << "\n";
+    for (bsv::string_view word : bsv::split_whitespace(bsv::string_view("  one\ttwo \n three "))) {
+        std::cout << "[" << word << "]";                                                // [one][two][three]
+    }
+    std::cout << "\n";
+    std::cout << std::ranges::distance(bsv::lines(bsv::string_view("\n"))) << " "
+              << std::ranges::distance(bsv::lines(bsv::string_view("a\nb\n"))) << "\n";          // 1 2
+}
+
+void test_intern_pool() {
+    std::cout << "Intern pool:\n";
+    bsv::intern_pool pool;
+    std::string label = "region=eu";
+    const auto a = pool.intern("region=eu");
+    const auto b = pool.intern(bsv::string_view(label.data(), label.size()));
+    std::cout << std::boolalpha << (a == b) << " " << (a.view.data() == b.view.data()) << "\n";   // true true
+    std::cout << pool.intern("region=us").id << " " << pool.size() << "\n";                   // 1 2
+}
+
+void test_parse() {
+    std::cout << "Parse:\n";
+    std::cout << bsv::parse<int>("-42").value << " " << bsv::parse<double>("2.5e3").value << "\n";     // -42 2500
+    std::cout << std::boolalpha << bool(bsv::parse<int>("12x")) << " "
+              << (bsv::parse<std::uint8_t>("300").ec == std::errc::result_out_of_range) << "\n";      // true true
+}
+
+void test_csv() {
+    std::cout << "CSV:\n";
+    bsv::csv_parser parser;
+    parser.parse("id,name\n1,\"Smith, \"\"J\"\"\"\n", true, [](const bsv::csv_record& record) {
+        for (bsv::string_view field : record) {
+            std::cout << "[" << field << "]";                                           // [id][name]
+        }                                                                               // [1][Smith, "J"]
+        std::cout << "\n";
+    });
+}
+
+void test_utf8() {
+    std::cout << "UTF-8:\n";
+    const bsv::u8string_view text = u8"na\u00efve \u6f22\u5b57 \U0001F600";
+    std::cout << bsv::validate_utf8(text) << " " << text.size() << " " << bsv::count_utf8(text) << "\n";   // true 18 10
+    std::vector<char16_t> utf16(bsv::utf16_length_from_utf8(text));
+    std::cout << bsv::utf8_to_utf16(text, utf16.data()).count << "\n";                                   // 11
+    const char broken[] = "ab\xE2\x82";
+    const bsv::utf_result r = bsv::validate_utf8_with_errors(bsv::string_view(broken));
+    std::cout << (r.error == bsv::utf_error::too_short) << " " << r.count << "\n";                       // true 2
+}
+
+void test_ci_string_view() {
+    std::cout << "ci_string_view:\n";
+    const bsv::ci_string_view header = "Content-Type: text/HTML";
+    std::cout << header.starts_with("content-type") << " " << header.find("html") << " "
+              << (bsv::ci_string_view("ETag") == bsv::ci_string_view("etag")) << "\n";                  // true 19 true
+    static_assert(std::is_same_v<decltype(header <=> header), std::weak_ordering>);
+}
+
+void test_stream_searcher() {
+    std::cout << "stream_searcher:\n";
+    bsv::stream_searcher searcher("boundary");
+    for (bsv::string_view chunk : {"--bou", "ndary\r\n--b", "oundary--"}) {
+        searcher.feed(chunk, [](std::size_t pos) { std::cout << pos << " "; });                      // 2 14
+    }
+    std::cout << "\n";
+}
+
+void test_parallel() {
+    std::cout << "parallel:\n";
+    bsv::thread_pool pool(2);
+    const bsv::parallel_policy policy(pool, 4);
+    const bsv::string_view log = "ok\nok\nerror\nok\nerror\n";
+    std::cout << bsv::parallel_find(policy, log, "error") << " " << bsv::parallel_rfind(policy, log, "error") << " "
+              << bsv::parallel_count(policy, log, '\n') << "\n";                                          // 6 15 5
+}
+
+void test_segmented_view() {
+    std::cout << "segmented_view:\n";
+    const bsv::segmented_view body = {"Content-Ty", "pe: text/pl", "ain\r\n\r\nhello"};
+    std::cout << body.size() << " " << body[12] << " " << body.find("text/plain") << " " << body.rfind("\r\n") << " "
+              << body.starts_with("Content-Type") << " " << body.substr(14, 10).str() << "\n";    // 33 : 14 26 true text/plain
+}
+
+void test_output_builder() {
+    std::cout << "output_builder:" << std::endl;
+    bsv::output_builder out(1);
+    const bsv::string_view status = "200 OK";
+    out << "HTTP/1.1 " << status << '\n';
+    const bsv::flush_stats stats = out.flush();
+    std::cout << stats.bytes << " bytes in " << stats.syscalls << " writev\n";                       // 16 bytes in 1 writev
+}
+
+void test_compact_view() {
+    std::cout << "compact_view:\n";
+    std::vector<bsv::compact_view> keys = {"zebra", "applesauce-with-cinnamon", "apple", "applesauce"};
+    std::sort(keys.begin(), keys.end());
+    for (const bsv::compact_view k : keys) {
+        std::cout << k.view() << (k.is_inline() ? "* " : " ");      // apple* applesauce* applesauce-with-cinnamon zebra*
+    }
+    std::cout << "\n" << sizeof(bsv::compact_view) << " " << keys[2].find("cinnamon") << "\n";    // 16 16
+}
+
+void test_string_sort() {
+    std::cout << "string_sort:\n";
+    std::vector<bsv::string_view> paths = {"/usr/lib", "/usr", "/etc/hosts", "/usr/bin", "/etc"};
+    bsv::string_sort(paths.begin(), paths.end());
+    for (const bsv::string_view p : paths) {
+        std::cout << p << " ";                                                          // /etc /etc/hosts /usr /usr/bin /usr/lib
+    }
+    std::cout << "\n";
+}
+
+void test_heavy_hitters() {
+    std::cout << "heavy_hitters:\n";
+    bsv::heavy_hitters_options options;
+    options.k = 2;
+    bsv::heavy_hitters hh(options);
+    for (const bsv::string_view word : bsv::split(bsv::string_view("a b a c a b d a b e"), ' ')) {
+        hh.add(word);
+    }
+    for (const auto& e : hh.top()) {
+        std::cout << e.key << "=" << e.count << " ";                                     // a=4 b=3
+    }
+    std::cout << "\n";
+}
+
+void test_fixed_string() {
+    std::cout << "fixed_string:\n";
+    const bsv::string_view head = "POST /items HTTP/1.1\r\nContent-Length: 42\r\n\r\nbody";
+    const std::size_t at = bsv::find<"Content-Length:">(head);
+    std::cout << at << " " << bsv::find<"\r\n\r\n">(head) << " " << bsv::starts_with<"POST ">(head)
+              << " " << bsv::contains<"GET ">(head) << "\n";                                // 22 40 true false
+}
+
+void test_line_index() {
+    std::cout << "line_index:\n";
+    const bsv::string_view log = "GET /\nPOST /items\n\nGET /health";
+    const bsv::line_index index(log);
+    std::cout << index.lines() << " [" << index.line(1) << "] [" << index.line(2) << "] [" << index.line(3) << "] "
+              << index.line_of(log.find("health")) << "\n";                                   // 4 [POST /items] [] [GET /health] 3
+}
+
+void test_glob() {
+    std::cout << "glob:\n";
+    const bsv::glob route("/api/*/users/?\?/profile*");
+    std::cout << route.matches("/api/v1/users/42/profile.json") << " " << route.matches("/api/v1/x/users/42/profile") << "\n"; // true false
+    bsv::glob_set acl;
+    acl.add("/static/**/*.js");
+    acl.add("/api/**");
+    std::cout << acl.match("/static/app/v2/main.js") << " " << acl.match("/api") << " "
+              << (acl.match("/index.html") == bsv::glob_set::npos) << "\n";                     // 0 1 true
+}
+
 int main() {
     test_string_view();
+    test_multi_searcher();
+    test_string_map();
+    test_split();
+    test_intern_pool();
+    test_parse();
+    test_csv();
+    test_utf8();
+    test_ci_string_view();
+    test_stream_searcher();
+    test_parallel();
+    test_segmented_view();
+    test_output_builder();
+    test_compact_view();
+    test_string_sort();
+    test_heavy_hitters();
+    test_fixed_string();
+    test_line_index();
+    test_glob();
     return 0;
 }
@@ -0,0 +1,89 @@
+/*
+A read-only memory-mapped file exposed as a bsv::string_view, so a file can be searched or split in place
+without being read into a std::string first (POSIX mmap).
+Files larger than the address window budget are mapped one window at a time. Every window but the last ends
+right after a '\n', so each view holds whole lines and lines(view()) never sees a line cut in two.
+*/
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include "string_view.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace bsv {
+
+    // madvise hints, combined with |. They are only hints: the kernel may ignore them (hugepage, in particular,
+    // needs a kernel with transparent huge pages for the page cache), so failing to apply one is not an error.
+    enum class map_advice : unsigned {
+        normal     = 0,
+        sequential = 1 << 0,    // MADV_SEQUENTIAL: aggressive read-ahead, pages freed soon after use
+        random     = 1 << 1,    // MADV_RANDOM: no read-ahead
+        willneed   = 1 << 2,    // MADV_WILLNEED: start reading the whole window now
+        hugepage   = 1 << 3     // MADV_HUGEPAGE
+    };
+
+    constexpr map_advice operator| (map_advice a, map_advice b) noexcept;
+    constexpr bool has_advice (map_advice set, map_advice a) noexcept;
+
+    struct map_options {
+        map_advice advice = map_advice::normal;
+        bool populate = false;              // MAP_POPULATE: fault the whole window in up front
+        std::size_t window = 0;             // max bytes mapped at once (rounded up to pages); 0 maps the whole file
+    };
+
+    class mapped_file {
+        public:
+            using size_type = std::size_t;
+            using view_type = string_view;
+
+        private:
+            int fd_ = -1;
+            size_type file_size_ = 0;
+            map_options options_;
+            void* map_ = nullptr;               // current mapping
+            size_type map_length_ = 0;
+            size_type map_offset_ = 0;          // file offset of map_ (page aligned)
+            size_type begin_ = 0;               // [begin_, end_) is the current window, in file offsets
+            size_type end_ = 0;
+
+            void map_window (size_type begin);
+            void unmap() noexcept;
+
+        public:
+            mapped_file() noexcept = default;
+            explicit mapped_file (const std::string& path, map_options options = {});
+            ~mapped_file();
+
+            mapped_file (const mapped_file&) = delete;
+            mapped_file& operator= (const mapped_file&) = delete;
+            mapped_file (mapped_file&& other) noexcept;
+            mapped_file& operator= (mapped_file&& other) noexcept;
+
+            // Contents of the current window (the whole file unless options.window is set).
+            view_type view() const noexcept;
+            size_type offset() const noexcept;          // file offset of view().data()
+            size_type file_size() const noexcept;
+            bool is_open() const noexcept;
+
+            // Maps the window that follows the current one. Returns false, leaving the view empty, at end of file.
+            bool next_window();
+
+            void close() noexcept;
+            void swap (mapped_file& other) noexcept;
+    };
+
+} // namespace bsv
+
+#include "mapped_file.impl.hpp"
+
+#endif // MAPPED_FILE_HPP
+
+/*
+Methods                           Time Complexity      Auxiliary Space
+mapped_file(path, options)        O(1) (O(window) page faults with populate or willneed)
+view()                            O(1)                 O(1)
+next_window()                     O(1) + a backward scan for the last '\n' of the window
+*/
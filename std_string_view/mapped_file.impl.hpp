@@ -0,0 +1,189 @@
+#ifndef MAPPED_FILE_IMPL_HPP
+#define MAPPED_FILE_IMPL_HPP
+
+#include "mapped_file.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bsv {
+    constexpr map_advice operator| (map_advice a, map_advice b) noexcept {
+        return static_cast<map_advice>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+    }
+
+    constexpr bool has_advice (map_advice set, map_advice a) noexcept {
+        return (static_cast<unsigned>(set) & static_cast<unsigned>(a)) != 0;
+    }
+
+
+    // ctors -------------------------------------------------------------------------------------------------------------------------
+
+    inline mapped_file::mapped_file (const std::string& path, map_options options) : options_(options) {
+        fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "mapped_file: open " + path);
+        }
+        struct stat st {};
+        if (::fstat(fd_, &st) != 0) {
+            const int err = errno;
+            close();
+            throw std::system_error(err, std::generic_category(), "mapped_file: fstat " + path);
+        }
+        file_size_ = static_cast<size_type>(st.st_size);
+        try {
+            map_window(0);
+        } catch (...) {
+            close();
+            throw;
+        }
+        // The whole file is mapped: the mapping keeps it alive, the descriptor is no longer needed.
+        if (map_ != nullptr && end_ == file_size_) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    inline mapped_file::~mapped_file() {
+        close();
+    }
+
+    inline mapped_file::mapped_file (mapped_file&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1)), file_size_(std::exchange(other.file_size_, 0)), options_(other.options_),
+          map_(std::exchange(other.map_, nullptr)), map_length_(std::exchange(other.map_length_, 0)),
+          map_offset_(std::exchange(other.map_offset_, 0)), begin_(std::exchange(other.begin_, 0)),
+          end_(std::exchange(other.end_, 0))
+    {}
+
+    inline mapped_file& mapped_file::operator= (mapped_file&& other) noexcept {
+        if (this != &other) {
+            mapped_file(std::move(other)).swap(*this);
+        }
+        return *this;
+    }
+
+
+    // Mapping -----------------------------------------------------------------------------------------------------------------------
+
+    // Maps [begin, begin + window) rounded out to pages, then trims the window back to just after its last '\n'.
+    // A line longer than the window makes the mapping grow until the line fits.
+    inline void mapped_file::map_window (size_type begin) {
+        unmap();
+        begin_ = end_ = std::min(begin, file_size_);
+        if (begin_ == file_size_) {
+            return;
+        }
+        const size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+        map_offset_ = begin_ & ~(page - 1);
+        size_type want = options_.window == 0 ? file_size_ : (options_.window + page - 1) & ~(page - 1);
+        int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+        if (options_.populate) {
+            flags |= MAP_POPULATE;
+        }
+#endif
+        for (;;) {
+            map_length_ = std::min(want, file_size_ - map_offset_);
+            map_ = ::mmap(nullptr, map_length_, PROT_READ, flags, fd_, static_cast<off_t>(map_offset_));
+            if (map_ == MAP_FAILED) {
+                map_ = nullptr;
+                map_length_ = 0;
+                begin_ = end_ = file_size_;
+                throw std::system_error(errno, std::generic_category(), "mapped_file: mmap");
+            }
+            end_ = map_offset_ + map_length_;
+            if (end_ == file_size_) {
+                break;
+            }
+            const view_type mapped(static_cast<const char*>(map_) + (begin_ - map_offset_), end_ - begin_);
+            if (const size_type last = mapped.rfind('\n'); last != view_type::npos) {
+                end_ = begin_ + last + 1;
+                break;
+            }
+            ::munmap(map_, map_length_);
+            map_ = nullptr;
+            want *= 2;
+        }
+
+        const auto advise = [this](map_advice a, int advice) {
+            if (has_advice(options_.advice, a)) {
+                ::madvise(map_, map_length_, advice);
+            }
+        };
+        advise(map_advice::sequential, MADV_SEQUENTIAL);
+        advise(map_advice::random, MADV_RANDOM);
+        advise(map_advice::willneed, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+        advise(map_advice::hugepage, MADV_HUGEPAGE);
+#endif
+    }
+
+    inline void mapped_file::unmap() noexcept {
+        if (map_ != nullptr) {
+            ::munmap(map_, map_length_);
+        }
+        map_ = nullptr;
+        map_length_ = map_offset_ = 0;
+    }
+
+    inline bool mapped_file::next_window() {
+        if (fd_ < 0 || end_ >= file_size_) {
+            unmap();
+            begin_ = end_ = file_size_;
+            return false;
+        }
+        map_window(end_);
+        return true;
+    }
+
+    inline void mapped_file::close() noexcept {
+        unmap();
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = -1;
+        file_size_ = begin_ = end_ = 0;
+    }
+
+    inline void mapped_file::swap (mapped_file& other) noexcept {
+        std::swap(fd_, other.fd_);
+        std::swap(file_size_, other.file_size_);
+        std::swap(options_, other.options_);
+        std::swap(map_, other.map_);
+        std::swap(map_length_, other.map_length_);
+        std::swap(map_offset_, other.map_offset_);
+        std::swap(begin_, other.begin_);
+        std::swap(end_, other.end_);
+    }
+
+
+    // Element access ----------------------------------------------------------------------------------------------------------------
+
+    inline auto mapped_file::view() const noexcept -> view_type {
+        if (map_ == nullptr) {
+            return view_type();
+        }
+        return view_type(static_cast<const char*>(map_) + (begin_ - map_offset_), end_ - begin_);
+    }
+
+    inline auto mapped_file::offset() const noexcept -> size_type {
+        return begin_;
+    }
+
+    inline auto mapped_file::file_size() const noexcept -> size_type {
+        return file_size_;
+    }
+
+    inline bool mapped_file::is_open() const noexcept {
+        return map_ != nullptr || fd_ >= 0;
+    }
+
+} // namespace bsv
+
+#endif // MAPPED_FILE_IMPL_HPP
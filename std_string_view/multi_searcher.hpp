@@ -0,0 +1,113 @@
+/*
+Aho-Corasick multi-pattern matcher over basic_string_view. 
+The patterns are compiled once into a dense DFA over byte equivalence classes (every byte that occurs in some pattern 
+gets its own class, all the others share class 0), so a scan is one table load per input byte, whatever the number 
+of patterns is.
+*/
+
+#ifndef MULTI_SEARCHER_HPP
+#define MULTI_SEARCHER_HPP
+
+#include "string_view.hpp"
+#include "simd.hpp"
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace bsv {
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class basic_multi_searcher {
+        static_assert(sizeof(CharT) == 1, "basic_multi_searcher works on byte-sized code units");
+
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using size_type = typename view_type::size_type;
+
+            // A match of pattern number `pattern` (its index in the construction sequence) at [pos, pos + length).
+            struct match_type {
+                size_type pattern;
+                size_type pos;
+                size_type length;
+            };
+
+            // automatic turns the start-byte prefilter on only when few distinct bytes can begin a match.
+            enum class prefilter_mode { automatic, always, never };
+
+            static constexpr size_type npos = view_type::npos;
+
+            // Where a scan over successive chunks of one stream stands: the automaton state after the last chunk and the 
+            // stream offset of the next one. A default constructed stream_state starts a new stream.
+            struct stream_state {
+                std::uint32_t state = 0;
+                size_type offset = 0;
+            };
+
+        private:
+            using state_type = std::uint32_t;
+            static constexpr state_type match_flag = state_type(1) << 31;
+
+            std::array<std::uint16_t, 256> classes_ {};  // byte -> equivalence class
+            size_type stride_ = 1;                       // number of classes
+            std::vector<state_type> delta_;              // premultiplied by stride_, match_flag marks states with output
+            std::vector<std::uint32_t> depth_;           // length of the trie path of every state
+            std::vector<std::uint32_t> out_begin_;       // CSR index into out_ids_, one entry per state + 1
+            std::vector<std::uint32_t> out_ids_;
+            std::vector<std::uint32_t> dict_;            // nearest state on the failure chain that ends a pattern
+            std::vector<size_type> lengths_;             // pattern lengths, by pattern id
+            simd::byte_set starts_;                      // bytes that can begin a match
+            bool prefilter_ = false;
+
+        public:
+            template <typename InputIt>
+            basic_multi_searcher (InputIt first, InputIt last, prefilter_mode mode = prefilter_mode::automatic);
+            basic_multi_searcher (std::initializer_list<view_type> patterns, prefilter_mode mode = prefilter_mode::automatic);
+
+        public: // Capacity
+            size_type pattern_count() const noexcept;
+            size_type state_count() const noexcept;
+            size_type memory_usage() const noexcept;
+            bool uses_prefilter() const noexcept;
+
+        public: // Operations
+            // Calls f(match_type) for every occurrence of every pattern, in order of the match end. Overlapping matches are 
+            // all reported. If f returns bool, returning false stops the scan.
+            template <typename F>
+            void for_each_match (view_type text, F f) const;
+
+            // for_each_match on the next chunk of a stream. Matches may start in earlier chunks; their pos is the offset in 
+            // the stream. Only the automaton state is carried over, nothing is copied. Returns false if f stopped the scan.
+            template <typename F>
+            bool for_each_match (stream_state& stream, view_type chunk, F f) const;
+
+            template <typename OutputIt>
+            OutputIt find_all (view_type text, OutputIt out) const;
+
+            // The match that starts first, the longest one among those starting at the same position. pos == npos if none.
+            match_type find_leftmost_longest (view_type text) const;
+
+            bool contains_any (view_type text) const;
+
+        private:
+            void compile (const std::vector<view_type>& patterns, prefilter_mode mode);
+            std::uint16_t class_of (CharT ch) const noexcept;
+    };
+
+    using multi_searcher = basic_multi_searcher<char>;
+    using u8multi_searcher = basic_multi_searcher<char8_t>;
+
+} // namespace bsv
+
+#include "multi_searcher.impl.hpp"
+
+#endif // MULTI_SEARCHER_HPP
+
+/*
+Methods                                 Time Complexity             Auxiliary Space
+multi_searcher (construction)           O(M * classes)              O(M * classes)      M - total pattern length
+multi_searcher::for_each_match()        O(N + matches)              O(1)
+multi_searcher::for_each_match(stream)  O(chunk + matches)          O(1)
+multi_searcher::find_leftmost_longest() O(N)                        O(1)
+multi_searcher::contains_any()          O(N)                        O(1)
+*/
@@ -0,0 +1,288 @@
+#ifndef MULTI_SEARCHER_IMPL_HPP
+#define MULTI_SEARCHER_IMPL_HPP
+
+#include "multi_searcher.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace bsv {
+    // ctors -------------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    template <typename InputIt>
+    basic_multi_searcher<CharT, Traits>::basic_multi_searcher (InputIt first, InputIt last, prefilter_mode mode) {
+        std::vector<view_type> patterns;
+        for (auto it = first; it != last; ++it) {
+            patterns.emplace_back(*it);
+        }
+        compile(patterns, mode);
+    }
+
+    template <typename CharT, typename Traits>
+    basic_multi_searcher<CharT, Traits>::basic_multi_searcher (std::initializer_list<view_type> patterns, prefilter_mode mode) {
+        compile(std::vector<view_type>(patterns.begin(), patterns.end()), mode);
+    }
+
+    // Builds the trie directly into the dense table, then fills the missing transitions in BFS order, so that 
+    // delta_[s + c] is already the Aho-Corasick goto/fail closure and the scan never follows a failure link.
+    /// NOTE: the outputs of a state are its own patterns plus those of its dictionary suffix link (the nearest state on 
+    ///       the failure chain that ends a pattern), so memory stays linear even for patterns like a, aa, aaa, ...
+    template <typename CharT, typename Traits>
+    void basic_multi_searcher<CharT, Traits>::compile (const std::vector<view_type>& patterns, prefilter_mode mode) {
+        stride_ = 1;
+        for (const auto& p : patterns) {
+            if (p.empty()) {
+                throw std::invalid_argument("basic_multi_searcher: empty pattern");
+            }
+            for (CharT ch : p) {
+                auto& cls = classes_[static_cast<unsigned char>(ch)];
+                if (cls == 0) {
+                    cls = static_cast<std::uint16_t>(stride_++);
+                }
+            }
+        }
+
+        std::vector<std::vector<std::uint32_t> > own(1);
+        delta_.assign(stride_, 0);
+        depth_.assign(1, 0);
+        lengths_.clear();
+        for (const auto& p : patterns) {
+            state_type s = 0;
+            for (CharT ch : p) {
+                const auto c = class_of(ch);
+                if (delta_[s + c] == 0) {
+                    if (delta_.size() + stride_ >= match_flag) {
+                        throw std::length_error("basic_multi_searcher: too many states");
+                    }
+                    delta_[s + c] = static_cast<state_type>(delta_.size());
+                    depth_.push_back(depth_[s / stride_] + 1);
+                    own.emplace_back();
+                    delta_.resize(delta_.size() + stride_, 0);
+                }
+                s = delta_[s + c];
+            }
+            own[s / stride_].push_back(static_cast<std::uint32_t>(lengths_.size()));
+            lengths_.push_back(p.size());
+            starts_.insert(static_cast<unsigned char>(p.front()));
+        }
+
+        const size_type states = depth_.size();
+        constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+        std::vector<state_type> fail(states, 0);
+        std::vector<std::uint32_t> dict(states, none);
+        std::vector<state_type> queue;
+        queue.reserve(states);
+        for (size_type c = 0; c < stride_; ++c) {
+            if (delta_[c] != 0) {
+                queue.push_back(delta_[c]);
+            }
+        }
+        for (size_type head = 0; head < queue.size(); ++head) {
+            const state_type s = queue[head];
+            const state_type f = fail[s / stride_];
+            for (size_type c = 0; c < stride_; ++c) {
+                const state_type child = delta_[s + c];
+                if (child == 0) {
+                    delta_[s + c] = delta_[f + c];
+                    continue;
+                }
+                const state_type child_fail = delta_[f + c];
+                fail[child / stride_] = child_fail;
+                dict[child / stride_] = own[child_fail / stride_].empty() ? dict[child_fail / stride_] 
+                                                                           : child_fail / stride_;
+                queue.push_back(child);
+            }
+        }
+
+        // Renumber the states in BFS order: the shallow states, which almost every scan keeps returning to, end up
+        // next to each other in delta_ instead of being spread out in pattern insertion order.
+        std::vector<std::uint32_t> rank(states, 0);
+        for (size_type k = 0; k < queue.size(); ++k) {
+            rank[queue[k] / stride_] = static_cast<std::uint32_t>(k + 1);
+        }
+        std::vector<state_type> delta(delta_.size());
+        std::vector<std::uint32_t> depth(states);
+        std::vector<std::vector<std::uint32_t> > own_ranked(states);
+        dict_.assign(states, none);
+        for (size_type s = 0; s < states; ++s) {
+            const size_type r = rank[s];
+            for (size_type c = 0; c < stride_; ++c) {
+                delta[r * stride_ + c] = rank[delta_[s * stride_ + c] / stride_] * static_cast<state_type>(stride_);
+            }
+            depth[r] = depth_[s];
+            own_ranked[r] = std::move(own[s]);
+            dict_[r] = dict[s] == none ? none : rank[dict[s]];
+        }
+        delta_ = std::move(delta);
+        depth_ = std::move(depth);
+        own = std::move(own_ranked);
+
+        out_begin_.assign(states + 1, 0);
+        out_ids_.clear();
+        for (size_type s = 0; s < states; ++s) {
+            out_begin_[s] = static_cast<std::uint32_t>(out_ids_.size());
+            out_ids_.insert(out_ids_.end(), own[s].begin(), own[s].end());
+        }
+        out_begin_[states] = static_cast<std::uint32_t>(out_ids_.size());
+
+        for (auto& next : delta_) {
+            const size_type t = next / stride_;
+            if (!own[t].empty() || dict_[t] != none) {
+                next |= match_flag;
+            }
+        }
+
+        switch (mode) {
+            case prefilter_mode::always: prefilter_ = true; break;
+            case prefilter_mode::never: prefilter_ = false; break;
+            case prefilter_mode::automatic: prefilter_ = starts_.count() <= 16; break;
+        }
+    }
+
+    template <typename CharT, typename Traits>
+    std::uint16_t basic_multi_searcher<CharT, Traits>::class_of (CharT ch) const noexcept {
+        return classes_[static_cast<unsigned char>(ch)];
+    }
+
+
+    // Capacity ----------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    auto basic_multi_searcher<CharT, Traits>::pattern_count() const noexcept -> size_type {
+        return lengths_.size();
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_multi_searcher<CharT, Traits>::state_count() const noexcept -> size_type {
+        return depth_.size();
+    }
+
+    // Bytes held by the compiled automaton.
+    template <typename CharT, typename Traits>
+    auto basic_multi_searcher<CharT, Traits>::memory_usage() const noexcept -> size_type {
+        return sizeof(*this) 
+             + delta_.capacity() * sizeof(state_type)
+             + (depth_.capacity() + out_begin_.capacity() + out_ids_.capacity() + dict_.capacity()) * sizeof(std::uint32_t)
+             + lengths_.capacity() * sizeof(size_type);
+    }
+
+    template <typename CharT, typename Traits>
+    bool basic_multi_searcher<CharT, Traits>::uses_prefilter() const noexcept {
+        return prefilter_;
+    }
+
+
+    // Operations --------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    template <typename F>
+    void basic_multi_searcher<CharT, Traits>::for_each_match (view_type text, F f) const {
+        stream_state stream;
+        for_each_match(stream, text, f);
+    }
+
+    // The scan is one table load per byte. While the automaton sits in the root state nothing can be matched until a start 
+    // byte shows up, so with the prefilter on, that stretch is skipped by the vector byte-set scan.
+    template <typename CharT, typename Traits>
+    template <typename F>
+    bool basic_multi_searcher<CharT, Traits>::for_each_match (stream_state& stream, view_type chunk, F f) const {
+        constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+        const auto* p = reinterpret_cast<const unsigned char*>(chunk.data());
+        const size_type n = chunk.size();
+        const size_type base = stream.offset;
+        stream.offset += n;
+        // Local copies: f may write through references, which would otherwise force a reload of these every byte.
+        const state_type* delta = delta_.data();
+        const std::uint16_t* classes = classes_.data();
+        const bool prefilter = prefilter_;
+        state_type s = stream.state;
+        for (size_type i = 0; i < n; ++i) {
+            if (prefilter && s == 0) {
+                i += simd::find_first_in(p + i, n - i, starts_);
+                if (i == n) { 
+                    break; 
+                }
+            }
+            const state_type next = delta[s + classes[p[i]]];
+            s = next & ~match_flag;
+            if ((next & match_flag) == 0) {
+                continue;
+            }
+            for (std::uint32_t t = s / stride_; t != none; t = dict_[t]) {
+                const size_type length = depth_[t];
+                for (auto k = out_begin_[t]; k != out_begin_[t + 1]; ++k) {
+                    const match_type m {out_ids_[k], base + i + 1 - length, length};
+                    if constexpr (std::is_same_v<std::invoke_result_t<F&, const match_type&>, bool>) {
+                        if (!f(m)) { 
+                            stream.state = s;
+                            return false; 
+                        }
+                    } else {
+                        f(m);
+                    }
+                }
+            }
+        }
+        stream.state = s;
+        return true;
+    }
+
+    template <typename CharT, typename Traits>
+    template <typename OutputIt>
+    OutputIt basic_multi_searcher<CharT, Traits>::find_all (view_type text, OutputIt out) const {
+        for_each_match(text, [&out](const match_type& m) { *out++ = m; });
+        return out;
+    }
+
+    // Any match that ends after position i and starts at or before i must have text[start, i] on a trie path, so it starts 
+    // at i + 1 - depth(state) or later. Once that bound passes the best start found so far, the answer is final.
+    template <typename CharT, typename Traits>
+    auto basic_multi_searcher<CharT, Traits>::find_leftmost_longest (view_type text) const -> match_type {
+        const auto* p = reinterpret_cast<const unsigned char*>(text.data());
+        const size_type n = text.size();
+        match_type best {npos, npos, 0};
+        state_type s = 0;
+        for (size_type i = 0; i < n; ++i) {
+            if (s == 0) {
+                if (best.pos != npos) {
+                    break;
+                }
+                if (prefilter_) {
+                    i += simd::find_first_in(p + i, n - i, starts_);
+                    if (i == n) { 
+                        break; 
+                    }
+                }
+            }
+            const state_type next = delta_[s + classes_[p[i]]];
+            s = next & ~match_flag;
+            const size_type si = s / stride_;
+            if (best.pos != npos && best.pos < i + 1 - depth_[si]) {
+                break;
+            }
+            if ((next & match_flag) == 0) {
+                continue;
+            }
+            // The first state on the output chain holds the longest (hence leftmost) patterns ending here.
+            const std::uint32_t t = out_begin_[si] != out_begin_[si + 1] ? static_cast<std::uint32_t>(si) : dict_[si];
+            const size_type length = depth_[t];
+            const size_type pos = i + 1 - length;
+            if (best.pos == npos || pos < best.pos || (pos == best.pos && length > best.length)) {
+                best = {out_ids_[out_begin_[t]], pos, length};
+            }
+        }
+        return best;
+    }
+
+    template <typename CharT, typename Traits>
+    bool basic_multi_searcher<CharT, Traits>::contains_any (view_type text) const {
+        bool found = false;
+        for_each_match(text, [&found](const match_type&) { found = true; return false; });
+        return found;
+    }
+
+} // namespace bsv
+
+#endif // MULTI_SEARCHER_IMPL_HPP
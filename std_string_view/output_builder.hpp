@@ -0,0 +1,108 @@
+/*
+Scatter-gather output to a file descriptor: the views appended are not copied into a stream buffer but recorded as
+iovec entries and written with writev, many per system call (POSIX). Where <sys/uio.h> is missing the entries are
+written one write() per entry instead, in the same order.
+Views shorter than small_copy bytes (separators, a few digits) are copied into a fixed staging buffer instead, merged
+with the neighbouring small pieces into one entry, so that a run of tiny pieces does not cost one iovec each.
+Pending entries are flushed when max_iovecs of them or a full staging buffer have accumulated, on flush(), and on
+destruction. Appended views must stay valid until they are flushed.
+*/
+
+#ifndef OUTPUT_BUILDER_HPP
+#define OUTPUT_BUILDER_HPP
+
+#include "string_view.hpp"
+#include "segmented_view.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#if __has_include(<sys/uio.h>)
+    #include <sys/uio.h>
+    #define BSV_HAS_IOVEC 1
+#endif
+
+namespace bsv {
+    namespace detail {
+    #ifdef BSV_HAS_IOVEC
+        using output_entry = struct ::iovec;
+    #else
+        // The fields of struct iovec, for the one-write()-per-entry fallback.
+        struct output_entry {
+            void* iov_base;
+            std::size_t iov_len;
+        };
+    #endif
+    } // namespace detail
+
+    struct output_options {
+        std::size_t small_copy = 32;        // views shorter than this many bytes are copied (at least 2)
+        std::size_t buffer_size = 8192;     // staging buffer for the copied bytes (at least 1)
+        std::size_t max_iovecs = 1024;      // entries per writev (Linux accepts up to 1024)
+    };
+
+    struct flush_stats {
+        std::size_t bytes = 0;
+        std::size_t syscalls = 0;
+    };
+
+    class output_builder {
+        public:
+            using size_type = std::size_t;
+
+        private:
+            int fd_ = -1;
+            output_options options_;
+            std::vector<detail::output_entry> pending_;
+            std::unique_ptr<char[]> buffer_;
+            size_type used_ = 0;            // bytes of buffer_ taken by pending entries
+            size_type pending_bytes_ = 0;
+            flush_stats totals_;
+
+            void append_bytes (const char* p, size_type n);
+
+        public:
+            // Does not take ownership of fd.
+            explicit output_builder (int fd, output_options options = {});
+            // Flushes what is pending; a write error is ignored here, call flush() first to see it.
+            ~output_builder();
+
+            output_builder (const output_builder&) = delete;
+            output_builder& operator= (const output_builder&) = delete;
+
+        public:
+            template <typename CharT, typename Traits>
+            output_builder& append (basic_string_view<CharT, Traits> v);
+            template <typename CharT, typename Traits>
+            output_builder& append (const basic_segmented_view<CharT, Traits>& v);
+            output_builder& append (char ch);
+
+            // Writes everything pending, resuming after partial writes and EINTR; returns what this flush took.
+            // Throws std::system_error if a write fails; the entries not yet written are dropped.
+            flush_stats flush();
+
+            size_type pending_bytes() const noexcept;
+            size_type pending_iovecs() const noexcept;
+            // Sums over all flushes so far.
+            flush_stats totals() const noexcept;
+            int fd() const noexcept;
+    };
+
+    template <typename CharT, typename Traits>
+    output_builder& operator<< (output_builder& out, basic_string_view<CharT, Traits> v);
+    output_builder& operator<< (output_builder& out, const char* s);
+    output_builder& operator<< (output_builder& out, char ch);
+
+} // namespace bsv
+
+#include "output_builder.impl.hpp"
+
+#endif // OUTPUT_BUILDER_HPP
+
+/*
+Methods                           Time Complexity                 Auxiliary Space
+append(v), |v| >= small_copy      O(1) amortized                  one iovec
+append(v), |v| < small_copy       O(|v|)                          |v| bytes of the staging buffer
+flush()                           O(entries), entries / max_iovecs system calls when nothing is partially written
+*/
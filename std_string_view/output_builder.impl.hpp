@@ -0,0 +1,183 @@
+#ifndef OUTPUT_BUILDER_IMPL_HPP
+#define OUTPUT_BUILDER_IMPL_HPP
+
+#include "output_builder.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#if __has_include(<unistd.h>)
+    #include <unistd.h>
+#elif __has_include(<io.h>)
+    #include <io.h>
+#endif
+
+namespace bsv {
+    namespace detail {
+        // One system call: writev of up to count entries, or without it a write of the first entry. Returns the bytes
+        // written or -1 with errno set.
+        inline std::ptrdiff_t write_entries (int fd, output_entry* entries, std::size_t count) noexcept {
+        #if defined(BSV_HAS_IOVEC)
+            return ::writev(fd, entries, static_cast<int>(count));
+        #elif __has_include(<unistd.h>)
+            (void)count;
+            return ::write(fd, entries->iov_base, entries->iov_len);
+        #else
+            (void)count;
+            return ::_write(fd, entries->iov_base, static_cast<unsigned>(entries->iov_len));
+        #endif
+        }
+    } // namespace detail
+
+    // ctors -------------------------------------------------------------------------------------------------------------------------
+
+    // append(char) hands over a pointer to its parameter, so single bytes are always copied: small_copy and buffer_size
+    // are at least 2 and 1.
+    inline output_builder::output_builder (int fd, output_options options)
+        : fd_(fd), options_(options)
+    {
+        options_.small_copy = std::max<size_type>(options_.small_copy, 2);
+        options_.buffer_size = std::max<size_type>(options_.buffer_size, 1);
+        buffer_.reset(new char[options_.buffer_size]);
+        options_.max_iovecs = std::max<size_type>(options_.max_iovecs, 1);
+        pending_.reserve(options_.max_iovecs);
+    }
+
+    inline output_builder::~output_builder() {
+        try {
+            flush();
+        } catch (...) {
+        }
+    }
+
+
+    // append ------------------------------------------------------------------------------------------------------------------------
+
+    // A small piece copied right behind the previous copied piece extends its entry instead of adding one.
+    inline void output_builder::append_bytes (const char* p, size_type n) {
+        if (n == 0) {
+            return;
+        }
+        if (n < options_.small_copy && n <= options_.buffer_size) {
+            if (used_ + n > options_.buffer_size) {
+                flush();
+            }
+            char* dst = buffer_.get() + used_;
+            std::memcpy(dst, p, n);
+            used_ += n;
+            if (!pending_.empty() && static_cast<char*>(pending_.back().iov_base) + pending_.back().iov_len == dst) {
+                pending_.back().iov_len += n;
+            } else {
+                pending_.push_back(detail::output_entry{dst, n});
+            }
+        } else {
+            pending_.push_back(detail::output_entry{const_cast<char*>(p), n});
+        }
+        pending_bytes_ += n;
+        if (pending_.size() >= options_.max_iovecs) {
+            flush();
+        }
+    }
+
+    template <typename CharT, typename Traits>
+    output_builder& output_builder::append (basic_string_view<CharT, Traits> v) {
+        append_bytes(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(CharT));
+        return *this;
+    }
+
+    template <typename CharT, typename Traits>
+    output_builder& output_builder::append (const basic_segmented_view<CharT, Traits>& v) {
+        for (std::size_t i = 0; i < v.segment_count(); ++i) {
+            append(v.segment(i));
+        }
+        return *this;
+    }
+
+    inline output_builder& output_builder::append (char ch) {
+        append_bytes(&ch, 1);
+        return *this;
+    }
+
+
+    // flush -------------------------------------------------------------------------------------------------------------------------
+
+    // After a partial write the entry it stopped in is trimmed in place and the next call starts there.
+    inline flush_stats output_builder::flush() {
+        flush_stats stats;
+        detail::output_entry* iov = pending_.data();
+        size_type left = pending_.size();
+        int error = 0;
+        while (left != 0) {
+            const std::ptrdiff_t written = detail::write_entries(fd_, iov, std::min(left, options_.max_iovecs));
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                error = errno;
+                break;
+            }
+            ++stats.syscalls;
+            stats.bytes += static_cast<size_type>(written);
+            for (size_type n = static_cast<size_type>(written); n != 0;) {
+                if (n >= iov->iov_len) {
+                    n -= iov->iov_len;
+                    ++iov;
+                    --left;
+                } else {
+                    iov->iov_base = static_cast<char*>(iov->iov_base) + n;
+                    iov->iov_len -= n;
+                    n = 0;
+                }
+            }
+        }
+        pending_.clear();
+        used_ = 0;
+        pending_bytes_ = 0;
+        totals_.bytes += stats.bytes;
+        totals_.syscalls += stats.syscalls;
+        if (error != 0) {
+            throw std::system_error(error, std::generic_category(), "output_builder: write");
+        }
+        return stats;
+    }
+
+
+    // Observers ---------------------------------------------------------------------------------------------------------------------
+
+    inline auto output_builder::pending_bytes() const noexcept -> size_type {
+        return pending_bytes_;
+    }
+
+    inline auto output_builder::pending_iovecs() const noexcept -> size_type {
+        return pending_.size();
+    }
+
+    inline flush_stats output_builder::totals() const noexcept {
+        return totals_;
+    }
+
+    inline int output_builder::fd() const noexcept {
+        return fd_;
+    }
+
+
+    // operator<< --------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    output_builder& operator<< (output_builder& out, basic_string_view<CharT, Traits> v) {
+        return out.append(v);
+    }
+
+    inline output_builder& operator<< (output_builder& out, const char* s) {
+        return out.append(string_view(s));
+    }
+
+    inline output_builder& operator<< (output_builder& out, char ch) {
+        return out.append(ch);
+    }
+
+} // namespace bsv
+
+#endif // OUTPUT_BUILDER_IMPL_HPP
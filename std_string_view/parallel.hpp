@@ -0,0 +1,67 @@
+/*
+Multi-threaded find, rfind, count and find_all over large views (a memory-mapped log as one string_view).
+The candidate start positions are cut into chunks of at least policy.min_chunk units; each chunk is searched with the
+ordinary (vectorized) basic_string_view::find / rfind over a window extended by m - 1 units past its end (m = needle
+length), so a match is found by exactly the chunk it starts in. Results are merged in chunk order.
+find / rfind hand the chunks out from the front / from the back; once a chunk has a match, chunks further away are
+skipped, so the leftmost / rightmost match costs about as much as a sequential scan up to it, split over the threads.
+*/
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include "string_view.hpp"
+#include "thread_pool.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace bsv {
+    // Where and how finely to split the work. The default runs on thread_pool::shared(); called from a task already
+    // running on the pool, the search runs on the calling thread alone.
+    struct parallel_policy {
+        thread_pool* pool = nullptr;
+        std::size_t min_chunk = std::size_t(1) << 20;    // code units per task, at least
+
+        parallel_policy() = default;
+        parallel_policy (thread_pool& p, std::size_t min_chunk_units = std::size_t(1) << 20) noexcept
+            : pool(&p), min_chunk(min_chunk_units)
+        {}
+    };
+
+    // Same results as text.find(needle, pos) / text.rfind(needle, pos).
+    template <typename CharT, typename Traits>
+    std::size_t parallel_find (const parallel_policy& policy, basic_string_view<CharT, Traits> text, 
+                               std::type_identity_t<basic_string_view<CharT, Traits> > needle, std::size_t pos = 0);
+
+    template <typename CharT, typename Traits>
+    std::size_t parallel_rfind (const parallel_policy& policy, basic_string_view<CharT, Traits> text, 
+                                std::type_identity_t<basic_string_view<CharT, Traits> > needle, 
+                                std::size_t pos = basic_string_view<CharT, Traits>::npos);
+
+    // Number of units equal to ch.
+    template <typename CharT, typename Traits>
+    std::size_t parallel_count (const parallel_policy& policy, basic_string_view<CharT, Traits> text, std::type_identity_t<CharT> ch);
+
+    // Number of occurrences of needle, overlapping ones included (text.size() + 1 for an empty needle).
+    template <typename CharT, typename Traits>
+    std::size_t parallel_count (const parallel_policy& policy, basic_string_view<CharT, Traits> text, 
+                                std::type_identity_t<basic_string_view<CharT, Traits> > needle);
+
+    // Writes the position of every occurrence (overlapping ones included) in increasing order.
+    template <typename CharT, typename Traits, typename OutputIt>
+    OutputIt parallel_find_all (const parallel_policy& policy, basic_string_view<CharT, Traits> text, 
+                                std::type_identity_t<basic_string_view<CharT, Traits> > needle, OutputIt out);
+
+} // namespace bsv
+
+#include "parallel.impl.hpp"
+
+#endif // PARALLEL_HPP
+
+/*
+Methods                                   Time Complexity                 Auxiliary Space
+parallel_find / parallel_rfind            O(N / threads) to a match       O(chunks)
+parallel_count(ch / needle)               O(N / threads)                  O(chunks)
+parallel_find_all                         O(N / threads + matches)        O(matches)
+*/
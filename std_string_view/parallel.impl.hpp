@@ -0,0 +1,191 @@
+#ifndef PARALLEL_IMPL_HPP
+#define PARALLEL_IMPL_HPP
+
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace bsv {
+    namespace detail {
+        // Candidate start positions [first, first + count), cut into `chunks` nearly equal pieces.
+        struct chunking {
+            std::size_t first = 0;
+            std::size_t count = 0;
+            std::size_t chunks = 1;
+
+            chunking (const parallel_policy& policy, thread_pool& pool, std::size_t first_pos, std::size_t positions) noexcept
+                : first(first_pos), count(positions)
+            {
+                const std::size_t min_chunk = std::max<std::size_t>(policy.min_chunk, 1);
+                // A few chunks per thread keeps the threads busy when the chunks do not take equally long.
+                chunks = std::clamp<std::size_t>(count / min_chunk, 1, 4 * pool.size());
+            }
+
+            std::size_t begin (std::size_t i) const noexcept { return first + count / chunks * i + std::min(i, count % chunks); }
+            std::size_t end (std::size_t i) const noexcept { return begin(i + 1); }
+        };
+
+        inline thread_pool& pool_of (const parallel_policy& policy) {
+            return policy.pool != nullptr ? *policy.pool : thread_pool::shared();
+        }
+
+        // The window in which the matches starting in [begin, end) are searched.
+        template <typename CharT, typename Traits>
+        basic_string_view<CharT, Traits> window (basic_string_view<CharT, Traits> text, std::size_t begin, std::size_t end, std::size_t m) noexcept {
+            return basic_string_view<CharT, Traits>(text.data() + begin, end - begin + m - 1);
+        }
+
+        inline void atomic_min (std::atomic<std::size_t>& a, std::size_t v) noexcept {
+            std::size_t cur = a.load(std::memory_order_relaxed);
+            while (v < cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+        }
+
+        inline void atomic_max (std::atomic<std::size_t>& a, std::size_t v) noexcept {
+            std::size_t cur = a.load(std::memory_order_relaxed);
+            while (v > cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+        }
+
+        template <typename CharT, typename Traits>
+        std::size_t count_units (basic_string_view<CharT, Traits> text, CharT ch) noexcept {
+            if constexpr (sizeof(CharT) == 1 && std::is_same_v<Traits, std::char_traits<CharT> >) {
+                return simd::count(reinterpret_cast<const unsigned char*>(text.data()), text.size(), static_cast<unsigned char>(ch));
+            } else {
+                std::size_t n = 0;
+                for (const CharT c : text) {
+                    n += Traits::eq(c, ch);
+                }
+                return n;
+            }
+        }
+
+        // Calls f(pos) for every occurrence of needle in text, overlapping ones included.
+        template <typename CharT, typename Traits, typename F>
+        void for_each_occurrence (basic_string_view<CharT, Traits> text, basic_string_view<CharT, Traits> needle, F f) {
+            using view_type = basic_string_view<CharT, Traits>;
+            for (std::size_t pos = text.find(needle); pos != view_type::npos; pos = text.find(needle, pos + 1)) {
+                f(pos);
+            }
+        }
+    } // namespace detail
+
+
+    // find / rfind ------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    std::size_t parallel_find (const parallel_policy& policy, basic_string_view<CharT, Traits> text, 
+                               std::type_identity_t<basic_string_view<CharT, Traits> > needle, std::size_t pos) {
+        using view_type = basic_string_view<CharT, Traits>;
+        const std::size_t m = needle.size();
+        if (pos > text.size() || m > text.size() - pos || m == 0) {
+            return text.find(needle, pos);
+        }
+        thread_pool& pool = detail::pool_of(policy);
+        const detail::chunking chunks(policy, pool, pos, text.size() - pos - m + 1);
+        if (chunks.chunks == 1) {
+            return text.find(needle, pos);
+        }
+        std::atomic<std::size_t> best {view_type::npos};
+        pool.for_each_index(chunks.chunks, [&](std::size_t i) {
+            // A match in an earlier chunk comes first anyway.
+            if (best.load(std::memory_order_relaxed) < chunks.begin(i)) {
+                return;
+            }
+            const std::size_t at = detail::window(text, chunks.begin(i), chunks.end(i), m).find(needle);
+            if (at != view_type::npos) {
+                detail::atomic_min(best, chunks.begin(i) + at);
+            }
+        });
+        return best.load();
+    }
+
+    template <typename CharT, typename Traits>
+    std::size_t parallel_rfind (const parallel_policy& policy, basic_string_view<CharT, Traits> text, 
+                                std::type_identity_t<basic_string_view<CharT, Traits> > needle, std::size_t pos) {
+        using view_type = basic_string_view<CharT, Traits>;
+        const std::size_t m = needle.size();
+        if (m == 0 || m > text.size()) {
+            return text.rfind(needle, pos);
+        }
+        thread_pool& pool = detail::pool_of(policy);
+        const std::size_t last = std::min(pos, text.size() - m);
+        const detail::chunking chunks(policy, pool, 0, last + 1);
+        if (chunks.chunks == 1) {
+            return text.rfind(needle, pos);
+        }
+        constexpr std::size_t none = 0;             // positions are stored + 1
+        std::atomic<std::size_t> best {none};
+        pool.for_each_index(chunks.chunks, [&](std::size_t t) {
+            const std::size_t i = chunks.chunks - 1 - t;
+            if (best.load(std::memory_order_relaxed) > chunks.end(i)) {
+                return;
+            }
+            const std::size_t at = detail::window(text, chunks.begin(i), chunks.end(i), m).rfind(needle);
+            if (at != view_type::npos) {
+                detail::atomic_max(best, chunks.begin(i) + at + 1);
+            }
+        });
+        return best.load() == none ? view_type::npos : best.load() - 1;
+    }
+
+
+    // count / find_all --------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    std::size_t parallel_count (const parallel_policy& policy, basic_string_view<CharT, Traits> text, std::type_identity_t<CharT> ch) {
+        thread_pool& pool = detail::pool_of(policy);
+        const detail::chunking chunks(policy, pool, 0, text.size());
+        std::atomic<std::size_t> total {0};
+        pool.for_each_index(chunks.chunks, [&](std::size_t i) {
+            const auto part = basic_string_view<CharT, Traits>(text.data() + chunks.begin(i), chunks.end(i) - chunks.begin(i));
+            total.fetch_add(detail::count_units(part, ch), std::memory_order_relaxed);
+        });
+        return total.load();
+    }
+
+    template <typename CharT, typename Traits>
+    std::size_t parallel_count (const parallel_policy& policy, basic_string_view<CharT, Traits> text, 
+                                std::type_identity_t<basic_string_view<CharT, Traits> > needle) {
+        const std::size_t m = needle.size();
+        if (m == 0 || m > text.size()) {
+            return m == 0 ? text.size() + 1 : 0;
+        }
+        thread_pool& pool = detail::pool_of(policy);
+        const detail::chunking chunks(policy, pool, 0, text.size() - m + 1);
+        std::atomic<std::size_t> total {0};
+        pool.for_each_index(chunks.chunks, [&](std::size_t i) {
+            std::size_t n = 0;
+            detail::for_each_occurrence(detail::window(text, chunks.begin(i), chunks.end(i), m), needle, [&n](std::size_t) { ++n; });
+            total.fetch_add(n, std::memory_order_relaxed);
+        });
+        return total.load();
+    }
+
+    template <typename CharT, typename Traits, typename OutputIt>
+    OutputIt parallel_find_all (const parallel_policy& policy, basic_string_view<CharT, Traits> text, 
+                                std::type_identity_t<basic_string_view<CharT, Traits> > needle, OutputIt out) {
+        const std::size_t m = needle.size();
+        if (m == 0 || m > text.size()) {
+            for (std::size_t pos = 0; m == 0 && pos <= text.size(); ++pos) {
+                *out++ = pos;
+            }
+            return out;
+        }
+        thread_pool& pool = detail::pool_of(policy);
+        const detail::chunking chunks(policy, pool, 0, text.size() - m + 1);
+        std::vector<std::vector<std::size_t> > found(chunks.chunks);
+        pool.for_each_index(chunks.chunks, [&](std::size_t i) {
+            const std::size_t base = chunks.begin(i);
+            detail::for_each_occurrence(detail::window(text, base, chunks.end(i), m), needle, 
+                                        [&found, i, base](std::size_t pos) { found[i].push_back(base + pos); });
+        });
+        for (const auto& part : found) {
+            out = std::copy(part.begin(), part.end(), out);
+        }
+        return out;
+    }
+
+} // namespace bsv
+
+#endif // PARALLEL_IMPL_HPP
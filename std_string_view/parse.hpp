@@ -0,0 +1,65 @@
+/*
+Locale-free, allocation-free number parsing straight from basic_string_view, with std::from_chars semantics: base 10
+integers, and floating point numbers in the "general" format (fixed or scientific, plus inf / nan).
+Integer digits are converted 8 at a time with SWAR arithmetic (16 at a time with SSE2). Floats take Clinger's exact
+path when the mantissa and the power of ten are both exact doubles, and the Eisel-Lemire algorithm otherwise; the
+rare inputs with more than 19 significant digits are handed to std::from_chars.
+*/
+
+#ifndef PARSE_HPP
+#define PARSE_HPP
+
+#include "string_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <type_traits>
+
+namespace bsv {
+
+    // ec == std::errc() on success. On failure value is T(), and ptr is the first unit of the text for
+    // std::errc::invalid_argument, or just past the number for std::errc::result_out_of_range (as in std::from_chars).
+    template <typename T, typename CharT = char>
+    struct parse_result {
+        T value {};
+        const CharT* ptr = nullptr;
+        std::errc ec {};
+
+        explicit operator bool() const noexcept { return ec == std::errc(); }
+    };
+
+    template <typename T>
+    concept parsable_number = (std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_same_v<T, float>
+                            || std::is_same_v<T, double>;
+
+    // Parses the longest number at the start of text (no leading whitespace, no '+').
+    template <parsable_number T, typename CharT, typename Traits>
+    parse_result<T, CharT> parse (basic_string_view<CharT, Traits> text) noexcept;
+
+    template <parsable_number T>
+    parse_result<T, char> parse (string_view text) noexcept;
+
+    struct parse_column_result {
+        std::size_t parsed = 0;         // fields converted; on failure, the index of the field that failed
+        std::errc ec {};
+
+        explicit operator bool() const noexcept { return ec == std::errc(); }
+    };
+
+    // Converts every field of a range of views into out[0, size), stopping at the first field that is not exactly
+    // one number (trailing characters give std::errc::invalid_argument).
+    template <parsable_number T, typename Range>
+    parse_column_result parse_column (const Range& fields, T* out) noexcept;
+
+} // namespace bsv
+
+#include "parse.impl.hpp"
+
+#endif // PARSE_HPP
+
+/*
+Methods                           Time Complexity      Auxiliary Space
+parse<T>(text)                    O(digits)            O(1)
+parse_column<T>(fields, out)      O(total digits)      O(1)
+*/
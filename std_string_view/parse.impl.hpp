@@ -0,0 +1,376 @@
+#ifndef PARSE_IMPL_HPP
+#define PARSE_IMPL_HPP
+
+#include "parse.hpp"
+#include "parse_tables.hpp"
+
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace bsv {
+    namespace detail {
+        inline bool is_digit (unsigned char ch) noexcept {
+            return static_cast<unsigned char>(ch - '0') < 10;
+        }
+
+        inline std::uint64_t load8 (const unsigned char* p) noexcept {
+            std::uint64_t v;
+            std::memcpy(&v, p, 8);
+            if constexpr (std::endian::native == std::endian::big) {
+                v = __builtin_bswap64(v);
+            }
+            return v;
+        }
+
+        // SWAR: all 8 bytes are in '0'..'9'.
+        inline bool is_eight_digits (std::uint64_t v) noexcept {
+            return ((v & 0xF0F0F0F0F0F0F0F0) | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+        }
+
+        // SWAR: 8 ASCII digits (first digit in the low byte) to their value, pairs then quads then the whole word.
+        inline std::uint32_t parse_eight_digits (std::uint64_t v) noexcept {
+            constexpr std::uint64_t mask = 0x000000FF000000FF;
+            constexpr std::uint64_t mul1 = 100 + (std::uint64_t(1000000) << 32);
+            constexpr std::uint64_t mul2 = 1 + (std::uint64_t(10000) << 32);
+            v -= 0x3030303030303030;
+            v = (v * 10) + (v >> 8);
+            v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+            return static_cast<std::uint32_t>(v);
+        }
+
+        // Number of leading digits in [p, p + 16), needs 16 readable bytes.
+        inline unsigned digit_run16 (const unsigned char* p) noexcept {
+#if defined(__SSE2__)
+            const __m128i t = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+            const __m128i ok = _mm_cmpeq_epi8(_mm_max_epu8(t, _mm_set1_epi8(9)), _mm_set1_epi8(9));
+            return static_cast<unsigned>(std::countr_one(static_cast<unsigned>(_mm_movemask_epi8(ok))));
+#else
+            unsigned n = 0;
+            while (n < 16 && is_digit(p[n])) {
+                ++n;
+            }
+            return n;
+#endif
+        }
+
+        // Value of 16 ASCII digits.
+        inline std::uint64_t parse_sixteen_digits (const unsigned char* p) noexcept {
+#if defined(__SSSE3__)
+            __m128i v = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+            v = _mm_maddubs_epi16(v, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+            v = _mm_madd_epi16(v, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+            v = _mm_packs_epi32(v, v);
+            v = _mm_madd_epi16(v, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+            const auto hi = static_cast<std::uint32_t>(_mm_cvtsi128_si32(v));
+            const auto lo = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(v, 4)));
+            return std::uint64_t(hi) * 100000000 + lo;
+#else
+            return std::uint64_t(parse_eight_digits(load8(p))) * 100000000 + parse_eight_digits(load8(p + 8));
+#endif
+        }
+
+        // Digits at [p, end) into v; stops after at most 19 digits, so v cannot overflow.
+        inline const unsigned char* parse_digits19 (const unsigned char* p, const unsigned char* end, std::uint64_t& v) noexcept {
+            const unsigned char* const stop = end - p > 19 ? p + 19 : end;
+            if (stop - p >= 16) {
+                const unsigned run = digit_run16(p);
+                if (run == 16) {
+                    v = parse_sixteen_digits(p);
+                    p += 16;
+                } else if (run >= 8) {
+                    v = parse_eight_digits(load8(p));
+                    p += 8;
+                }
+            } else if (stop - p >= 8) {
+                if (const std::uint64_t chunk = load8(p); is_eight_digits(chunk)) {
+                    v = parse_eight_digits(chunk);
+                    p += 8;
+                }
+            }
+            for (; p != stop; ++p) {
+                const unsigned digit = static_cast<unsigned char>(*p - '0');
+                if (digit > 9) {
+                    break;
+                }
+                v = v * 10 + digit;
+            }
+            return p;
+        }
+
+        template <typename T>
+        parse_result<T, unsigned char> parse_integer (const unsigned char* first, const unsigned char* end) noexcept {
+            using U = std::make_unsigned_t<T>;
+            const unsigned char* p = first;
+            bool negative = false;
+            if constexpr (std::is_signed_v<T>) {
+                if (p != end && *p == '-') {
+                    negative = true;
+                    ++p;
+                }
+            }
+            const unsigned char* const digits = p;
+            std::uint64_t v = 0;
+            p = parse_digits19(p, end, v);
+            if (p == digits) {
+                return {T(), first, std::errc::invalid_argument};
+            }
+            // Past 19 digits (leading zeros included) every step has to check for overflow.
+            bool overflow = false;
+            for (; p != end && is_digit(*p); ++p) {
+                overflow = overflow || __builtin_mul_overflow(v, 10, &v) || __builtin_add_overflow(v, *p - '0', &v);
+            }
+            const std::uint64_t limit = negative ? std::uint64_t(std::numeric_limits<U>::max() / 2) + 1
+                                                 : std::uint64_t(std::numeric_limits<T>::max());
+            if (overflow || v > limit) {
+                return {T(), p, std::errc::result_out_of_range};
+            }
+            const U magnitude = static_cast<U>(v);
+            return {static_cast<T>(negative ? U(0 - magnitude) : magnitude), p, std::errc()};
+        }
+
+        template <typename T>
+        struct float_format;
+
+        template <>
+        struct float_format<double> {
+            using bits_type = std::uint64_t;
+            static constexpr int mantissa_bits = 52;
+            static constexpr int minimum_exponent = -1023;
+            static constexpr int infinite_power = 0x7FF;
+            static constexpr int min_round_to_even = -4;
+            static constexpr int max_round_to_even = 23;
+            static constexpr int min_fast_exponent = -22;
+            static constexpr int max_fast_exponent = 22;
+            static constexpr int smallest_power_of_ten = -342;
+            static constexpr int largest_power_of_ten = 308;
+            static constexpr double exact_powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                                      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        };
+
+        template <>
+        struct float_format<float> {
+            using bits_type = std::uint32_t;
+            static constexpr int mantissa_bits = 23;
+            static constexpr int minimum_exponent = -127;
+            static constexpr int infinite_power = 0xFF;
+            static constexpr int min_round_to_even = -17;
+            static constexpr int max_round_to_even = 10;
+            static constexpr int min_fast_exponent = -10;
+            static constexpr int max_fast_exponent = 10;
+            static constexpr int smallest_power_of_ten = -65;
+            static constexpr int largest_power_of_ten = 38;
+            static constexpr float exact_powers[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+        };
+
+        __extension__ using u128 = unsigned __int128;
+
+        // w * 10^q rounded to nearest-even, as a biased exponent and a mantissa without the implicit bit (w != 0,
+        // w < 2^64 exact). The 128-bit product with the truncated power of five is always enough to round correctly
+        // (Lemire, "Number Parsing at a Gigabyte per Second", 2021).
+        template <typename T>
+        void eisel_lemire (std::int64_t q, std::uint64_t w, std::uint64_t& mantissa, int& power2) noexcept {
+            using format = float_format<T>;
+            if (q < format::smallest_power_of_ten) {
+                mantissa = 0;
+                power2 = 0;
+                return;
+            }
+            if (q > format::largest_power_of_ten) {
+                mantissa = 0;
+                power2 = format::infinite_power;
+                return;
+            }
+            const int lz = std::countl_zero(w);
+            w <<= lz;
+
+            const std::size_t index = 2 * static_cast<std::size_t>(q - smallest_power_of_five);
+            constexpr std::uint64_t precision_mask = ~std::uint64_t(0) >> (format::mantissa_bits + 3);
+            u128 product = static_cast<u128>(w) * power_of_five_128[index];
+            auto high = static_cast<std::uint64_t>(product >> 64);
+            auto low = static_cast<std::uint64_t>(product);
+            if ((high & precision_mask) == precision_mask) {
+                const auto second = static_cast<std::uint64_t>((static_cast<u128>(w) * power_of_five_128[index + 1]) >> 64);
+                low += second;
+                high += (second > low);
+            }
+
+            const int upperbit = static_cast<int>(high >> 63);
+            const int shift = upperbit + 64 - format::mantissa_bits - 3;
+            mantissa = high >> shift;
+            power2 = static_cast<int>((((152170 + 65536) * q) >> 16) + 63) + upperbit - lz - format::minimum_exponent;
+            if (power2 <= 0) {
+                // Subnormal: shift down to the fixed exponent, then round.
+                if (-power2 + 1 >= 64) {
+                    mantissa = 0;
+                    power2 = 0;
+                    return;
+                }
+                mantissa >>= -power2 + 1;
+                mantissa += (mantissa & 1);
+                mantissa >>= 1;
+                power2 = (mantissa < (std::uint64_t(1) << format::mantissa_bits)) ? 0 : 1;
+                return;
+            }
+            // Exactly halfway between two floats: only possible for small q, and then round to even.
+            if (low <= 1 && q >= format::min_round_to_even && q <= format::max_round_to_even && (mantissa & 3) == 1
+                && (mantissa << shift) == high) {
+                mantissa &= ~std::uint64_t(1);
+            }
+            mantissa += (mantissa & 1);
+            mantissa >>= 1;
+            if (mantissa >= (std::uint64_t(2) << format::mantissa_bits)) {
+                mantissa = std::uint64_t(1) << format::mantissa_bits;
+                ++power2;
+            }
+            mantissa &= ~(std::uint64_t(1) << format::mantissa_bits);
+            if (power2 >= format::infinite_power) {
+                power2 = format::infinite_power;
+                mantissa = 0;
+            }
+        }
+
+        template <typename T>
+        parse_result<T, unsigned char> from_chars_fallback (const unsigned char* first, const unsigned char* end) noexcept {
+            T value {};
+            const auto r = std::from_chars(reinterpret_cast<const char*>(first), reinterpret_cast<const char*>(end), value);
+            return {r.ec == std::errc() ? value : T(), reinterpret_cast<const unsigned char*>(r.ptr), r.ec};
+        }
+
+        template <typename T>
+        parse_result<T, unsigned char> parse_float (const unsigned char* first, const unsigned char* end) noexcept {
+            using format = float_format<T>;
+            const unsigned char* p = first;
+            const bool negative = p != end && *p == '-';
+            p += negative;
+            if (p == end) {
+                return {T(), first, std::errc::invalid_argument};
+            }
+            if (!is_digit(*p) && *p != '.') {
+                return from_chars_fallback<T>(first, end);      // inf, infinity, nan, nan(...), or invalid
+            }
+
+            // Mantissa: integer digits, then fraction digits (the fraction is where long runs usually are).
+            const unsigned char* const integer = p;
+            std::uint64_t w = 0;
+            for (; p != end && is_digit(*p); ++p) {
+                w = w * 10 + (*p - '0');        // may wrap for > 19 digits; such inputs are redone below
+            }
+            std::int64_t digit_count = p - integer;
+            std::int64_t exponent = 0;
+            if (p != end && *p == '.') {
+                ++p;
+                const unsigned char* const fraction = p;
+                while (end - p >= 8 && is_eight_digits(load8(p))) {
+                    w = w * 100000000 + parse_eight_digits(load8(p));
+                    p += 8;
+                }
+                for (; p != end && is_digit(*p); ++p) {
+                    w = w * 10 + (*p - '0');
+                }
+                exponent = fraction - p;
+                digit_count -= exponent;
+            }
+            if (digit_count == 0) {
+                return {T(), first, std::errc::invalid_argument};
+            }
+            if (p != end && (*p == 'e' || *p == 'E')) {
+                const unsigned char* e = p + 1;
+                const bool negative_exponent = e != end && *e == '-';
+                e += (e != end && (*e == '-' || *e == '+'));
+                if (e != end && is_digit(*e)) {
+                    std::int64_t value = 0;
+                    for (; e != end && is_digit(*e); ++e) {
+                        if (value < 0x10000000) {
+                            value = value * 10 + (*e - '0');
+                        }
+                    }
+                    exponent += negative_exponent ? -value : value;
+                    p = e;
+                }
+                // "1e" or "1e+" parse as "1", leaving ptr on the 'e'.
+            }
+
+            if (digit_count > 19) {
+                // Leading zeros do not count; if the significant digits still do not fit in w, let the library round.
+                for (const unsigned char* s = integer; s != p && (*s == '0' || *s == '.'); ++s) {
+                    digit_count -= (*s == '0');
+                }
+                if (digit_count > 19) {
+                    return from_chars_fallback<T>(first, end);
+                }
+            }
+
+            T value;
+            if (w == 0) {
+                value = T(0);
+            } else if (exponent >= format::min_fast_exponent && exponent <= format::max_fast_exponent
+                       && w <= (std::uint64_t(1) << (format::mantissa_bits + 1))) {
+                // Clinger: both w and 10^|exponent| are exact, so one rounding in the multiply or divide.
+                value = static_cast<T>(w);
+                value = exponent < 0 ? value / format::exact_powers[-exponent] : value * format::exact_powers[exponent];
+            } else {
+                std::uint64_t mantissa;
+                int power2;
+                eisel_lemire<T>(exponent, w, mantissa, power2);
+                if (power2 == format::infinite_power || (power2 == 0 && mantissa == 0)) {
+                    return {T(), p, std::errc::result_out_of_range};
+                }
+                using bits_type = typename format::bits_type;
+                value = std::bit_cast<T>(static_cast<bits_type>(mantissa | (bits_type(power2) << format::mantissa_bits)));
+            }
+            return {negative ? -value : value, p, std::errc()};
+        }
+    } // namespace detail
+
+
+    // Parsing -----------------------------------------------------------------------------------------------------------------------
+
+    template <parsable_number T, typename CharT, typename Traits>
+    parse_result<T, CharT> parse (basic_string_view<CharT, Traits> text) noexcept {
+        static_assert(sizeof(CharT) == 1, "bsv::parse: only byte-sized code units are supported");
+        const auto* first = reinterpret_cast<const unsigned char*>(text.data());
+        const auto* end = first + text.size();
+        parse_result<T, unsigned char> r;
+        if constexpr (std::is_integral_v<T>) {
+            r = detail::parse_integer<T>(first, end);
+        } else {
+            r = detail::parse_float<T>(first, end);
+        }
+        return {r.value, text.data() + (r.ptr - first), r.ec};
+    }
+
+    template <parsable_number T>
+    parse_result<T, char> parse (string_view text) noexcept {
+        return parse<T, char, std::char_traits<char> >(text);
+    }
+
+    template <parsable_number T, typename Range>
+    parse_column_result parse_column (const Range& fields, T* out) noexcept {
+        parse_column_result result;
+        for (const auto& field : fields) {
+            const auto r = parse<T>(field);
+            if (r.ec != std::errc()) {
+                result.ec = r.ec;
+                return result;
+            }
+            if (r.ptr != field.data() + field.size()) {
+                result.ec = std::errc::invalid_argument;
+                return result;
+            }
+            out[result.parsed++] = r.value;
+        }
+        return result;
+    }
+
+} // namespace bsv
+
+#endif // PARSE_IMPL_HPP
@@ -0,0 +1,189 @@
+/*
+A read-only view of a sequence of code units stored as a chain of non-contiguous segments (the buffers a request body
+was received into, the pieces of a rope), with the string_view operations that make sense over it: indexing, substr,
+compare, starts_with / ends_with, find / rfind / find_first_of and iteration, without first copying the segments into
+one buffer.
+Every operation runs the basic_string_view kernel on each segment and only handles the seams specially: a match of a
+pattern of length m that crosses a seam starts in the last m - 1 units before it, so find / rfind search the few units
+around each seam copied into a small buffer, and the rest of every segment with basic_string_view::find / rfind.
+The segments are kept with their starting offsets, the first few inline, so that operator[] is a binary search.
+to_iovecs / write_to hand the segments to writev as they are (POSIX).
+*/
+
+#ifndef SEGMENTED_VIEW_HPP
+#define SEGMENTED_VIEW_HPP
+
+#include "string_view.hpp"
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if __has_include(<sys/uio.h>)
+    #include <sys/uio.h>
+    #define BSV_HAS_IOVEC 1
+#endif
+
+namespace bsv {
+    namespace detail {
+        // A vector of trivially copyable elements that keeps the first N inline; past N all of them move to the heap.
+        template <typename T, std::size_t N>
+        class small_vector {
+            private:
+                std::array<T, N> inline_ {};
+                std::vector<T> heap_;
+                std::size_t size_ = 0;
+
+            public:
+                void push_back (const T& value);
+                void clear() noexcept;
+
+                std::size_t size() const noexcept { return size_; }
+                bool empty() const noexcept { return size_ == 0; }
+                const T* data() const noexcept { return size_ <= N ? inline_.data() : heap_.data(); }
+                T* data() noexcept { return size_ <= N ? inline_.data() : heap_.data(); }
+                const T& operator[] (std::size_t i) const noexcept { return data()[i]; }
+                const T* begin() const noexcept { return data(); }
+                const T* end() const noexcept { return data() + size_; }
+                const T& back() const noexcept { return data()[size_ - 1]; }
+        };
+    }
+
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class basic_segmented_view {
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using traits_type = Traits;
+            using value_type = CharT;
+            using size_type = typename view_type::size_type;
+            using difference_type = typename view_type::difference_type;
+            using const_reference = const CharT&;
+
+            static constexpr size_type npos = view_type::npos;
+
+        private:
+            struct piece {
+                view_type view;
+                size_type offset;           // position of view[0] in the whole sequence
+            };
+
+            detail::small_vector<piece, 8> segments_;     // never empty views
+            size_type size_ = 0;
+
+        public:
+            // Iterates the units of all segments in order; incrementing past the end of a segment moves to the next.
+            class const_iterator {
+                private:
+                    const piece* seg_ = nullptr;
+                    size_type i_ = 0;
+
+                    friend class basic_segmented_view;
+                    const_iterator (const piece* seg, size_type i) noexcept : seg_(seg), i_(i) {}
+
+                public:
+                    using iterator_category = std::bidirectional_iterator_tag;
+                    using value_type = CharT;
+                    using difference_type = typename basic_segmented_view::difference_type;
+                    using pointer = const CharT*;
+                    using reference = const CharT&;
+
+                    const_iterator() = default;
+
+                    reference operator*() const noexcept { return seg_->view[i_]; }
+                    pointer operator->() const noexcept { return seg_->view.data() + i_; }
+                    const_iterator& operator++() noexcept;
+                    const_iterator operator++ (int) noexcept { const_iterator old = *this; ++*this; return old; }
+                    const_iterator& operator--() noexcept;
+                    const_iterator operator-- (int) noexcept { const_iterator old = *this; --*this; return old; }
+
+                    friend bool operator== (const const_iterator& a, const const_iterator& b) noexcept {
+                        return a.seg_ == b.seg_ && a.i_ == b.i_;
+                    }
+            };
+            using iterator = const_iterator;
+
+        public:
+            basic_segmented_view() noexcept = default;
+            basic_segmented_view (view_type v);
+            basic_segmented_view (std::initializer_list<view_type> segments);
+            template <typename InputIt>
+            basic_segmented_view (InputIt first, InputIt last);
+
+        public: // Segments
+            // Appends a segment (empty ones are dropped). The units are not copied and must outlive the view.
+            void append (view_type v);
+            void clear() noexcept;
+
+            size_type segment_count() const noexcept;
+            view_type segment (size_type i) const noexcept;
+
+        public: // Iterators
+            const_iterator begin() const noexcept;
+            const_iterator end() const noexcept;
+
+        public: // Element access and capacity
+            const_reference operator[] (size_type pos) const;
+            const_reference at (size_type pos) const;
+            size_type size() const noexcept;
+            [[nodiscard]] bool empty() const noexcept;
+
+        public: // Operations
+            basic_segmented_view substr (size_type pos = 0, size_type count = npos) const;
+            size_type copy (CharT* dest, size_type count, size_type pos = 0) const;
+            std::basic_string<CharT, Traits> str() const;
+
+            int compare (const basic_segmented_view& other) const noexcept;
+            int compare (view_type v) const noexcept;
+
+            bool starts_with (view_type v) const noexcept;
+            bool ends_with (view_type v) const noexcept;
+
+            size_type find (view_type v, size_type pos = 0) const;
+            size_type find (CharT ch, size_type pos = 0) const noexcept;
+            size_type rfind (view_type v, size_type pos = npos) const;
+            size_type rfind (CharT ch, size_type pos = npos) const noexcept;
+            size_type find_first_of (view_type chars, size_type pos = 0) const noexcept;
+
+        #ifdef BSV_HAS_IOVEC
+        public: // Output
+            // Fills out[0, max) with the segments starting at segment first; returns how many were filled.
+            size_type to_iovecs (struct iovec* out, size_type max, size_type first = 0) const noexcept;
+            // Writes all the units to fd with writev, retrying on partial writes and EINTR. Throws std::system_error.
+            void write_to (int fd) const;
+        #endif
+
+        private:
+            // Index of the segment holding pos; pos must be < size().
+            size_type locate (size_type pos) const noexcept;
+            // Whether the units [pos, pos + v.size()) equal v; they must exist.
+            bool equal_at (size_type pos, view_type v) const noexcept;
+            // Copies the units [first, last) into out.
+            void gather (size_type first, size_type last, std::vector<CharT>& out) const;
+    };
+
+    template <typename CharT, typename Traits>
+    bool operator== (const basic_segmented_view<CharT, Traits>& a, const basic_segmented_view<CharT, Traits>& b) noexcept;
+    template <typename CharT, typename Traits>
+    bool operator== (const basic_segmented_view<CharT, Traits>& a, std::type_identity_t<basic_string_view<CharT, Traits> > b) noexcept;
+
+    using segmented_view = basic_segmented_view<char>;
+
+} // namespace bsv
+
+#include "segmented_view.impl.hpp"
+
+#endif // SEGMENTED_VIEW_HPP
+
+/*
+Methods                           Time Complexity                      Auxiliary Space
+operator[] / at                   O(log k)                             O(1)           k - number of segments
+substr(pos, count)                O(log k + segments in the result)    O(segments in the result)
+compare / starts_with             O(min(n, |v|))                       O(1)
+find(v) / rfind(v)                as find on each segment + O(k * m)   O(m)           m - needle length
+find(ch) / find_first_of          as on each segment                   O(1)
+iteration                         O(1) per step                        O(1)
+write_to(fd)                      O(k) system calls at most            O(1)
+*/
@@ -0,0 +1,444 @@
+#ifndef SEGMENTED_VIEW_IMPL_HPP
+#define SEGMENTED_VIEW_IMPL_HPP
+
+#include "segmented_view.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef BSV_HAS_IOVEC
+    #include <cerrno>
+    #include <system_error>
+    #include <unistd.h>
+#endif
+
+namespace bsv {
+    // small_vector ------------------------------------------------------------------------------------------------------------------
+
+    namespace detail {
+        template <typename T, std::size_t N>
+        void small_vector<T, N>::push_back (const T& value) {
+            if (size_ < N) {
+                inline_[size_] = value;
+            } else {
+                if (size_ == N) {
+                    heap_.assign(inline_.begin(), inline_.end());
+                }
+                heap_.push_back(value);
+            }
+            ++size_;
+        }
+
+        template <typename T, std::size_t N>
+        void small_vector<T, N>::clear() noexcept {
+            heap_.clear();
+            size_ = 0;
+        }
+    }
+
+
+    // const_iterator ----------------------------------------------------------------------------------------------------------------
+
+    // The end iterator is (one past the last segment, 0), which is where incrementing past the last unit lands.
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::const_iterator::operator++() noexcept -> const_iterator& {
+        if (++i_ == seg_->view.size()) {
+            ++seg_;
+            i_ = 0;
+        }
+        return *this;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::const_iterator::operator--() noexcept -> const_iterator& {
+        if (i_ == 0) {
+            --seg_;
+            i_ = seg_->view.size();
+        }
+        --i_;
+        return *this;
+    }
+
+
+    // ctors and segments ------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    basic_segmented_view<CharT, Traits>::basic_segmented_view (view_type v) {
+        append(v);
+    }
+
+    template <typename CharT, typename Traits>
+    basic_segmented_view<CharT, Traits>::basic_segmented_view (std::initializer_list<view_type> segments) {
+        for (const view_type v : segments) {
+            append(v);
+        }
+    }
+
+    template <typename CharT, typename Traits>
+    template <typename InputIt>
+    basic_segmented_view<CharT, Traits>::basic_segmented_view (InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            append(view_type(*first));
+        }
+    }
+
+    template <typename CharT, typename Traits>
+    void basic_segmented_view<CharT, Traits>::append (view_type v) {
+        if (!v.empty()) {
+            segments_.push_back(piece{v, size_});
+            size_ += v.size();
+        }
+    }
+
+    template <typename CharT, typename Traits>
+    void basic_segmented_view<CharT, Traits>::clear() noexcept {
+        segments_.clear();
+        size_ = 0;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::segment_count() const noexcept -> size_type {
+        return segments_.size();
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::segment (size_type i) const noexcept -> view_type {
+        return segments_[i].view;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::locate (size_type pos) const noexcept -> size_type {
+        const auto it = std::upper_bound(segments_.begin(), segments_.end(), pos,
+                                         [](size_type p, const piece& s) { return p < s.offset; });
+        return static_cast<size_type>(it - segments_.begin()) - 1;
+    }
+
+    template <typename CharT, typename Traits>
+    void basic_segmented_view<CharT, Traits>::gather (size_type first, size_type last, std::vector<CharT>& out) const {
+        out.clear();
+        for (size_type s = locate(first); first < last; ++s) {
+            const piece& seg = segments_[s];
+            const size_type from = first - seg.offset;
+            const size_type len = std::min(seg.view.size() - from, last - first);
+            out.insert(out.end(), seg.view.data() + from, seg.view.data() + from + len);
+            first += len;
+        }
+    }
+
+
+    // Iterators, element access and capacity ----------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::begin() const noexcept -> const_iterator {
+        return const_iterator(segments_.begin(), 0);
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::end() const noexcept -> const_iterator {
+        return const_iterator(segments_.end(), 0);
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::operator[] (size_type pos) const -> const_reference {
+        const piece& seg = segments_[locate(pos)];
+        return seg.view[pos - seg.offset];
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::at (size_type pos) const -> const_reference {
+        if (pos >= size_) {
+            throw std::out_of_range("basic_segmented_view::at: pos out of range");
+        }
+        return (*this)[pos];
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::size() const noexcept -> size_type {
+        return size_;
+    }
+
+    template <typename CharT, typename Traits>
+    bool basic_segmented_view<CharT, Traits>::empty() const noexcept {
+        return size_ == 0;
+    }
+
+
+    // substr, copy, str -------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    basic_segmented_view<CharT, Traits> basic_segmented_view<CharT, Traits>::substr (size_type pos, size_type count) const {
+        if (pos > size_) {
+            throw std::out_of_range("basic_segmented_view::substr: pos out of range");
+        }
+        const size_type last = pos + std::min(count, size_ - pos);
+        basic_segmented_view result;
+        for (size_type s = (pos < last) ? locate(pos) : segments_.size(); pos < last; ++s) {
+            const piece& seg = segments_[s];
+            const size_type from = pos - seg.offset;
+            const size_type len = std::min(seg.view.size() - from, last - pos);
+            result.append(seg.view.substr(from, len));
+            pos += len;
+        }
+        return result;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::copy (CharT* dest, size_type count, size_type pos) const -> size_type {
+        if (pos > size_) {
+            throw std::out_of_range("basic_segmented_view::copy: pos out of range");
+        }
+        const size_type n = std::min(count, size_ - pos);
+        for (size_type s = (n != 0) ? locate(pos) : segments_.size(), done = 0; done < n; ++s) {
+            const piece& seg = segments_[s];
+            const size_type from = pos + done - seg.offset;
+            done += seg.view.copy(dest + done, n - done, from);
+        }
+        return n;
+    }
+
+    template <typename CharT, typename Traits>
+    std::basic_string<CharT, Traits> basic_segmented_view<CharT, Traits>::str() const {
+        std::basic_string<CharT, Traits> result;
+        result.reserve(size_);
+        for (const piece& seg : segments_) {
+            result.append(seg.view.data(), seg.view.size());
+        }
+        return result;
+    }
+
+
+    // compare -----------------------------------------------------------------------------------------------------------------------
+
+    // Walks both segment lists at once and compares the overlapping pieces with basic_string_view::compare, so each
+    // piece goes through the vector kernel.
+    template <typename CharT, typename Traits>
+    int basic_segmented_view<CharT, Traits>::compare (const basic_segmented_view& other) const noexcept {
+        const piece* a = segments_.begin();
+        const piece* b = other.segments_.begin();
+        size_type i = 0;
+        size_type j = 0;
+        while (a != segments_.end() && b != other.segments_.end()) {
+            const size_type len = std::min(a->view.size() - i, b->view.size() - j);
+            const int r = a->view.substr(i, len).compare(b->view.substr(j, len));
+            if (r != 0) {
+                return r;
+            }
+            if ((i += len) == a->view.size()) {
+                ++a;
+                i = 0;
+            }
+            if ((j += len) == b->view.size()) {
+                ++b;
+                j = 0;
+            }
+        }
+        return (size_ < other.size_) ? -1 : (size_ > other.size_);
+    }
+
+    template <typename CharT, typename Traits>
+    int basic_segmented_view<CharT, Traits>::compare (view_type v) const noexcept {
+        return compare(basic_segmented_view(v));
+    }
+
+    template <typename CharT, typename Traits>
+    bool basic_segmented_view<CharT, Traits>::starts_with (view_type v) const noexcept {
+        return v.size() <= size_ && equal_at(0, v);
+    }
+
+    template <typename CharT, typename Traits>
+    bool basic_segmented_view<CharT, Traits>::ends_with (view_type v) const noexcept {
+        return v.size() <= size_ && equal_at(size_ - v.size(), v);
+    }
+
+    template <typename CharT, typename Traits>
+    bool basic_segmented_view<CharT, Traits>::equal_at (size_type pos, view_type v) const noexcept {
+        for (size_type s = v.empty() ? segments_.size() : locate(pos), done = 0; done < v.size(); ++s) {
+            const piece& seg = segments_[s];
+            const size_type from = pos + done - seg.offset;
+            const size_type len = std::min(seg.view.size() - from, v.size() - done);
+            if (seg.view.substr(from, len).compare(v.substr(done, len)) != 0) {
+                return false;
+            }
+            done += len;
+        }
+        return true;
+    }
+
+    template <typename CharT, typename Traits>
+    bool operator== (const basic_segmented_view<CharT, Traits>& a, const basic_segmented_view<CharT, Traits>& b) noexcept {
+        return a.size() == b.size() && a.compare(b) == 0;
+    }
+
+    template <typename CharT, typename Traits>
+    bool operator== (const basic_segmented_view<CharT, Traits>& a, std::type_identity_t<basic_string_view<CharT, Traits> > b) noexcept {
+        return a.size() == b.size() && a.compare(b) == 0;
+    }
+
+
+    // find / rfind ------------------------------------------------------------------------------------------------------------------
+
+    // The matches starting in a segment either lie inside it, found by find on the segment, or cross its end and so
+    // start in its last m - 1 units, found by find on those units and the m - 1 after the seam. The inside ones come
+    // first. A match crossing several seams is found at the first of them.
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::find (view_type v, size_type pos) const -> size_type {
+        const size_type m = v.size();
+        if (pos > size_ || m > size_ - pos) {
+            return npos;
+        }
+        if (m == 0) {
+            return pos;
+        }
+        std::vector<CharT> seam;
+        for (size_type s = locate(pos); s < segments_.size(); ++s) {
+            const piece& seg = segments_[s];
+            const size_type seg_end = seg.offset + seg.view.size();
+            const size_type hit = seg.view.find(v, pos > seg.offset ? pos - seg.offset : 0);
+            if (hit != npos) {
+                return seg.offset + hit;
+            }
+            if (m == 1 || s + 1 == segments_.size()) {
+                continue;
+            }
+            const size_type first = std::max({seg.offset, pos, seg_end > m - 1 ? seg_end - (m - 1) : size_type(0)});
+            const size_type last = std::min(size_, seg_end + (m - 1));
+            if (last - first < m) {
+                continue;
+            }
+            gather(first, last, seam);
+            const size_type at = view_type(seam.data(), seam.size()).find(v);
+            if (at != npos && first + at < seg_end) {
+                return first + at;
+            }
+        }
+        return npos;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::find (CharT ch, size_type pos) const noexcept -> size_type {
+        if (pos >= size_) {
+            return npos;
+        }
+        for (size_type s = locate(pos); s < segments_.size(); ++s) {
+            const piece& seg = segments_[s];
+            const size_type hit = seg.view.find(ch, pos > seg.offset ? pos - seg.offset : 0);
+            if (hit != npos) {
+                return seg.offset + hit;
+            }
+        }
+        return npos;
+    }
+
+    // Mirror image of find: from the segment holding the last admissible start backwards, the matches crossing a
+    // segment's end before the ones inside it.
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::rfind (view_type v, size_type pos) const -> size_type {
+        const size_type m = v.size();
+        if (m > size_) {
+            return npos;
+        }
+        const size_type top = std::min(pos, size_ - m);     // the last admissible start
+        if (m == 0) {
+            return top;
+        }
+        std::vector<CharT> seam;
+        for (size_type s = locate(top) + 1; s-- > 0;) {
+            const piece& seg = segments_[s];
+            const size_type seg_end = seg.offset + seg.view.size();
+            if (m > 1 && s + 1 < segments_.size()) {
+                const size_type first = std::max(seg.offset, seg_end > m - 1 ? seg_end - (m - 1) : size_type(0));
+                if (first <= top) {
+                    gather(first, std::min(top, seg_end - 1) + m, seam);
+                    const size_type at = view_type(seam.data(), seam.size()).rfind(v);
+                    if (at != npos) {
+                        return first + at;
+                    }
+                }
+            }
+            if (top >= seg.offset) {
+                const size_type hit = seg.view.rfind(v, top - seg.offset);
+                if (hit != npos) {
+                    return seg.offset + hit;
+                }
+            }
+        }
+        return npos;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::rfind (CharT ch, size_type pos) const noexcept -> size_type {
+        if (size_ == 0) {
+            return npos;
+        }
+        const size_type top = std::min(pos, size_ - 1);
+        for (size_type s = locate(top) + 1; s-- > 0;) {
+            const piece& seg = segments_[s];
+            const size_type hit = seg.view.rfind(ch, top - std::min(top, seg.offset));
+            if (hit != npos) {
+                return seg.offset + hit;
+            }
+        }
+        return npos;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::find_first_of (view_type chars, size_type pos) const noexcept -> size_type {
+        if (pos >= size_) {
+            return npos;
+        }
+        for (size_type s = locate(pos); s < segments_.size(); ++s) {
+            const piece& seg = segments_[s];
+            const size_type hit = seg.view.find_first_of(chars, pos > seg.offset ? pos - seg.offset : 0);
+            if (hit != npos) {
+                return seg.offset + hit;
+            }
+        }
+        return npos;
+    }
+
+
+    // Output ------------------------------------------------------------------------------------------------------------------------
+
+    #ifdef BSV_HAS_IOVEC
+    template <typename CharT, typename Traits>
+    auto basic_segmented_view<CharT, Traits>::to_iovecs (struct iovec* out, size_type max, size_type first) const noexcept -> size_type {
+        size_type n = 0;
+        for (size_type s = first; s < segments_.size() && n < max; ++s, ++n) {
+            out[n].iov_base = const_cast<CharT*>(segments_[s].view.data());
+            out[n].iov_len = segments_[s].view.size() * sizeof(CharT);
+        }
+        return n;
+    }
+
+    // Up to 64 segments per call, well under any IOV_MAX. After a partial write the next call starts in the middle
+    // of the segment it stopped in.
+    template <typename CharT, typename Traits>
+    void basic_segmented_view<CharT, Traits>::write_to (int fd) const {
+        constexpr size_type batch = 64;
+        struct iovec iov[batch];
+        size_type s = 0;
+        std::size_t skip = 0;           // bytes of segment s already written
+        while (s < segments_.size()) {
+            const size_type n = to_iovecs(iov, batch, s);
+            iov[0].iov_base = static_cast<char*>(iov[0].iov_base) + skip;
+            iov[0].iov_len -= skip;
+            const ssize_t written = ::writev(fd, iov, static_cast<int>(n));
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "basic_segmented_view: writev");
+            }
+            std::size_t left = static_cast<std::size_t>(written) + skip;
+            while (s < segments_.size() && left >= segments_[s].view.size() * sizeof(CharT)) {
+                left -= segments_[s].view.size() * sizeof(CharT);
+                ++s;
+            }
+            skip = left;
+        }
+    }
+    #endif
+
+} // namespace bsv
+
+#endif // SEGMENTED_VIEW_IMPL_HPP
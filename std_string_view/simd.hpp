@@ -0,0 +1,124 @@
+/*
+Small vector kernels shared by the searchers built on top of basic_string_view.
+Every kernel has a scalar fallback, so the headers still compile (and stay correct) 
+on targets without the instruction sets below.
+*/
+
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__AVX512BW__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#if defined(__PCLMUL__)
+#include <wmmintrin.h>
+#endif
+
+// Kernels compiled for an instruction set that the rest of the build may not enable, selected at run time with cpu().
+// GCC and Clang declare every intrinsic in immintrin.h, whatever -m flags are in effect. BSV_FLATTEN inlines every
+// call of a function into it, so generic code called from a BSV_TARGET function is compiled for that target.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BSV_X86_DISPATCH 1
+#define BSV_TARGET(isa) __attribute__((target(isa)))
+#define BSV_FLATTEN __attribute__((flatten))
+#include <immintrin.h>
+#else
+#define BSV_X86_DISPATCH 0
+#define BSV_TARGET(isa)
+#define BSV_FLATTEN
+#endif
+
+namespace bsv::simd {
+
+    // Instruction sets of the running CPU, detected once.
+    struct cpu_features {
+        bool ssse3 = false;
+        bool pclmul = false;
+        bool avx2 = false;
+        bool avx512bw = false;
+    };
+
+    const cpu_features& cpu() noexcept;
+
+    // A set of byte values. It is kept both as a 256-bit bitmap (scalar path) and as the two nibble lookup tables 
+    // used by the pshufb based scan ("truffle" in Hyperscan), which tests membership of 16 bytes per step for any set.
+    class byte_set {
+        private:
+            std::array<std::uint64_t, 4> bits_ {};
+            alignas(16) std::array<unsigned char, 16> lo_highclear_ {};
+            alignas(16) std::array<unsigned char, 16> lo_highset_ {};
+
+        public:
+            constexpr byte_set() noexcept = default;
+
+        public:
+            constexpr void insert (unsigned char b) noexcept;
+            constexpr bool contains (unsigned char b) const noexcept;
+            constexpr std::size_t count() const noexcept;
+            [[nodiscard]] constexpr bool empty() const noexcept;
+
+            const unsigned char* lo_highclear() const noexcept;
+            const unsigned char* lo_highset() const noexcept;
+    };
+
+    // Returns the index of the first byte of [first, first + n) that belongs to set, or n if there is none.
+    std::size_t find_first_in (const unsigned char* first, std::size_t n, const byte_set& set) noexcept;
+
+    // Bit i is set if p[i] == c, for the 64 bytes starting at p (all of which must be readable).
+    std::uint64_t eq_mask64 (const unsigned char* p, unsigned char c) noexcept;
+
+    // Bit i is set if p[i] belongs to set, for the 64 bytes starting at p (all of which must be readable).
+    std::uint64_t in_mask64 (const unsigned char* p, const byte_set& set) noexcept;
+
+    // Bit i of the result is the xor of bits 0..i of m: with m the quote positions of a block, the bits inside quoted
+    // regions (opening quote included, closing quote excluded). One carry-less multiply by all-ones with PCLMUL.
+    std::uint64_t prefix_xor (std::uint64_t m) noexcept;
+
+    // Returns the index of the first byte where [a, a + n) and [b, b + n) differ, or n if they are equal. 
+    // Compares 64 (AVX-512BW), 32 (AVX2) or 16 (SSE2) bytes per step.
+    std::size_t mismatch (const unsigned char* a, const unsigned char* b, std::size_t n) noexcept;
+
+    // mismatch(a, b, n) == n, but the first and the last 16 bytes are checked before the rest is scanned, since that is 
+    // where keys sharing a long common prefix (URLs, paths) tend to differ.
+    bool equal (const unsigned char* a, const unsigned char* b, std::size_t n) noexcept;
+
+    // ASCII case folding: 'A'..'Z' become 'a'..'z', every other byte (bytes >= 0x80 included) is left as it is.
+    constexpr unsigned char fold (unsigned char c) noexcept;
+
+    // The same on the 8 bytes of a word at once.
+    constexpr std::uint64_t fold8 (std::uint64_t w) noexcept;
+
+    // mismatch(a, b, n) on the folded bytes, at the same width.
+    std::size_t fold_mismatch (const unsigned char* a, const unsigned char* b, std::size_t n) noexcept;
+
+    // Index of the first occurrence of [needle, needle + m) in [hay, hay + n), or n if there is none (0 for m == 0).
+    // Vector compares of the needle's first and last bytes against every position select the candidates, which are
+    // then verified, so that a step rejects 16 (SSE2) or 32 (AVX2) positions at once ("SIMD-friendly" search, W. Muła).
+    std::size_t find (const unsigned char* hay, std::size_t n, const unsigned char* needle, std::size_t m) noexcept;
+
+    // find on the folded bytes.
+    std::size_t fold_find (const unsigned char* hay, std::size_t n, const unsigned char* needle, std::size_t m) noexcept;
+
+    // Index of the last occurrence of [needle, needle + m) in [hay, hay + n), or n if there is none. m must not be 0.
+    // The same candidate filter as find, scanning from the end.
+    std::size_t rfind (const unsigned char* hay, std::size_t n, const unsigned char* needle, std::size_t m) noexcept;
+    std::size_t fold_rfind (const unsigned char* hay, std::size_t n, const unsigned char* needle, std::size_t m) noexcept;
+
+    // Number of bytes of [p, p + n) equal to c.
+    std::size_t count (const unsigned char* p, std::size_t n, unsigned char c) noexcept;
+
+} // namespace bsv::simd
+
+#include "simd.impl.hpp"
+
+#endif // SIMD_HPP
@@ -0,0 +1,602 @@
+#ifndef SIMD_IMPL_HPP
+#define SIMD_IMPL_HPP
+
+#include "simd.hpp"
+
+#include <bit>
+#include <cstring>
+
+namespace bsv::simd {
+    inline const cpu_features& cpu() noexcept {
+        static const cpu_features features = [] {
+            cpu_features f;
+#if BSV_X86_DISPATCH
+            __builtin_cpu_init();
+            f.ssse3 = __builtin_cpu_supports("ssse3");
+            f.pclmul = __builtin_cpu_supports("pclmul");
+            f.avx2 = __builtin_cpu_supports("avx2");
+            f.avx512bw = __builtin_cpu_supports("avx512bw");
+#endif
+            return f;
+        }();
+        return features;
+    }
+
+    // byte_set ----------------------------------------------------------------------------------------------------------------------
+
+    // The low nibble of b selects the table entry, the high nibble selects the bit inside it. Bytes with the top bit set live 
+    // in the second table, so that pshufb (which zeroes lanes whose index has bit 7 set) can look both halves up.
+    constexpr void byte_set::insert (unsigned char b) noexcept {
+        bits_[b >> 6] |= std::uint64_t(1) << (b & 63);
+        const unsigned char lo = b & 0x0F;
+        const unsigned char hi = b >> 4;
+        if (hi < 8) {
+            lo_highclear_[lo] |= static_cast<unsigned char>(1u << hi);
+        } else {
+            lo_highset_[lo] |= static_cast<unsigned char>(1u << (hi - 8));
+        }
+    }
+
+    constexpr bool byte_set::contains (unsigned char b) const noexcept {
+        return (bits_[b >> 6] >> (b & 63)) & 1;
+    }
+
+    constexpr std::size_t byte_set::count() const noexcept {
+        std::size_t n = 0;
+        for (auto word : bits_) {
+            n += std::popcount(word);
+        }
+        return n;
+    }
+
+    [[nodiscard]] constexpr bool byte_set::empty() const noexcept {
+        return (bits_[0] | bits_[1] | bits_[2] | bits_[3]) == 0;
+    }
+
+    inline const unsigned char* byte_set::lo_highclear() const noexcept {
+        return lo_highclear_.data();
+    }
+
+    inline const unsigned char* byte_set::lo_highset() const noexcept {
+        return lo_highset_.data();
+    }
+
+
+    // Scans ---------------------------------------------------------------------------------------------------------------------
+
+#if BSV_X86_DISPATCH
+    namespace detail {
+        // Bit i is set if byte i of v belongs to set.
+        BSV_TARGET("ssse3")
+        inline unsigned in_set16 (__m128i v, const byte_set& set) noexcept {
+            const __m128i lo_clear = _mm_load_si128(reinterpret_cast<const __m128i*>(set.lo_highclear()));
+            const __m128i lo_set = _mm_load_si128(reinterpret_cast<const __m128i*>(set.lo_highset()));
+            const __m128i bit_of_hi = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+            const __m128i rows = _mm_or_si128(_mm_shuffle_epi8(lo_clear, v), 
+                                              _mm_shuffle_epi8(lo_set, _mm_xor_si128(v, _mm_set1_epi8(static_cast<char>(0x80)))));
+            const __m128i hi = _mm_shuffle_epi8(bit_of_hi, _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F)));
+            const __m128i hit = _mm_and_si128(rows, hi);
+            return ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(hit, _mm_setzero_si128()))) & 0xFFFFu;
+        }
+
+        BSV_TARGET("ssse3") BSV_FLATTEN
+        inline std::size_t find_first_in_ssse3 (const unsigned char* first, std::size_t n, const byte_set& set) noexcept {
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                const unsigned mask = in_set16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i)), set);
+                if (mask != 0) {
+                    return i + std::countr_zero(mask);
+                }
+            }
+            for (; i < n; ++i) {
+                if (set.contains(first[i])) {
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        BSV_TARGET("ssse3") BSV_FLATTEN
+        inline std::uint64_t in_mask64_ssse3 (const unsigned char* p, const byte_set& set) noexcept {
+            std::uint64_t mask = 0;
+            for (int k = 0; k < 4; ++k) {
+                mask |= static_cast<std::uint64_t>(in_set16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k)), set)) << (16 * k);
+            }
+            return mask;
+        }
+
+        BSV_TARGET("sse2,pclmul")
+        inline std::uint64_t prefix_xor_pclmul (std::uint64_t m) noexcept {
+            return static_cast<std::uint64_t>(_mm_cvtsi128_si64(
+                _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<long long>(m)), _mm_set1_epi8(-1), 0)));
+        }
+
+        // Whether the kernels above can run: known at compile time when the build enables them, asked of cpu() otherwise.
+        inline bool has_ssse3() noexcept {
+#if defined(__SSSE3__)
+            return true;
+#else
+            return cpu().ssse3;
+#endif
+        }
+
+        inline bool has_pclmul() noexcept {
+#if defined(__PCLMUL__)
+            return true;
+#else
+            return cpu().pclmul;
+#endif
+        }
+    } // namespace detail
+#endif
+
+    inline std::size_t find_first_in (const unsigned char* first, std::size_t n, const byte_set& set) noexcept {
+#if BSV_X86_DISPATCH
+        if (detail::has_ssse3()) {
+            return detail::find_first_in_ssse3(first, n, set);
+        }
+#endif
+        for (std::size_t i = 0; i < n; ++i) {
+            if (set.contains(first[i])) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    inline std::uint64_t eq_mask64 (const unsigned char* p, unsigned char c) noexcept {
+#if defined(__AVX512BW__)
+        return _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p), _mm512_set1_epi8(static_cast<char>(c)));
+#elif defined(__AVX2__)
+        const __m256i needle = _mm256_set1_epi8(static_cast<char>(c));
+        const auto lo = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), needle)));
+        const auto hi = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), needle)));
+        return static_cast<std::uint64_t>(hi) << 32 | lo;
+#elif defined(__SSE2__)
+        const __m128i needle = _mm_set1_epi8(static_cast<char>(c));
+        std::uint64_t mask = 0;
+        for (int k = 0; k < 4; ++k) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k));
+            mask |= static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)))) << (16 * k);
+        }
+        return mask;
+#else
+        std::uint64_t mask = 0;
+        for (int k = 0; k < 64; ++k) {
+            mask |= static_cast<std::uint64_t>(p[k] == c) << k;
+        }
+        return mask;
+#endif
+    }
+
+    inline std::uint64_t prefix_xor (std::uint64_t m) noexcept {
+#if BSV_X86_DISPATCH
+        if (detail::has_pclmul()) {
+            return detail::prefix_xor_pclmul(m);
+        }
+#endif
+        for (int shift = 1; shift < 64; shift *= 2) {
+            m ^= m << shift;
+        }
+        return m;
+    }
+
+    inline std::uint64_t in_mask64 (const unsigned char* p, const byte_set& set) noexcept {
+#if BSV_X86_DISPATCH
+        if (detail::has_ssse3()) {
+            return detail::in_mask64_ssse3(p, set);
+        }
+#endif
+        std::uint64_t mask = 0;
+        for (int k = 0; k < 64; ++k) {
+            mask |= static_cast<std::uint64_t>(set.contains(p[k])) << k;
+        }
+        return mask;
+    }
+
+    inline std::size_t mismatch (const unsigned char* a, const unsigned char* b, std::size_t n) noexcept {
+        std::size_t i = 0;
+#if defined(__SSE2__)
+        // Shorter inputs go to the word loop below. With every vector load behind this test, none is left on the path
+        // of a short array once the call is inlined (GCC would flag it with -Warray-bounds).
+        if (n >= 16) {
+#if defined(__AVX512BW__)
+            for (; i + 64 <= n; i += 64) {
+                const std::uint64_t ne = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+                if (ne != 0) {
+                    return i + std::countr_zero(ne);
+                }
+            }
+#endif
+#if defined(__AVX2__)
+            for (; i + 32 <= n; i += 32) {
+                const __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                                     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+                const auto ne = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(eq));
+                if (ne != 0) {
+                    return i + std::countr_zero(ne);
+                }
+            }
+#endif
+            auto mismatch16 = [a, b] (std::size_t at) -> unsigned {
+                const __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + at)),
+                                                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + at)));
+                return ~static_cast<unsigned>(_mm_movemask_epi8(eq)) & 0xFFFFu;
+            };
+            for (; i + 16 <= n; i += 16) {
+                if (const unsigned ne = mismatch16(i); ne != 0) {
+                    return i + std::countr_zero(ne);
+                }
+            }
+            // The last vector overlaps bytes already known to be equal, so its first difference is the first one overall.
+            if (i < n) {
+                const unsigned ne = mismatch16(n - 16);
+                return ne != 0 ? n - 16 + std::countr_zero(ne) : n;
+            }
+            return n;
+        }
+#endif
+        if constexpr (std::endian::native == std::endian::little) {
+            for (; i + 8 <= n; i += 8) {
+                std::uint64_t x, y;
+                std::memcpy(&x, a + i, 8);
+                std::memcpy(&y, b + i, 8);
+                if (x != y) {
+                    return i + std::countr_zero(x ^ y) / 8;
+                }
+            }
+        }
+        for (; i < n; ++i) {
+            if (a[i] != b[i]) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    inline bool equal (const unsigned char* a, const unsigned char* b, std::size_t n) noexcept {
+        auto word_eq = [a, b] (std::size_t at, auto word) {
+            decltype(word) x, y;
+            std::memcpy(&x, a + at, sizeof(x));
+            std::memcpy(&y, b + at, sizeof(y));
+            return x == y;
+        };
+        if (n < 16) {
+            // Two overlapping loads cover every length in [k, 2k].
+            if (n >= 8) {
+                return word_eq(0, std::uint64_t()) && word_eq(n - 8, std::uint64_t());
+            }
+            if (n >= 4) {
+                return word_eq(0, std::uint32_t()) && word_eq(n - 4, std::uint32_t());
+            }
+            return n == 0 || (a[0] == b[0] && a[n / 2] == b[n / 2] && a[n - 1] == b[n - 1]);
+        }
+        if (!word_eq(0, std::uint64_t()) || !word_eq(8, std::uint64_t()) || 
+            !word_eq(n - 16, std::uint64_t()) || !word_eq(n - 8, std::uint64_t())) {
+            return false;
+        }
+        return n <= 32 || mismatch(a + 16, b + 16, n - 32) == n - 32;
+    }
+
+
+    // Case folding --------------------------------------------------------------------------------------------------------------
+
+    constexpr unsigned char fold (unsigned char c) noexcept {
+        return static_cast<unsigned>(c - 'A') < 26 ? static_cast<unsigned char>(c | 0x20) : c;
+    }
+
+    // With the top bits cleared, adding to a byte cannot carry into the next one: the top bit of x + (0x80 - 'A') is
+    // set when x >= 'A', that of x + (0x80 - 'Z' - 1) when x > 'Z'. Bytes that had their top bit set are excluded.
+    constexpr std::uint64_t fold8 (std::uint64_t w) noexcept {
+        constexpr std::uint64_t ones = 0x0101010101010101;
+        const std::uint64_t x = w & (0x7F * ones);
+        const std::uint64_t upper = (x + (0x80 - 'A') * ones) & ~(x + (0x80 - 'Z' - 1) * ones) & ~w & (0x80 * ones);
+        return w | (upper >> 2);
+    }
+
+#if defined(__SSE2__)
+    // 'A' + 0x3F is 0x80: the upper-case letters are the 26 smallest signed values after the addition.
+    inline __m128i fold16 (__m128i v) noexcept {
+        const __m128i upper = _mm_cmplt_epi8(_mm_add_epi8(v, _mm_set1_epi8(0x3F)), _mm_set1_epi8(-128 + 26));
+        return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+    }
+#endif
+
+#if defined(__AVX2__)
+    inline __m256i fold32 (__m256i v) noexcept {
+        const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), _mm256_add_epi8(v, _mm256_set1_epi8(0x3F)));
+        return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+    }
+#endif
+
+#if defined(__AVX512BW__)
+    inline __m512i fold64 (__m512i v) noexcept {
+        const __mmask64 upper = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(v, _mm512_set1_epi8('A')), _mm512_set1_epi8(26));
+        return _mm512_mask_add_epi8(v, upper, v, _mm512_set1_epi8(0x20));
+    }
+#endif
+
+    inline std::size_t fold_mismatch (const unsigned char* a, const unsigned char* b, std::size_t n) noexcept {
+        std::size_t i = 0;
+#if defined(__AVX512BW__)
+        for (; i + 64 <= n; i += 64) {
+            const std::uint64_t ne = _mm512_cmpneq_epi8_mask(fold64(_mm512_loadu_si512(a + i)), fold64(_mm512_loadu_si512(b + i)));
+            if (ne != 0) {
+                return i + std::countr_zero(ne);
+            }
+        }
+#endif
+#if defined(__AVX2__)
+        for (; i + 32 <= n; i += 32) {
+            const __m256i eq = _mm256_cmpeq_epi8(fold32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i))),
+                                                 fold32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i))));
+            const auto ne = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(eq));
+            if (ne != 0) {
+                return i + std::countr_zero(ne);
+            }
+        }
+#endif
+#if defined(__SSE2__)
+        auto mismatch16 = [a, b] (std::size_t at) -> unsigned {
+            const __m128i eq = _mm_cmpeq_epi8(fold16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + at))),
+                                              fold16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + at))));
+            return ~static_cast<unsigned>(_mm_movemask_epi8(eq)) & 0xFFFFu;
+        };
+        for (; i + 16 <= n; i += 16) {
+            if (const unsigned ne = mismatch16(i); ne != 0) {
+                return i + std::countr_zero(ne);
+            }
+        }
+        if (i < n && n >= 16) {
+            const unsigned ne = mismatch16(n - 16);
+            return ne != 0 ? n - 16 + std::countr_zero(ne) : n;
+        }
+#endif
+        if constexpr (std::endian::native == std::endian::little) {
+            for (; i + 8 <= n; i += 8) {
+                std::uint64_t x, y;
+                std::memcpy(&x, a + i, 8);
+                std::memcpy(&y, b + i, 8);
+                if (const std::uint64_t d = fold8(x) ^ fold8(y); d != 0) {
+                    return i + std::countr_zero(d) / 8;
+                }
+            }
+        }
+        for (; i < n; ++i) {
+            if (fold(a[i]) != fold(b[i])) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    // Search ----------------------------------------------------------------------------------------------------------------------
+
+    template <bool Fold>
+    inline std::size_t find_pair (const unsigned char* hay, std::size_t n, const unsigned char* needle, std::size_t m) noexcept {
+        if (m == 0) {
+            return 0;
+        }
+        if (m > n) {
+            return n;
+        }
+        const auto unit = [] (unsigned char c) { return Fold ? fold(c) : c; };
+        // The first and the last bytes are already known to match.
+        const auto verify = [hay, needle, m] (std::size_t at) {
+            if (m <= 2) {
+                return true;
+            }
+            if constexpr (Fold) {
+                return fold_mismatch(hay + at + 1, needle + 1, m - 2) == m - 2;
+            } else {
+                return equal(hay + at + 1, needle + 1, m - 2);
+            }
+        };
+        const unsigned char first = unit(needle[0]);
+        const unsigned char last = unit(needle[m - 1]);
+        // For a lower-case letter l, (b | 0x20) == l holds for exactly both cases of l, so the candidate filter needs
+        // one or instead of a full fold; other bytes are compared as they are.
+        const auto case_bit = [] (unsigned char c) -> char {
+            return Fold && static_cast<unsigned>(c - 'a') < 26 ? 0x20 : 0;
+        };
+        const std::size_t candidates = n - m + 1;
+        std::size_t i = 0;
+#if defined(__AVX2__)
+        {
+            const __m256i f = _mm256_set1_epi8(static_cast<char>(first));
+            const __m256i l = _mm256_set1_epi8(static_cast<char>(last));
+            const __m256i f_case = _mm256_set1_epi8(case_bit(first));
+            const __m256i l_case = _mm256_set1_epi8(case_bit(last));
+            for (; i + 32 <= candidates; i += 32) {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i + m - 1));
+                if constexpr (Fold) {
+                    a = _mm256_or_si256(a, f_case);
+                    b = _mm256_or_si256(b, l_case);
+                }
+                auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+                    _mm256_and_si256(_mm256_cmpeq_epi8(a, f), _mm256_cmpeq_epi8(b, l))));
+                for (; mask != 0; mask &= mask - 1) {
+                    if (const std::size_t at = i + std::countr_zero(mask); verify(at)) {
+                        return at;
+                    }
+                }
+            }
+        }
+#endif
+#if defined(__SSE2__)
+        {
+            const __m128i f = _mm_set1_epi8(static_cast<char>(first));
+            const __m128i l = _mm_set1_epi8(static_cast<char>(last));
+            const __m128i f_case = _mm_set1_epi8(case_bit(first));
+            const __m128i l_case = _mm_set1_epi8(case_bit(last));
+            for (; i + 16 <= candidates; i += 16) {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i + m - 1));
+                if constexpr (Fold) {
+                    a = _mm_or_si128(a, f_case);
+                    b = _mm_or_si128(b, l_case);
+                }
+                auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, f), _mm_cmpeq_epi8(b, l))));
+                for (; mask != 0; mask &= mask - 1) {
+                    if (const std::size_t at = i + std::countr_zero(mask); verify(at)) {
+                        return at;
+                    }
+                }
+            }
+        }
+#endif
+        for (; i < candidates; ++i) {
+            if (unit(hay[i]) == first && unit(hay[i + m - 1]) == last && verify(i)) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    inline std::size_t find (const unsigned char* hay, std::size_t n, const unsigned char* needle, std::size_t m) noexcept {
+        return find_pair<false>(hay, n, needle, m);
+    }
+
+    inline std::size_t fold_find (const unsigned char* hay, std::size_t n, const unsigned char* needle, std::size_t m) noexcept {
+        return find_pair<true>(hay, n, needle, m);
+    }
+
+    // find_pair backwards: the highest candidate bit of each block is tried first.
+    template <bool Fold>
+    inline std::size_t rfind_pair (const unsigned char* hay, std::size_t n, const unsigned char* needle, std::size_t m) noexcept {
+        if (m > n) {
+            return n;
+        }
+        const auto unit = [] (unsigned char c) { return Fold ? fold(c) : c; };
+        const auto verify = [hay, needle, m] (std::size_t at) {
+            if (m <= 2) {
+                return true;
+            }
+            if constexpr (Fold) {
+                return fold_mismatch(hay + at + 1, needle + 1, m - 2) == m - 2;
+            } else {
+                return equal(hay + at + 1, needle + 1, m - 2);
+            }
+        };
+        const unsigned char first = unit(needle[0]);
+        const unsigned char last = unit(needle[m - 1]);
+        const auto case_bit = [] (unsigned char c) -> char {
+            return Fold && static_cast<unsigned>(c - 'a') < 26 ? 0x20 : 0;
+        };
+        std::size_t end = n - m + 1;        // candidates left: [0, end)
+#if defined(__AVX2__)
+        {
+            const __m256i f = _mm256_set1_epi8(static_cast<char>(first));
+            const __m256i l = _mm256_set1_epi8(static_cast<char>(last));
+            const __m256i f_case = _mm256_set1_epi8(case_bit(first));
+            const __m256i l_case = _mm256_set1_epi8(case_bit(last));
+            for (; end >= 32; end -= 32) {
+                const std::size_t i = end - 32;
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i + m - 1));
+                if constexpr (Fold) {
+                    a = _mm256_or_si256(a, f_case);
+                    b = _mm256_or_si256(b, l_case);
+                }
+                auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+                    _mm256_and_si256(_mm256_cmpeq_epi8(a, f), _mm256_cmpeq_epi8(b, l))));
+                while (mask != 0) {
+                    const int bit = 31 - std::countl_zero(mask);
+                    if (verify(i + bit)) {
+                        return i + bit;
+                    }
+                    mask ^= std::uint32_t(1) << bit;
+                }
+            }
+        }
+#endif
+#if defined(__SSE2__)
+        {
+            const __m128i f = _mm_set1_epi8(static_cast<char>(first));
+            const __m128i l = _mm_set1_epi8(static_cast<char>(last));
+            const __m128i f_case = _mm_set1_epi8(case_bit(first));
+            const __m128i l_case = _mm_set1_epi8(case_bit(last));
+            for (; end >= 16; end -= 16) {
+                const std::size_t i = end - 16;
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i + m - 1));
+                if constexpr (Fold) {
+                    a = _mm_or_si128(a, f_case);
+                    b = _mm_or_si128(b, l_case);
+                }
+                auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, f), _mm_cmpeq_epi8(b, l))));
+                while (mask != 0) {
+                    const int bit = 31 - std::countl_zero(mask);
+                    if (verify(i + bit)) {
+                        return i + bit;
+                    }
+                    mask ^= std::uint32_t(1) << bit;
+                }
+            }
+        }
+#endif
+        while (end-- > 0) {
+            if (unit(hay[end]) == first && unit(hay[end + m - 1]) == last && verify(end)) {
+                return end;
+            }
+        }
+        return n;
+    }
+
+    inline std::size_t rfind (const unsigned char* hay, std::size_t n, const unsigned char* needle, std::size_t m) noexcept {
+        return rfind_pair<false>(hay, n, needle, m);
+    }
+
+    inline std::size_t fold_rfind (const unsigned char* hay, std::size_t n, const unsigned char* needle, std::size_t m) noexcept {
+        return rfind_pair<true>(hay, n, needle, m);
+    }
+
+    // cmpeq gives -1 per equal byte: subtracting it counts into 8-bit lanes, which are widened with psadbw every 255
+    // vectors, before they can overflow.
+    inline std::size_t count (const unsigned char* p, std::size_t n, unsigned char c) noexcept {
+        std::size_t total = 0;
+        std::size_t i = 0;
+#if defined(__AVX2__)
+        {
+            const __m256i needle = _mm256_set1_epi8(static_cast<char>(c));
+            __m256i sums = _mm256_setzero_si256();
+            while (i + 32 <= n) {
+                __m256i counts = _mm256_setzero_si256();
+                for (std::size_t k = 0; k < 255 && i + 32 <= n; ++k, i += 32) {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+                    counts = _mm256_sub_epi8(counts, _mm256_cmpeq_epi8(v, needle));
+                }
+                sums = _mm256_add_epi64(sums, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+            }
+            alignas(32) std::uint64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sums);
+            total += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        }
+#endif
+#if defined(__SSE2__)
+        {
+            const __m128i needle = _mm_set1_epi8(static_cast<char>(c));
+            __m128i sums = _mm_setzero_si128();
+            while (i + 16 <= n) {
+                __m128i counts = _mm_setzero_si128();
+                for (std::size_t k = 0; k < 255 && i + 16 <= n; ++k, i += 16) {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+                    counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(v, needle));
+                }
+                sums = _mm_add_epi64(sums, _mm_sad_epu8(counts, _mm_setzero_si128()));
+            }
+            total += static_cast<std::size_t>(_mm_cvtsi128_si64(sums)) + static_cast<std::size_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums)));
+        }
+#endif
+        for (; i < n; ++i) {
+            total += p[i] == c;
+        }
+        return total;
+    }
+
+} // namespace bsv::simd
+
+#endif // SIMD_IMPL_HPP
@@ -0,0 +1,70 @@
+/*
+Vector kernels over code units of 1, 2 or 4 bytes (char, char8_t, char16_t, char32_t, wchar_t), behind the searches
+and comparisons of basic_string_view with std::char_traits.
+Each kernel is one body written against a handful of vector operations (load, broadcast, compare, and/or, bit mask)
+that are provided for SSE2, AVX2 and AVX-512BW at every unit width. The body is compiled once per instruction set into
+an entry point carrying that target attribute and flattened, so that every operation is inlined into it; the entry
+point for the running CPU is picked by cpu() on the first call and kept in a function pointer, the way an ifunc
+resolver would. Off x86 the same bodies run on one unit at a time.
+*/
+
+#ifndef SIMD_UNITS_HPP
+#define SIMD_UNITS_HPP
+
+#include "simd.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace bsv::simd::units {
+
+    // The character types the kernels accept: equality of two units is equality of their bytes.
+    template <typename T>
+    concept code_unit = std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4);
+
+    // Sets of up to this many units are matched with one broadcast compare per unit and step (when that is cheaper
+    // than a lookup per unit at the width); larger ones go through a bitmap on the low byte, one unit at a time.
+    inline constexpr std::size_t max_vector_set = 16;
+
+    // Index of the first unit of [p, p + n) equal to c, or n.
+    template <code_unit T>
+    std::size_t find (const T* p, std::size_t n, T c) noexcept;
+
+    // Index of the last unit of [p, p + n) equal to c, or n.
+    template <code_unit T>
+    std::size_t rfind (const T* p, std::size_t n, T c) noexcept;
+
+    // Index of the first occurrence of [needle, needle + m) in [hay, hay + n), or n (0 for m == 0). Candidates are
+    // the positions matching both the first and the last unit of the needle, a vector of positions per step.
+    template <code_unit T>
+    std::size_t search (const T* hay, std::size_t n, const T* needle, std::size_t m) noexcept;
+
+    // Index of the last occurrence of [needle, needle + m) in [hay, hay + n), or n. m must not be 0.
+    template <code_unit T>
+    std::size_t rsearch (const T* hay, std::size_t n, const T* needle, std::size_t m) noexcept;
+
+    // Index of the first unit where [a, a + n) and [b, b + n) differ, or n.
+    template <code_unit T>
+    std::size_t mismatch (const T* a, const T* b, std::size_t n) noexcept;
+
+    // Index of the first unit of [p, p + n) that is one of the k units of set (member) or none of them (!member), or n.
+    template <code_unit T>
+    std::size_t find_of (const T* p, std::size_t n, const T* set, std::size_t k, bool member) noexcept;
+
+    // The same, for the last such unit.
+    template <code_unit T>
+    std::size_t rfind_of (const T* p, std::size_t n, const T* set, std::size_t k, bool member) noexcept;
+
+} // namespace bsv::simd::units
+
+#include "simd_units.impl.hpp"
+
+#endif // SIMD_UNITS_HPP
+
+/*
+Methods                 Time Complexity      Auxiliary Space
+find() / rfind()        O(n)                 O(1)
+search() / rsearch()    O(n * m) worst, O(n) typical      O(1)
+mismatch()              O(n)                 O(1)
+find_of() / rfind_of()  O(n * k / lanes) for small sets, O(n) otherwise      O(1)
+*/
@@ -0,0 +1,589 @@
+#ifndef SIMD_UNITS_IMPL_HPP
+#define SIMD_UNITS_IMPL_HPP
+
+#include "simd_units.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+// The kernel bodies pass vectors wider than the default target's between inline functions. They are only ever compiled
+// into the entry points that enable the instruction set, so GCC's note on the changed calling convention does not apply.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+namespace bsv::simd::units {
+    namespace detail {
+        // Vector operations -------------------------------------------------------------------------------------------------------------
+
+        // For units of W bytes: a vec holds `lanes` units, a compare gives a cmp, and bits() of a cmp has `scale` bits per
+        // lane, lane 0 lowest (a movemask gives one bit per byte, an AVX-512 compare one per lane).
+        template <std::size_t W>
+        struct scalar_ops {
+            using vec = std::conditional_t<W == 1, std::uint8_t, std::conditional_t<W == 2, std::uint16_t, std::uint32_t> >;
+            using cmp = bool;
+            static constexpr std::size_t lanes = 1;
+            static constexpr unsigned scale = 1;
+
+            static vec load (const void* p) noexcept { vec v; std::memcpy(&v, p, W); return v; }
+            template <typename T>
+            static vec splat (T c) noexcept { return static_cast<vec>(c); }
+            static cmp eq (vec a, vec b) noexcept { return a == b; }
+            static cmp either (cmp a, cmp b) noexcept { return a || b; }
+            static cmp both (cmp a, cmp b) noexcept { return a && b; }
+            static std::uint64_t bits (cmp c) noexcept { return c; }
+        };
+
+#if BSV_X86_DISPATCH
+        template <std::size_t W>
+        struct sse2_ops {
+            using vec = __m128i;
+            using cmp = __m128i;
+            static constexpr std::size_t lanes = 16 / W;
+            static constexpr unsigned scale = W;
+
+            BSV_TARGET("sse2") static vec load (const void* p) noexcept {
+                return _mm_loadu_si128(static_cast<const __m128i*>(p));
+            }
+            template <typename T>
+            BSV_TARGET("sse2") static vec splat (T c) noexcept {
+                if constexpr (W == 1) { return _mm_set1_epi8(static_cast<char>(c)); }
+                else if constexpr (W == 2) { return _mm_set1_epi16(static_cast<short>(c)); }
+                else { return _mm_set1_epi32(static_cast<int>(c)); }
+            }
+            BSV_TARGET("sse2") static cmp eq (vec a, vec b) noexcept {
+                if constexpr (W == 1) { return _mm_cmpeq_epi8(a, b); }
+                else if constexpr (W == 2) { return _mm_cmpeq_epi16(a, b); }
+                else { return _mm_cmpeq_epi32(a, b); }
+            }
+            BSV_TARGET("sse2") static cmp either (cmp a, cmp b) noexcept { return _mm_or_si128(a, b); }
+            BSV_TARGET("sse2") static cmp both (cmp a, cmp b) noexcept { return _mm_and_si128(a, b); }
+            BSV_TARGET("sse2") static std::uint64_t bits (cmp c) noexcept {
+                return static_cast<unsigned>(_mm_movemask_epi8(c));
+            }
+        };
+
+        template <std::size_t W>
+        struct avx2_ops {
+            using vec = __m256i;
+            using cmp = __m256i;
+            static constexpr std::size_t lanes = 32 / W;
+            static constexpr unsigned scale = W;
+
+            BSV_TARGET("avx2") static vec load (const void* p) noexcept {
+                return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+            }
+            template <typename T>
+            BSV_TARGET("avx2") static vec splat (T c) noexcept {
+                if constexpr (W == 1) { return _mm256_set1_epi8(static_cast<char>(c)); }
+                else if constexpr (W == 2) { return _mm256_set1_epi16(static_cast<short>(c)); }
+                else { return _mm256_set1_epi32(static_cast<int>(c)); }
+            }
+            BSV_TARGET("avx2") static cmp eq (vec a, vec b) noexcept {
+                if constexpr (W == 1) { return _mm256_cmpeq_epi8(a, b); }
+                else if constexpr (W == 2) { return _mm256_cmpeq_epi16(a, b); }
+                else { return _mm256_cmpeq_epi32(a, b); }
+            }
+            BSV_TARGET("avx2") static cmp either (cmp a, cmp b) noexcept { return _mm256_or_si256(a, b); }
+            BSV_TARGET("avx2") static cmp both (cmp a, cmp b) noexcept { return _mm256_and_si256(a, b); }
+            BSV_TARGET("avx2") static std::uint64_t bits (cmp c) noexcept {
+                return static_cast<std::uint32_t>(_mm256_movemask_epi8(c));
+            }
+        };
+
+        template <std::size_t W>
+        struct avx512_ops {
+            using vec = __m512i;
+            using cmp = std::uint64_t;
+            static constexpr std::size_t lanes = 64 / W;
+            static constexpr unsigned scale = 1;
+
+            BSV_TARGET("avx512bw") static vec load (const void* p) noexcept { return _mm512_loadu_si512(p); }
+            template <typename T>
+            BSV_TARGET("avx512bw") static vec splat (T c) noexcept {
+                if constexpr (W == 1) { return _mm512_set1_epi8(static_cast<char>(c)); }
+                else if constexpr (W == 2) { return _mm512_set1_epi16(static_cast<short>(c)); }
+                else { return _mm512_set1_epi32(static_cast<int>(c)); }
+            }
+            BSV_TARGET("avx512bw") static cmp eq (vec a, vec b) noexcept {
+                if constexpr (W == 1) { return _mm512_cmpeq_epi8_mask(a, b); }
+                else if constexpr (W == 2) { return _mm512_cmpeq_epi16_mask(a, b); }
+                else { return _mm512_cmpeq_epi32_mask(a, b); }
+            }
+            static cmp either (cmp a, cmp b) noexcept { return a | b; }
+            static cmp both (cmp a, cmp b) noexcept { return a & b; }
+            static std::uint64_t bits (cmp c) noexcept { return c; }
+        };
+#endif
+
+        // Lane masks --------------------------------------------------------------------------------------------------------------------
+
+        template <typename Ops>
+        constexpr std::uint64_t all_lanes = Ops::lanes * Ops::scale == 64 ? ~std::uint64_t(0)
+                                                                          : (std::uint64_t(1) << (Ops::lanes * Ops::scale)) - 1;
+
+        template <typename Ops>
+        std::size_t first_lane (std::uint64_t m) noexcept {
+            return static_cast<std::size_t>(std::countr_zero(m)) / Ops::scale;
+        }
+
+        template <typename Ops>
+        std::size_t last_lane (std::uint64_t m) noexcept {
+            return static_cast<std::size_t>(63 - std::countl_zero(m)) / Ops::scale;
+        }
+
+        // The lanes of m from `from` on, and below `to` (to < lanes).
+        template <typename Ops>
+        std::uint64_t lanes_from (std::uint64_t m, std::size_t from) noexcept {
+            return m & (all_lanes<Ops> << (from * Ops::scale));
+        }
+
+        template <typename Ops>
+        std::uint64_t lanes_below (std::uint64_t m, std::size_t to) noexcept {
+            return m & ~(all_lanes<Ops> << (to * Ops::scale));
+        }
+
+        // m without its first / last lane: a set lane has all of its bits set.
+        template <typename Ops>
+        std::uint64_t clear_first (std::uint64_t m) noexcept {
+            return m & ~(((std::uint64_t(1) << Ops::scale) - 1) << std::countr_zero(m));
+        }
+
+        template <typename Ops>
+        std::uint64_t clear_last (std::uint64_t m) noexcept {
+            return m & ~(((std::uint64_t(1) << Ops::scale) - 1) << (64 - Ops::scale - std::countl_zero(m)));
+        }
+
+
+        // Sets of units -----------------------------------------------------------------------------------------------------------------
+
+        // Membership in a set of units of any size: a bitmap of the units below 256, which decides for those, and one of the
+        // low bytes of the others in front of a scan of the set.
+        template <typename T>
+        struct unit_set {
+            std::uint64_t small[4] = {};
+            std::uint64_t wide[4] = {};
+            const T* units;
+            std::size_t k;
+
+            static bool test (const std::uint64_t* bits, unsigned b) noexcept { return (bits[b >> 6] >> (b & 63)) & 1; }
+
+            unit_set (const T* set, std::size_t count) noexcept : units(set), k(count) {
+                for (std::size_t j = 0; j < k; ++j) {
+                    const auto u = static_cast<std::make_unsigned_t<T> >(units[j]);
+                    std::uint64_t* bits = u < 256 ? small : wide;
+                    bits[(u & 0xFF) >> 6] |= std::uint64_t(1) << (u & 63);
+                }
+            }
+
+            bool contains (T c) const noexcept {
+                const auto u = static_cast<std::make_unsigned_t<T> >(c);
+                if (u < 256) {
+                    return test(small, static_cast<unsigned>(u));
+                }
+                return test(wide, static_cast<unsigned>(u & 0xFF)) && std::find(units, units + k, c) != units + k;
+            }
+        };
+
+        template <typename T>
+        std::size_t scalar_find_of (const T* p, std::size_t n, const T* set, std::size_t k, bool member) noexcept {
+            const unit_set<T> s (set, k);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (s.contains(p[i]) == member) {
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        template <typename T>
+        std::size_t scalar_rfind_of (const T* p, std::size_t n, const T* set, std::size_t k, bool member) noexcept {
+            const unit_set<T> s (set, k);
+            for (std::size_t i = n; i-- > 0; ) {
+                if (s.contains(p[i]) == member) {
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        // A broadcast compare per unit of the set and step beats a lookup per unit while the set is no larger than a vector.
+        template <typename Ops>
+        constexpr std::size_t vector_set_limit = std::min(max_vector_set, std::max<std::size_t>(Ops::lanes, 4));
+
+
+        // Kernel bodies -----------------------------------------------------------------------------------------------------------------
+
+        // Every scan runs over whole vectors, then finishes with one vector ending at the last unit when the range is long
+        // enough (the lanes it shares with the previous vectors are masked out), or one unit at a time when it is not.
+
+        struct find_body {
+            template <typename Ops, typename T>
+            static std::size_t run (const T* p, std::size_t n, T c) noexcept {
+                constexpr std::size_t L = Ops::lanes;
+                const auto needle = Ops::splat(c);
+                std::size_t i = 0;
+                // Four vectors per step, with one test of their union.
+                for (; i + 4 * L <= n; i += 4 * L) {
+                    const auto c0 = Ops::eq(Ops::load(p + i), needle), c1 = Ops::eq(Ops::load(p + i + L), needle);
+                    const auto c2 = Ops::eq(Ops::load(p + i + 2 * L), needle), c3 = Ops::eq(Ops::load(p + i + 3 * L), needle);
+                    if (Ops::bits(Ops::either(Ops::either(c0, c1), Ops::either(c2, c3))) != 0) {
+                        for (const auto& [m, at] : {std::pair(Ops::bits(c0), i), std::pair(Ops::bits(c1), i + L),
+                                                    std::pair(Ops::bits(c2), i + 2 * L)}) {
+                            if (m != 0) {
+                                return at + first_lane<Ops>(m);
+                            }
+                        }
+                        return i + 3 * L + first_lane<Ops>(Ops::bits(c3));
+                    }
+                }
+                for (; i + L <= n; i += L) {
+                    if (const std::uint64_t m = Ops::bits(Ops::eq(Ops::load(p + i), needle)); m != 0) {
+                        return i + first_lane<Ops>(m);
+                    }
+                }
+                if (i < n && n >= L) {
+                    const std::uint64_t m = lanes_from<Ops>(Ops::bits(Ops::eq(Ops::load(p + n - L), needle)), i - (n - L));
+                    return m != 0 ? n - L + first_lane<Ops>(m) : n;
+                }
+                for (; i < n; ++i) {
+                    if (p[i] == c) {
+                        return i;
+                    }
+                }
+                return n;
+            }
+        };
+
+        struct rfind_body {
+            template <typename Ops, typename T>
+            static std::size_t run (const T* p, std::size_t n, T c) noexcept {
+                constexpr std::size_t L = Ops::lanes;
+                const auto needle = Ops::splat(c);
+                std::size_t i = n;      // [0, i) is left
+                for (; i >= 4 * L; i -= 4 * L) {
+                    const std::size_t at = i - 4 * L;
+                    const auto c0 = Ops::eq(Ops::load(p + at), needle), c1 = Ops::eq(Ops::load(p + at + L), needle);
+                    const auto c2 = Ops::eq(Ops::load(p + at + 2 * L), needle), c3 = Ops::eq(Ops::load(p + at + 3 * L), needle);
+                    if (Ops::bits(Ops::either(Ops::either(c0, c1), Ops::either(c2, c3))) != 0) {
+                        for (const auto& [m, from] : {std::pair(Ops::bits(c3), at + 3 * L), std::pair(Ops::bits(c2), at + 2 * L),
+                                                      std::pair(Ops::bits(c1), at + L)}) {
+                            if (m != 0) {
+                                return from + last_lane<Ops>(m);
+                            }
+                        }
+                        return at + last_lane<Ops>(Ops::bits(c0));
+                    }
+                }
+                for (; i >= L; i -= L) {
+                    if (const std::uint64_t m = Ops::bits(Ops::eq(Ops::load(p + i - L), needle)); m != 0) {
+                        return i - L + last_lane<Ops>(m);
+                    }
+                }
+                if (i > 0 && n >= L) {
+                    const std::uint64_t m = lanes_below<Ops>(Ops::bits(Ops::eq(Ops::load(p), needle)), i);
+                    return m != 0 ? last_lane<Ops>(m) : n;
+                }
+                while (i-- > 0) {
+                    if (p[i] == c) {
+                        return i;
+                    }
+                }
+                return n;
+            }
+        };
+
+        // The first position of [0, n - m] whose units at 0 and m - 1 are first_unit and last_unit and that verify(position)
+        // accepts, or n. m >= 2 and m <= n.
+        template <typename Ops, typename T, typename Verify>
+        std::size_t search_candidates (const T* hay, std::size_t n, std::size_t m, T first_unit, T last_unit, Verify verify) noexcept {
+            constexpr std::size_t L = Ops::lanes;
+            const auto first = Ops::splat(first_unit);
+            const auto last = Ops::splat(last_unit);
+            // The positions of [at, at + L) whose first and last units match.
+            const auto candidates = [&](std::size_t at) {
+                return Ops::bits(Ops::both(Ops::eq(Ops::load(hay + at), first), Ops::eq(Ops::load(hay + at + m - 1), last)));
+            };
+            const std::size_t positions = n - m + 1;
+            std::size_t i = 0;
+            for (; i + L <= positions; i += L) {
+                for (std::uint64_t c = candidates(i); c != 0; c = clear_first<Ops>(c)) {
+                    if (const std::size_t at = i + first_lane<Ops>(c); verify(at)) {
+                        return at;
+                    }
+                }
+            }
+            if (i < positions && positions >= L) {
+                const std::size_t base = positions - L;
+                for (std::uint64_t c = lanes_from<Ops>(candidates(base), i - base); c != 0; c = clear_first<Ops>(c)) {
+                    if (const std::size_t at = base + first_lane<Ops>(c); verify(at)) {
+                        return at;
+                    }
+                }
+                return n;
+            }
+            for (; i < positions; ++i) {
+                if (hay[i] == first_unit && hay[i + m - 1] == last_unit && verify(i)) {
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        // m >= 2 and m <= n.
+        struct search_body {
+            template <typename Ops, typename T>
+            static std::size_t run (const T* hay, std::size_t n, const T* needle, std::size_t m) noexcept {
+                return search_candidates<Ops>(hay, n, m, needle[0], needle[m - 1], [&](std::size_t at) {
+                    return std::memcmp(hay + at + 1, needle + 1, (m - 2) * sizeof(T)) == 0;
+                });
+            }
+        };
+
+        // m >= 2 and m <= n.
+        struct rsearch_body {
+            template <typename Ops, typename T>
+            static std::size_t run (const T* hay, std::size_t n, const T* needle, std::size_t m) noexcept {
+                constexpr std::size_t L = Ops::lanes;
+                const auto first = Ops::splat(needle[0]);
+                const auto last = Ops::splat(needle[m - 1]);
+                const auto candidates = [&](std::size_t at) {
+                    return Ops::bits(Ops::both(Ops::eq(Ops::load(hay + at), first), Ops::eq(Ops::load(hay + at + m - 1), last)));
+                };
+                const auto verify = [&](std::size_t at) {
+                    return std::memcmp(hay + at + 1, needle + 1, (m - 2) * sizeof(T)) == 0;
+                };
+                const std::size_t positions = n - m + 1;
+                std::size_t i = positions;      // positions [0, i) are left
+                for (; i >= L; i -= L) {
+                    for (std::uint64_t c = candidates(i - L); c != 0; c = clear_last<Ops>(c)) {
+                        if (const std::size_t at = i - L + last_lane<Ops>(c); verify(at)) {
+                            return at;
+                        }
+                    }
+                }
+                if (i > 0 && positions >= L) {
+                    for (std::uint64_t c = lanes_below<Ops>(candidates(0), i); c != 0; c = clear_last<Ops>(c)) {
+                        if (const std::size_t at = last_lane<Ops>(c); verify(at)) {
+                            return at;
+                        }
+                    }
+                    return n;
+                }
+                while (i-- > 0) {
+                    if (hay[i] == needle[0] && hay[i + m - 1] == needle[m - 1] && verify(i)) {
+                        return i;
+                    }
+                }
+                return n;
+            }
+        };
+
+        struct mismatch_body {
+            template <typename Ops, typename T>
+            static std::size_t run (const T* a, const T* b, std::size_t n) noexcept {
+                constexpr std::size_t L = Ops::lanes;
+                // Lanes of [at, at + L) where a and b agree.
+                const auto same = [&](std::size_t at) { return Ops::bits(Ops::eq(Ops::load(a + at), Ops::load(b + at))); };
+                std::size_t i = 0;
+                // Four vectors per step while they are all equal; the step that is not is rescanned one vector at a time.
+                for (; i + 4 * L <= n; i += 4 * L) {
+                    if ((same(i) & same(i + L) & same(i + 2 * L) & same(i + 3 * L)) != all_lanes<Ops>) {
+                        break;
+                    }
+                }
+                for (; i + L <= n; i += L) {
+                    if (const std::uint64_t d = ~same(i) & all_lanes<Ops>; d != 0) {
+                        return i + first_lane<Ops>(d);
+                    }
+                }
+                if (i < n && n >= L) {
+                    const std::uint64_t d = lanes_from<Ops>(~same(n - L), i - (n - L));
+                    return d != 0 ? n - L + first_lane<Ops>(d) : n;
+                }
+                for (; i < n; ++i) {
+                    if (a[i] != b[i]) {
+                        return i;
+                    }
+                }
+                return n;
+            }
+        };
+
+        // k >= 1.
+        struct find_of_body {
+            template <typename Ops, typename T>
+            static std::size_t run (const T* p, std::size_t n, const T* set, std::size_t k, bool member) noexcept {
+                constexpr std::size_t L = Ops::lanes;
+                if (k > vector_set_limit<Ops>) {
+                    return scalar_find_of(p, n, set, k, member);
+                }
+                typename Ops::vec units[max_vector_set];
+                for (std::size_t j = 0; j < k; ++j) {
+                    units[j] = Ops::splat(set[j]);
+                }
+                const auto hits = [&](std::size_t at) {
+                    const auto v = Ops::load(p + at);
+                    auto c = Ops::eq(v, units[0]);
+                    for (std::size_t j = 1; j < k; ++j) {
+                        c = Ops::either(c, Ops::eq(v, units[j]));
+                    }
+                    const std::uint64_t bits = Ops::bits(c);
+                    return member ? bits : ~bits & all_lanes<Ops>;
+                };
+                std::size_t i = 0;
+                for (; i + L <= n; i += L) {
+                    if (const std::uint64_t m = hits(i); m != 0) {
+                        return i + first_lane<Ops>(m);
+                    }
+                }
+                if (i < n && n >= L) {
+                    const std::uint64_t m = lanes_from<Ops>(hits(n - L), i - (n - L));
+                    return m != 0 ? n - L + first_lane<Ops>(m) : n;
+                }
+                const std::size_t j = scalar_find_of(p + i, n - i, set, k, member);
+                return j == n - i ? n : i + j;
+            }
+        };
+
+        // k >= 1.
+        struct rfind_of_body {
+            template <typename Ops, typename T>
+            static std::size_t run (const T* p, std::size_t n, const T* set, std::size_t k, bool member) noexcept {
+                constexpr std::size_t L = Ops::lanes;
+                if (k > vector_set_limit<Ops>) {
+                    return scalar_rfind_of(p, n, set, k, member);
+                }
+                typename Ops::vec units[max_vector_set];
+                for (std::size_t j = 0; j < k; ++j) {
+                    units[j] = Ops::splat(set[j]);
+                }
+                const auto hits = [&](std::size_t at) {
+                    const auto v = Ops::load(p + at);
+                    auto c = Ops::eq(v, units[0]);
+                    for (std::size_t j = 1; j < k; ++j) {
+                        c = Ops::either(c, Ops::eq(v, units[j]));
+                    }
+                    const std::uint64_t bits = Ops::bits(c);
+                    return member ? bits : ~bits & all_lanes<Ops>;
+                };
+                std::size_t i = n;      // [0, i) is left
+                for (; i >= L; i -= L) {
+                    if (const std::uint64_t m = hits(i - L); m != 0) {
+                        return i - L + last_lane<Ops>(m);
+                    }
+                }
+                if (i > 0 && n >= L) {
+                    const std::uint64_t m = lanes_below<Ops>(hits(0), i);
+                    return m != 0 ? last_lane<Ops>(m) : n;
+                }
+                const std::size_t j = scalar_rfind_of(p, i, set, k, member);
+                return j == i ? n : j;
+            }
+        };
+
+
+        // Dispatch ----------------------------------------------------------------------------------------------------------------------
+
+        // One entry point per instruction set: flattening compiles the whole body, with its vector operations, for that target.
+        template <typename Body, std::size_t W, typename... Args>
+        std::size_t run_scalar (Args... args) noexcept {
+            return Body::template run<scalar_ops<W> >(args...);
+        }
+
+#if BSV_X86_DISPATCH
+        template <typename Body, std::size_t W, typename... Args>
+        BSV_TARGET("sse2") BSV_FLATTEN
+        std::size_t run_sse2 (Args... args) noexcept {
+            return Body::template run<sse2_ops<W> >(args...);
+        }
+
+        template <typename Body, std::size_t W, typename... Args>
+        BSV_TARGET("avx2") BSV_FLATTEN
+        std::size_t run_avx2 (Args... args) noexcept {
+            return Body::template run<avx2_ops<W> >(args...);
+        }
+
+        template <typename Body, std::size_t W, typename... Args>
+        BSV_TARGET("avx512bw") BSV_FLATTEN
+        std::size_t run_avx512 (Args... args) noexcept {
+            return Body::template run<avx512_ops<W> >(args...);
+        }
+#endif
+
+        template <typename Body, std::size_t W, typename... Args>
+        std::size_t dispatch (Args... args) noexcept {
+            using kernel = std::size_t (*)(Args...) noexcept;
+            static const kernel selected = []() -> kernel {
+#if BSV_X86_DISPATCH
+                if (simd::cpu().avx512bw) {
+                    return run_avx512<Body, W, Args...>;
+                }
+                if (simd::cpu().avx2) {
+                    return run_avx2<Body, W, Args...>;
+                }
+                return run_sse2<Body, W, Args...>;
+#else
+                return run_scalar<Body, W, Args...>;
+#endif
+            }();
+            return selected(args...);
+        }
+    } // namespace detail
+
+
+    // Kernels -------------------------------------------------------------------------------------------------------------------
+
+    template <code_unit T>
+    inline std::size_t find (const T* p, std::size_t n, T c) noexcept {
+        return detail::dispatch<detail::find_body, sizeof(T)>(p, n, c);
+    }
+
+    template <code_unit T>
+    inline std::size_t rfind (const T* p, std::size_t n, T c) noexcept {
+        return detail::dispatch<detail::rfind_body, sizeof(T)>(p, n, c);
+    }
+
+    template <code_unit T>
+    inline std::size_t search (const T* hay, std::size_t n, const T* needle, std::size_t m) noexcept {
+        if (m == 0) { return 0; }
+        if (m > n) { return n; }
+        if (m == 1) { return find(hay, n, needle[0]); }
+        return detail::dispatch<detail::search_body, sizeof(T)>(hay, n, needle, m);
+    }
+
+    template <code_unit T>
+    inline std::size_t rsearch (const T* hay, std::size_t n, const T* needle, std::size_t m) noexcept {
+        if (m > n) { return n; }
+        if (m == 1) { return rfind(hay, n, needle[0]); }
+        return detail::dispatch<detail::rsearch_body, sizeof(T)>(hay, n, needle, m);
+    }
+
+    template <code_unit T>
+    inline std::size_t mismatch (const T* a, const T* b, std::size_t n) noexcept {
+        return detail::dispatch<detail::mismatch_body, sizeof(T)>(a, b, n);
+    }
+
+    template <code_unit T>
+    inline std::size_t find_of (const T* p, std::size_t n, const T* set, std::size_t k, bool member) noexcept {
+        if (k == 0) { return member ? n : 0; }
+        return detail::dispatch<detail::find_of_body, sizeof(T)>(p, n, set, k, member);
+    }
+
+    template <code_unit T>
+    inline std::size_t rfind_of (const T* p, std::size_t n, const T* set, std::size_t k, bool member) noexcept {
+        if (k == 0) { return member || n == 0 ? n : n - 1; }
+        return detail::dispatch<detail::rfind_of_body, sizeof(T)>(p, n, set, k, member);
+    }
+
+} // namespace bsv::simd::units
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif // SIMD_UNITS_IMPL_HPP
@@ -0,0 +1,240 @@
+/*
+Lazy, allocation-free split views over basic_string_view: by a character, by any character of a set, by a substring 
+and by whitespace runs. They are C++20 forward ranges yielding basic_string_views into the original text.
+Delimiters are located 64 code units at a time: one vector step produces a bitmask of all candidate positions in 
+the block, which the iterator keeps and consumes one bit per token, instead of calling find once per token.
+*/
+
+#ifndef SPLIT_HPP
+#define SPLIT_HPP
+
+#include "string_view.hpp"
+#include "simd.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+
+namespace bsv {
+
+    // Delimiter policies. Each one provides
+    //     std::uint64_t mask (const CharT* block) const     - bit i set if a delimiter may start at block[i] (64 units)
+    //     size_type match (view_type text, size_type pos) const  - length of the delimiter at a candidate, npos if none
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class char_delimiter {
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using size_type = typename view_type::size_type;
+
+        private:
+            CharT ch_ {};
+
+        public:
+            constexpr char_delimiter() noexcept = default;
+            constexpr explicit char_delimiter (CharT ch) noexcept;
+
+            std::uint64_t mask (const CharT* block) const noexcept;
+            constexpr size_type match (view_type text, size_type pos) const noexcept;
+    };
+
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class any_of_delimiter {
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using size_type = typename view_type::size_type;
+
+        private:
+            view_type set_;
+            simd::byte_set bytes_;      // only used for byte-sized code units
+
+        public:
+            any_of_delimiter() noexcept = default;
+            explicit any_of_delimiter (view_type set) noexcept;
+
+            std::uint64_t mask (const CharT* block) const noexcept;
+            constexpr size_type match (view_type text, size_type pos) const noexcept;
+    };
+
+    // Candidates are the positions of the first code unit of the needle, verified with compare. An empty needle splits 
+    // the text into single code units, like std::views::split.
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class substring_delimiter {
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using size_type = typename view_type::size_type;
+
+        private:
+            view_type needle_;
+
+        public:
+            constexpr substring_delimiter() noexcept = default;
+            constexpr explicit substring_delimiter (view_type needle) noexcept;
+
+            std::uint64_t mask (const CharT* block) const noexcept;
+            constexpr size_type match (view_type text, size_type pos) const noexcept;
+    };
+
+    namespace detail {
+        // Mask of the current 64-unit block, kept by the iterators between tokens.
+        struct block_cursor {
+            std::size_t base = std::size_t(0) - 64;
+            std::uint64_t mask = 0;
+            std::uint64_t valid = 0;    // positions of the block inside the text
+        };
+
+        // First position >= from whose mask bit equals want, or text.size(). Reuses cursor's mask while from stays in 
+        // the same block; the last partial block is copied into a zero-padded buffer first.
+        template <typename CharT, typename Traits, typename Delimiter>
+        std::size_t next_marked (const Delimiter& delim, basic_string_view<CharT, Traits> text, block_cursor& cursor, 
+                                 std::size_t from, bool want = true) noexcept;
+    } // namespace detail
+
+    // Same semantics as std::views::split: "a,,b" gives "a", "", "b", a trailing delimiter gives a trailing empty field 
+    // and an empty text gives no fields at all. A terminated view takes a trailing delimiter as the end of the last field
+    // instead ("a,b," gives "a", "b"; "," gives one empty field).
+    template <typename CharT, typename Traits, typename Delimiter>
+    class basic_split_view : public std::ranges::view_interface<basic_split_view<CharT, Traits, Delimiter> > {
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using size_type = typename view_type::size_type;
+
+            class iterator;
+
+        private:
+            view_type text_;
+            Delimiter delim_;
+            bool terminated_ = false;
+
+        public:
+            basic_split_view() = default;
+            basic_split_view (view_type text, Delimiter delim, bool terminated = false);
+
+            iterator begin() const;
+            std::default_sentinel_t end() const noexcept;
+
+            view_type base() const noexcept;
+            const Delimiter& delimiter() const noexcept;
+    };
+
+    template <typename CharT, typename Traits, typename Delimiter>
+    class basic_split_view<CharT, Traits, Delimiter>::iterator {
+        public:
+            using iterator_concept = std::forward_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = view_type;
+            using difference_type = std::ptrdiff_t;
+
+        private:
+            const basic_split_view* parent_ = nullptr;
+            size_type cur_ = 0;                 // start of the current field
+            size_type next_begin_ = 0;          // delimiter that ends it: [next_begin_, next_end_)
+            size_type next_end_ = 0;
+            bool trailing_empty_ = false;
+            detail::block_cursor cursor_;
+
+            void find_next (size_type from) noexcept;
+
+        public:
+            iterator() = default;
+            explicit iterator (const basic_split_view& parent);
+
+            view_type operator*() const noexcept;
+            iterator& operator++() noexcept;
+            iterator operator++ (int) noexcept;
+
+            friend bool operator== (const iterator& a, const iterator& b) noexcept { 
+                return a.cur_ == b.cur_ && a.trailing_empty_ == b.trailing_empty_; 
+            }
+            friend bool operator== (const iterator& it, std::default_sentinel_t) noexcept { 
+                return it.cur_ == it.parent_->base().size() && !it.trailing_empty_; 
+            }
+    };
+
+    // Maximal runs of non-whitespace (" \t\n\v\f\r"): leading, trailing and repeated whitespace gives no empty fields.
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class basic_split_whitespace_view : public std::ranges::view_interface<basic_split_whitespace_view<CharT, Traits> > {
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using size_type = typename view_type::size_type;
+
+            class iterator;
+
+        private:
+            view_type text_;
+            any_of_delimiter<CharT, Traits> spaces_;
+
+        public:
+            basic_split_whitespace_view() = default;
+            explicit basic_split_whitespace_view (view_type text);
+
+            iterator begin() const;
+            std::default_sentinel_t end() const noexcept;
+
+            view_type base() const noexcept;
+    };
+
+    template <typename CharT, typename Traits>
+    class basic_split_whitespace_view<CharT, Traits>::iterator {
+        public:
+            using iterator_concept = std::forward_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = view_type;
+            using difference_type = std::ptrdiff_t;
+
+        private:
+            const basic_split_whitespace_view* parent_ = nullptr;
+            size_type begin_ = 0;
+            size_type end_ = 0;
+            detail::block_cursor cursor_;
+
+            void find_from (size_type from) noexcept;
+
+        public:
+            iterator() = default;
+            explicit iterator (const basic_split_whitespace_view& parent);
+
+            view_type operator*() const noexcept;
+            iterator& operator++() noexcept;
+            iterator operator++ (int) noexcept;
+
+            friend bool operator== (const iterator& a, const iterator& b) noexcept { 
+                return a.begin_ == b.begin_; 
+            }
+            friend bool operator== (const iterator& it, std::default_sentinel_t) noexcept { 
+                return it.begin_ == it.parent_->base().size(); 
+            }
+    };
+
+    // Factories ---------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    basic_split_view<CharT, Traits, char_delimiter<CharT, Traits> > 
+    split (basic_string_view<CharT, Traits> text, std::type_identity_t<CharT> delim);
+
+    template <typename CharT, typename Traits>
+    basic_split_view<CharT, Traits, substring_delimiter<CharT, Traits> > 
+    split (basic_string_view<CharT, Traits> text, std::type_identity_t<basic_string_view<CharT, Traits> > delim);
+
+    template <typename CharT, typename Traits>
+    basic_split_view<CharT, Traits, any_of_delimiter<CharT, Traits> > 
+    split_any (basic_string_view<CharT, Traits> text, std::type_identity_t<basic_string_view<CharT, Traits> > delims);
+
+    template <typename CharT, typename Traits>
+    basic_split_whitespace_view<CharT, Traits> split_whitespace (basic_string_view<CharT, Traits> text);
+
+    // Lines separated by '\n'. A final '\n' ends the last line instead of starting an empty one, so "\n" is one empty
+    // line, as in basic_line_index; '\r' is kept.
+    template <typename CharT, typename Traits>
+    basic_split_view<CharT, Traits, char_delimiter<CharT, Traits> > lines (basic_string_view<CharT, Traits> text);
+
+} // namespace bsv
+
+#include "split.impl.hpp"
+
+#endif // SPLIT_HPP
+
+/*
+Methods                           Time Complexity      Auxiliary Space
+split(...).begin()                O(first field)       O(1)
+iterator::operator++()            O(field / 64) vector steps, O(1) if the delimiter is in the cached block
+*/
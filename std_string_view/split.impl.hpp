@@ -0,0 +1,305 @@
+#ifndef SPLIT_IMPL_HPP
+#define SPLIT_IMPL_HPP
+
+#include "split.hpp"
+
+#include <bit>
+#include <type_traits>
+
+namespace bsv {
+    namespace detail {
+        // Byte-sized code units compared bitwise can use the byte kernels of simd.hpp.
+        template <typename CharT, typename Traits>
+        inline constexpr bool byte_units = sizeof(CharT) == 1 && std::is_same_v<Traits, std::char_traits<CharT> >;
+
+        template <typename CharT>
+        inline constexpr CharT whitespace_units[] = {CharT(' '), CharT('\t'), CharT('\n'), CharT('\v'), CharT('\f'), CharT('\r')};
+
+        // Computes the mask of the block starting at from (from < text.size()).
+        template <typename CharT, typename Traits, typename Delimiter>
+        void load_block (const Delimiter& delim, basic_string_view<CharT, Traits> text, block_cursor& cursor, 
+                         std::size_t from) noexcept {
+            constexpr std::size_t block = 64;
+            const std::size_t n = text.size();
+            cursor.base = from;
+            if (n - from >= block) {
+                cursor.mask = delim.mask(text.data() + from);
+                cursor.valid = ~std::uint64_t(0);
+            } else {
+                CharT padded[block] {};
+                Traits::copy(padded, text.data() + from, n - from);
+                cursor.valid = (std::uint64_t(1) << (n - from)) - 1;
+                cursor.mask = delim.mask(padded) & cursor.valid;
+            }
+        }
+
+        // Slow path of next_marked: walks whole blocks until one has a bit equal to want.
+        template <typename CharT, typename Traits, typename Delimiter>
+        std::size_t next_marked_refill (const Delimiter& delim, basic_string_view<CharT, Traits> text, block_cursor& cursor, 
+                                        std::size_t from, bool want) noexcept {
+            constexpr std::size_t block = 64;
+            for (; from < text.size(); from = cursor.base + block) {
+                load_block(delim, text, cursor, from);
+                const std::uint64_t bits = (want ? cursor.mask : ~cursor.mask & cursor.valid) & (~std::uint64_t(0) << (from - cursor.base));
+                if (bits != 0) {
+                    return cursor.base + std::countr_zero(bits);
+                }
+            }
+            return text.size();
+        }
+
+        // The cursor starts one block before 0, so the first call always takes the slow path and the hot path is a 
+        // subtraction, a shift and a bit scan.
+        template <typename CharT, typename Traits, typename Delimiter>
+        inline std::size_t next_marked (const Delimiter& delim, basic_string_view<CharT, Traits> text, block_cursor& cursor, 
+                                        std::size_t from, bool want) noexcept {
+            constexpr std::size_t block = 64;
+            if (const std::size_t skip = from - cursor.base; skip < block) {
+                const std::uint64_t bits = (want ? cursor.mask : ~cursor.mask & cursor.valid) & (~std::uint64_t(0) << skip);
+                if (bits != 0) [[likely]] {
+                    return cursor.base + std::countr_zero(bits);
+                }
+                from = cursor.base + block;
+            }
+            return next_marked_refill(delim, text, cursor, from, want);
+        }
+    } // namespace detail
+
+
+    // Delimiters --------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    constexpr char_delimiter<CharT, Traits>::char_delimiter (CharT ch) noexcept : ch_(ch) {}
+
+    template <typename CharT, typename Traits>
+    std::uint64_t char_delimiter<CharT, Traits>::mask (const CharT* block) const noexcept {
+        if constexpr (detail::byte_units<CharT, Traits>) {
+            return simd::eq_mask64(reinterpret_cast<const unsigned char*>(block), static_cast<unsigned char>(ch_));
+        } else {
+            std::uint64_t m = 0;
+            for (int i = 0; i < 64; ++i) {
+                m |= static_cast<std::uint64_t>(Traits::eq(block[i], ch_)) << i;
+            }
+            return m;
+        }
+    }
+
+    template <typename CharT, typename Traits>
+    constexpr auto char_delimiter<CharT, Traits>::match (view_type, size_type) const noexcept -> size_type {
+        return 1;
+    }
+
+    template <typename CharT, typename Traits>
+    any_of_delimiter<CharT, Traits>::any_of_delimiter (view_type set) noexcept : set_(set) {
+        if constexpr (detail::byte_units<CharT, Traits>) {
+            for (CharT ch : set) {
+                bytes_.insert(static_cast<unsigned char>(ch));
+            }
+        }
+    }
+
+    template <typename CharT, typename Traits>
+    std::uint64_t any_of_delimiter<CharT, Traits>::mask (const CharT* block) const noexcept {
+        if constexpr (detail::byte_units<CharT, Traits>) {
+            return simd::in_mask64(reinterpret_cast<const unsigned char*>(block), bytes_);
+        } else {
+            std::uint64_t m = 0;
+            for (int i = 0; i < 64; ++i) {
+                m |= static_cast<std::uint64_t>(set_.find(block[i]) != view_type::npos) << i;
+            }
+            return m;
+        }
+    }
+
+    template <typename CharT, typename Traits>
+    constexpr auto any_of_delimiter<CharT, Traits>::match (view_type, size_type) const noexcept -> size_type {
+        return 1;
+    }
+
+    template <typename CharT, typename Traits>
+    constexpr substring_delimiter<CharT, Traits>::substring_delimiter (view_type needle) noexcept : needle_(needle) {}
+
+    template <typename CharT, typename Traits>
+    std::uint64_t substring_delimiter<CharT, Traits>::mask (const CharT* block) const noexcept {
+        if (needle_.empty()) {
+            return ~std::uint64_t(0);
+        }
+        return char_delimiter<CharT, Traits>(needle_.front()).mask(block);
+    }
+
+    template <typename CharT, typename Traits>
+    constexpr auto substring_delimiter<CharT, Traits>::match (view_type text, size_type pos) const noexcept -> size_type {
+        return text.size() - pos >= needle_.size() && text.substr(pos, needle_.size()) == needle_ ? needle_.size() 
+                                                                                                   : view_type::npos;
+    }
+
+
+    // basic_split_view --------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits, typename Delimiter>
+    basic_split_view<CharT, Traits, Delimiter>::basic_split_view (view_type text, Delimiter delim, bool terminated) 
+        : text_(text), delim_(std::move(delim)), terminated_(terminated)
+    {}
+
+    template <typename CharT, typename Traits, typename Delimiter>
+    auto basic_split_view<CharT, Traits, Delimiter>::begin() const -> iterator {
+        return iterator(*this);
+    }
+
+    template <typename CharT, typename Traits, typename Delimiter>
+    std::default_sentinel_t basic_split_view<CharT, Traits, Delimiter>::end() const noexcept {
+        return std::default_sentinel;
+    }
+
+    template <typename CharT, typename Traits, typename Delimiter>
+    auto basic_split_view<CharT, Traits, Delimiter>::base() const noexcept -> view_type {
+        return text_;
+    }
+
+    template <typename CharT, typename Traits, typename Delimiter>
+    const Delimiter& basic_split_view<CharT, Traits, Delimiter>::delimiter() const noexcept {
+        return delim_;
+    }
+
+    template <typename CharT, typename Traits, typename Delimiter>
+    basic_split_view<CharT, Traits, Delimiter>::iterator::iterator (const basic_split_view& parent) : parent_(&parent) {
+        find_next(0);
+    }
+
+    // Sets [next_begin_, next_end_) to the first delimiter at or after from, or to [size, size).
+    template <typename CharT, typename Traits, typename Delimiter>
+    inline void basic_split_view<CharT, Traits, Delimiter>::iterator::find_next (size_type from) noexcept {
+        const view_type text = parent_->text_;
+        for (size_type pos = from; ; ++pos) {
+            pos = detail::next_marked(parent_->delim_, text, cursor_, pos);
+            if (pos == text.size()) {
+                next_begin_ = next_end_ = pos;
+                return;
+            }
+            if (const size_type len = parent_->delim_.match(text, pos); len != view_type::npos) {
+                // An empty delimiter matches everywhere; take the one after the first unit, as std::views::split does.
+                const size_type at = (len == 0) ? pos + 1 : pos;
+                next_begin_ = at;
+                next_end_ = at + len;
+                return;
+            }
+        }
+    }
+
+    template <typename CharT, typename Traits, typename Delimiter>
+    auto basic_split_view<CharT, Traits, Delimiter>::iterator::operator*() const noexcept -> view_type {
+        return view_type(parent_->text_.data() + cur_, next_begin_ - cur_);
+    }
+
+    template <typename CharT, typename Traits, typename Delimiter>
+    auto basic_split_view<CharT, Traits, Delimiter>::iterator::operator++() noexcept -> iterator& {
+        const size_type n = parent_->text_.size();
+        cur_ = next_begin_;
+        if (cur_ != n) {
+            cur_ = next_end_;
+            if (cur_ == n) {
+                trailing_empty_ = !parent_->terminated_;
+                next_begin_ = next_end_ = cur_;
+            } else {
+                find_next(cur_);
+            }
+        } else {
+            trailing_empty_ = false;
+        }
+        return *this;
+    }
+
+    template <typename CharT, typename Traits, typename Delimiter>
+    auto basic_split_view<CharT, Traits, Delimiter>::iterator::operator++ (int) noexcept -> iterator {
+        auto old = *this;
+        ++*this;
+        return old;
+    }
+
+
+    // basic_split_whitespace_view ---------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    basic_split_whitespace_view<CharT, Traits>::basic_split_whitespace_view (view_type text) 
+        : text_(text), spaces_(view_type(detail::whitespace_units<CharT>, 6))
+    {}
+
+    template <typename CharT, typename Traits>
+    auto basic_split_whitespace_view<CharT, Traits>::begin() const -> iterator {
+        return iterator(*this);
+    }
+
+    template <typename CharT, typename Traits>
+    std::default_sentinel_t basic_split_whitespace_view<CharT, Traits>::end() const noexcept {
+        return std::default_sentinel;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_split_whitespace_view<CharT, Traits>::base() const noexcept -> view_type {
+        return text_;
+    }
+
+    template <typename CharT, typename Traits>
+    basic_split_whitespace_view<CharT, Traits>::iterator::iterator (const basic_split_whitespace_view& parent) : parent_(&parent) {
+        find_from(0);
+    }
+
+    // Both scans run over the same whitespace mask, so one vector step serves several fields.
+    template <typename CharT, typename Traits>
+    void basic_split_whitespace_view<CharT, Traits>::iterator::find_from (size_type from) noexcept {
+        begin_ = detail::next_marked(parent_->spaces_, parent_->text_, cursor_, from, false);
+        end_ = detail::next_marked(parent_->spaces_, parent_->text_, cursor_, begin_, true);
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_split_whitespace_view<CharT, Traits>::iterator::operator*() const noexcept -> view_type {
+        return view_type(parent_->text_.data() + begin_, end_ - begin_);
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_split_whitespace_view<CharT, Traits>::iterator::operator++() noexcept -> iterator& {
+        find_from(end_);
+        return *this;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_split_whitespace_view<CharT, Traits>::iterator::operator++ (int) noexcept -> iterator {
+        auto old = *this;
+        ++*this;
+        return old;
+    }
+
+
+    // Factories ---------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    basic_split_view<CharT, Traits, char_delimiter<CharT, Traits> > 
+    split (basic_string_view<CharT, Traits> text, std::type_identity_t<CharT> delim) {
+        return {text, char_delimiter<CharT, Traits>(delim)};
+    }
+
+    template <typename CharT, typename Traits>
+    basic_split_view<CharT, Traits, substring_delimiter<CharT, Traits> > 
+    split (basic_string_view<CharT, Traits> text, std::type_identity_t<basic_string_view<CharT, Traits> > delim) {
+        return {text, substring_delimiter<CharT, Traits>(delim)};
+    }
+
+    template <typename CharT, typename Traits>
+    basic_split_view<CharT, Traits, any_of_delimiter<CharT, Traits> > 
+    split_any (basic_string_view<CharT, Traits> text, std::type_identity_t<basic_string_view<CharT, Traits> > delims) {
+        return {text, any_of_delimiter<CharT, Traits>(delims)};
+    }
+
+    template <typename CharT, typename Traits>
+    basic_split_whitespace_view<CharT, Traits> split_whitespace (basic_string_view<CharT, Traits> text) {
+        return basic_split_whitespace_view<CharT, Traits>(text);
+    }
+
+    template <typename CharT, typename Traits>
+    basic_split_view<CharT, Traits, char_delimiter<CharT, Traits> > lines (basic_string_view<CharT, Traits> text) {
+        return {text, char_delimiter<CharT, Traits>(CharT('\n')), true};
+    }
+
+} // namespace bsv
+
+#endif // SPLIT_IMPL_HPP
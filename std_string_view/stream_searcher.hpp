@@ -0,0 +1,96 @@
+/*
+Incremental search over a stream delivered in chunks (network reads, file blocks), finding matches that span chunk
+boundaries without staging the chunks in a contiguous buffer.
+basic_stream_searcher looks for one pattern with basic_string_view::find on every chunk. The only state carried from
+one chunk to the next is the last m - 1 code units (m = pattern length), since that is all a match still open at the
+boundary can have seen; matches starting there are found by searching that tail joined with the first m - 1 units of
+the next chunk.
+basic_stream_multi_searcher looks for many patterns with the Aho-Corasick automaton of basic_multi_searcher, whose
+state already summarizes everything a match in progress needs: nothing is copied at all.
+Both report match positions as offsets in the whole stream.
+*/
+
+#ifndef STREAM_SEARCHER_HPP
+#define STREAM_SEARCHER_HPP
+
+#include "string_view.hpp"
+#include "multi_searcher.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace bsv {
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class basic_stream_searcher {
+        public:
+            using view_type = basic_string_view<CharT, Traits>;
+            using size_type = typename view_type::size_type;
+
+        private:
+            std::vector<CharT> pattern_;
+            std::vector<CharT> tail_;       // the last pattern_.size() - 1 units seen, then the seam being searched
+            size_type offset_ = 0;          // stream offset of the next chunk
+
+        public:
+            // Copies the pattern. An empty pattern never matches.
+            explicit basic_stream_searcher (view_type pattern);
+
+        public:
+            // Calls f(size_type pos) for every match that ends in chunk, pos being its stream offset, in increasing order.
+            // Overlapping matches are all reported. f may return false to stop; feed then returns false, and the 
+            // searcher has to be reset() before it is used again.
+            template <typename F>
+            bool feed (view_type chunk, F f);
+
+            // Starts a new stream.
+            void reset() noexcept;
+
+            // Number of code units fed since the stream started.
+            size_type offset() const noexcept;
+            view_type pattern() const noexcept;
+    };
+
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class basic_stream_multi_searcher {
+        public:
+            using searcher_type = basic_multi_searcher<CharT, Traits>;
+            using view_type = typename searcher_type::view_type;
+            using size_type = typename searcher_type::size_type;
+            using match_type = typename searcher_type::match_type;
+            using prefilter_mode = typename searcher_type::prefilter_mode;
+
+        private:
+            searcher_type searcher_;
+            typename searcher_type::stream_state stream_;
+
+        public:
+            template <typename InputIt>
+            basic_stream_multi_searcher (InputIt first, InputIt last, prefilter_mode mode = prefilter_mode::automatic);
+            basic_stream_multi_searcher (std::initializer_list<view_type> patterns, prefilter_mode mode = prefilter_mode::automatic);
+
+        public:
+            // Calls f(const match_type&) for every match that ends in chunk, in order of the match end; match_type::pos is 
+            // the stream offset. f may return false to stop, feed then returns false.
+            template <typename F>
+            bool feed (view_type chunk, F f);
+
+            void reset() noexcept;
+            size_type offset() const noexcept;
+            const searcher_type& searcher() const noexcept;
+    };
+
+    using stream_searcher = basic_stream_searcher<char>;
+    using stream_multi_searcher = basic_stream_multi_searcher<char>;
+
+} // namespace bsv
+
+#include "stream_searcher.impl.hpp"
+
+#endif // STREAM_SEARCHER_HPP
+
+/*
+Methods                                   Time Complexity             Auxiliary Space
+stream_searcher::feed(chunk)              as find on chunk + O(m^2)   O(m)            m - pattern length
+stream_multi_searcher::feed(chunk)        O(chunk + matches)          O(1)
+*/
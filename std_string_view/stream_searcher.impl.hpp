@@ -0,0 +1,120 @@
+#ifndef STREAM_SEARCHER_IMPL_HPP
+#define STREAM_SEARCHER_IMPL_HPP
+
+#include "stream_searcher.hpp"
+
+#include <type_traits>
+
+namespace bsv {
+    // basic_stream_searcher ---------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    basic_stream_searcher<CharT, Traits>::basic_stream_searcher (view_type pattern) : pattern_(pattern.begin(), pattern.end()) {
+        tail_.reserve(pattern_.empty() ? 0 : 2 * (pattern_.size() - 1));
+    }
+
+    // A match that ends in chunk either lies inside it, or starts in the carried tail and ends within the first m - 1 
+    // units of the chunk. The seam (tail + those units) is searched for the latter, chunk itself for the former.
+    template <typename CharT, typename Traits>
+    template <typename F>
+    bool basic_stream_searcher<CharT, Traits>::feed (view_type chunk, F f) {
+        const auto report = [&f](size_type pos) {
+            if constexpr (std::is_same_v<std::invoke_result_t<F&, size_type>, bool>) {
+                return f(pos);
+            } else {
+                f(pos);
+                return true;
+            }
+        };
+        const size_type m = pattern_.size();
+        if (m == 0) {
+            offset_ += chunk.size();
+            return true;
+        }
+        const view_type pattern(pattern_.data(), m);
+        const size_type keep = m - 1;
+        const size_type carried = tail_.size();
+
+        if (carried != 0) {
+            const size_type head = chunk.size() < keep ? chunk.size() : keep;
+            tail_.insert(tail_.end(), chunk.begin(), chunk.begin() + head);
+            const view_type seam(tail_.data(), tail_.size());
+            for (size_type pos = seam.find(pattern); pos < carried; pos = seam.find(pattern, pos + 1)) {
+                if (!report(offset_ - carried + pos)) {
+                    return false;
+                }
+            }
+            tail_.resize(carried);
+        }
+        for (size_type pos = chunk.find(pattern); pos != view_type::npos; pos = chunk.find(pattern, pos + 1)) {
+            if (!report(offset_ + pos)) {
+                return false;
+            }
+        }
+
+        if (chunk.size() >= keep) {
+            tail_.assign(chunk.end() - keep, chunk.end());
+        } else {
+            tail_.insert(tail_.end(), chunk.begin(), chunk.end());
+            if (tail_.size() > keep) {
+                tail_.erase(tail_.begin(), tail_.end() - keep);
+            }
+        }
+        offset_ += chunk.size();
+        return true;
+    }
+
+    template <typename CharT, typename Traits>
+    void basic_stream_searcher<CharT, Traits>::reset() noexcept {
+        tail_.clear();
+        offset_ = 0;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_stream_searcher<CharT, Traits>::offset() const noexcept -> size_type {
+        return offset_;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_stream_searcher<CharT, Traits>::pattern() const noexcept -> view_type {
+        return view_type(pattern_.data(), pattern_.size());
+    }
+
+
+    // basic_stream_multi_searcher ---------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits>
+    template <typename InputIt>
+    basic_stream_multi_searcher<CharT, Traits>::basic_stream_multi_searcher (InputIt first, InputIt last, prefilter_mode mode)
+        : searcher_(first, last, mode)
+    {}
+
+    template <typename CharT, typename Traits>
+    basic_stream_multi_searcher<CharT, Traits>::basic_stream_multi_searcher (std::initializer_list<view_type> patterns, prefilter_mode mode)
+        : searcher_(patterns, mode)
+    {}
+
+    template <typename CharT, typename Traits>
+    template <typename F>
+    bool basic_stream_multi_searcher<CharT, Traits>::feed (view_type chunk, F f) {
+        return searcher_.for_each_match(stream_, chunk, f);
+    }
+
+    template <typename CharT, typename Traits>
+    void basic_stream_multi_searcher<CharT, Traits>::reset() noexcept {
+        stream_ = {};
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_stream_multi_searcher<CharT, Traits>::offset() const noexcept -> size_type {
+        return stream_.offset;
+    }
+
+    template <typename CharT, typename Traits>
+    auto basic_stream_multi_searcher<CharT, Traits>::searcher() const noexcept -> const searcher_type& {
+        return searcher_;
+    }
+
+} // namespace bsv
+
+#endif // STREAM_SEARCHER_IMPL_HPP
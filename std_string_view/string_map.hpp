@@ -0,0 +1,178 @@
+/*
+Open-addressing hash map from owned strings to T, looked up by basic_string_view without building a key string.
+The layout follows SwissTable: one control byte per slot (7 bits of the hash, or empty / deleted), probed 16 at a 
+time with SSE2, so a lookup usually touches one control group and one slot.
+*/
+
+#ifndef STRING_MAP_HPP
+#define STRING_MAP_HPP
+
+#include "string_view.hpp"
+#include "hash.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace bsv {
+    template <typename T, typename CharT = char, typename Traits = std::char_traits<CharT>,
+              typename Hash = std::hash<basic_string_view<CharT, Traits> > >
+    class basic_string_map {
+        public:
+            using key_type = std::basic_string<CharT, Traits>;
+            using mapped_type = T;
+            /// NOTE: the key is not const so that rehashing can move it; do not modify it through an iterator.
+            using value_type = std::pair<key_type, T>;
+            using view_type = basic_string_view<CharT, Traits>;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using hasher = Hash;
+            using reference = value_type&;
+            using const_reference = const value_type&;
+
+        private:
+            template <bool Const>
+            class basic_iterator;
+
+        public:
+            using iterator = basic_iterator<false>;
+            using const_iterator = basic_iterator<true>;
+
+        private:
+            union slot {
+                slot() noexcept {}
+                ~slot() {}
+                value_type value;
+            };
+
+            static constexpr std::int8_t ctrl_empty = -128;
+            static constexpr std::int8_t ctrl_deleted = -2;
+            static constexpr size_type group_width = 16;
+
+            std::unique_ptr<std::int8_t[]> ctrl_;
+            std::unique_ptr<slot[]> slots_;
+            size_type capacity_ = 0;        // 0 or a power of two >= group_width
+            size_type size_ = 0;
+            size_type deleted_ = 0;
+            Hash hash_;
+
+        public:
+            basic_string_map() = default;
+            explicit basic_string_map (size_type bucket_count, const Hash& hash = Hash());
+            basic_string_map (std::initializer_list<std::pair<view_type, T> > init);
+
+            ~basic_string_map();
+
+            basic_string_map (const basic_string_map& other);
+            basic_string_map (basic_string_map&& other) noexcept;
+
+            basic_string_map& operator= (const basic_string_map& other);
+            basic_string_map& operator= (basic_string_map&& other) noexcept;
+
+        public: // Iterators
+            iterator begin() noexcept;
+            const_iterator begin() const noexcept;
+            const_iterator cbegin() const noexcept;
+
+            iterator end() noexcept;
+            const_iterator end() const noexcept;
+            const_iterator cend() const noexcept;
+
+        public: // Capacity
+            [[nodiscard]] bool empty() const noexcept;
+            size_type size() const noexcept;
+            size_type capacity() const noexcept;
+            float load_factor() const noexcept;
+
+        public: // Lookup
+            iterator find (view_type key);
+            const_iterator find (view_type key) const;
+            bool contains (view_type key) const;
+            size_type count (view_type key) const;
+            T& at (view_type key);
+            const T& at (view_type key) const;
+
+        public: // Modifiers
+            // The key string is only built when key is not present yet.
+            template <typename... Args>
+            std::pair<iterator, bool> try_emplace (view_type key, Args&&... args);
+
+            template <typename M>
+            std::pair<iterator, bool> insert_or_assign (view_type key, M&& obj);
+
+            T& operator[] (view_type key);
+
+            size_type erase (view_type key);
+            iterator erase (const_iterator pos);
+
+            void clear() noexcept;
+            void reserve (size_type count);
+            void rehash (size_type count);
+            void swap (basic_string_map& other) noexcept;
+
+        private:
+            static bool equal (const key_type& k, view_type v) noexcept;
+            static std::uint32_t match_byte (const std::int8_t* group, std::int8_t b) noexcept;
+            static std::uint32_t match_empty_or_deleted (const std::int8_t* group) noexcept;
+
+            size_type find_index (view_type key, std::uint64_t h) const noexcept;
+            size_type find_insert_slot (std::uint64_t h) const noexcept;
+            void set_ctrl (size_type i, std::int8_t c) noexcept;
+            void destroy_all() noexcept;
+            void resize (size_type new_capacity);
+    };
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    template <bool Const>
+    class basic_string_map<T, CharT, Traits, Hash>::basic_iterator {
+        friend class basic_string_map;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = typename basic_string_map::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+            using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+        private:
+            using slot_pointer = std::conditional_t<Const, const slot*, slot*>;
+            const std::int8_t* ctrl_ = nullptr;
+            const std::int8_t* ctrl_end_ = nullptr;
+            slot_pointer slot_ = nullptr;
+
+            basic_iterator (const std::int8_t* ctrl, const std::int8_t* ctrl_end, slot_pointer s) noexcept;
+            void skip_free() noexcept;
+
+        public:
+            basic_iterator() = default;
+            template <bool C = Const, typename = std::enable_if_t<C> >
+            basic_iterator (const basic_iterator<false>& other) noexcept : ctrl_(other.ctrl_), ctrl_end_(other.ctrl_end_), slot_(other.slot_) {}
+
+            reference operator*() const noexcept { return slot_->value; }
+            pointer operator->() const noexcept { return &slot_->value; }
+            basic_iterator& operator++() noexcept;
+            basic_iterator operator++ (int) noexcept;
+            friend bool operator== (const basic_iterator& a, const basic_iterator& b) noexcept { return a.ctrl_ == b.ctrl_; }
+
+            friend class basic_iterator<!Const>;
+    };
+
+    template <typename T>
+    using string_map = basic_string_map<T, char>;
+
+} // namespace bsv
+
+#include "string_map.impl.hpp"
+
+#endif // STRING_MAP_HPP
+
+/*
+Methods                           Time Complexity      Auxiliary Space
+string_map::find()                O(1) expected        O(1)
+string_map::try_emplace()         O(1) amortized       O(key)
+string_map::operator[]()          O(1) amortized       O(key) on insert
+string_map::erase()               O(1) expected        O(1)
+string_map::rehash()              O(N)                 O(N)
+*/
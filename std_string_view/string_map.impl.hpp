@@ -0,0 +1,457 @@
+#ifndef STRING_MAP_IMPL_HPP
+#define STRING_MAP_IMPL_HPP
+
+#include "string_map.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace bsv {
+    // iterator ----------------------------------------------------------------------------------------------------------------------
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    template <bool Const>
+    basic_string_map<T, CharT, Traits, Hash>::basic_iterator<Const>::basic_iterator (const std::int8_t* ctrl, 
+                    const std::int8_t* ctrl_end, slot_pointer s) noexcept 
+        : ctrl_(ctrl), ctrl_end_(ctrl_end), slot_(s)
+    {}
+
+    // Full slots are the ones whose control byte is a hash fragment, i.e. non-negative.
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    template <bool Const>
+    void basic_string_map<T, CharT, Traits, Hash>::basic_iterator<Const>::skip_free() noexcept {
+        while (ctrl_ != ctrl_end_ && *ctrl_ < 0) {
+            ++ctrl_;
+            ++slot_;
+        }
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    template <bool Const>
+    auto basic_string_map<T, CharT, Traits, Hash>::basic_iterator<Const>::operator++() noexcept -> basic_iterator& {
+        ++ctrl_;
+        ++slot_;
+        skip_free();
+        return *this;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    template <bool Const>
+    auto basic_string_map<T, CharT, Traits, Hash>::basic_iterator<Const>::operator++ (int) noexcept -> basic_iterator {
+        auto old = *this;
+        ++*this;
+        return old;
+    }
+
+
+    // ctors -------------------------------------------------------------------------------------------------------------------------
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    basic_string_map<T, CharT, Traits, Hash>::basic_string_map (size_type bucket_count, const Hash& hash) 
+        : hash_(hash)
+    {
+        reserve(bucket_count);
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    basic_string_map<T, CharT, Traits, Hash>::basic_string_map (std::initializer_list<std::pair<view_type, T> > init) {
+        reserve(init.size());
+        for (const auto& [key, value] : init) {
+            try_emplace(key, value);
+        }
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    basic_string_map<T, CharT, Traits, Hash>::~basic_string_map() {
+        destroy_all();
+    }
+
+    // Copies keep the slot positions, tombstones included (probe sequences run through them), so nothing is rehashed.
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    basic_string_map<T, CharT, Traits, Hash>::basic_string_map (const basic_string_map& other) 
+        : hash_(other.hash_)
+    {
+        if (other.capacity_ == 0) {
+            return;
+        }
+        ctrl_ = std::make_unique<std::int8_t[]>(other.capacity_);
+        slots_ = std::make_unique<slot[]>(other.capacity_);
+        capacity_ = other.capacity_;
+        std::fill_n(ctrl_.get(), capacity_, ctrl_empty);
+        try {
+            for (size_type i = 0; i < capacity_; ++i) {
+                if (other.ctrl_[i] >= 0) {
+                    ::new (&slots_[i].value) value_type(other.slots_[i].value);
+                    ++size_;
+                }
+                ctrl_[i] = other.ctrl_[i];
+            }
+        } catch (...) {
+            destroy_all();
+            throw;
+        }
+        deleted_ = other.deleted_;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    basic_string_map<T, CharT, Traits, Hash>::basic_string_map (basic_string_map&& other) noexcept 
+        : ctrl_(std::move(other.ctrl_)), slots_(std::move(other.slots_)), capacity_(other.capacity_), 
+          size_(other.size_), deleted_(other.deleted_), hash_(std::move(other.hash_))
+    {
+        other.capacity_ = other.size_ = other.deleted_ = 0;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::operator= (const basic_string_map& other) -> basic_string_map& {
+        if (this != &other) {
+            basic_string_map copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::operator= (basic_string_map&& other) noexcept -> basic_string_map& {
+        if (this != &other) {
+            destroy_all();
+            ctrl_ = std::move(other.ctrl_);
+            slots_ = std::move(other.slots_);
+            capacity_ = std::exchange(other.capacity_, 0);
+            size_ = std::exchange(other.size_, 0);
+            deleted_ = std::exchange(other.deleted_, 0);
+            hash_ = std::move(other.hash_);
+        }
+        return *this;
+    }
+
+
+    // Iterators ---------------------------------------------------------------------------------------------------------------------
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::begin() noexcept -> iterator {
+        iterator it(ctrl_.get(), ctrl_.get() + capacity_, slots_.get());
+        it.skip_free();
+        return it;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::begin() const noexcept -> const_iterator {
+        const_iterator it(ctrl_.get(), ctrl_.get() + capacity_, slots_.get());
+        it.skip_free();
+        return it;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::cbegin() const noexcept -> const_iterator {
+        return begin();
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::end() noexcept -> iterator {
+        return iterator(ctrl_.get() + capacity_, ctrl_.get() + capacity_, slots_.get() + capacity_);
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::end() const noexcept -> const_iterator {
+        return const_iterator(ctrl_.get() + capacity_, ctrl_.get() + capacity_, slots_.get() + capacity_);
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::cend() const noexcept -> const_iterator {
+        return end();
+    }
+
+
+    // Capacity ----------------------------------------------------------------------------------------------------------------------
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    [[nodiscard]] bool basic_string_map<T, CharT, Traits, Hash>::empty() const noexcept {
+        return size_ == 0;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::size() const noexcept -> size_type {
+        return size_;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::capacity() const noexcept -> size_type {
+        return capacity_;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    float basic_string_map<T, CharT, Traits, Hash>::load_factor() const noexcept {
+        return capacity_ ? static_cast<float>(size_) / static_cast<float>(capacity_) : 0.0f;
+    }
+
+
+    // Lookup ------------------------------------------------------------------------------------------------------------------------
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::find (view_type key) -> iterator {
+        const size_type i = find_index(key, hash_(key));
+        return i == capacity_ ? end() : iterator(ctrl_.get() + i, ctrl_.get() + capacity_, slots_.get() + i);
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::find (view_type key) const -> const_iterator {
+        const size_type i = find_index(key, hash_(key));
+        return i == capacity_ ? end() : const_iterator(ctrl_.get() + i, ctrl_.get() + capacity_, slots_.get() + i);
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    bool basic_string_map<T, CharT, Traits, Hash>::contains (view_type key) const {
+        return find_index(key, hash_(key)) != capacity_;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::count (view_type key) const -> size_type {
+        return contains(key) ? 1 : 0;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    T& basic_string_map<T, CharT, Traits, Hash>::at (view_type key) {
+        const size_type i = find_index(key, hash_(key));
+        if (i == capacity_) {
+            throw std::out_of_range("basic_string_map::at: key not found");
+        }
+        return slots_[i].value.second;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    const T& basic_string_map<T, CharT, Traits, Hash>::at (view_type key) const {
+        const size_type i = find_index(key, hash_(key));
+        if (i == capacity_) {
+            throw std::out_of_range("basic_string_map::at: key not found");
+        }
+        return slots_[i].value.second;
+    }
+
+
+    // Modifiers ---------------------------------------------------------------------------------------------------------------------
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    template <typename... Args>
+    auto basic_string_map<T, CharT, Traits, Hash>::try_emplace (view_type key, Args&&... args) -> std::pair<iterator, bool> {
+        const std::uint64_t h = hash_(key);
+        size_type i = find_index(key, h);
+        if (i != capacity_) {
+            return {iterator(ctrl_.get() + i, ctrl_.get() + capacity_, slots_.get() + i), false};
+        }
+        if (capacity_ == 0 || (size_ + deleted_ + 1) * 8 > capacity_ * 7) {
+            // Mostly tombstones: clean up in place instead of doubling.
+            resize(size_ * 2 + 2 > capacity_ ? std::max(capacity_ * 2, group_width) : capacity_);
+        }
+        i = find_insert_slot(h);
+        ::new (&slots_[i].value) value_type(std::piecewise_construct, std::forward_as_tuple(key.data(), key.size()), 
+                                            std::forward_as_tuple(std::forward<Args>(args)...));
+        if (ctrl_[i] == ctrl_deleted) {
+            --deleted_;
+        }
+        set_ctrl(i, static_cast<std::int8_t>(h & 0x7F));
+        ++size_;
+        return {iterator(ctrl_.get() + i, ctrl_.get() + capacity_, slots_.get() + i), true};
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    template <typename M>
+    auto basic_string_map<T, CharT, Traits, Hash>::insert_or_assign (view_type key, M&& obj) -> std::pair<iterator, bool> {
+        auto res = try_emplace(key, std::forward<M>(obj));
+        if (!res.second) {
+            res.first->second = std::forward<M>(obj);
+        }
+        return res;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    T& basic_string_map<T, CharT, Traits, Hash>::operator[] (view_type key) {
+        return try_emplace(key).first->second;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::erase (view_type key) -> size_type {
+        const size_type i = find_index(key, hash_(key));
+        if (i == capacity_) {
+            return 0;
+        }
+        erase(const_iterator(ctrl_.get() + i, ctrl_.get() + capacity_, slots_.get() + i));
+        return 1;
+    }
+
+    // A slot can go back to empty (rather than deleted) if its group still has an empty slot: no probe sequence can have 
+    // passed through this group looking for a key further on.
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::erase (const_iterator pos) -> iterator {
+        const auto i = static_cast<size_type>(pos.ctrl_ - ctrl_.get());
+        slots_[i].value.~value_type();
+        --size_;
+        const std::int8_t* group = ctrl_.get() + (i & ~(group_width - 1));
+        if (match_byte(group, ctrl_empty) != 0) {
+            set_ctrl(i, ctrl_empty);
+        } else {
+            set_ctrl(i, ctrl_deleted);
+            ++deleted_;
+        }
+        iterator next(ctrl_.get() + i, ctrl_.get() + capacity_, slots_.get() + i);
+        next.skip_free();
+        return next;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    void basic_string_map<T, CharT, Traits, Hash>::clear() noexcept {
+        destroy_all();
+        if (capacity_) {
+            std::fill_n(ctrl_.get(), capacity_, ctrl_empty);
+        }
+        size_ = deleted_ = 0;
+    }
+
+    // Makes room for count elements without rehashing.
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    void basic_string_map<T, CharT, Traits, Hash>::reserve (size_type count) {
+        rehash(count + count / 7 + 1);
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    void basic_string_map<T, CharT, Traits, Hash>::rehash (size_type count) {
+        const size_type needed = std::max({count, (size_ * 8 + 6) / 7, group_width});
+        const size_type new_capacity = std::bit_ceil(needed);
+        if (new_capacity != capacity_ || deleted_ != 0) {
+            resize(new_capacity);
+        }
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    void basic_string_map<T, CharT, Traits, Hash>::swap (basic_string_map& other) noexcept {
+        using std::swap;
+        swap(ctrl_, other.ctrl_);
+        swap(slots_, other.slots_);
+        swap(capacity_, other.capacity_);
+        swap(size_, other.size_);
+        swap(deleted_, other.deleted_);
+        swap(hash_, other.hash_);
+    }
+
+
+    // Internals ---------------------------------------------------------------------------------------------------------------------
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    bool basic_string_map<T, CharT, Traits, Hash>::equal (const key_type& k, view_type v) noexcept {
+        return k.size() == v.size() && Traits::compare(k.data(), v.data(), v.size()) == 0;
+    }
+
+    // Bit i is set if group[i] == b.
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    std::uint32_t basic_string_map<T, CharT, Traits, Hash>::match_byte (const std::int8_t* group, std::int8_t b) noexcept {
+#if defined(__SSE2__)
+        const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(b))));
+#else
+        std::uint32_t mask = 0;
+        for (size_type i = 0; i < group_width; ++i) {
+            mask |= static_cast<std::uint32_t>(group[i] == b) << i;
+        }
+        return mask;
+#endif
+    }
+
+    // Empty and deleted are the only negative control bytes, so this is just the sign bits.
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    std::uint32_t basic_string_map<T, CharT, Traits, Hash>::match_empty_or_deleted (const std::int8_t* group) noexcept {
+#if defined(__SSE2__)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+#else
+        std::uint32_t mask = 0;
+        for (size_type i = 0; i < group_width; ++i) {
+            mask |= static_cast<std::uint32_t>(group[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+
+    // The high bits of the hash pick the first group, the low 7 bits are stored in the control byte. Groups are visited in 
+    // triangular order, which covers all of them since their count is a power of two. Returns capacity_ if not found.
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::find_index (view_type key, std::uint64_t h) const noexcept -> size_type {
+        if (capacity_ == 0) {
+            return capacity_;
+        }
+        const auto h2 = static_cast<std::int8_t>(h & 0x7F);
+        const size_type mask = capacity_ / group_width - 1;
+        size_type g = (h >> 7) & mask;
+        for (size_type step = 1; ; ++step) {
+            const std::int8_t* group = ctrl_.get() + g * group_width;
+            for (std::uint32_t m = match_byte(group, h2); m != 0; m &= m - 1) {
+                const size_type i = g * group_width + std::countr_zero(m);
+                if (equal(slots_[i].value.first, key)) {
+                    return i;
+                }
+            }
+            if (match_byte(group, ctrl_empty) != 0 || step > mask) {
+                return capacity_;
+            }
+            g = (g + step) & mask;
+        }
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    auto basic_string_map<T, CharT, Traits, Hash>::find_insert_slot (std::uint64_t h) const noexcept -> size_type {
+        const size_type mask = capacity_ / group_width - 1;
+        size_type g = (h >> 7) & mask;
+        for (size_type step = 1; ; ++step) {
+            if (const std::uint32_t m = match_empty_or_deleted(ctrl_.get() + g * group_width); m != 0) {
+                return g * group_width + std::countr_zero(m);
+            }
+            g = (g + step) & mask;
+        }
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    void basic_string_map<T, CharT, Traits, Hash>::set_ctrl (size_type i, std::int8_t c) noexcept {
+        ctrl_[i] = c;
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    void basic_string_map<T, CharT, Traits, Hash>::destroy_all() noexcept {
+        for (size_type i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                slots_[i].value.~value_type();
+                ctrl_[i] = ctrl_empty;
+            }
+        }
+    }
+
+    template <typename T, typename CharT, typename Traits, typename Hash>
+    void basic_string_map<T, CharT, Traits, Hash>::resize (size_type new_capacity) {
+        auto old_ctrl = std::move(ctrl_);
+        auto old_slots = std::move(slots_);
+        const size_type old_capacity = capacity_;
+
+        ctrl_ = std::make_unique<std::int8_t[]>(new_capacity);
+        slots_ = std::make_unique<slot[]>(new_capacity);
+        capacity_ = new_capacity;
+        deleted_ = 0;
+        std::fill_n(ctrl_.get(), capacity_, ctrl_empty);
+
+        for (size_type i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] < 0) {
+                continue;
+            }
+            auto& value = old_slots[i].value;
+            const std::uint64_t h = hash_(view_type(value.first.data(), value.first.size()));
+            const size_type j = find_insert_slot(h);
+            ::new (&slots_[j].value) value_type(std::move(value));
+            set_ctrl(j, static_cast<std::int8_t>(h & 0x7F));
+            value.~value_type();
+        }
+    }
+
+} // namespace bsv
+
+#endif // STRING_MAP_IMPL_HPP
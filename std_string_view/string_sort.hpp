@@ -0,0 +1,46 @@
+/*
+Sorting ranges of basic_string_view keys (URLs, object paths) in lexicographic order without rescanning common
+prefixes on every comparison, as std::sort with compare() does.
+Every key is paired with a cache of its next 8 bytes (big-endian, zero padded), so that most steps read the cache
+instead of the string. Large ranges are split by MSD radix sort on the next byte (257 buckets: "ended" and 0..255);
+the buckets below a threshold go to multikey quicksort (Bentley and Sedgewick), which 3-way partitions on the whole
+cached word and descends 8 bytes into the keys of the middle part; small ranges are insertion sorted. Only the keys
+of one range are read at each depth, and each byte of a key about once.
+parallel_string_sort first splits the keys into MSD buckets until none holds more than a share of them, then sorts
+the buckets on a thread_pool, largest first. The buckets are disjoint key ranges already in order, so they need no
+merge afterwards.
+Byte-sized code units with std::char_traits; other views are sorted with std::sort.
+*/
+
+#ifndef STRING_SORT_HPP
+#define STRING_SORT_HPP
+
+#include "string_view.hpp"
+#include "parallel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace bsv {
+    // Sorts [first, last) of basic_string_view in increasing order (the order of compare()). Not stable: equal keys
+    // may be permuted, which for views of equal contents only matters if their data() pointers are.
+    template <typename RandomIt>
+    void string_sort (RandomIt first, RandomIt last);
+
+    // The same order, with the buckets sorted on policy.pool. policy.min_chunk is the number of keys below which
+    // the sort runs on the calling thread alone.
+    template <typename RandomIt>
+    void parallel_string_sort (const parallel_policy& policy, RandomIt first, RandomIt last);
+
+} // namespace bsv
+
+#include "string_sort.impl.hpp"
+
+#endif // STRING_SORT_HPP
+
+/*
+Methods                           Time Complexity                         Auxiliary Space
+string_sort(first, last)          O(D + n log n) word comparisons         O(n)        D - sum of distinguishing prefixes
+parallel_string_sort              O((D + n log n) / threads) + O(n) split   O(n)
+*/
@@ -0,0 +1,274 @@
+#ifndef STRING_SORT_IMPL_HPP
+#define STRING_SORT_IMPL_HPP
+
+#include "string_sort.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bsv {
+    namespace detail {
+        // A key and the v bytes of it from the current depth on, in the top bytes of cache; v is the same for all
+        // the keys of a range, and the bytes past a key's end are zeros.
+        struct sort_item {
+            std::uint64_t cache;
+            const unsigned char* data;
+            std::size_t size;
+        };
+
+        inline constexpr std::size_t sort_insertion_threshold = 16;
+        inline constexpr std::size_t sort_radix_threshold = 1024;
+
+        inline std::uint64_t load_key_word (const sort_item& item, std::size_t depth) noexcept {
+            std::uint64_t word = 0;
+            const std::size_t left = item.size - depth;
+            if (left != 0) {
+                std::memcpy(&word, item.data + depth, left < 8 ? left : 8);
+            }
+            if constexpr (std::endian::native == std::endian::little) {
+                word = __builtin_bswap64(word);
+            }
+            return word;
+        }
+
+        inline void refill_caches (sort_item* a, std::size_t n, std::size_t depth) noexcept {
+            for (std::size_t i = 0; i < n; ++i) {
+                a[i].cache = load_key_word(a[i], depth);
+            }
+        }
+
+        // All keys share their first depth bytes; equal caches hold the same first min(v, sizes) bytes after that.
+        inline bool item_less (const sort_item& a, const sort_item& b, std::size_t depth, unsigned v) noexcept {
+            if (a.cache != b.cache) {
+                return a.cache < b.cache;
+            }
+            const std::size_t la = a.size - depth;
+            const std::size_t lb = b.size - depth;
+            const std::size_t skip = std::min<std::size_t>({v, la, lb});
+            const int r = std::memcmp(a.data + depth + skip, b.data + depth + skip, std::min(la, lb) - skip);
+            return r != 0 ? r < 0 : la < lb;
+        }
+
+        inline void insertion_sort_items (sort_item* a, std::size_t n, std::size_t depth, unsigned v) noexcept {
+            for (std::size_t i = 1; i < n; ++i) {
+                const sort_item x = a[i];
+                std::size_t j = i;
+                for (; j > 0 && item_less(x, a[j - 1], depth, v); --j) {
+                    a[j] = a[j - 1];
+                }
+                a[j] = x;
+            }
+        }
+
+        // One MSD radix step on the top cached byte: counts[0] keys that end at depth, then counts[1 + b] keys whose
+        // byte at depth is b, moved into that order through tmp. The caches are shifted past the byte.
+        inline void radix_distribute (sort_item* a, sort_item* tmp, std::size_t n, std::size_t depth,
+                                      std::array<std::size_t, 257>& counts) noexcept {
+            counts.fill(0);
+            const auto bucket = [depth](const sort_item& item) {
+                return item.size > depth ? static_cast<std::size_t>(item.cache >> 56) + 1 : 0;
+            };
+            for (std::size_t i = 0; i < n; ++i) {
+                ++counts[bucket(a[i])];
+            }
+            if (std::find(counts.begin(), counts.end(), n) == counts.end()) {
+                std::array<std::size_t, 257> next {};
+                for (std::size_t b = 1; b < 257; ++b) {
+                    next[b] = next[b - 1] + counts[b - 1];
+                }
+                for (std::size_t i = 0; i < n; ++i) {
+                    tmp[next[bucket(a[i])]++] = a[i];
+                }
+                std::copy(tmp, tmp + n, a);
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                a[i].cache <<= 8;
+            }
+        }
+
+        inline void sort_items (sort_item* a, sort_item* tmp, std::size_t n, std::size_t depth, unsigned v) {
+            for (;;) {
+                if (n < 2) {
+                    return;
+                }
+                if (v == 0) {
+                    refill_caches(a, n, depth);
+                    v = 8;
+                }
+                if (n < sort_insertion_threshold) {
+                    insertion_sort_items(a, n, depth, v);
+                    return;
+                }
+                if (n >= sort_radix_threshold) {
+                    std::array<std::size_t, 257> counts;
+                    radix_distribute(a, tmp, n, depth, counts);
+                    // counts[0] keys ended: they are equal and first. The largest bucket is sorted by this loop.
+                    std::size_t begin = counts[0];
+                    std::size_t largest = 0;
+                    for (std::size_t b = 1; b < 257; ++b) {
+                        if (counts[b] > counts[largest]) {
+                            largest = b;
+                        }
+                    }
+                    std::size_t largest_begin = 0;
+                    for (std::size_t b = 1; b < 257; ++b) {
+                        if (b == largest) {
+                            largest_begin = begin;
+                        } else {
+                            sort_items(a + begin, tmp + begin, counts[b], depth + 1, v - 1);
+                        }
+                        begin += counts[b];
+                    }
+                    if (largest == 0) {
+                        return;
+                    }
+                    a += largest_begin;
+                    tmp += largest_begin;
+                    n = counts[largest];
+                    depth += 1;
+                    v -= 1;
+                    continue;
+                }
+
+                // Multikey quicksort on the cached word, median of three pivot.
+                std::uint64_t p0 = a[0].cache, p1 = a[n / 2].cache, p2 = a[n - 1].cache;
+                if (p0 > p1) { std::swap(p0, p1); }
+                if (p1 > p2) { std::swap(p1, p2); }
+                if (p0 > p1) { std::swap(p0, p1); }
+                const std::uint64_t pivot = p1;
+                std::size_t lt = 0;
+                std::size_t gt = n;
+                for (std::size_t i = 0; i < gt;) {
+                    if (a[i].cache < pivot) {
+                        std::swap(a[lt++], a[i++]);
+                    } else if (a[i].cache > pivot) {
+                        std::swap(a[i], a[--gt]);
+                    } else {
+                        ++i;
+                    }
+                }
+                sort_items(a, tmp, lt, depth, v);
+                sort_items(a + gt, tmp + gt, n - gt, depth, v);
+                // Equal words: the keys ending within them differ only in length (the padding is zeros) and come
+                // first; the others share v more bytes.
+                sort_item* eq = a + lt;
+                const std::size_t end = depth + v;
+                sort_item* const unfinished = std::partition(eq, a + gt, [end](const sort_item& x) { return x.size <= end; });
+                std::sort(eq, unfinished, [](const sort_item& x, const sort_item& y) { return x.size < y.size; });
+                tmp += unfinished - a;
+                n = static_cast<std::size_t>((a + gt) - unfinished);
+                a = unfinished;
+                depth = end;
+                v = 0;
+            }
+        }
+
+        template <typename View>
+        inline constexpr bool radix_sortable = sizeof(typename View::value_type) == 1 &&
+                                               std::is_same_v<typename View::traits_type, std::char_traits<typename View::value_type> >;
+
+        template <typename View>
+        sort_item make_sort_item (View v) noexcept {
+            return sort_item{0, reinterpret_cast<const unsigned char*>(v.data()), v.size()};
+        }
+
+        template <typename View>
+        View view_of (const sort_item& item) noexcept {
+            return View(reinterpret_cast<const typename View::value_type*>(item.data), item.size);
+        }
+    }
+
+
+    // string_sort -------------------------------------------------------------------------------------------------------------------
+
+    template <typename RandomIt>
+    void string_sort (RandomIt first, RandomIt last) {
+        using view_type = typename std::iterator_traits<RandomIt>::value_type;
+        if constexpr (!detail::radix_sortable<view_type>) {
+            std::sort(first, last);
+        } else {
+            const std::size_t n = static_cast<std::size_t>(last - first);
+            std::vector<detail::sort_item> items(n);
+            std::vector<detail::sort_item> tmp(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                items[i] = detail::make_sort_item(view_type(first[i]));
+            }
+            detail::sort_items(items.data(), tmp.data(), n, 0, 0);
+            for (std::size_t i = 0; i < n; ++i) {
+                first[i] = detail::view_of<view_type>(items[i]);
+            }
+        }
+    }
+
+
+    // parallel_string_sort ----------------------------------------------------------------------------------------------------------
+
+    // Splits with radix steps, on the calling thread, every bucket holding more than 1 / (2 * threads) of the keys;
+    // each step is one pass over the bucket. Long common prefixes only cost a pass per byte, like the sequential sort.
+    template <typename RandomIt>
+    void parallel_string_sort (const parallel_policy& policy, RandomIt first, RandomIt last) {
+        using view_type = typename std::iterator_traits<RandomIt>::value_type;
+        thread_pool& pool = detail::pool_of(policy);
+        const std::size_t n = static_cast<std::size_t>(last - first);
+        if (!detail::radix_sortable<view_type> || pool.size() == 1 || n < std::max<std::size_t>(policy.min_chunk, 2)) {
+            string_sort(first, last);
+            return;
+        }
+        std::vector<detail::sort_item> items(n);
+        std::vector<detail::sort_item> tmp(n);
+        const std::size_t blocks = 4 * pool.size();
+        pool.for_each_index(blocks, [&](std::size_t b) {
+            for (std::size_t i = n * b / blocks; i < n * (b + 1) / blocks; ++i) {
+                items[i] = detail::make_sort_item(view_type(first[i]));
+                items[i].cache = detail::load_key_word(items[i], 0);
+            }
+        });
+
+        struct task {
+            std::size_t begin;
+            std::size_t size;
+            std::size_t depth;
+            unsigned v;
+        };
+        const std::size_t share = std::max<std::size_t>(n / (2 * pool.size()), detail::sort_radix_threshold);
+        std::vector<task> tasks;
+        std::vector<task> split = {task{0, n, 0, 8}};
+        while (!split.empty()) {
+            task t = split.back();
+            split.pop_back();
+            if (t.v == 0) {
+                detail::refill_caches(items.data() + t.begin, t.size, t.depth);
+                t.v = 8;
+            }
+            std::array<std::size_t, 257> counts;
+            detail::radix_distribute(items.data() + t.begin, tmp.data() + t.begin, t.size, t.depth, counts);
+            for (std::size_t b = 1, begin = t.begin + counts[0]; b < 257; begin += counts[b++]) {
+                const task bucket {begin, counts[b], t.depth + 1, t.v - 1};
+                if (bucket.size > share) {
+                    split.push_back(bucket);
+                } else if (bucket.size > 1) {
+                    tasks.push_back(bucket);
+                }
+            }
+        }
+        std::sort(tasks.begin(), tasks.end(), [](const task& a, const task& b) { return a.size > b.size; });
+        pool.for_each_index(tasks.size(), [&](std::size_t i) {
+            const task& t = tasks[i];
+            detail::sort_items(items.data() + t.begin, tmp.data() + t.begin, t.size, t.depth, t.v);
+        });
+
+        pool.for_each_index(blocks, [&](std::size_t b) {
+            for (std::size_t i = n * b / blocks; i < n * (b + 1) / blocks; ++i) {
+                first[i] = detail::view_of<view_type>(items[i]);
+            }
+        });
+    }
+
+} // namespace bsv
+
+#endif // STRING_SORT_IMPL_HPP
@@ -1,6 +1,7 @@
 #ifndef STRING_VIEW_HPP
 #define STRING_VIEW_HPP
 
+#include <compare>
 #include <iterator>
 #include <string>
 #include <type_traits>
@@ -74,17 +75,16 @@ namespace bsv {
             //         R is not convertible to const CharT*, and
             //         Let d be an lvalue of type std::remove_cvref_t<R>, d.operator::std::basic_string_view<CharT, Traits>() 
             //             is not a valid expression.
+            /// NOTE: these have to be constraints rather than static_asserts, otherwise R&& is a better match than the copy 
+            ///       constructor for every non-const or rvalue basic_string_view, and copying one (e.g. in a std::vector) fails.
             template <typename R> 
-            constexpr explicit basic_string_view (R&& r) : data_(std::ranges::data(r)), size_(std::ranges::size(r)) {
-                static_assert(std::is_same_v<std::remove_cvref_t<R>, basic_string_view>, "R must not be basic_string_view");
-                static_assert(std::ranges::contiguous_range<R>, "R must satisfy contiguous_range");
-                static_assert(std::ranges::sized_range<R>, "R must satisfy sized_range");
-                static_assert(std::is_same_v<std::ranges::range_value_t<R>, CharT>, "range_value_t<R> must be the same type as CharT");
-                static_assert(!std::is_convertible_v<R, const CharT*>, "R must not be convertible to const CharT*");
-                static_assert(!requires { static_cast<basic_string_view<CharT, Traits>>(std::declval<R>()); }, "R must not have an operator that converts it to basic_string_view<CharT, Traits>");
-                // std::declval<R>() is basically pretending to have an instance of type R w/out actually creating one
-                /// TODO: is the last assert correct ?
-            }
+                requires (!std::is_same_v<std::remove_cvref_t<R>, basic_string_view> &&
+                          std::ranges::contiguous_range<R> &&
+                          std::ranges::sized_range<R> &&
+                          std::is_same_v<std::ranges::range_value_t<R>, CharT> &&
+                          !std::is_convertible_v<R, const CharT*> &&
+                          !requires (std::remove_cvref_t<R>& d) { d.operator basic_string_view<CharT, Traits>(); })
+            constexpr explicit basic_string_view (R&& r) : data_(std::ranges::data(r)), size_(std::ranges::size(r)) {}
 
             constexpr basic_string_view (std::nullptr_t) = delete;
 
@@ -173,17 +173,40 @@ namespace bsv {
             constexpr size_type find_last_not_of (CharT ch, size_type pos = npos) const noexcept;
             constexpr size_type find_last_not_of (const CharT* s, size_type pos, size_type count) const;
             constexpr size_type find_last_not_of (const CharT* s, size_type pos = npos) const;
+
+        private:
+            // Traits::compare / equality of n code units. With std::char_traits these go through the vector 
+            // first-mismatch kernel of simd_units.hpp (its equality is bitwise), with ci_char_traits through the folding 
+            // one of simd.hpp, otherwise through Traits.
+            static constexpr int compare_units (const CharT* a, const CharT* b, size_type n) noexcept;
+            static constexpr bool equal_units (const CharT* a, const CharT* b, size_type n) noexcept;
+            // Position of the first occurrence of [needle, needle + m) in [hay, hay + n), or npos. std::char_traits 
+            // (of any unit width) use simd::units::search, ci_char_traits simd::fold_find, other traits compare at 
+            // every position.
+            static constexpr size_type search_units (const CharT* hay, size_type n, const CharT* needle, size_type m) noexcept;
+            // The last occurrence, likewise through simd::units::rsearch / simd::fold_rfind. m must not be 0.
+            static constexpr size_type rsearch_units (const CharT* hay, size_type n, const CharT* needle, size_type m) noexcept;
+            // Position of the first / last unit of [p, p + n) that is one of the k units of set (member) or none of 
+            // them (!member), or npos. std::char_traits use simd::units::find_of / rfind_of, other traits Traits::eq.
+            static constexpr size_type find_of_units (const CharT* p, size_type n, const CharT* set, size_type k, bool member) noexcept;
+            static constexpr size_type rfind_of_units (const CharT* p, size_type n, const CharT* set, size_type k, bool member) noexcept;
     };
 
     template <typename CharT, typename Traits>
     std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, basic_string_view<CharT, Traits> v);
 
+    // As in C++20, only == and <=> are declared: !=, <, <=, > and >= (and the reversed argument orders) are rewritten 
+    // in terms of them by the compiler.
     template< class CharT, class Traits >
     constexpr bool operator== (basic_string_view<CharT,Traits> lhs, std::type_identity_t<basic_string_view<CharT,Traits> > rhs) noexcept;
 
+    template< class CharT, class Traits >
+    constexpr auto operator<=> (basic_string_view<CharT,Traits> lhs, std::type_identity_t<basic_string_view<CharT,Traits> > rhs) noexcept;
+
 } // namespace bsv
 
 #include "string_view.impl.hpp"
 #include "string_view_definitions.hpp"
+#include "hash.hpp"
 
 #endif // STRING_VIEW_HPP
\ No newline at end of file
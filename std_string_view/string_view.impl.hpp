@@ -2,6 +2,9 @@
 #define STRING_VIEW_IMPL_HPP
 
 #include "string_view.hpp"
+#include "simd.hpp"
+#include "simd_units.hpp"
+#include "ci_char_traits.hpp"
 
 #include <iostream>
 #include <limits>
@@ -184,7 +187,7 @@ namespace bsv {
     template <typename CharT, typename Traits> 
     constexpr int basic_string_view<CharT, Traits>::compare (basic_string_view v) const noexcept {
         size_type rlen = std::min(size_, v.size_);
-        int res = Traits::compare(data_, v.data_, rlen);
+        int res = compare_units(data_, v.data_, rlen);
         
         if (res != 0) { return res; }
         if (size_ < v.size_) { return -1; }
@@ -227,7 +230,7 @@ namespace bsv {
     // sv 	- 	a string view which may be a result of implicit conversion from std::basic_string
     template <typename CharT, typename Traits> 
     constexpr bool basic_string_view<CharT, Traits>::starts_with (basic_string_view sv) const noexcept {
-        return basic_string_view(data(), std::min(size(), sv.size())) == sv;
+        return size() >= sv.size() && equal_units(data(), sv.data(), sv.size());
     }
     
     // Checks if the string view begins with the given prefix, where the prefix is a single character. Effectively returns 
@@ -251,7 +254,7 @@ namespace bsv {
     // sv 	- 	a string view which may be a result of implicit conversion from std::basic_string
     template <typename CharT, typename Traits> 
     constexpr bool basic_string_view<CharT, Traits>::ends_with (basic_string_view sv) const noexcept {
-        return size() >= sv.size() && compare(size() - sv.size(), npos, sv) == 0;
+        return size() >= sv.size() && equal_units(data() + size() - sv.size(), sv.data(), sv.size());
     }
     
     // Checks if the string view ends with the given suffix, where the suffix is a single character. Effectively returns 
@@ -299,12 +302,8 @@ namespace bsv {
     constexpr basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::find (basic_string_view v, size_type pos) const noexcept {
         if (pos > size_ || v.size_ > size_) { return npos; }
         if (v.size_ == 0) { return pos; } 
-        for (size_type i = pos; i <= size_ - v.size_; ++i) {
-            if (Traits::compare(data_ + i, v.data_, v.size_) == 0) {
-                return i;
-            }
-        }
-        return npos;
+        const size_type i = search_units(data_ + pos, size_ - pos, v.data_, v.size_);
+        return i == npos ? npos : pos + i;
     }
     
     // Equivalent to find(basic_string_view(std::addressof(ch), 1), pos).
@@ -332,20 +331,12 @@ namespace bsv {
     template <typename CharT, typename Traits> 
     constexpr basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::rfind (basic_string_view v, size_type pos) const noexcept {
         if (v.size_ > size_) { return npos; } 
-        if (v.size_ == 0) { return pos; }
-
         if (pos > size_) { pos = size_; }
+        if (v.size_ == 0) { return pos; }
 
-        // Start from the last possible position where v can fit in the string view
+        // Start from the last possible position where v can fit in the string view, down to and including 0
         const size_type start_pos = (size_ - v.size_ < pos ? size_ - v.size_ : pos);
-        for (size_type i = start_pos + 1; i > 0; --i) {
-            /// TODO: is --i correct here ?
-            if (Traits::compare(data_ + i, v.data_, v.size_) == 0) {
-                return i; 
-            }
-        }
-        return npos; 
-        /// TODO: is this correct?
+        return rsearch_units(data_, start_pos + v.size_, v.data_, v.size_);
     }
 
     // Finds the last substring that is equal to the given character sequence. The search begins at pos and proceeds from right to 
@@ -380,15 +371,8 @@ namespace bsv {
     template <typename CharT, typename Traits> 
     constexpr basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::find_first_of (basic_string_view v, size_type pos) const noexcept {
         if (pos >= size_) { return npos; }
-
-        for (size_type i = pos; i < size_; ++i) {
-            for (size_type j = 0; j < v.size_; ++j) {
-                if (Traits::eq(data_[i], v.data_[j])) {
-                    return i;
-                }
-            }
-        }
-        return npos;
+        const size_type i = find_of_units(data_ + pos, size_ - pos, v.data_, v.size_, true);
+        return i == npos ? npos : pos + i;
     }
 
     // Finds the first character equal to any of the characters in the given character sequence.
@@ -417,29 +401,8 @@ namespace bsv {
     // Finds the last occurence of any of the characters of v in this view, ending at position pos.
     template <typename CharT, typename Traits> 
     constexpr basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::find_last_of (basic_string_view v, size_type pos) const noexcept {
-        if (pos >= size_) { pos = size_ - 1; }
-        for (size_type i = pos; i >= 0; --i) { 
-            bool found = false;
-            for (size_type j = 0; j < v.size_; ++j) {
-                if (Traits::eq(data_[i], v.data_[j])) {
-                    found = true;
-                    break;
-                }
-            }
-            if (found) {
-                return i;
-            }
-        }
-        return npos;
-        // for (size_type i = pos; i >= 0; --i) { 
-        //     /// TODO: is --i correct here ?
-        //     for (size_type j = 0; j < v.size_; ++j) {
-        //         if (Traits::eq(data_[i], v.data_[j])) {
-        //             return i;
-        //         }
-        //     }
-        // }
-        // return npos;
+        if (size_ == 0) { return npos; }
+        return rfind_of_units(data_, (pos < size_ ? pos : size_ - 1) + 1, v.data_, v.size_, true);
     }
 
     // Finds the last character equal to one of characters in the given character sequence. Exact search algorithm is not specified. 
@@ -471,29 +434,8 @@ namespace bsv {
     template <typename CharT, typename Traits> 
     constexpr basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::find_first_not_of (basic_string_view v, size_type pos) const noexcept {
         if (pos >= size_) { return npos; }
-
-        for (size_type i = pos; i < size_; ++i) {
-            bool found = false;
-            for (size_type j = 0; j < v.size_; ++j) {
-                if (Traits::eq(data_[i], v.data_[j])) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
-                return i;
-            }
-        }
-        return npos;
-
-        // for (size_type i = pos; i < size_; ++i) {
-        //     for (size_type j = 0; j < v.size_; ++j) {
-        //         if (!Traits::eq(data_[i], v.data_[j])) {
-        //             return i;
-        //         }
-        //     }
-        // }
-        // return npos;
+        const size_type i = find_of_units(data_ + pos, size_ - pos, v.data_, v.size_, false);
+        return i == npos ? npos : pos + i;
     }
 
     // Finds the first character not equal to any of the characters in the given character sequence.
@@ -522,30 +464,8 @@ namespace bsv {
     // Finds the last character not equal to any of the characters of v in this view, starting at position pos.
     template <typename CharT, typename Traits> 
     constexpr basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::find_last_not_of (basic_string_view v, size_type pos) const noexcept {
-        if (pos >= size_) { pos = size_ - 1; }
-        for (size_type i = pos; i >= 0; --i) {
-            bool found = false;
-            for (size_type j = 0; j < v.size_; ++j) {
-                if (Traits::eq(data_[i], v.data_[j])) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
-                return i;
-            }
-        }
-        return npos;
-
-        // for (size_type i = pos; i <= 0; --i) { 
-        //     /// TODO: is --i correct here ?
-        //     for (size_type j = 0; j < v.size_; ++j) {
-        //         if (!Traits::eq(data_[i], v.data_[j])) {
-        //             return i;
-        //         }
-        //     }
-        // }
-        // return npos;
+        if (size_ == 0) { return npos; }
+        return rfind_of_units(data_, (pos < size_ ? pos : size_ - 1) + 1, v.data_, v.size_, false);
     }
 
     // Finds the last character not equal to any of the characters in the given character sequence. The search considers only 
@@ -585,12 +505,149 @@ namespace bsv {
     //     return os;
     // }
 
+    // Lengths first. With equal lengths, starts_with is equality: it checks identity (views of the same characters, 
+    // e.g. interned strings), then the first and last chunks, and only then scans the middle.
     template< class CharT, class Traits >
     constexpr bool operator== (basic_string_view<CharT,Traits> lhs, std::type_identity_t<basic_string_view<CharT,Traits> > rhs) noexcept {
-        return lhs.data() == rhs.data() && lhs.size() == rhs.size();
+        return lhs.size() == rhs.size() && lhs.starts_with(rhs);
     }
 
-    
+    namespace detail {
+        template <typename Traits>
+        struct comparison_category { using type = std::weak_ordering; };
+
+        template <typename Traits> requires requires { typename Traits::comparison_category; }
+        struct comparison_category<Traits> { using type = typename Traits::comparison_category; };
+    } // namespace detail
+
+    // The result type is Traits::comparison_category if Traits has one, std::weak_ordering otherwise.
+    template< class CharT, class Traits >
+    constexpr auto operator<=> (basic_string_view<CharT,Traits> lhs, std::type_identity_t<basic_string_view<CharT,Traits> > rhs) noexcept {
+        return static_cast<typename detail::comparison_category<Traits>::type>(lhs.compare(rhs) <=> 0);
+    }
+
+    // Private helpers ---------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits> 
+    constexpr int basic_string_view<CharT, Traits>::compare_units (const CharT* a, const CharT* b, size_type n) noexcept {
+        if constexpr (std::is_same_v<Traits, std::char_traits<CharT> > && simd::units::code_unit<CharT>) {
+            if (!std::is_constant_evaluated()) {
+                // As in equal_units: short keys inline through simd::mismatch (the first differing byte lies in the first
+                // differing code unit), long ones through the dispatched kernel. Traits orders that code unit.
+                if (a == b) { return 0; }
+                const size_type i = n * sizeof(CharT) <= 64 
+                    ? simd::mismatch(reinterpret_cast<const unsigned char*>(a), reinterpret_cast<const unsigned char*>(b), n * sizeof(CharT)) / sizeof(CharT)
+                    : simd::units::mismatch(a, b, n);
+                if (i == n) { return 0; }
+                return Traits::lt(a[i], b[i]) ? -1 : 1;
+            }
+        }
+        return Traits::compare(a, b, n);
+    }
+
+    template <typename CharT, typename Traits> 
+    constexpr bool basic_string_view<CharT, Traits>::equal_units (const CharT* a, const CharT* b, size_type n) noexcept {
+        if constexpr (std::is_same_v<Traits, std::char_traits<CharT> > && simd::units::code_unit<CharT>) {
+            if (!std::is_constant_evaluated()) {
+                // Short keys are settled by simd::equal's loads at both ends, long ones by the dispatched kernel.
+                if (a == b) { return true; }
+                if (n * sizeof(CharT) <= 64) {
+                    return simd::equal(reinterpret_cast<const unsigned char*>(a), reinterpret_cast<const unsigned char*>(b), n * sizeof(CharT));
+                }
+                return simd::units::mismatch(a, b, n) == n;
+            }
+        } else if constexpr (std::is_same_v<Traits, ci_char_traits>) {
+            if (!std::is_constant_evaluated()) {
+                return a == b || simd::fold_mismatch(reinterpret_cast<const unsigned char*>(a), 
+                                                     reinterpret_cast<const unsigned char*>(b), n) == n;
+            }
+        }
+        return Traits::compare(a, b, n) == 0;
+    }
+
+    template <typename CharT, typename Traits> 
+    constexpr basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::search_units (const CharT* hay, size_type n, const CharT* needle, size_type m) noexcept {
+        if constexpr (std::is_same_v<Traits, std::char_traits<CharT> > && simd::units::code_unit<CharT>) {
+            if (!std::is_constant_evaluated()) {
+                const size_type i = simd::units::search(hay, n, needle, m);
+                return i == n ? npos : i;
+            }
+        } else if constexpr (sizeof(CharT) == 1 && std::is_same_v<Traits, ci_char_traits>) {
+            if (!std::is_constant_evaluated()) {
+                const size_type i = simd::fold_find(reinterpret_cast<const unsigned char*>(hay), n, 
+                                                    reinterpret_cast<const unsigned char*>(needle), m);
+                return i == n ? npos : i;
+            }
+        }
+        for (size_type i = 0; m <= n && i <= n - m; ++i) {
+            if (Traits::compare(hay + i, needle, m) == 0) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    template <typename CharT, typename Traits> 
+    constexpr basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::rsearch_units (const CharT* hay, size_type n, const CharT* needle, size_type m) noexcept {
+        if constexpr (std::is_same_v<Traits, std::char_traits<CharT> > && simd::units::code_unit<CharT>) {
+            if (!std::is_constant_evaluated()) {
+                const size_type i = simd::units::rsearch(hay, n, needle, m);
+                return i == n ? npos : i;
+            }
+        } else if constexpr (sizeof(CharT) == 1 && std::is_same_v<Traits, ci_char_traits>) {
+            if (!std::is_constant_evaluated()) {
+                const size_type i = simd::fold_rfind(reinterpret_cast<const unsigned char*>(hay), n, 
+                                                     reinterpret_cast<const unsigned char*>(needle), m);
+                return i == n ? npos : i;
+            }
+        }
+        for (size_type i = (m <= n ? n - m + 1 : 0); i-- > 0; ) {
+            if (Traits::compare(hay + i, needle, m) == 0) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    template <typename CharT, typename Traits> 
+    constexpr basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::find_of_units (const CharT* p, size_type n, const CharT* set, size_type k, bool member) noexcept {
+        if constexpr (std::is_same_v<Traits, std::char_traits<CharT> > && simd::units::code_unit<CharT>) {
+            if (!std::is_constant_evaluated()) {
+                const size_type i = simd::units::find_of(p, n, set, k, member);
+                return i == n ? npos : i;
+            }
+        }
+        for (size_type i = 0; i < n; ++i) {
+            bool found = false;
+            for (size_type j = 0; j < k && !found; ++j) {
+                found = Traits::eq(p[i], set[j]);
+            }
+            if (found == member) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    template <typename CharT, typename Traits> 
+    constexpr basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::rfind_of_units (const CharT* p, size_type n, const CharT* set, size_type k, bool member) noexcept {
+        if constexpr (std::is_same_v<Traits, std::char_traits<CharT> > && simd::units::code_unit<CharT>) {
+            if (!std::is_constant_evaluated()) {
+                const size_type i = simd::units::rfind_of(p, n, set, k, member);
+                return i == n ? npos : i;
+            }
+        }
+        for (size_type i = n; i-- > 0; ) {
+            bool found = false;
+            for (size_type j = 0; j < k && !found; ++j) {
+                found = Traits::eq(p[i], set[j]);
+            }
+            if (found == member) {
+                return i;
+            }
+        }
+        return npos;
+    }
 
 } // namespace bsv
 
@@ -10,6 +10,7 @@ namespace bsv {
     using u8string_view = basic_string_view<char8_t>;
     using u16string_view = basic_string_view<char16_t>;
     using u32string_view = basic_string_view<char32_t>;
+    using ci_string_view = basic_string_view<char, ci_char_traits>;
 
 } // namespace bsv
 
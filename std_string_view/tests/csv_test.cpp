@@ -0,0 +1,126 @@
+// csv_parser and csv_reader: quoting, escapes and terminators on small inputs, then random tables (quoted delimiters
+// and newlines across 64-byte blocks) written out and parsed back, whole, in chunks and through a small reader buffer.
+
+#include "../csv.hpp"
+#include "../../tests/check.hpp"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    using table = std::vector<std::vector<std::string> >;
+
+    table parse_all (const std::string& text, bsv::csv_dialect dialect = {}) {
+        table out;
+        bsv::csv_parser parser(dialect);
+        parser.parse(bsv::string_view(text.data(), text.size()), true, [&](const bsv::csv_record& r) {
+            std::vector<std::string> record;
+            for (const bsv::string_view field : r) {
+                record.emplace_back(field.data(), field.size());
+            }
+            out.push_back(std::move(record));
+        });
+        return out;
+    }
+
+    table read_all (const std::string& text, std::size_t buffer_size) {
+        table out;
+        std::istringstream in(text);
+        bsv::csv_reader reader(in, {}, buffer_size);
+        reader.for_each_record([&](const bsv::csv_record& r) {
+            std::vector<std::string> record;
+            for (const bsv::string_view field : r) {
+                record.emplace_back(field.data(), field.size());
+            }
+            out.push_back(std::move(record));
+        });
+        return out;
+    }
+
+    // Quotes the fields that need it, and some others.
+    std::string write (const table& t, std::mt19937& rng) {
+        std::string out;
+        for (const auto& record : t) {
+            for (std::size_t i = 0; i < record.size(); ++i) {
+                const std::string& field = record[i];
+                if (i > 0) {
+                    out += ',';
+                }
+                if (field.find_first_of(",\"\n") != std::string::npos || rng() % 4 == 0) {
+                    out += '"';
+                    for (const char ch : field) {
+                        if (ch == '"') {
+                            out += '"';
+                        }
+                        out += ch;
+                    }
+                    out += '"';
+                } else {
+                    out += field;
+                }
+            }
+            out += rng() % 2 ? "\n" : "\r\n";
+        }
+        return out;
+    }
+
+    void test_quoting() {
+        CHECK(parse_all("id,name\n1,\"Smith, \"\"J\"\"\"\n") == (table{{"id", "name"}, {"1", "Smith, \"J\""}}));
+        CHECK(parse_all("a,\"x\ny\",b\r\nc") == (table{{"a", "x\ny", "b"}, {"c"}}));
+        CHECK(parse_all("a,,\n\nb,") == (table{{"a", "", ""}, {""}, {"b", ""}}));
+        CHECK(parse_all("a;\"b;c\"\n", bsv::csv_dialect{';', '"'}) == (table{{"a", "b;c"}}));
+        CHECK(parse_all("a,'b,''c'''\n", bsv::csv_dialect{',', '\''}) == (table{{"a", "b,'c'"}}));
+        CHECK(parse_all("").empty());
+    }
+
+    void test_raw_and_stop() {
+        bsv::csv_parser parser;
+        const std::string text = "a,\"b\"\r\nc,d\ne,f\n";
+        std::vector<std::string> raws;
+        const std::size_t consumed = parser.parse(bsv::string_view(text.data(), text.size()), false, [&](const bsv::csv_record& r) {
+            raws.emplace_back(r.raw().data(), r.raw().size());
+            return raws.size() < 2;
+        });
+        CHECK(raws == (std::vector<std::string>{"a,\"b\"", "c,d"}));
+        CHECK(consumed == text.find('e'));
+
+        // Without last, an unterminated record is left for the next chunk.
+        const std::string partial = "a,b\nc,\"d\n";
+        std::size_t records = 0;
+        CHECK(parser.parse(bsv::string_view(partial.data(), partial.size()), false, [&](const bsv::csv_record&) { ++records; }) == 4);
+        CHECK(records == 1);
+    }
+
+    void test_random_tables() {
+        std::mt19937 rng(44);
+        const std::string alphabet = "ab,\"\n x";
+        for (int round = 0; round < 50; ++round) {
+            table t(1 + rng() % 60);
+            for (auto& record : t) {
+                record.resize(1 + rng() % 6);
+                for (auto& field : record) {
+                    field.resize(rng() % 12);
+                    for (char& ch : field) {
+                        ch = alphabet[rng() % alphabet.size()];
+                    }
+                }
+                if (record.size() == 1 && record[0].empty()) {
+                    record[0].push_back('x');
+                }
+            }
+            const std::string text = write(t, rng);
+            CHECK(parse_all(text) == t);
+            CHECK(read_all(text, 7) == t);
+            CHECK(read_all(text, 1 << 10) == t);
+        }
+    }
+}
+
+int main() {
+    test_quoting();
+    test_raw_and_stop();
+    test_random_tables();
+    return check::report();
+}
@@ -0,0 +1,118 @@
+// basic_glob and basic_glob_set: wildcards, classes, escapes and `**` on paths, glob_mode::text, compile errors, then
+// random patterns and paths on which glob::matches and a glob_set of the same pattern must agree.
+
+#include "../glob.hpp"
+#include "../../tests/check.hpp"
+
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    bool matches (const char* pattern, const char* text, bsv::glob_mode mode = bsv::glob_mode::path) {
+        return bsv::glob(pattern, mode).matches(text);
+    }
+
+    void test_components() {
+        CHECK(matches("/api/*/users/?\?/profile*", "/api/v1/users/42/profile.json"));
+        CHECK(!matches("/api/*/users/?\?/profile*", "/api/v1/x/users/42/profile"));
+        CHECK(!matches("*.js", "app/main.js"));
+        CHECK(matches("*/*.js", "app/main.js"));
+        CHECK(matches("a*b*c", "abc") && matches("a*b*c", "aXbYbZc") && !matches("a*b*c", "aXbYc/"));
+        CHECK(matches("", "") && !matches("", "/") && matches("/", "/"));
+        CHECK(matches("a/", "a/") && !matches("a/", "a"));
+    }
+
+    void test_globstar() {
+        CHECK(matches("/api/**", "/api") && matches("/api/**", "/api/") && matches("/api/**", "/api/v1/users"));
+        CHECK(!matches("/api/**", "/apis/v1"));
+        CHECK(matches("/static/**/*.js", "/static/main.js") && matches("/static/**/*.js", "/static/a/b/c/main.js"));
+        CHECK(!matches("/static/**/*.js", "/static/a/main.css"));
+        CHECK(matches("**/.git/**", ".git") && matches("**/.git/**", "/repo/.git/objects/ab"));
+        CHECK(!matches("**/.git/**", "/repo/.github/x"));
+        CHECK(matches("/a/**/b/**/c", "/a/b/c") && matches("/a/**/b/**/c", "/a/x/b/y/z/c") && !matches("/a/**/b/**/c", "/a/c/b"));
+        CHECK(matches("/a/**/x/y/**/z", "/a/q/x/x/y/z") && !matches("/a/**/x/y/**/z", "/a/x/q/y/z"));
+        CHECK(matches("/x/***/y", "/x/1/2/y") && matches("/x/**/**/y", "/x/y"));
+        CHECK(!matches("/a/**/b", "/a") && !matches("/a/**/b/c", "/a/c"));
+        // A `**` that is not a whole component is a `*`.
+        CHECK(matches("/a**/b", "/abc/b") && !matches("/a**/b", "/a/c/b"));
+    }
+
+    void test_classes_and_escapes() {
+        CHECK(matches("[a-c]x", "bx") && !matches("[a-c]x", "dx"));
+        CHECK(matches("[!a-c]x", "dx") && !matches("[!a-c]x", "ax") && matches("[^0-9]", "z"));
+        CHECK(matches("[]]", "]") && matches("[a-]", "-") && matches("[-a]", "-"));
+        CHECK(matches("\\*", "*") && !matches("\\*", "x") && matches("a\\?b", "a?b"));
+        CHECK(matches("file[0-9][0-9].txt", "file42.txt") && !matches("file[0-9][0-9].txt", "file4.txt"));
+        CHECK_THROWS(bsv::glob("a[bc"), std::invalid_argument);
+        CHECK_THROWS(bsv::glob("ab\\"), std::invalid_argument);
+    }
+
+    void test_text_mode() {
+        CHECK(matches("*.log", "var/log/app.log", bsv::glob_mode::text));
+        CHECK(matches("a**b", "a/x/b", bsv::glob_mode::text));
+        CHECK(matches("*a*a*a*b", "aaaaaaaaab", bsv::glob_mode::text) && !matches("*a*a*a*b", "aaaaaaaaaa", bsv::glob_mode::text));
+        CHECK(!matches("abc", "ab", bsv::glob_mode::text) && matches("abc", "abc", bsv::glob_mode::text));
+    }
+
+    void test_set() {
+        bsv::glob_set acl;
+        CHECK(acl.add("/static/**/*.js") == 0);
+        CHECK(acl.add("/api/**") == 1);
+        CHECK(acl.add("/api/v1/users") == 2);
+        CHECK(acl.add("**/*.js") == 3);
+        CHECK(acl.size() == 4);
+        CHECK(acl.match("/static/app/v2/main.js") == 0);
+        CHECK(acl.match("/api") == 1);
+        CHECK(acl.match("/index.html") == bsv::glob_set::npos);
+
+        std::vector<std::size_t> ids;
+        acl.match_all("/api/v1/users", std::back_inserter(ids));
+        CHECK(ids == (std::vector<std::size_t>{1, 2}));
+        ids.clear();
+        acl.match_all("/static/main.js", std::back_inserter(ids));
+        CHECK(ids == (std::vector<std::size_t>{0, 3}));
+        CHECK(acl[2].matches("/api/v1/users"));
+    }
+
+    void test_random() {
+        std::mt19937 rng(48);
+        const char* pattern_parts[] = {"a", "b", "ab", "*", "?", "**", "[ab]", "*a", "a*", "", "x"};
+        const char* text_parts[] = {"a", "b", "ab", "ba", "", "x", "aa", "bab"};
+        for (int round = 0; round < 2000; ++round) {
+            std::string pattern = rng() % 2 ? "/" : "";
+            for (std::size_t i = 0, n = rng() % 5; i < n; ++i) {
+                pattern += i > 0 ? "/" : "";
+                pattern += pattern_parts[rng() % 11];
+                pattern += pattern_parts[rng() % 11];
+            }
+            for (const bsv::glob_mode mode : {bsv::glob_mode::path, bsv::glob_mode::text}) {
+                const bsv::string_view p(pattern.data(), pattern.size());
+                const bsv::glob g(p, mode);
+                bsv::glob_set set(mode);
+                set.add(p);
+                for (int k = 0; k < 20; ++k) {
+                    std::string text = rng() % 2 ? "/" : "";
+                    for (std::size_t i = 0, n = rng() % 6; i < n; ++i) {
+                        text += i > 0 ? "/" : "";
+                        text += text_parts[rng() % 8];
+                    }
+                    const bsv::string_view t(text.data(), text.size());
+                    CHECK(g.matches(t) == (set.match(t) == 0));
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    test_components();
+    test_globstar();
+    test_classes_and_escapes();
+    test_text_mode();
+    test_set();
+    test_random();
+    return check::report();
+}
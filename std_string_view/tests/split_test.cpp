@@ -0,0 +1,107 @@
+// split, split_any, split_whitespace and lines: the std::views::split semantics on short texts, then long random texts
+// (many 64-unit blocks, delimiters at every offset) against a find loop.
+
+#include "../split.hpp"
+#include "../../tests/check.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    template <typename View>
+    std::vector<std::string> collect (const View& view) {
+        std::vector<std::string> out;
+        for (const auto field : view) {
+            out.emplace_back(field.data(), field.size());
+        }
+        return out;
+    }
+
+    // The fields between any of the units of delims, as std::views::split gives them.
+    std::vector<std::string> reference (const std::string& text, const std::string& delims) {
+        std::vector<std::string> out;
+        if (text.empty()) {
+            return out;
+        }
+        std::size_t from = 0;
+        for (std::size_t next = text.find_first_of(delims); next != std::string::npos; next = text.find_first_of(delims, from)) {
+            out.push_back(text.substr(from, next - from));
+            from = next + 1;
+        }
+        out.push_back(text.substr(from));
+        return out;
+    }
+
+    using fields = std::vector<std::string>;
+
+    void test_char() {
+        CHECK(collect(bsv::split(bsv::string_view("a,,b"), ',')) == (fields{"a", "", "b"}));
+        CHECK(collect(bsv::split(bsv::string_view("a,b,"), ',')) == (fields{"a", "b", ""}));
+        CHECK(collect(bsv::split(bsv::string_view(","), ',')) == (fields{"", ""}));
+        CHECK(collect(bsv::split(bsv::string_view("abc"), ',')) == (fields{"abc"}));
+        CHECK(collect(bsv::split(bsv::string_view(""), ',')).empty());
+    }
+
+    void test_substring() {
+        CHECK(collect(bsv::split(bsv::string_view("a::b:c::"), bsv::string_view("::"))) == (fields{"a", "b:c", ""}));
+        CHECK(collect(bsv::split(bsv::string_view("abc"), bsv::string_view(""))) == (fields{"a", "b", "c"}));
+        CHECK(collect(bsv::split(bsv::string_view("a:"), bsv::string_view("::"))) == (fields{"a:"}));
+    }
+
+    void test_any_and_whitespace() {
+        CHECK(collect(bsv::split_any(bsv::string_view("a,b\nc,\n"), bsv::string_view(",\n"))) == (fields{"a", "b", "c", "", ""}));
+        CHECK(collect(bsv::split_any(bsv::string_view("a\xff" "b\x80" "c"), bsv::string_view("\x80\xff"))) == (fields{"a", "b", "c"}));
+        CHECK(collect(bsv::split_whitespace(bsv::string_view("  one\ttwo \n three "))) == (fields{"one", "two", "three"}));
+        CHECK(collect(bsv::split_whitespace(bsv::string_view(" \t\r\n"))).empty());
+    }
+
+    void test_lines() {
+        CHECK(collect(bsv::lines(bsv::string_view("a\nb\r\n"))) == (fields{"a", "b\r"}));
+        CHECK(collect(bsv::lines(bsv::string_view("\n"))) == (fields{""}));
+        CHECK(collect(bsv::lines(bsv::string_view("a\n\nb"))) == (fields{"a", "", "b"}));
+        CHECK(collect(bsv::lines(bsv::string_view(""))).empty());
+    }
+
+    void test_long_texts() {
+        std::mt19937 rng(44);
+        const std::string alphabet = "ab,;\n \t\x80\xff";
+        for (int round = 0; round < 200; ++round) {
+            std::string text(rng() % 700, 'x');
+            for (char& ch : text) {
+                ch = alphabet[rng() % alphabet.size()];
+            }
+            const bsv::string_view view(text.data(), text.size());
+            CHECK(collect(bsv::split(view, ',')) == reference(text, ","));
+            CHECK(collect(bsv::split_any(view, bsv::string_view(",;\n"))) == reference(text, ",;\n"));
+            CHECK(collect(bsv::split_any(view, bsv::string_view("\x80\xff"))) == reference(text, "\x80\xff"));
+
+            fields words;
+            for (const std::string& w : reference(text, " \t\n")) {
+                if (!w.empty()) {
+                    words.push_back(w);
+                }
+            }
+            CHECK(collect(bsv::split_whitespace(view)) == words);
+        }
+    }
+
+    void test_wide() {
+        const std::u16string text = u"é,中,,x";
+        std::vector<std::u16string> out;
+        for (const auto field : bsv::split_any(bsv::u16string_view(text.data(), text.size()), bsv::u16string_view(u","))) {
+            out.emplace_back(field.data(), field.size());
+        }
+        CHECK(out == (std::vector<std::u16string>{u"é", u"中", u"", u"x"}));
+    }
+}
+
+int main() {
+    test_char();
+    test_substring();
+    test_any_and_whitespace();
+    test_lines();
+    test_long_texts();
+    test_wide();
+    return check::report();
+}
@@ -0,0 +1,118 @@
+// UTF-8 validation, counting and transcoding: every error kind with its position, then random texts of all sequence
+// lengths (long enough for the vector kernels) converted to UTF-16 and UTF-32 and back, with errors injected.
+
+#include "../utf8.hpp"
+#include "../../tests/check.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    std::string encode (const std::u32string& code_points) {
+        std::string out;
+        for (const char32_t cp : code_points) {
+            if (cp < 0x80) {
+                out += static_cast<char>(cp);
+            } else if (cp < 0x800) {
+                out += static_cast<char>(0xC0 | cp >> 6);
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else if (cp < 0x10000) {
+                out += static_cast<char>(0xE0 | cp >> 12);
+                out += static_cast<char>(0x80 | (cp >> 6 & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | cp >> 18);
+                out += static_cast<char>(0x80 | (cp >> 12 & 0x3F));
+                out += static_cast<char>(0x80 | (cp >> 6 & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        }
+        return out;
+    }
+
+    bsv::utf_result validate (const std::string& bytes) {
+        return bsv::validate_utf8_with_errors(bsv::string_view(bytes.data(), bytes.size()));
+    }
+
+    bool fails_at (const std::string& bytes, bsv::utf_error error, std::size_t position) {
+        const bsv::utf_result r = validate(bytes);
+        return r.error == error && r.count == position && !bsv::validate_utf8(bsv::string_view(bytes.data(), bytes.size()));
+    }
+
+    void test_errors() {
+        CHECK(fails_at("ab\xF8", bsv::utf_error::header_bits, 2));
+        CHECK(fails_at("ab\xC3", bsv::utf_error::too_short, 2));
+        CHECK(fails_at("a\xE2\x82" "b", bsv::utf_error::too_short, 1));
+        CHECK(fails_at("a\x80", bsv::utf_error::too_long, 1));
+        CHECK(fails_at("\xC0\xAF", bsv::utf_error::overlong, 0));
+        CHECK(fails_at("x\xE0\x80\xAF", bsv::utf_error::overlong, 1));
+        CHECK(fails_at("\xF4\x90\x80\x80", bsv::utf_error::too_large, 0));
+        CHECK(fails_at("\xED\xA0\x80", bsv::utf_error::surrogate, 0));
+        CHECK(validate("").error == bsv::utf_error::none);
+
+        const std::u16string lone = u"a\xD800" "b";
+        std::vector<char8_t> out(16);
+        const bsv::utf_result r = bsv::utf16_to_utf8(bsv::u16string_view(lone.data(), lone.size()), out.data());
+        CHECK(r.error == bsv::utf_error::surrogate && r.count == 1);
+        const std::u32string big = U"a\x110000";
+        CHECK(bsv::utf32_to_utf8(bsv::u32string_view(big.data(), big.size()), out.data()).error == bsv::utf_error::too_large);
+    }
+
+    void test_round_trips() {
+        std::mt19937 rng(44);
+        const auto code_point = [&]() -> char32_t {
+            switch (rng() % 5) {
+                case 0: case 1: return 0x20 + rng() % 0x60;
+                case 2: return 0x80 + rng() % (0x800 - 0x80);
+                case 3: {
+                    const char32_t cp = 0x800 + rng() % (0x10000 - 0x800);
+                    return cp >= 0xD800 && cp < 0xE000 ? cp - 0x1000 : cp;
+                }
+                default: return 0x10000 + rng() % (0x110000 - 0x10000);
+            }
+        };
+        for (int round = 0; round < 300; ++round) {
+            std::u32string text32(rng() % 200, U' ');
+            for (char32_t& cp : text32) {
+                cp = code_point();
+            }
+            const std::string text = encode(text32);
+            const bsv::string_view view(text.data(), text.size());
+            CHECK(bsv::validate_utf8(view));
+            CHECK(bsv::count_utf8(view) == text32.size());
+
+            std::vector<char32_t> utf32(text32.size());
+            const bsv::utf_result to32 = bsv::utf8_to_utf32(view, utf32.data());
+            CHECK(to32 && to32.count == text32.size() && std::u32string(utf32.begin(), utf32.end()) == text32);
+
+            std::vector<char16_t> utf16(bsv::utf16_length_from_utf8(view));
+            const bsv::utf_result to16 = bsv::utf8_to_utf16(view, utf16.data());
+            CHECK(to16 && to16.count == utf16.size());
+
+            const bsv::u16string_view view16(utf16.data(), utf16.size());
+            std::vector<char8_t> back(bsv::utf8_length_from_utf16(view16));
+            const bsv::utf_result from16 = bsv::utf16_to_utf8(view16, back.data());
+            CHECK(from16 && back.size() == text.size() && std::equal(back.begin(), back.end(), text.begin(),
+                  [](char8_t a, char b) { return a == static_cast<char8_t>(b); }));
+
+            const bsv::u32string_view view32(utf32.data(), utf32.size());
+            CHECK(bsv::utf8_length_from_utf32(view32) == text.size());
+
+            // A stray byte at a code point boundary is reported where it is.
+            if (!text32.empty()) {
+                const std::size_t at = encode(text32.substr(0, rng() % text32.size())).size();
+                std::string broken = text;
+                broken.insert(at, 1, rng() % 2 ? '\xFF' : '\x80');
+                CHECK(fails_at(broken, broken[at] == '\xFF' ? bsv::utf_error::header_bits : bsv::utf_error::too_long, at));
+            }
+        }
+    }
+}
+
+int main() {
+    test_errors();
+    test_round_trips();
+    return check::report();
+}
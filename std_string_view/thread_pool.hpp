@@ -0,0 +1,89 @@
+/*
+A fixed-size fork-join thread pool for the parallel algorithms: for_each_index(n, f) runs f(0), ..., f(n - 1) on the
+pool's workers and the calling thread, handing indices out one at a time from an atomic counter (so that tasks taken
+in index order are also started in index order), and returns once all of them have finished.
+A for_each_index called from inside a task of the same pool, directly or through another pool (say a parallel_find in a
+parallel_string_sort task on thread_pool::shared()), runs inline on the calling thread: the pool is busy with the outer
+job, and waiting for it would deadlock.
+*/
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bsv {
+    class thread_pool {
+        private:
+            // The pools the current task is nested in, innermost first. A worker running a job continues its caller's
+            // chain, so that a nesting that goes through another pool and back is also caught.
+            struct running_scope {
+                const thread_pool* pool;
+                const running_scope* outer;
+            };
+
+            struct job {
+                const std::function<void(std::size_t)>* f = nullptr;
+                const running_scope* caller = nullptr;      // the pools the caller was running tasks for
+                std::size_t n = 0;
+                std::atomic<std::size_t> next {0};
+                std::mutex error_mutex;
+                std::exception_ptr error;
+            };
+
+            std::vector<std::thread> workers_;
+            std::mutex mutex_;
+            std::condition_variable wake_;
+            std::condition_variable idle_;
+            job* job_ = nullptr;
+            std::uint64_t generation_ = 0;      // bumped for every job, so that a worker never runs one twice
+            std::size_t busy_ = 0;              // workers inside the current job
+            bool stop_ = false;
+            std::mutex run_mutex_;              // one job at a time
+            static inline thread_local const running_scope* running_ = nullptr;    // of the task on this thread
+
+            bool running_here() const noexcept;
+            void work_here (job& j) noexcept;
+            static void work (job& j) noexcept;
+            void worker_loop();
+
+        public:
+            // threads counts the calling thread: thread_pool(1) runs everything on the caller. 0 means one per core.
+            explicit thread_pool (std::size_t threads = 0);
+            ~thread_pool();
+
+            thread_pool (const thread_pool&) = delete;
+            thread_pool& operator= (const thread_pool&) = delete;
+
+        public:
+            std::size_t size() const noexcept;
+
+            // Calls f(i) for every i in [0, n), possibly concurrently. The first exception thrown by f is rethrown here, 
+            // after the other calls have finished; the remaining indices are skipped. Called from a task of this pool,
+            // it runs every f(i) on the calling thread.
+            template <typename F>
+            void for_each_index (std::size_t n, F&& f);
+
+            // A process-wide pool with one thread per core, created on first use.
+            static thread_pool& shared();
+    };
+
+} // namespace bsv
+
+#include "thread_pool.impl.hpp"
+
+#endif // THREAD_POOL_HPP
+
+/*
+Methods                           Time Complexity      Auxiliary Space
+thread_pool(threads)              O(threads)           O(threads)
+for_each_index(n, f)              O(n / size()) calls per thread, plus one wake-up     O(1)
+*/
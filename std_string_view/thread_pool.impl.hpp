@@ -0,0 +1,127 @@
+#ifndef THREAD_POOL_IMPL_HPP
+#define THREAD_POOL_IMPL_HPP
+
+#include "thread_pool.hpp"
+
+namespace bsv {
+    // ctors -------------------------------------------------------------------------------------------------------------------------
+
+    inline thread_pool::thread_pool (std::size_t threads) {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        for (std::size_t i = 1; i < threads; ++i) {
+            workers_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    inline thread_pool::~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : workers_) {
+            t.join();
+        }
+    }
+
+    inline thread_pool& thread_pool::shared() {
+        static thread_pool pool;
+        return pool;
+    }
+
+    inline std::size_t thread_pool::size() const noexcept {
+        return workers_.size() + 1;
+    }
+
+
+    // Jobs --------------------------------------------------------------------------------------------------------------------------
+
+    inline bool thread_pool::running_here() const noexcept {
+        for (const running_scope* r = running_; r != nullptr; r = r->outer) {
+            if (r->pool == this) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // work, with this pool pushed on the caller's running_ chain meanwhile. The caller's scopes outlive the job: it waits
+    // for every worker to leave before returning.
+    inline void thread_pool::work_here (job& j) noexcept {
+        const running_scope* const saved = running_;
+        const running_scope scope {this, j.caller};
+        running_ = &scope;
+        work(j);
+        running_ = saved;
+    }
+
+    inline void thread_pool::work (job& j) noexcept {
+        for (std::size_t i = j.next.fetch_add(1, std::memory_order_relaxed); i < j.n; i = j.next.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                (*j.f)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(j.error_mutex);
+                if (!j.error) {
+                    j.error = std::current_exception();
+                }
+                j.next.store(j.n, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    inline void thread_pool::worker_loop() {
+        std::uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            wake_.wait(lock, [&] { return stop_ || (job_ != nullptr && generation_ != seen); });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+            job& j = *job_;
+            ++busy_;
+            lock.unlock();
+            work_here(j);
+            lock.lock();
+            if (--busy_ == 0) {
+                idle_.notify_all();
+            }
+        }
+    }
+
+    // The caller works on the job too, then waits until no worker is still inside it before the job goes out of scope.
+    template <typename F>
+    void thread_pool::for_each_index (std::size_t n, F&& f) {
+        if (n == 0) {
+            return;
+        }
+        const std::function<void(std::size_t)> task(std::ref(f));
+        job j;
+        j.f = &task;
+        j.caller = running_;
+        j.n = n;
+        if (workers_.empty() || n == 1 || running_here()) {
+            work(j);
+        } else {
+            std::lock_guard<std::mutex> run(run_mutex_);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                job_ = &j;
+                ++generation_;
+            }
+            wake_.notify_all();
+            work_here(j);
+            std::unique_lock<std::mutex> lock(mutex_);
+            job_ = nullptr;
+            idle_.wait(lock, [this] { return busy_ == 0; });
+        }
+        if (j.error) {
+            std::rethrow_exception(j.error);
+        }
+    }
+
+} // namespace bsv
+
+#endif // THREAD_POOL_IMPL_HPP
@@ -0,0 +1,77 @@
+/*
+UTF-8 validation, code point counting and transcoding between UTF-8, UTF-16 and UTF-32, for u8string_view (or any
+view of byte-sized units), u16string_view and u32string_view.
+Validation is the lookup-table algorithm of Keiser and Lemire ("Validating UTF-8 In Less Than One Instruction Per
+Byte", 2021): three pshufb lookups on the nibbles of each byte and of the byte before it classify every 2-byte
+window, and two saturating subtractions check where 3rd and 4th bytes must be. The vector kernels (SSSE3, AVX2) are
+chosen at run time from the CPU; every function has a scalar fallback.
+Transcoding copies ASCII runs 16 units at a time and decodes the other code points one by one.
+*/
+
+#ifndef UTF8_HPP
+#define UTF8_HPP
+
+#include "string_view.hpp"
+#include "simd.hpp"
+
+#include <cstddef>
+
+namespace bsv {
+    enum class utf_error {
+        none,
+        header_bits,    // a byte that cannot start a sequence (0xF8..0xFF)
+        too_short,      // a leading byte not followed by enough continuation bytes
+        too_long,       // a continuation byte without a leading byte
+        overlong,       // a code point encoded with more bytes than needed
+        too_large,      // above U+10FFFF
+        surrogate       // U+D800..U+DFFF in UTF-8 / UTF-32, or an unpaired surrogate in UTF-16
+    };
+
+    // On success count is the number of units written (for validation, the input size). On failure it is the
+    // position of the input unit where the invalid sequence starts; the output up to that point is written.
+    struct utf_result {
+        utf_error error = utf_error::none;
+        std::size_t count = 0;
+
+        explicit operator bool() const noexcept { return error == utf_error::none; }
+    };
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    bool validate_utf8 (basic_string_view<CharT, Traits> text) noexcept;
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    utf_result validate_utf8_with_errors (basic_string_view<CharT, Traits> text) noexcept;
+
+    // Code points of valid UTF-8 (every byte that is not a continuation byte).
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    std::size_t count_utf8 (basic_string_view<CharT, Traits> text) noexcept;
+
+    // Output sizes, for valid input, so that the caller can size the buffers of the conversions below.
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    std::size_t utf16_length_from_utf8 (basic_string_view<CharT, Traits> text) noexcept;
+    std::size_t utf8_length_from_utf16 (u16string_view text) noexcept;
+    std::size_t utf8_length_from_utf32 (u32string_view text) noexcept;
+
+    // Validating conversions into caller-provided buffers.
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    utf_result utf8_to_utf16 (basic_string_view<CharT, Traits> text, char16_t* out) noexcept;
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    utf_result utf8_to_utf32 (basic_string_view<CharT, Traits> text, char32_t* out) noexcept;
+
+    utf_result utf16_to_utf8 (u16string_view text, char8_t* out) noexcept;
+    utf_result utf32_to_utf8 (u32string_view text, char8_t* out) noexcept;
+
+} // namespace bsv
+
+#include "utf8.impl.hpp"
+
+#endif // UTF8_HPP
+
+/*
+Methods                           Time Complexity      Auxiliary Space
+validate_utf8(text)               O(n), 32 bytes per step with AVX2     O(1)
+count_utf8(text)                  O(n)                 O(1)
+utf8_to_utf16 / utf8_to_utf32     O(n)                 O(1) besides the output
+utf16_to_utf8 / utf32_to_utf8     O(n)                 O(1) besides the output
+*/
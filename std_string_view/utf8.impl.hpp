@@ -0,0 +1,615 @@
+#ifndef UTF8_IMPL_HPP
+#define UTF8_IMPL_HPP
+
+#include "utf8.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace bsv {
+    namespace detail {
+        // Scalar --------------------------------------------------------------------------------------------------------------------
+
+        // Decodes the sequence at p[i], advancing i past it; i is left alone on error.
+        inline utf_error decode_utf8 (const unsigned char* p, std::size_t n, std::size_t& i, char32_t& cp) noexcept {
+            const unsigned char b = p[i];
+            const auto continuation = [&](std::size_t k) { return i + k < n && (p[i + k] & 0xC0) == 0x80; };
+            if (b < 0x80) {
+                cp = b;
+                i += 1;
+            } else if ((b & 0xE0) == 0xC0) {
+                if (!continuation(1)) {
+                    return utf_error::too_short;
+                }
+                cp = char32_t(b & 0x1F) << 6 | (p[i + 1] & 0x3F);
+                if (cp < 0x80) {
+                    return utf_error::overlong;
+                }
+                i += 2;
+            } else if ((b & 0xF0) == 0xE0) {
+                if (!continuation(1) || !continuation(2)) {
+                    return utf_error::too_short;
+                }
+                cp = char32_t(b & 0x0F) << 12 | char32_t(p[i + 1] & 0x3F) << 6 | (p[i + 2] & 0x3F);
+                if (cp < 0x800) {
+                    return utf_error::overlong;
+                }
+                if (cp >= 0xD800 && cp <= 0xDFFF) {
+                    return utf_error::surrogate;
+                }
+                i += 3;
+            } else if ((b & 0xF8) == 0xF0) {
+                if (!continuation(1) || !continuation(2) || !continuation(3)) {
+                    return utf_error::too_short;
+                }
+                cp = char32_t(b & 0x07) << 18 | char32_t(p[i + 1] & 0x3F) << 12 | char32_t(p[i + 2] & 0x3F) << 6 | (p[i + 3] & 0x3F);
+                if (cp <= 0xFFFF) {
+                    return utf_error::overlong;
+                }
+                if (cp > 0x10FFFF) {
+                    return utf_error::too_large;
+                }
+                i += 4;
+            } else {
+                return (b & 0xC0) == 0x80 ? utf_error::too_long : utf_error::header_bits;
+            }
+            return utf_error::none;
+        }
+
+        inline utf_result validate_utf8_scalar (const unsigned char* p, std::size_t n, std::size_t from) noexcept {
+            std::size_t i = from;
+            while (i < n) {
+                // Skips ASCII 8 bytes at a time. The condition cannot wrap, so the compiler sees the bound of the load.
+                while (n >= 8 && i <= n - 8) {
+                    std::uint64_t word;
+                    std::memcpy(&word, p + i, 8);
+                    if ((word & 0x8080808080808080) != 0) {
+                        break;
+                    }
+                    i += 8;
+                }
+                if (i == n) {
+                    break;
+                }
+                char32_t cp;
+                if (const utf_error e = decode_utf8(p, n, i, cp); e != utf_error::none) {
+                    return {e, i};
+                }
+            }
+            return {utf_error::none, n};
+        }
+
+        // The vector kernels below return n for valid input, otherwise the start of the chunk where the error was
+        // detected, which is at most 3 bytes past the start of the offending sequence. Errors are only tested once per
+        // chunk, so that the loop carries no branch on them.
+        inline constexpr std::size_t utf8_chunk = 1024;
+        inline std::size_t utf8_check_scalar (const unsigned char* p, std::size_t n) noexcept {
+            return validate_utf8_scalar(p, n, 0).count;
+        }
+
+        // Code points, and 4-byte leading bytes (the code points that take a surrogate pair in UTF-16).
+        struct utf8_counts {
+            std::size_t code_points = 0;
+            std::size_t four_byte = 0;
+        };
+
+        inline utf8_counts utf8_count_scalar (const unsigned char* p, std::size_t n) noexcept {
+            utf8_counts c;
+            for (std::size_t i = 0; i < n; ++i) {
+                c.code_points += static_cast<signed char>(p[i]) > -65;
+                c.four_byte += p[i] >= 0xF0;
+            }
+            return c;
+        }
+
+
+        // Keiser-Lemire lookup tables ------------------------------------------------------------------------------------------------
+
+        // Error classes of a 2-byte window: each table sets the bits of the classes its nibble is compatible with, so
+        // the and of the three lookups is non-zero exactly for the invalid windows.
+        namespace utf8_class {
+            inline constexpr unsigned char too_short = 1 << 0;      // 11______ 0_______ or 11______ 11______
+            inline constexpr unsigned char too_long = 1 << 1;       // 0_______ 10______
+            inline constexpr unsigned char overlong_3 = 1 << 2;     // 11100000 100_____
+            inline constexpr unsigned char too_large = 1 << 3;      // 11110100 1001____, 11110100 101_____, 11110101+ 1001____ ...
+            inline constexpr unsigned char surrogate = 1 << 4;      // 11101101 101_____
+            inline constexpr unsigned char overlong_2 = 1 << 5;     // 1100000_ 10______
+            inline constexpr unsigned char too_large_1000 = 1 << 6; // 11110101+ 1000____
+            inline constexpr unsigned char overlong_4 = 1 << 6;     // 11110000 1000____
+            inline constexpr unsigned char two_conts = 1 << 7;      // 10______ 10______
+            inline constexpr unsigned char carry = too_short | too_long | two_conts;
+        }
+
+        // Indexed by the high nibble of the first byte of the window.
+        alignas(16) inline constexpr unsigned char utf8_byte_1_high[16] = {
+            utf8_class::too_long, utf8_class::too_long, utf8_class::too_long, utf8_class::too_long,
+            utf8_class::too_long, utf8_class::too_long, utf8_class::too_long, utf8_class::too_long,
+            utf8_class::two_conts, utf8_class::two_conts, utf8_class::two_conts, utf8_class::two_conts,
+            utf8_class::too_short | utf8_class::overlong_2,
+            utf8_class::too_short,
+            utf8_class::too_short | utf8_class::overlong_3 | utf8_class::surrogate,
+            utf8_class::too_short | utf8_class::too_large | utf8_class::too_large_1000 | utf8_class::overlong_4
+        };
+
+        // Indexed by the low nibble of the first byte.
+        alignas(16) inline constexpr unsigned char utf8_byte_1_low[16] = {
+            utf8_class::carry | utf8_class::overlong_3 | utf8_class::overlong_2 | utf8_class::overlong_4,
+            utf8_class::carry | utf8_class::overlong_2,
+            utf8_class::carry,
+            utf8_class::carry,
+            utf8_class::carry | utf8_class::too_large,
+            utf8_class::carry | utf8_class::too_large | utf8_class::too_large_1000,
+            utf8_class::carry | utf8_class::too_large | utf8_class::too_large_1000,
+            utf8_class::carry | utf8_class::too_large | utf8_class::too_large_1000,
+            utf8_class::carry | utf8_class::too_large | utf8_class::too_large_1000,
+            utf8_class::carry | utf8_class::too_large | utf8_class::too_large_1000,
+            utf8_class::carry | utf8_class::too_large | utf8_class::too_large_1000,
+            utf8_class::carry | utf8_class::too_large | utf8_class::too_large_1000,
+            utf8_class::carry | utf8_class::too_large | utf8_class::too_large_1000,
+            utf8_class::carry | utf8_class::too_large | utf8_class::too_large_1000 | utf8_class::surrogate,
+            utf8_class::carry | utf8_class::too_large | utf8_class::too_large_1000,
+            utf8_class::carry | utf8_class::too_large | utf8_class::too_large_1000
+        };
+
+        // Indexed by the high nibble of the second byte.
+        alignas(16) inline constexpr unsigned char utf8_byte_2_high[16] = {
+            utf8_class::too_short, utf8_class::too_short, utf8_class::too_short, utf8_class::too_short,
+            utf8_class::too_short, utf8_class::too_short, utf8_class::too_short, utf8_class::too_short,
+            utf8_class::too_long | utf8_class::overlong_2 | utf8_class::two_conts | utf8_class::overlong_3
+                | utf8_class::too_large_1000 | utf8_class::overlong_4,
+            utf8_class::too_long | utf8_class::overlong_2 | utf8_class::two_conts | utf8_class::overlong_3
+                | utf8_class::too_large,
+            utf8_class::too_long | utf8_class::overlong_2 | utf8_class::two_conts | utf8_class::surrogate
+                | utf8_class::too_large,
+            utf8_class::too_long | utf8_class::overlong_2 | utf8_class::two_conts | utf8_class::surrogate
+                | utf8_class::too_large,
+            utf8_class::too_short, utf8_class::too_short, utf8_class::too_short, utf8_class::too_short
+        };
+
+
+#if BSV_X86_DISPATCH
+        // SSSE3 ---------------------------------------------------------------------------------------------------------------------
+
+        BSV_TARGET("ssse3")
+        inline __m128i utf8_errors_16 (__m128i input, __m128i prev_input) noexcept {
+            const __m128i nibble = _mm_set1_epi8(0x0F);
+            const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+            const __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+            const __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+            const __m128i byte_1_high = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(utf8_byte_1_high)),
+                                                         _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+            const __m128i byte_1_low = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(utf8_byte_1_low)),
+                                                        _mm_and_si128(prev1, nibble));
+            const __m128i byte_2_high = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(utf8_byte_2_high)),
+                                                         _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+            const __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+            // Bytes 2 and 3 positions after a 3- or 4-byte lead must be continuations (and nothing else may be).
+            const __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+            const __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+            const __m128i must_continue = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+            return _mm_xor_si128(must_continue, special);
+        }
+
+        // Checks one 64-byte block, carrying the previous block's bytes and its unfinished sequences over.
+        BSV_TARGET("ssse3")
+        inline void utf8_block_16 (const unsigned char* block, __m128i& prev, __m128i& incomplete, __m128i& error) noexcept {
+            // Non-zero where the block ends in the middle of a sequence.
+            const __m128i max_value = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                    static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+            __m128i in[4];
+            for (int k = 0; k < 4; ++k) {
+                in[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * k));
+            }
+            if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(in[0], in[1]), _mm_or_si128(in[2], in[3]))) == 0) {
+                error = _mm_or_si128(error, incomplete);
+                incomplete = _mm_setzero_si128();
+            } else {
+                error = _mm_or_si128(error, utf8_errors_16(in[0], prev));
+                for (int k = 1; k < 4; ++k) {
+                    error = _mm_or_si128(error, utf8_errors_16(in[k], in[k - 1]));
+                }
+                incomplete = _mm_subs_epu8(in[3], max_value);
+            }
+            prev = in[3];
+        }
+
+        BSV_TARGET("ssse3")
+        inline std::size_t utf8_check_ssse3 (const unsigned char* p, std::size_t n) noexcept {
+            __m128i prev = _mm_setzero_si128();
+            __m128i incomplete = _mm_setzero_si128();
+            __m128i error = _mm_setzero_si128();
+            std::size_t chunk = 0;
+            std::size_t base = 0;
+            for (; n - base >= 64; base += 64) {
+                utf8_block_16(p + base, prev, incomplete, error);
+                if ((base + 64) % utf8_chunk == 0) {
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF) {
+                        return chunk;
+                    }
+                    chunk = base + 64;
+                }
+            }
+            if (base < n) {
+                alignas(16) unsigned char padded[64] = {};
+                std::memcpy(padded, p + base, n - base);
+                utf8_block_16(padded, prev, incomplete, error);
+            }
+            error = _mm_or_si128(error, incomplete);
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF ? chunk : n;
+        }
+
+        // AVX2 ----------------------------------------------------------------------------------------------------------------------
+
+        BSV_TARGET("avx2")
+        inline __m256i utf8_table_32 (const unsigned char* table) noexcept {
+            return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(table)));
+        }
+
+        BSV_TARGET("avx2")
+        inline __m256i utf8_errors_32 (__m256i input, __m256i prev_input) noexcept {
+            const __m256i nibble = _mm256_set1_epi8(0x0F);
+            const __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+            const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+            const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+            const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+            const __m256i byte_1_high = _mm256_shuffle_epi8(utf8_table_32(utf8_byte_1_high), _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+            const __m256i byte_1_low = _mm256_shuffle_epi8(utf8_table_32(utf8_byte_1_low), _mm256_and_si256(prev1, nibble));
+            const __m256i byte_2_high = _mm256_shuffle_epi8(utf8_table_32(utf8_byte_2_high), _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+            const __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+            const __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+            const __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+            const __m256i must_continue = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+            return _mm256_xor_si256(must_continue, special);
+        }
+
+        BSV_TARGET("avx2")
+        inline void utf8_block_32 (const unsigned char* block, __m256i& prev, __m256i& incomplete, __m256i& error) noexcept {
+            const __m256i max_value = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                       -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                       static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+            const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+            const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+            if (_mm256_movemask_epi8(_mm256_or_si256(lo, hi)) == 0) {
+                error = _mm256_or_si256(error, incomplete);
+                incomplete = _mm256_setzero_si256();
+            } else {
+                error = _mm256_or_si256(error, utf8_errors_32(lo, prev));
+                error = _mm256_or_si256(error, utf8_errors_32(hi, lo));
+                incomplete = _mm256_subs_epu8(hi, max_value);
+            }
+            prev = hi;
+        }
+
+        BSV_TARGET("avx2")
+        inline std::size_t utf8_check_avx2 (const unsigned char* p, std::size_t n) noexcept {
+            __m256i prev = _mm256_setzero_si256();
+            __m256i incomplete = _mm256_setzero_si256();
+            __m256i error = _mm256_setzero_si256();
+            std::size_t chunk = 0;
+            std::size_t base = 0;
+            for (; n - base >= 64; base += 64) {
+                utf8_block_32(p + base, prev, incomplete, error);
+                if ((base + 64) % utf8_chunk == 0) {
+                    if (!_mm256_testz_si256(error, error)) {
+                        return chunk;
+                    }
+                    chunk = base + 64;
+                }
+            }
+            if (base < n) {
+                alignas(32) unsigned char padded[64] = {};
+                std::memcpy(padded, p + base, n - base);
+                utf8_block_32(padded, prev, incomplete, error);
+            }
+            error = _mm256_or_si256(error, incomplete);
+            return _mm256_testz_si256(error, error) ? n : chunk;
+        }
+
+        BSV_TARGET("avx2")
+        inline utf8_counts utf8_count_avx2 (const unsigned char* p, std::size_t n) noexcept {
+            utf8_counts c;
+            std::size_t i = 0;
+            for (; n - i >= 32; i += 32) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+                const auto leads = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(-65))));
+                const __m256i f0 = _mm256_set1_epi8(static_cast<char>(0xF0));
+                const auto fours = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(v, f0), v)));
+                c.code_points += std::popcount(leads);
+                c.four_byte += std::popcount(fours);
+            }
+            const utf8_counts tail = utf8_count_scalar(p + i, n - i);
+            c.code_points += tail.code_points;
+            c.four_byte += tail.four_byte;
+            return c;
+        }
+#endif
+
+        inline utf8_counts utf8_count_sse2 (const unsigned char* p, std::size_t n) noexcept {
+            utf8_counts c;
+            std::size_t i = 0;
+#if defined(__SSE2__)
+            for (; n - i >= 16; i += 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+                const auto leads = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, _mm_set1_epi8(-65))));
+                const __m128i f0 = _mm_set1_epi8(static_cast<char>(0xF0));
+                const auto fours = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, f0), v)));
+                c.code_points += std::popcount(leads);
+                c.four_byte += std::popcount(fours);
+            }
+#endif
+            const utf8_counts tail = utf8_count_scalar(p + i, n - i);
+            c.code_points += tail.code_points;
+            c.four_byte += tail.four_byte;
+            return c;
+        }
+
+
+        // Dispatch ------------------------------------------------------------------------------------------------------------------
+
+        inline std::size_t utf8_check (const unsigned char* p, std::size_t n) noexcept {
+            using kernel = std::size_t (*)(const unsigned char*, std::size_t) noexcept;
+            static const kernel selected = []() -> kernel {
+#if BSV_X86_DISPATCH
+                if (simd::cpu().avx2) {
+                    return utf8_check_avx2;
+                }
+                if (simd::cpu().ssse3) {
+                    return utf8_check_ssse3;
+                }
+#endif
+                return utf8_check_scalar;
+            }();
+            return selected(p, n);
+        }
+
+        inline utf8_counts utf8_count (const unsigned char* p, std::size_t n) noexcept {
+            using kernel = utf8_counts (*)(const unsigned char*, std::size_t) noexcept;
+            static const kernel selected = []() -> kernel {
+#if BSV_X86_DISPATCH
+                if (simd::cpu().avx2) {
+                    return utf8_count_avx2;
+                }
+#endif
+                return utf8_count_sse2;
+            }();
+            return selected(p, n);
+        }
+
+        template <typename CharT, typename Traits>
+        const unsigned char* utf8_bytes (basic_string_view<CharT, Traits> text) noexcept {
+            return reinterpret_cast<const unsigned char*>(text.data());
+        }
+    } // namespace detail
+
+
+    // Validation --------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    bool validate_utf8 (basic_string_view<CharT, Traits> text) noexcept {
+        return detail::utf8_check(detail::utf8_bytes(text), text.size()) == text.size();
+    }
+
+    // The vector pass only finds the chunk of the first error; the scalar decoder then pinpoints it, starting from the
+    // last sequence start before that chunk, whose sequence may straddle the boundary.
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    utf_result validate_utf8_with_errors (basic_string_view<CharT, Traits> text) noexcept {
+        const unsigned char* p = detail::utf8_bytes(text);
+        std::size_t from = detail::utf8_check(p, text.size());
+        if (from == text.size()) {
+            return {utf_error::none, text.size()};
+        }
+        for (std::size_t k = 1; k <= 3 && k <= from; ++k) {
+            if ((p[from - k] & 0xC0) != 0x80) {
+                from -= k;
+                break;
+            }
+        }
+        return detail::validate_utf8_scalar(p, text.size(), from);
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    std::size_t count_utf8 (basic_string_view<CharT, Traits> text) noexcept {
+        return detail::utf8_count(detail::utf8_bytes(text), text.size()).code_points;
+    }
+
+
+    // Lengths -----------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    std::size_t utf16_length_from_utf8 (basic_string_view<CharT, Traits> text) noexcept {
+        const detail::utf8_counts c = detail::utf8_count(detail::utf8_bytes(text), text.size());
+        return c.code_points + c.four_byte;
+    }
+
+    // A surrogate pair takes 4 bytes, 2 per unit.
+    inline std::size_t utf8_length_from_utf16 (u16string_view text) noexcept {
+        std::size_t n = 0;
+        for (const char16_t c : text) {
+            n += 1 + (c >= 0x80) + (c >= 0x800) - ((c & 0xF800) == 0xD800);
+        }
+        return n;
+    }
+
+    inline std::size_t utf8_length_from_utf32 (u32string_view text) noexcept {
+        std::size_t n = 0;
+        for (const char32_t c : text) {
+            n += 1 + (c >= 0x80) + (c >= 0x800) + (c >= 0x10000);
+        }
+        return n;
+    }
+
+
+    // Transcoding -------------------------------------------------------------------------------------------------------------------
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    utf_result utf8_to_utf16 (basic_string_view<CharT, Traits> text, char16_t* out) noexcept {
+        const unsigned char* p = detail::utf8_bytes(text);
+        const std::size_t n = text.size();
+        std::size_t i = 0;
+        char16_t* o = out;
+        while (i < n) {
+#if defined(__SSE2__)
+            if (p[i] < 0x80 && n - i >= 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+                if (_mm_movemask_epi8(v) == 0) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(o), _mm_unpacklo_epi8(v, _mm_setzero_si128()));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(o + 8), _mm_unpackhi_epi8(v, _mm_setzero_si128()));
+                    i += 16;
+                    o += 16;
+                    continue;
+                }
+            }
+#endif
+            // Decode at least a vector's worth before looking for ASCII again.
+            for (const std::size_t stop = i + 16 < n ? i + 16 : n; i < stop; ) {
+                char32_t cp;
+                if (const utf_error e = detail::decode_utf8(p, n, i, cp); e != utf_error::none) {
+                    return {e, i};
+                }
+                if (cp < 0x10000) {
+                    *o++ = static_cast<char16_t>(cp);
+                } else {
+                    cp -= 0x10000;
+                    *o++ = static_cast<char16_t>(0xD800 + (cp >> 10));
+                    *o++ = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+                }
+            }
+        }
+        return {utf_error::none, static_cast<std::size_t>(o - out)};
+    }
+
+    template <typename CharT, typename Traits> requires (sizeof(CharT) == 1)
+    utf_result utf8_to_utf32 (basic_string_view<CharT, Traits> text, char32_t* out) noexcept {
+        const unsigned char* p = detail::utf8_bytes(text);
+        const std::size_t n = text.size();
+        std::size_t i = 0;
+        char32_t* o = out;
+        while (i < n) {
+#if defined(__SSE2__)
+            if (p[i] < 0x80 && n - i >= 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+                if (_mm_movemask_epi8(v) == 0) {
+                    const __m128i zero = _mm_setzero_si128();
+                    const __m128i lo = _mm_unpacklo_epi8(v, zero);
+                    const __m128i hi = _mm_unpackhi_epi8(v, zero);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(o), _mm_unpacklo_epi16(lo, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(o + 4), _mm_unpackhi_epi16(lo, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(o + 8), _mm_unpacklo_epi16(hi, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(o + 12), _mm_unpackhi_epi16(hi, zero));
+                    i += 16;
+                    o += 16;
+                    continue;
+                }
+            }
+#endif
+            for (const std::size_t stop = i + 16 < n ? i + 16 : n; i < stop; ) {
+                char32_t cp;
+                if (const utf_error e = detail::decode_utf8(p, n, i, cp); e != utf_error::none) {
+                    return {e, i};
+                }
+                *o++ = cp;
+            }
+        }
+        return {utf_error::none, static_cast<std::size_t>(o - out)};
+    }
+
+    inline utf_result utf16_to_utf8 (u16string_view text, char8_t* out) noexcept {
+        const char16_t* p = text.data();
+        const std::size_t n = text.size();
+        std::size_t i = 0;
+        char8_t* o = out;
+        while (i < n) {
+#if defined(__SSE2__)
+            if (n - i >= 8) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+                const __m128i high = _mm_and_si128(v, _mm_set1_epi16(static_cast<short>(0xFF80)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xFFFF) {
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(o), _mm_packus_epi16(v, v));
+                    i += 8;
+                    o += 8;
+                    continue;
+                }
+            }
+#endif
+            for (const std::size_t stop = i + 8 < n ? i + 8 : n; i < stop; ) {
+                const char32_t c = p[i];
+                if (c < 0x80) {
+                    *o++ = static_cast<char8_t>(c);
+                    i += 1;
+                } else if (c < 0x800) {
+                    *o++ = static_cast<char8_t>(0xC0 | (c >> 6));
+                    *o++ = static_cast<char8_t>(0x80 | (c & 0x3F));
+                    i += 1;
+                } else if ((c & 0xF800) != 0xD800) {
+                    *o++ = static_cast<char8_t>(0xE0 | (c >> 12));
+                    *o++ = static_cast<char8_t>(0x80 | ((c >> 6) & 0x3F));
+                    *o++ = static_cast<char8_t>(0x80 | (c & 0x3F));
+                    i += 1;
+                } else {
+                    if (c > 0xDBFF || i + 1 == n || (p[i + 1] & 0xFC00) != 0xDC00) {
+                        return {utf_error::surrogate, i};
+                    }
+                    const char32_t cp = 0x10000 + ((c - 0xD800) << 10) + (p[i + 1] - 0xDC00);
+                    *o++ = static_cast<char8_t>(0xF0 | (cp >> 18));
+                    *o++ = static_cast<char8_t>(0x80 | ((cp >> 12) & 0x3F));
+                    *o++ = static_cast<char8_t>(0x80 | ((cp >> 6) & 0x3F));
+                    *o++ = static_cast<char8_t>(0x80 | (cp & 0x3F));
+                    i += 2;
+                }
+            }
+        }
+        return {utf_error::none, static_cast<std::size_t>(o - out)};
+    }
+
+    inline utf_result utf32_to_utf8 (u32string_view text, char8_t* out) noexcept {
+        const char32_t* p = text.data();
+        const std::size_t n = text.size();
+        std::size_t i = 0;
+        char8_t* o = out;
+        while (i < n) {
+#if defined(__SSE2__)
+            if (n - i >= 8) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 4));
+                const __m128i high = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi32(~0x7F));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) == 0xFFFF) {
+                    const __m128i words = _mm_packs_epi32(a, b);
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(o), _mm_packus_epi16(words, words));
+                    i += 8;
+                    o += 8;
+                    continue;
+                }
+            }
+#endif
+            for (const std::size_t stop = i + 8 < n ? i + 8 : n; i < stop; ++i) {
+                const char32_t c = p[i];
+                if (c < 0x80) {
+                    *o++ = static_cast<char8_t>(c);
+                } else if (c < 0x800) {
+                    *o++ = static_cast<char8_t>(0xC0 | (c >> 6));
+                    *o++ = static_cast<char8_t>(0x80 | (c & 0x3F));
+                } else if (c < 0x10000) {
+                    if (c >= 0xD800 && c <= 0xDFFF) {
+                        return {utf_error::surrogate, i};
+                    }
+                    *o++ = static_cast<char8_t>(0xE0 | (c >> 12));
+                    *o++ = static_cast<char8_t>(0x80 | ((c >> 6) & 0x3F));
+                    *o++ = static_cast<char8_t>(0x80 | (c & 0x3F));
+                } else {
+                    if (c > 0x10FFFF) {
+                        return {utf_error::too_large, i};
+                    }
+                    *o++ = static_cast<char8_t>(0xF0 | (c >> 18));
+                    *o++ = static_cast<char8_t>(0x80 | ((c >> 12) & 0x3F));
+                    *o++ = static_cast<char8_t>(0x80 | ((c >> 6) & 0x3F));
+                    *o++ = static_cast<char8_t>(0x80 | (c & 0x3F));
+                }
+            }
+        }
+        return {utf_error::none, static_cast<std::size_t>(o - out)};
+    }
+
+} // namespace bsv
+
+#endif // UTF8_IMPL_HPP
@@ -0,0 +1,31 @@
+/*
+Minimal assertion helpers shared by the tests/ programs of every module.
+CHECK(expr) prints the expression, file and line of every failed check and carries on, so that one run lists all of
+them; CHECK_THROWS(expr, exception) checks that evaluating expr throws exception (or a class derived from it). A test
+returns check::report() from main, which is non-zero once a check has failed, for ctest to see.
+*/
+
+#ifndef CHECK_HPP
+#define CHECK_HPP
+
+namespace check {
+
+    // Counts and prints a failure unless ok; returns ok.
+    bool expect (bool ok, const char* expr, const char* file, int line);
+
+    // Prints how many checks failed and returns the exit status of the test: 0 if none did, 1 otherwise.
+    int report();
+
+} // namespace check
+
+#define CHECK(expr) ::check::expect(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+#define CHECK_THROWS(expr, exception)                                                                                 \
+    ::check::expect([&] {                                                                                             \
+        try { static_cast<void>(expr); } catch (const exception&) { return true; } catch (...) {}                    \
+        return false;                                                                                                 \
+    }(), #expr " throws " #exception, __FILE__, __LINE__)
+
+#include "check.impl.hpp"
+
+#endif // CHECK_HPP
@@ -0,0 +1,30 @@
+#ifndef CHECK_IMPL_HPP
+#define CHECK_IMPL_HPP
+
+#include "check.hpp"
+
+#include <cstdio>
+
+namespace check {
+    namespace detail {
+        inline int checks = 0;
+        inline int failures = 0;
+    }
+
+    inline bool expect (bool ok, const char* expr, const char* file, int line) {
+        ++detail::checks;
+        if (!ok) {
+            ++detail::failures;
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+        }
+        return ok;
+    }
+
+    inline int report() {
+        std::printf("%d of %d checks failed\n", detail::failures, detail::checks);
+        return detail::failures == 0 ? 0 : 1;
+    }
+
+} // namespace check
+
+#endif // CHECK_IMPL_HPP